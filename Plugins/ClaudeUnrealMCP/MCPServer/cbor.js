@@ -0,0 +1,169 @@
+// Minimal CBOR (RFC 8949) decoder for responses from the editor plugin.
+// Supports everything the plugin emits: integers, floats, text and byte strings,
+// arrays, maps (string keys), booleans and null. Indefinite lengths are accepted too.
+
+const BREAK = Symbol("break");
+
+function decodeHalf(bits) {
+  const exponent = (bits >> 10) & 0x1f;
+  const mantissa = bits & 0x3ff;
+  const sign = bits & 0x8000 ? -1 : 1;
+  if (exponent === 0) {
+    return sign * 2 ** -14 * (mantissa / 1024);
+  }
+  if (exponent === 0x1f) {
+    return mantissa ? NaN : sign * Infinity;
+  }
+  return sign * 2 ** (exponent - 15) * (1 + mantissa / 1024);
+}
+
+export function decodeCbor(buffer) {
+  const view = new DataView(buffer.buffer, buffer.byteOffset, buffer.byteLength);
+  let offset = 0;
+
+  function need(count) {
+    if (offset + count > buffer.length) {
+      throw new Error("Truncated CBOR data");
+    }
+  }
+
+  function readArgument(info) {
+    if (info < 24) {
+      return info;
+    }
+    switch (info) {
+      case 24:
+        need(1);
+        return view.getUint8(offset++);
+      case 25: {
+        need(2);
+        const value = view.getUint16(offset);
+        offset += 2;
+        return value;
+      }
+      case 26: {
+        need(4);
+        const value = view.getUint32(offset);
+        offset += 4;
+        return value;
+      }
+      case 27: {
+        need(8);
+        const value = view.getBigUint64(offset);
+        offset += 8;
+        return Number(value);
+      }
+      case 31:
+        return -1; // indefinite length
+      default:
+        throw new Error(`Invalid CBOR additional info ${info}`);
+    }
+  }
+
+  function readString(major, length) {
+    if (length === -1) {
+      // Indefinite string: concatenation of definite chunks until a break
+      const parts = [];
+      for (;;) {
+        const chunk = readItem();
+        if (chunk === BREAK) {
+          break;
+        }
+        parts.push(chunk);
+      }
+      return major === 3 ? parts.join("") : Buffer.concat(parts);
+    }
+
+    need(length);
+    const start = offset;
+    offset += length;
+    return major === 3 ? buffer.toString("utf8", start, offset) : buffer.subarray(start, offset);
+  }
+
+  function readItem() {
+    need(1);
+    const initial = view.getUint8(offset++);
+    const major = initial >> 5;
+    const info = initial & 0x1f;
+
+    switch (major) {
+      case 0:
+        return readArgument(info);
+      case 1:
+        return -1 - readArgument(info);
+      case 2:
+      case 3:
+        return readString(major, readArgument(info));
+      case 4: {
+        const length = readArgument(info);
+        const array = [];
+        if (length === -1) {
+          for (let item = readItem(); item !== BREAK; item = readItem()) {
+            array.push(item);
+          }
+        } else {
+          for (let i = 0; i < length; i++) {
+            array.push(readItem());
+          }
+        }
+        return array;
+      }
+      case 5: {
+        const length = readArgument(info);
+        const map = {};
+        for (let i = 0; length === -1 || i < length; i++) {
+          const key = readItem();
+          if (key === BREAK) {
+            break;
+          }
+          map[key] = readItem();
+        }
+        return map;
+      }
+      case 6:
+        // Tags carry no meaning for us; return the tagged item itself
+        readArgument(info);
+        return readItem();
+      case 7:
+        switch (info) {
+          case 20:
+            return false;
+          case 21:
+            return true;
+          case 22:
+          case 23:
+            return null;
+          case 25: {
+            need(2);
+            const value = decodeHalf(view.getUint16(offset));
+            offset += 2;
+            return value;
+          }
+          case 26: {
+            need(4);
+            const value = view.getFloat32(offset);
+            offset += 4;
+            return value;
+          }
+          case 27: {
+            need(8);
+            const value = view.getFloat64(offset);
+            offset += 8;
+            return value;
+          }
+          case 31:
+            return BREAK;
+          default:
+            return undefined;
+        }
+      default:
+        throw new Error(`Invalid CBOR major type ${major}`);
+    }
+  }
+
+  const value = readItem();
+  if (offset !== buffer.length) {
+    throw new Error(`Unexpected ${buffer.length - offset} trailing bytes after CBOR item`);
+  }
+  return value;
+}
@@ -7,6 +7,28 @@ export const MCP_TOOL_DEFINITIONS = [
           properties: {},
         },
       },
+      {
+        name: "get_server_stats",
+        description: "Per-command telemetry of the Unreal MCP server since it started or was last reset: request count, and for each of queue_wait_ms, execute_ms, serialize_ms, send_ms, response_bytes and allocations the count, total, mean, p50, p90, p99 and max. Commands are listed by total execution time, longest first. Percentiles come from log2 buckets and are within 2x. send_ms and response_bytes are per frame; allocations are process-wide Malloc/Realloc calls made while the command ran. Runs off the game thread, so it answers even while the editor is busy",
+        inputSchema: {
+          type: "object",
+          properties: {
+            commands: {
+              type: "array",
+              items: { type: "string" },
+              description: "Only report these commands. Default: every command that ran",
+            },
+            histograms: {
+              type: "boolean",
+              description: "Also list the non-empty buckets of every histogram as {le, count}. Default: false",
+            },
+            reset: {
+              type: "boolean",
+              description: "Clear all stats after reading them. Default: false",
+            },
+          },
+        },
+      },
       {
         name: "reload_mcp_server",
         description: "Reload the MCP server (useful after code changes to index.js)",
@@ -23,7 +45,65 @@ export const MCP_TOOL_DEFINITIONS = [
           properties: {
             path: {
               type: "string",
-              description: "Filter by path prefix (e.g., /Game/Blueprints)",
+              description: "Filter by path prefix (e.g., /Game/Blueprints) or glob: * any characters, ? one character, [a-z] / [!a-z] character sets; case-insensitive (e.g., /Game/*/Enemies)",
+            },
+            page_size: {
+              type: "number",
+              description: "Optional: Return at most this many items, in a stable order, plus 'next_cursor' when more remain (default 100 once paging, max 10000). Without page_size or cursor everything is returned. Every page still scans all blueprints under path in the asset registry, so narrowing path is what makes a page cheaper",
+            },
+            cursor: {
+              type: "string",
+              description: "Optional: 'next_cursor' from the previous page of this command; continues after the last item it returned",
+            },
+          },
+        },
+      },
+      {
+        name: "query_assets",
+        description: "Find assets by folder, class, parent class, interface and asset registry tags, and return their metadata (parent class, interfaces, blueprint type, tags such as NumReplicatedProperties) without loading them. Much faster than reading each blueprint",
+        inputSchema: {
+          type: "object",
+          properties: {
+            path: {
+              type: "string",
+              description: "Optional: Package path prefix (e.g., /Game/Blueprints) or glob: * any characters, ? one character, [a-z] / [!a-z] character sets; case-insensitive. Default: /Game/",
+            },
+            class: {
+              type: ["string", "array"],
+              items: { type: "string" },
+              description: "Optional: Asset class name(s): Blueprint, AnimBlueprint, WidgetBlueprint, UserDefinedStruct, UserDefinedEnum, DataTable, World, InputAction, InputMappingContext, or any class path (e.g., /Script/Engine.StaticMesh). Default: Blueprint (all blueprint kinds)",
+            },
+            exact_class: {
+              type: "boolean",
+              description: "Optional: Match class exactly, excluding subclasses (default: false)",
+            },
+            name_pattern: {
+              type: "string",
+              description: "Optional: Asset name glob; text without wildcards matches anywhere in the name",
+            },
+            parent_class: {
+              type: "string",
+              description: "Optional: Direct parent class name or glob (e.g., 'Character', 'BP_Enemy*'); matches the short name with or without _C, or the full path",
+            },
+            implements_interface: {
+              type: "string",
+              description: "Optional: Interface name or glob (e.g., 'BPI_Interactable'); matches assets implementing it directly",
+            },
+            tags: {
+              type: "object",
+              description: "Optional: Asset registry tag values that must match exactly (e.g., { \"BlueprintType\": \"BPTYPE_Normal\" })",
+            },
+            fields: {
+              type: "string",
+              description: "Optional: Fields to return, comma-separated: name, path, class, parent_class, native_parent_class, blueprint_type, implemented_interfaces, tags (or tags{TagA,TagB}). Default: all; bulk search-data tags are only returned when named",
+            },
+            page_size: {
+              type: "number",
+              description: "Optional: Return at most this many items, in a stable order, plus 'next_cursor' when more remain (default 100 once paging, max 10000). Without page_size or cursor everything is returned. Every page still scans all assets the filters match in the asset registry, so narrowing path or class is what makes a page cheaper",
+            },
+            cursor: {
+              type: "string",
+              description: "Optional: 'next_cursor' from the previous page of this command; continues after the last item it returned",
             },
           },
         },
@@ -36,12 +116,20 @@ export const MCP_TOOL_DEFINITIONS = [
           properties: {
             path: {
               type: "string",
-              description: "Filter by path prefix (e.g., /Game/Blueprints). Defaults to /Game/",
+              description: "Filter by path prefix (e.g., /Game/Blueprints) or glob: * any characters, ? one character, [a-z] / [!a-z] character sets; case-insensitive. Defaults to /Game/",
             },
             include_warnings: {
               type: "boolean",
               description: "Include blueprints with warnings (not just errors). Default: false",
             },
+            use_cache: {
+              type: "boolean",
+              description: "Reuse the last compile result of blueprints that have not changed, and whose dependencies have not changed, since they were last checked. Set to false to recompile everything. Default: true",
+            },
+            async: {
+              type: "boolean",
+              description: "Return a job_id immediately instead of waiting; poll with get_job_status. By default the call waits for the job to finish",
+            },
           },
         },
       },
@@ -83,6 +171,22 @@ export const MCP_TOOL_DEFINITIONS = [
               type: "string",
               description: "Full path to the blueprint asset",
             },
+            page_size: {
+              type: "number",
+              description: "Optional: Return at most this many items, in a stable order, plus 'next_cursor' when more remain (default 100 once paging, max 10000). Without page_size or cursor everything is returned",
+            },
+            cursor: {
+              type: "string",
+              description: "Optional: 'next_cursor' from the previous page of this command; continues after the last item it returned",
+            },
+            fields: {
+              type: "string",
+              description: "Optional: Property fields to return, comma-separated (e.g., 'name,value'): name, type, category, value, object_value, object_class, class_value, class_name, array_size, array_values. Default: all",
+            },
+            max_depth: {
+              type: "number",
+              description: "Optional: 0 leaves out struct and container values and array_values, which are not exported at all. Default: unlimited",
+            },
           },
           required: ["path"],
         },
@@ -97,6 +201,14 @@ export const MCP_TOOL_DEFINITIONS = [
               type: "string",
               description: "Full path to the blueprint asset",
             },
+            page_size: {
+              type: "number",
+              description: "Optional: Return at most this many items, in a stable order, plus 'next_cursor' when more remain (default 100 once paging, max 10000). Without page_size or cursor everything is returned",
+            },
+            cursor: {
+              type: "string",
+              description: "Optional: 'next_cursor' from the previous page of this command; continues after the last item it returned",
+            },
           },
           required: ["path"],
         },
@@ -115,6 +227,22 @@ export const MCP_TOOL_DEFINITIONS = [
               type: "string",
               description: "Name of the component to read properties from (e.g., CharacterMover, SkeletalMesh)",
             },
+            page_size: {
+              type: "number",
+              description: "Optional: Return at most this many items, in a stable order, plus 'next_cursor' when more remain (default 100 once paging, max 10000). Without page_size or cursor everything is returned",
+            },
+            cursor: {
+              type: "string",
+              description: "Optional: 'next_cursor' from the previous page of this command; continues after the last item it returned",
+            },
+            fields: {
+              type: "string",
+              description: "Optional: Property fields to return, comma-separated (e.g., 'name,value'): name, type, category, value, object_value, object_class, class_value, class_name, array_size, array_values. Default: all",
+            },
+            max_depth: {
+              type: "number",
+              description: "Optional: 0 leaves out struct and container values and array_values, which are not exported at all. Default: unlimited",
+            },
           },
           required: ["path", "component_name"],
         },
@@ -122,7 +250,7 @@ export const MCP_TOOL_DEFINITIONS = [
       {
         name: "read_event_graph",
         description:
-          "Read the event graph nodes and their connections from a blueprint",
+          "Read the event graph nodes and their connections from a blueprint. The editor streams the result in chunks, but it is collected in full before it is returned; narrow it with fields or max_depth",
         inputSchema: {
           type: "object",
           properties: {
@@ -130,6 +258,14 @@ export const MCP_TOOL_DEFINITIONS = [
               type: "string",
               description: "Full path to the blueprint asset",
             },
+            fields: {
+              type: "string",
+              description: "Optional: Node fields to return, comma-separated, with braces for pin and connection fields (e.g., 'id,connections' or 'id,type,pins{name,default_value}'). Node fields: id, class, title, type, event_name, function_name, variable_name, property_path, path_segments, pins, connections. Unselected fields, notably the costly title, are not computed. Default: all",
+            },
+            max_depth: {
+              type: "number",
+              description: "Optional: Levels of nested objects/arrays to return below each node; 0 leaves out pins and connections. Default: unlimited",
+            },
           },
           required: ["path"],
         },
@@ -137,7 +273,7 @@ export const MCP_TOOL_DEFINITIONS = [
       {
         name: "read_event_graph_detailed",
         description:
-          "Read the event graph nodes, connections, and pin default values from a blueprint",
+          "Read the event graph nodes, connections, and pin default values from a blueprint. The editor streams the result in chunks, but it is collected in full before it is returned; bound it with page_size, fields or since_version",
         inputSchema: {
           type: "object",
           properties: {
@@ -145,13 +281,34 @@ export const MCP_TOOL_DEFINITIONS = [
               type: "string",
               description: "Full path to the blueprint asset",
             },
+            page_size: {
+              type: "number",
+              description: "Optional: Return at most this many nodes across all graphs read in full, ordered by graph name then node id, plus 'next_cursor' when more remain (default 100 once paging, max 10000). Pages seek to the cursor in a node order kept per graph version, so a late page costs no more than the first, and stay stable when nodes are added or removed between pages; prefer it over start_index/max_nodes",
+            },
+            cursor: {
+              type: "string",
+              description: "Optional: 'next_cursor' from the previous page of this command; continues after the last node it returned",
+            },
             max_nodes: {
               type: "integer",
-              description: "Optional max nodes to return (for large graphs, use pagination)",
+              description: "Optional max nodes to return per graph (positional paging; ignored with page_size or cursor)",
             },
             start_index: {
               type: "integer",
-              description: "Optional start index into graph nodes (pagination)",
+              description: "Optional start index into each graph's nodes (positional paging; ignored with page_size or cursor)",
+            },
+            since_version: {
+              type: "integer",
+              description:
+                "Optional 'version' from an earlier response of this command. Graphs still known at that version come back with delta: true and only the added or changed nodes, removed_nodes, added_links and removed_links; others are read in full (delta: false). Pagination applies to full reads only",
+            },
+            fields: {
+              type: "string",
+              description: "Optional: Node fields to return, comma-separated, with braces for pin and connection fields (e.g., 'id,connections' or 'id,type,pins{name,default_value}'). Node fields: id, class, title, type, event_name, function_name, variable_name, property_path, path_segments, pins, connections. Unselected fields, notably the costly title, are not computed. Default: all",
+            },
+            max_depth: {
+              type: "number",
+              description: "Optional: Levels of nested objects/arrays to return below each node; 0 leaves out pins and connections. Default: unlimited",
             },
           },
           required: ["path"],
@@ -160,7 +317,7 @@ export const MCP_TOOL_DEFINITIONS = [
       {
         name: "read_function_graphs",
         description:
-          "Read function graph nodes, connections, and pin default values from a blueprint",
+          "Read function graph nodes, connections, and pin default values from a blueprint. The editor streams the result in chunks, but it is collected in full before it is returned; bound it with page_size, fields or since_version",
         inputSchema: {
           type: "object",
           properties: {
@@ -172,13 +329,34 @@ export const MCP_TOOL_DEFINITIONS = [
               type: "string",
               description: "Optional function graph name to filter (exact match)",
             },
+            page_size: {
+              type: "number",
+              description: "Optional: Return at most this many nodes across all graphs read in full, ordered by graph name then node id, plus 'next_cursor' when more remain (default 100 once paging, max 10000). Pages seek to the cursor in a node order kept per graph version, so a late page costs no more than the first, and stay stable when nodes are added or removed between pages; prefer it over start_index/max_nodes",
+            },
+            cursor: {
+              type: "string",
+              description: "Optional: 'next_cursor' from the previous page of this command; continues after the last node it returned",
+            },
             max_nodes: {
               type: "integer",
-              description: "Optional max nodes per graph (for large graphs)",
+              description: "Optional max nodes per graph (positional paging; ignored with page_size or cursor)",
             },
             start_index: {
               type: "integer",
-              description: "Optional start index into graph nodes (pagination)",
+              description: "Optional start index into each graph's nodes (positional paging; ignored with page_size or cursor)",
+            },
+            since_version: {
+              type: "integer",
+              description:
+                "Optional 'version' from an earlier response of this command. Graphs still known at that version come back with delta: true and only the added or changed nodes, removed_nodes, added_links and removed_links; others are read in full (delta: false). Pagination applies to full reads only",
+            },
+            fields: {
+              type: "string",
+              description: "Optional: Node fields to return, comma-separated, with braces for pin and connection fields (e.g., 'id,connections' or 'id,type,pins{name,default_value}'). Node fields: id, class, title, type, event_name, function_name, variable_name, property_path, path_segments, pins, connections. Unselected fields, notably the costly title, are not computed. Default: all",
+            },
+            max_depth: {
+              type: "number",
+              description: "Optional: Levels of nested objects/arrays to return below each node; 0 leaves out pins and connections. Default: unlimited",
             },
           },
           required: ["path"],
@@ -245,7 +423,16 @@ export const MCP_TOOL_DEFINITIONS = [
         description: "List all actors in the current level",
         inputSchema: {
           type: "object",
-          properties: {},
+          properties: {
+            page_size: {
+              type: "number",
+              description: "Optional: Return at most this many items, in a stable order, plus 'next_cursor' when more remain (default 100 once paging, max 10000). Without page_size or cursor everything is returned. Pages seek to the cursor in the editor's actor index, so a late page costs no more than the first",
+            },
+            cursor: {
+              type: "string",
+              description: "Optional: 'next_cursor' from the previous page of this command; continues after the last item it returned",
+            },
+          },
         },
       },
       {
@@ -258,6 +445,14 @@ export const MCP_TOOL_DEFINITIONS = [
               type: "string",
               description: "Name of the actor in the level (e.g., LevelBlock_Traversable_C_24)",
             },
+            page_size: {
+              type: "number",
+              description: "Optional: Return at most this many items, in a stable order, plus 'next_cursor' when more remain (default 100 once paging, max 10000). Without page_size or cursor everything is returned",
+            },
+            cursor: {
+              type: "string",
+              description: "Optional: 'next_cursor' from the previous page of this command; continues after the last item it returned",
+            },
           },
           required: ["actor_name"],
         },
@@ -276,19 +471,35 @@ export const MCP_TOOL_DEFINITIONS = [
               type: "string",
               description: "Component name to inspect (use read_actor_components to find names)",
             },
+            page_size: {
+              type: "number",
+              description: "Optional: Return at most this many items, in a stable order, plus 'next_cursor' when more remain (default 100 once paging, max 10000). Without page_size or cursor everything is returned",
+            },
+            cursor: {
+              type: "string",
+              description: "Optional: 'next_cursor' from the previous page of this command; continues after the last item it returned",
+            },
+            fields: {
+              type: "string",
+              description: "Optional: Property fields to return, comma-separated (e.g., 'name,value'): name, type, category, value, object_value, object_class, class_value, class_name, array_size, array_values. Default: all",
+            },
+            max_depth: {
+              type: "number",
+              description: "Optional: 0 leaves out struct and container values and array_values, which are not exported at all. Default: unlimited",
+            },
           },
           required: ["actor_name", "component_name"],
         },
       },
       {
         name: "find_actors_by_name",
-        description: "Search for actors by name pattern (supports wildcards: * for any characters, ? for single character)",
+        description: "Search for actors by name pattern (supports wildcards: * for any characters, ? for single character, [a-z] / [!a-z] for character sets)",
         inputSchema: {
           type: "object",
           properties: {
             name_pattern: {
               type: "string",
-              description: "Name pattern to search for (e.g., 'LevelBlock*', '*Traversable*', 'Player?')",
+              description: "Name pattern to search for (e.g., 'LevelBlock*', '*Traversable*', 'Player?', 'Door_[0-9]'); text without wildcards matches anywhere in the name",
             },
             actor_class: {
               type: "string",
@@ -298,6 +509,49 @@ export const MCP_TOOL_DEFINITIONS = [
           required: ["name_pattern"],
         },
       },
+      {
+        name: "query_actors",
+        description: "Find level actors by name or label pattern, class and/or location. Filters combine; omitted filters match everything",
+        inputSchema: {
+          type: "object",
+          properties: {
+            name_pattern: {
+              type: "string",
+              description: "Optional: Actor name or label, exact or glob: * any characters, ? one character, [a-z] / [!a-z] character sets; case-insensitive",
+            },
+            actor_class: {
+              type: "string",
+              description: "Optional: Actor class name (e.g., 'StaticMeshActor', 'LevelBlock_C'); subclasses match too",
+            },
+            exact_class: {
+              type: "boolean",
+              description: "Optional: Match actor_class exactly, excluding subclasses (default: false)",
+            },
+            bounds_min: {
+              type: "array",
+              items: { type: "number" },
+              description: "Optional: Minimum corner [x, y, z] of a world-space box; actors whose bounds intersect it match",
+            },
+            bounds_max: {
+              type: "array",
+              items: { type: "number" },
+              description: "Optional: Maximum corner [x, y, z] of the box; required with bounds_min",
+            },
+            max_results: {
+              type: "number",
+              description: "Optional: Maximum number of actors to return; 'truncated' is set when more matched",
+            },
+            page_size: {
+              type: "number",
+              description: "Optional: Return at most this many items, in a stable order, plus 'next_cursor' when more remain (default 100 once paging, max 10000). Without page_size or cursor everything is returned. Every page still ranks all actors the filters match; narrow the filters, or use list_actors, to page cheaply through a large level",
+            },
+            cursor: {
+              type: "string",
+              description: "Optional: 'next_cursor' from the previous page of this command; continues after the last item it returned",
+            },
+          },
+        },
+      },
       {
         name: "get_actor_material_info",
         description: "Get detailed material information from an actor's components (materials, textures, parameters)",
@@ -498,7 +752,7 @@ export const MCP_TOOL_DEFINITIONS = [
       },
       {
         name: "compile_blueprint",
-        description: "Compile a blueprint",
+        description: "Compile one or more blueprints. Graph edits (connect_nodes, disconnect_pin, delete_node, ...) only queue a compile; blueprints still queued are compiled in the same pass, dependencies first, and listed under 'blueprints'",
         inputSchema: {
           type: "object",
           properties: {
@@ -506,8 +760,79 @@ export const MCP_TOOL_DEFINITIONS = [
               type: "string",
               description: "Full path to the blueprint asset",
             },
+            paths: {
+              type: "array",
+              items: { type: "string" },
+              description: "Several blueprints to compile in one pass instead of 'path'; each is reported under 'blueprints'",
+            },
           },
-          required: ["path"],
+        },
+      },
+      {
+        name: "flush",
+        description: "Compile every blueprint with queued edits now, in dependency order. Queued compiles otherwise run at the end of a batch, before save_asset/save_all, or after about a second without further edits",
+        inputSchema: {
+          type: "object",
+          properties: {},
+        },
+      },
+      {
+        name: "batch",
+        description: "Run several commands in order in one editor game-thread slice. Much faster than issuing them one by one (e.g. a sequence of connect_nodes / set_pin_default / reconstruct_node / compile_blueprint). Returns one result per executed command, in order; blueprints the commands edited are compiled once at the end and reported under 'compile'.",
+        inputSchema: {
+          type: "object",
+          properties: {
+            commands: {
+              type: "array",
+              description: "Ordered list of commands to run",
+              items: {
+                type: "object",
+                properties: {
+                  command: {
+                    type: "string",
+                    description: "Command name (any tool except batch)",
+                  },
+                  params: {
+                    type: "object",
+                    description: "Parameters for the command",
+                  },
+                },
+                required: ["command"],
+              },
+            },
+            stop_on_error: {
+              type: "boolean",
+              description: "Stop at the first command that fails. Default: false",
+            },
+          },
+          required: ["commands"],
+        },
+      },
+      {
+        name: "get_job_status",
+        description: "Get status (running, succeeded, failed or cancelled), progress and (once finished) the result of a long-running job started with async=true. Without job_id, lists all known jobs.",
+        inputSchema: {
+          type: "object",
+          properties: {
+            job_id: {
+              type: "number",
+              description: "Job id returned when the job was started",
+            },
+          },
+        },
+      },
+      {
+        name: "cancel_job",
+        description: "Cancel a running job. It stops before its next step; work already done is kept and reported in the result.",
+        inputSchema: {
+          type: "object",
+          properties: {
+            job_id: {
+              type: "number",
+              description: "Job id returned when the job was started",
+            },
+          },
+          required: ["job_id"],
         },
       },
       {
@@ -526,10 +851,15 @@ export const MCP_TOOL_DEFINITIONS = [
       },
       {
         name: "save_all",
-        description: "Save all modified assets in the project",
+        description: "Save all modified assets and levels in the project. Runs as a job: packages are saved one per step with their files written in the background, and job_progress events name the package being saved in 'current'",
         inputSchema: {
           type: "object",
-          properties: {},
+          properties: {
+            async: {
+              type: "boolean",
+              description: "Return a job_id immediately instead of waiting; poll with get_job_status. By default the call waits for the job to finish",
+            },
+          },
         },
       },
       {
@@ -576,7 +906,15 @@ export const MCP_TOOL_DEFINITIONS = [
           properties: {
             pattern: {
               type: "string",
-              description: "Pattern to filter struct names (e.g., 'FS_', 'CharacterProperties'). Default: 'FS_'",
+              description: "Substring of struct names (e.g., 'FS_', 'CharacterProperties') or glob: * any characters, ? one character, [a-z] / [!a-z] character sets; case-insensitive (e.g., 'FS_*Data'). Default: 'FS_'",
+            },
+            page_size: {
+              type: "number",
+              description: "Optional: Return at most this many items, in a stable order, plus 'next_cursor' when more remain (default 100 once paging, max 10000). Without page_size or cursor everything is returned. Every page still scans all loaded structs",
+            },
+            cursor: {
+              type: "string",
+              description: "Optional: 'next_cursor' from the previous page of this command; continues after the last item it returned",
             },
           },
         },
@@ -951,6 +1289,22 @@ export const MCP_TOOL_DEFINITIONS = [
               type: "string",
               description: "Name of the actor in the level (e.g., LevelVisuals_2, LevelBlock_3)",
             },
+            page_size: {
+              type: "number",
+              description: "Optional: Return at most this many items, in a stable order, plus 'next_cursor' when more remain (default 100 once paging, max 10000). Without page_size or cursor everything is returned",
+            },
+            cursor: {
+              type: "string",
+              description: "Optional: 'next_cursor' from the previous page of this command; continues after the last item it returned",
+            },
+            fields: {
+              type: "string",
+              description: "Optional: Property names to return, comma-separated (e.g., 'RelativeLocation,bHidden'). Default: all",
+            },
+            max_depth: {
+              type: "number",
+              description: "Optional: 0 leaves out struct and container properties, which are not exported at all. Default: unlimited",
+            },
           },
           required: ["actor_name"],
         },
@@ -1202,6 +1556,11 @@ export const MCP_TOOL_DEFINITIONS = [
               type: "boolean",
               description: "If true, report what would change without modifying anything. Default: false",
             },
+            blueprint_paths: {
+              type: "array",
+              items: { type: "string" },
+              description: "Only migrate these blueprints (e.g. one chunk of a plan_migration plan); others are not loaded. An empty list migrates no blueprints",
+            },
           },
           required: ["source_struct_path", "target_struct_path"],
         },
@@ -1225,10 +1584,41 @@ export const MCP_TOOL_DEFINITIONS = [
               type: "boolean",
               description: "If true, report what would change without modifying anything. Default: false",
             },
+            async: {
+              type: "boolean",
+              description: "Return a job_id immediately instead of waiting; poll with get_job_status. By default the call waits for the job to finish",
+            },
+            blueprint_paths: {
+              type: "array",
+              items: { type: "string" },
+              description: "Only migrate these blueprints (e.g. one chunk of a plan_migration plan); others are not loaded. An empty list migrates no blueprints",
+            },
           },
           required: ["source_enum_path", "target_enum_path"],
         },
       },
+      {
+        name: "plan_migration",
+        description: "Plan a migrate_enum_references or migrate_struct_references run without loading any package. Uses the asset registry and the type reference index to list affected blueprints with variable, node and pin counts (for blueprints already indexed), disk size, and estimated load and compile seconds, then orders them into dependency stages split into chunks. Stages run in order; the chunks of a stage do not depend on each other and may run in any order, but all run on the editor's game thread, so the total estimate is their sum. With target_path each chunk carries the command and params to run it",
+        inputSchema: {
+          type: "object",
+          properties: {
+            source_path: {
+              type: "string",
+              description: "UserDefinedEnum or UserDefinedStruct to migrate from (e.g., '/Game/Blueprints/Data/E_Gait')",
+            },
+            target_path: {
+              type: "string",
+              description: "C++ type to migrate to, used to fill in each chunk's params",
+            },
+            chunk_size: {
+              type: "number",
+              description: "Most blueprints per chunk. Default: 25",
+            },
+          },
+          required: ["source_path"],
+        },
+      },
       {
         name: "fix_optional_struct_pin_defaults",
         description: "Fix invalid enum default values stored in optional struct pins (hidden SetFieldsInStruct/MakeStruct pins). Replaces NewEnumeratorN with the enum value names.",
@@ -1285,7 +1675,7 @@ export const MCP_TOOL_DEFINITIONS = [
             },
             pin_name_contains: {
               type: "string",
-              description: "Optional: only fix pins whose names contain this substring (e.g., ActionType)",
+              description: "Optional: only fix pins whose names contain this substring (e.g., ActionType) or match this glob: * any characters, ? one character, [a-z] / [!a-z] character sets; case-insensitive",
             },
           },
           required: ["blueprint_path", "enum_path"],
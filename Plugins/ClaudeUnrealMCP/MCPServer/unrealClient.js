@@ -1,56 +1,348 @@
 import * as net from "net";
+import * as zlib from "zlib";
+import { decodeCbor } from "./cbor.js";
 
 const UE_HOST = process.env.UE_HOST || "127.0.0.1";
 const UE_PORT = parseInt(process.env.UE_PORT || "9877", 10);
+// Response encoding requested from the editor: "cbor" (compact binary) or "json"
+const UE_ENCODING = process.env.UE_ENCODING || "cbor";
+// Optional compression of large responses ("zlib"); worth it over slow links such as SSH tunnels
+const UE_COMPRESSION = process.env.UE_COMPRESSION || "none";
+// Responses smaller than this many bytes are never compressed
+const UE_COMPRESSION_THRESHOLD = parseInt(process.env.UE_COMPRESSION_THRESHOLD || "4096", 10);
+const REQUEST_TIMEOUT_MS = 30000;
+// Async jobs report progress several times a second; give up only if they go quiet
+const JOB_IDLE_TIMEOUT_MS = 60000;
+const MAX_UNCLAIMED_JOB_RESULTS = 32;
 
-export async function sendToUnreal(command, params = {}) {
-  return new Promise((resolve, reject) => {
-    const client = new net.Socket();
-    let data = "";
+// Commands that can run for minutes; these are started as editor-side jobs
+const LONG_RUNNING_COMMANDS = new Set(["check_all_blueprints", "migrate_enum_references", "save_all"]);
 
-    client.setNoDelay(true);
-    client.setTimeout(30000);
+// One long-lived connection to the editor. Requests are newline-delimited JSON with
+// an "id"; responses echo the id, so many requests can be in flight at once and
+// may complete in any order. Messages with an "event" field instead of an id are
+// unsolicited job notifications (job_progress, job_complete).
+//
+// Right after connecting, a "hello" request asks for the preferred response encoding
+// and for chunking. Either way every frame from the editor describes itself: a JSON
+// line, or a "$<length>:<encoding>[:tags]\n" header followed by that many payload bytes.
+// Large responses may come as several "chunk=<stream>" frames, the final one tagged
+// "last"; their payloads joined together form the message. A "zlib" tag means that frame's
+// payload is compressed.
+//
+// Only the editor side streams. Chunking keeps the editor's memory flat and lets it pause
+// for a slow reader, but this client keeps every chunk of a response and decodes the whole
+// message once the last one arrives, so its memory still grows with the response. Bound
+// large reads with paging or field selection, not with chunking.
+class UnrealConnection {
+  constructor(host, port) {
+    this.host = host;
+    this.port = port;
+    this.socket = null;
+    this.connecting = null;
+    this.pending = new Map();
+    this.jobs = new Map();
+    this.unclaimedJobResults = new Map();
+    this.nextId = 1;
+    this.resetReceiveState();
+  }
 
-    client.connect(UE_PORT, UE_HOST, () => {
-      const request = JSON.stringify({ command, params });
-      client.write(request);
-    });
+  resetReceiveState() {
+    // Socket reads not yet split into frames, kept as a list so a large frame arriving
+    // in many reads is joined once instead of on every read
+    this.received = [];
+    this.receivedBytes = 0;
+    this.awaitingBytes = 0;
+    // Payload pieces of chunked responses still in progress, by stream number
+    this.streams = new Map();
+  }
+
+  connect() {
+    if (this.socket) {
+      return Promise.resolve(this.socket);
+    }
+    if (this.connecting) {
+      return this.connecting;
+    }
+
+    this.connecting = new Promise((resolve, reject) => {
+      const socket = new net.Socket();
+      socket.setNoDelay(true);
+      socket.setKeepAlive(true);
 
-    client.on("data", (chunk) => {
-      data += chunk.toString("utf8");
-      if (data.endsWith("\n")) {
-        client.destroy();
-        try {
-          const trimmed = data.trim();
-          console.error(`Received ${trimmed.length} bytes from Unreal Engine`);
-          resolve(JSON.parse(trimmed));
-        } catch {
-          const preview =
-            data.length > 1000
-              ? `${data.substring(0, 1000)}... (truncated for display)`
-              : data;
-          reject(new Error(`Invalid JSON response (${data.length} bytes): ${preview}`));
+      socket.once("connect", () => {
+        this.socket = socket;
+        this.negotiate(socket).then(
+          () => {
+            this.connecting = null;
+            resolve(socket);
+          },
+          (err) => {
+            this.connecting = null;
+            reject(err);
+          }
+        );
+      });
+
+      socket.on("data", (chunk) => this.handleData(chunk));
+
+      socket.on("error", (err) => {
+        if (this.connecting) {
+          this.connecting = null;
+          reject(new Error(`Connection error: ${err.message}`));
         }
-      }
-    });
+        this.failAll(new Error(`Connection error: ${err.message}`));
+      });
 
-    client.on("timeout", () => {
-      client.destroy();
-      reject(new Error("Connection timeout"));
-    });
+      socket.on("close", () => {
+        this.socket = null;
+        this.resetReceiveState();
+        this.failAll(new Error("Connection closed by Unreal Engine"));
+      });
 
-    client.on("error", (err) => {
-      reject(new Error(`Connection error: ${err.message}`));
+      socket.connect(this.port, this.host);
     });
 
-    client.on("close", () => {
-      if (data && !data.includes("\n")) {
-        try {
-          resolve(JSON.parse(data.trim()));
-        } catch {
-          // Ignore parse errors on close; handled above when data is complete.
+    return this.connecting;
+  }
+
+  async negotiate(socket) {
+    const options = { encoding: UE_ENCODING, chunking: true };
+    if (UE_COMPRESSION !== "none") {
+      options.compression = UE_COMPRESSION;
+      options.compression_threshold = UE_COMPRESSION_THRESHOLD;
+    }
+
+    const reply = await this.sendOnSocket(socket, "hello", options);
+    if (!reply.success) {
+      // Older plugin builds have no hello; they only speak JSON
+      console.error(`Unreal Engine did not accept ${UE_ENCODING} encoding: ${reply.error}`);
+    }
+  }
+
+  handleData(chunk) {
+    this.received.push(chunk);
+    this.receivedBytes += chunk.length;
+    if (this.receivedBytes < this.awaitingBytes) {
+      return;
+    }
+
+    const buffer = this.received.length === 1 ? this.received[0] : Buffer.concat(this.received, this.receivedBytes);
+    this.received = [];
+    this.receivedBytes = 0;
+    this.awaitingBytes = 0;
+
+    let offset = 0;
+    while (offset < buffer.length) {
+      if (buffer[offset] === 0x24 /* $ */) {
+        // Length-prefixed frame: $<length>:<encoding>[:tags]\n<payload>
+        const headerEnd = buffer.indexOf(0x0a, offset);
+        if (headerEnd === -1) {
+          break;
+        }
+        const [lengthText, ...tags] = buffer.toString("latin1", offset + 1, headerEnd).split(":");
+        const length = parseInt(lengthText, 10);
+        const payloadEnd = headerEnd + 1 + length;
+        if (buffer.length < payloadEnd) {
+          this.awaitingBytes = payloadEnd - offset;
+          break;
+        }
+        this.handleFrame(buffer.subarray(headerEnd + 1, payloadEnd), tags);
+        offset = payloadEnd;
+      } else {
+        const newline = buffer.indexOf(0x0a, offset);
+        if (newline === -1) {
+          break;
         }
+        const line = buffer.subarray(offset, newline);
+        offset = newline + 1;
+        if (line.toString("latin1").trim()) {
+          this.handleFrame(line, ["json"]);
+        }
+      }
+    }
+
+    if (offset < buffer.length) {
+      const rest = buffer.subarray(offset);
+      this.received.push(rest);
+      this.receivedBytes = rest.length;
+    }
+  }
+
+  handleFrame(framePayload, tags) {
+    const encoding = tags[0] || "json";
+    const chunkTag = tags.find((tag) => tag.startsWith("chunk="));
+    if (tags.includes("zlib")) {
+      try {
+        framePayload = zlib.inflateSync(framePayload);
+      } catch (err) {
+        console.error(`Invalid compressed frame (${framePayload.length} bytes): ${err.message}`);
+        return;
+      }
+    }
+
+    let payload = framePayload;
+    if (chunkTag) {
+      // Keep the raw pieces until the last one arrives; nothing is decoded or copied before
+      // then, but the whole payload is held here (see the note above the class)
+      const streamId = chunkTag.slice("chunk=".length);
+      const stream = this.streams.get(streamId) || { pieces: [], bytes: 0 };
+      stream.pieces.push(framePayload);
+      stream.bytes += framePayload.length;
+      if (!tags.includes("last")) {
+        this.streams.set(streamId, stream);
+        return;
+      }
+      this.streams.delete(streamId);
+      payload = Buffer.concat(stream.pieces, stream.bytes);
+    }
+
+    let message;
+    try {
+      if (encoding === "cbor") {
+        message = decodeCbor(payload);
+      } else if (encoding === "json") {
+        message = JSON.parse(payload.toString("utf8"));
+      } else {
+        throw new Error(`unsupported encoding "${encoding}"`);
+      }
+    } catch (err) {
+      const text = payload.toString("utf8", 0, Math.min(payload.length, 1000));
+      const preview = payload.length > 1000 ? `${text}... (truncated for display)` : text;
+      console.error(`Invalid ${encoding} response (${payload.length} bytes, ${err.message}): ${preview}`);
+      return;
+    }
+
+    this.handleMessage(message, payload.length);
+  }
+
+  handleMessage(message, byteLength) {
+    if (message.event) {
+      this.handleEvent(message);
+      return;
+    }
+
+    const request = this.pending.get(message.id);
+    if (!request) {
+      console.error(`Received response for unknown request id ${message.id}`);
+      return;
+    }
+
+    console.error(`Received ${byteLength} bytes from Unreal Engine`);
+    this.pending.delete(message.id);
+    clearTimeout(request.timer);
+    delete message.id;
+    request.resolve(message);
+  }
+
+  handleEvent(event) {
+    if (event.event === "job_progress") {
+      console.error(
+        `Job ${event.job_id} (${event.command}): ${event.phase} ${event.done}/${event.total}`
+      );
+      const job = this.jobs.get(event.job_id);
+      if (job) {
+        job.resetTimer();
+      }
+      return;
+    }
+
+    if (event.event === "job_complete") {
+      const job = this.jobs.get(event.job_id);
+      if (job) {
+        this.jobs.delete(event.job_id);
+        clearTimeout(job.timer);
+        job.resolve(event);
+        return;
       }
+
+      // The completion can arrive before the caller has seen the job id
+      this.unclaimedJobResults.set(event.job_id, event);
+      if (this.unclaimedJobResults.size > MAX_UNCLAIMED_JOB_RESULTS) {
+        this.unclaimedJobResults.delete(this.unclaimedJobResults.keys().next().value);
+      }
+      return;
+    }
+
+    console.error(`Ignoring unknown event from Unreal Engine: ${event.event}`);
+  }
+
+  waitForJob(jobId) {
+    const finished = this.unclaimedJobResults.get(jobId);
+    if (finished) {
+      this.unclaimedJobResults.delete(jobId);
+      return Promise.resolve(finished);
+    }
+
+    return new Promise((resolve, reject) => {
+      const job = { resolve, reject, timer: null };
+      job.resetTimer = () => {
+        clearTimeout(job.timer);
+        job.timer = setTimeout(() => {
+          this.jobs.delete(jobId);
+          reject(new Error(`Job ${jobId} stopped reporting progress`));
+        }, JOB_IDLE_TIMEOUT_MS);
+      };
+      job.resetTimer();
+      this.jobs.set(jobId, job);
     });
-  });
+  }
+
+  // Starts a long-running command as an editor job and resolves with its final result
+  async runJob(command, params) {
+    const started = await this.send(command, { ...params, async: true });
+    if (!started.success) {
+      return started;
+    }
+
+    // Same shape as the synchronous call: a job that reported an error is not a success
+    const completion = await this.waitForJob(started.data.job_id);
+    if (completion.status === "failed") {
+      return { success: false, data: completion.result, error: completion.result?.error };
+    }
+    return { success: true, data: completion.result };
+  }
+
+  failAll(error) {
+    for (const request of this.pending.values()) {
+      clearTimeout(request.timer);
+      request.reject(error);
+    }
+    this.pending.clear();
+
+    for (const job of this.jobs.values()) {
+      clearTimeout(job.timer);
+      job.reject(error);
+    }
+    this.jobs.clear();
+  }
+
+  async send(command, params) {
+    const socket = await this.connect();
+    return this.sendOnSocket(socket, command, params);
+  }
+
+  sendOnSocket(socket, command, params) {
+    const id = this.nextId++;
+
+    return new Promise((resolve, reject) => {
+      const timer = setTimeout(() => {
+        this.pending.delete(id);
+        reject(new Error("Connection timeout"));
+      }, REQUEST_TIMEOUT_MS);
+
+      this.pending.set(id, { resolve, reject, timer });
+      socket.write(`${JSON.stringify({ id, command, params })}\n`);
+    });
+  }
+}
+
+const connection = new UnrealConnection(UE_HOST, UE_PORT);
+
+export async function sendToUnreal(command, params = {}) {
+  // Callers that pass "async" themselves get the job id back and poll with get_job_status
+  if (LONG_RUNNING_COMMANDS.has(command) && params.async === undefined) {
+    return connection.runJob(command, params);
+  }
+  return connection.send(command, params);
 }
@@ -28,7 +28,8 @@ public class ClaudeUnrealMCP : ModuleRules
 			"InputCore",
 			"UMGEditor",  // For UWidgetBlueprint
 			"Chooser",    // For UChooserTable migration
-			"StructUtils"  // For FInstancedStruct
+			"StructUtils", // For FInstancedStruct
+			"Cbor"         // For binary response encoding
 		});
 	}
 }
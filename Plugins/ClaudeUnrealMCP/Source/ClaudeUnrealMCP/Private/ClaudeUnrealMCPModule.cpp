@@ -1,5 +1,9 @@
 #include "ClaudeUnrealMCPModule.h"
 #include "MCPServer.h"
+#include "MCPServerTypeIndex.h"
+#include "MCPServerTypeRegistry.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
 #include "Editor.h"
 #include "Kismet2/KismetEditorUtilities.h"
 #include "Framework/Application/SlateApplication.h"
@@ -26,8 +30,13 @@ void FClaudeUnrealMCPModule::StartupModule()
 		{
 			if (GEditor)
 			{
+				OnBlueprintPreCompileHandle = GEditor->OnBlueprintPreCompile().AddRaw(this, &FClaudeUnrealMCPModule::OnBlueprintPreCompile);
 				OnBlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddRaw(this, &FClaudeUnrealMCPModule::OnBlueprintCompiled);
-				UE_LOG(LogTemp, Log, TEXT("ClaudeUnrealMCP: Registered blueprint compile callback"));
+
+				IAssetRegistry& AssetRegistry = FAssetRegistryModule::GetRegistry();
+				OnAssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FClaudeUnrealMCPModule::OnAssetRemoved);
+				OnAssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FClaudeUnrealMCPModule::OnAssetRenamed);
+				UE_LOG(LogTemp, Log, TEXT("ClaudeUnrealMCP: Registered blueprint compile and asset registry callbacks"));
 				return false; // Stop ticking
 			}
 			return true; // Keep ticking until GEditor is available
@@ -44,12 +53,19 @@ void FClaudeUnrealMCPModule::ShutdownModule()
 		FTSTicker::GetCoreTicker().RemoveTicker(TickerHandle);
 	}
 
-	// Unregister blueprint compilation callback
+	// Unregister blueprint compilation callbacks
 	if (GEditor && OnBlueprintCompiledHandle.IsValid())
 	{
+		GEditor->OnBlueprintPreCompile().Remove(OnBlueprintPreCompileHandle);
 		GEditor->OnBlueprintCompiled().Remove(OnBlueprintCompiledHandle);
 	}
 
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		AssetRegistryModule->Get().OnAssetRemoved().Remove(OnAssetRemovedHandle);
+		AssetRegistryModule->Get().OnAssetRenamed().Remove(OnAssetRenamedHandle);
+	}
+
 	if (Server)
 	{
 		Server->Stop();
@@ -58,13 +74,39 @@ void FClaudeUnrealMCPModule::ShutdownModule()
 	}
 }
 
+void FClaudeUnrealMCPModule::OnBlueprintPreCompile(UBlueprint* Blueprint)
+{
+	if (FMCPTypeReferenceIndex* TypeIndex = Server ? Server->GetTypeReferenceIndex() : nullptr)
+	{
+		TypeIndex->OnBlueprintPreCompile(Blueprint);
+	}
+}
+
 void FClaudeUnrealMCPModule::OnBlueprintCompiled()
 {
-	// Defer reconstruction with a small delay to let blueprint compilation and reinstancing fully complete
-	// The callback fires during compilation, before all objects are ready
-	if (Server)
+	// Rescan the blueprints reported by OnBlueprintPreCompile
+	if (FMCPTypeReferenceIndex* TypeIndex = Server ? Server->GetTypeReferenceIndex() : nullptr)
+	{
+		TypeIndex->OnBlueprintCompiled();
+	}
+}
+
+void FClaudeUnrealMCPModule::OnAssetRemoved(const FAssetData& AssetData)
+{
+	if (FMCPTypeReferenceIndex* TypeIndex = Server ? Server->GetTypeReferenceIndex() : nullptr)
+	{
+		TypeIndex->OnAssetRemoved(AssetData);
+	}
+}
+
+void FClaudeUnrealMCPModule::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	// The type registry lives outside the server and would otherwise only notice on a lookup by the old name
+	FMCPTypeRegistry::Get().OnAssetRenamed(AssetData, OldObjectPath);
+
+	if (FMCPTypeReferenceIndex* TypeIndex = Server ? Server->GetTypeReferenceIndex() : nullptr)
 	{
-		// Server started successfully
+		TypeIndex->OnAssetRenamed(AssetData, OldObjectPath);
 	}
 }
 
@@ -55,6 +55,9 @@
 #include "EnhancedInputComponent.h"
 #include "Components/ActorComponent.h"
 #include "Kismet2/ComponentEditorUtils.h"
+#include "MCPServerActorIndex.h"
+#include "MCPServerPaging.h"
+#include "MCPServerFields.h"
 
 FString FMCPServer::HandleReadActorProperties(const TSharedPtr<FJsonObject>& Params)
 {
@@ -72,26 +75,34 @@ FString FMCPServer::HandleReadActorProperties(const TSharedPtr<FJsonObject>& Par
 	}
 
 	// Find the actor by name in the current level
-	AActor* FoundActor = nullptr;
-	for (TActorIterator<AActor> It(World); It; ++It)
-	{
-		AActor* Actor = *It;
-		if (Actor && Actor->GetName() == ActorName)
-		{
-			FoundActor = Actor;
-			break;
-		}
-	}
+	AActor* FoundActor = ActorIndex->FindByName(World, FName(*ActorName, FNAME_Find));
 
 	if (!FoundActor)
 	{
 		return MakeError(FString::Printf(TEXT("Actor not found: %s"), *ActorName));
 	}
 
+	FMCPPage Page(TEXT("read_actor_properties"));
+	FString PageError;
+	if (!Page.Init(Params, PageError))
+	{
+		return MakeError(PageError);
+	}
+
+	// The actor is the item here: "fields" picks properties by name, and max_depth 0 leaves out
+	// struct and container values
+	FMCPFieldSelection Fields;
+	FString FieldsError;
+	if (!Fields.Init(Params, FieldsError))
+	{
+		return MakeError(FieldsError);
+	}
+
 	// Serialize actor properties to JSON
 	TSharedPtr<FJsonObject> PropertiesObj = MakeShared<FJsonObject>();
 	UClass* ActorClass = FoundActor->GetClass();
 
+	TArray<FProperty*> Properties;
 	for (TFieldIterator<FProperty> PropIt(ActorClass); PropIt; ++PropIt)
 	{
 		FProperty* Property = *PropIt;
@@ -102,6 +113,18 @@ FString FMCPServer::HandleReadActorProperties(const TSharedPtr<FJsonObject>& Par
 			continue;
 		}
 
+		const FString PropertyName = Property->GetName();
+		if (IsNestedProperty(Property) ? !Fields.HasNested(PropertyName) : !Fields.Has(PropertyName))
+		{
+			continue;
+		}
+
+		Page.Offer(PropertyName, Properties.Add(Property));
+	}
+
+	for (const int32 PropertyIndex : Page.Finish())
+	{
+		FProperty* Property = Properties[PropertyIndex];
 		FString PropertyName = Property->GetName();
 		FString PropertyValue;
 		Property->ExportTextItem_Direct(PropertyValue, Property->ContainerPtrToValuePtr<void>(FoundActor), nullptr, FoundActor, PPF_None);
@@ -114,6 +137,7 @@ FString FMCPServer::HandleReadActorProperties(const TSharedPtr<FJsonObject>& Par
 	Data->SetStringField(TEXT("actor_class"), ActorClass->GetName());
 	Data->SetStringField(TEXT("actor_label"), FoundActor->GetActorLabel());
 	Data->SetObjectField(TEXT("properties"), PropertiesObj);
+	Page.WriteCursor(Data);
 
 	return MakeResponse(true, Data);
 }
@@ -135,16 +159,7 @@ FString FMCPServer::HandleSetActorProperties(const TSharedPtr<FJsonObject>& Para
 	}
 
 	// Find the actor by name
-	AActor* FoundActor = nullptr;
-	for (TActorIterator<AActor> It(World); It; ++It)
-	{
-		AActor* Actor = *It;
-		if (Actor && Actor->GetName() == ActorName)
-		{
-			FoundActor = Actor;
-			break;
-		}
-	}
+	AActor* FoundActor = ActorIndex->FindByName(World, FName(*ActorName, FNAME_Find));
 
 	if (!FoundActor)
 	{
@@ -185,6 +200,9 @@ FString FMCPServer::HandleSetActorProperties(const TSharedPtr<FJsonObject>& Para
 	// Mark the actor for saving
 	FoundActor->MarkPackageDirty();
 
+	// ImportText raises no change event, so the index would keep the old bounds
+	ActorIndex->Refresh(FoundActor);
+
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetStringField(TEXT("message"), TEXT("Actor properties set successfully"));
 	Data->SetStringField(TEXT("actor_name"), ActorName);
@@ -212,16 +230,7 @@ FString FMCPServer::HandleSetActorComponentProperty(const TSharedPtr<FJsonObject
 		return MakeError(TEXT("No world available"));
 	}
 
-	AActor* FoundActor = nullptr;
-	for (TActorIterator<AActor> It(World); It; ++It)
-	{
-		AActor* Actor = *It;
-		if (Actor && Actor->GetName() == ActorName)
-		{
-			FoundActor = Actor;
-			break;
-		}
-	}
+	AActor* FoundActor = ActorIndex->FindByName(World, FName(*ActorName, FNAME_Find));
 
 	if (!FoundActor)
 	{
@@ -285,6 +294,9 @@ FString FMCPServer::HandleSetActorComponentProperty(const TSharedPtr<FJsonObject
 
 	FoundActor->MarkPackageDirty();
 
+	// A relative transform or a new mesh changes the actor's bounds
+	ActorIndex->Refresh(FoundActor);
+
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetStringField(TEXT("message"), TEXT("Actor component property set successfully"));
 	Data->SetStringField(TEXT("actor_name"), ActorName);
@@ -311,16 +323,7 @@ FString FMCPServer::HandleReconstructActor(const TSharedPtr<FJsonObject>& Params
 	}
 
 	// Find the actor by name
-	AActor* FoundActor = nullptr;
-	for (TActorIterator<AActor> It(World); It; ++It)
-	{
-		AActor* Actor = *It;
-		if (Actor && Actor->GetName() == ActorName)
-		{
-			FoundActor = Actor;
-			break;
-		}
-	}
+	AActor* FoundActor = ActorIndex->FindByName(World, FName(*ActorName, FNAME_Find));
 
 	if (!FoundActor)
 	{
@@ -336,6 +339,9 @@ FString FMCPServer::HandleReconstructActor(const TSharedPtr<FJsonObject>& Params
 	// Mark the actor for saving
 	FoundActor->MarkPackageDirty();
 
+	// The construction script may have added, removed or resized components
+	ActorIndex->Refresh(FoundActor);
+
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetStringField(TEXT("message"), TEXT("Actor reconstructed successfully"));
 	Data->SetStringField(TEXT("actor_name"), ActorName);
@@ -360,85 +366,25 @@ FString FMCPServer::HandleFindActorsByName(const TSharedPtr<FJsonObject>& Params
 		return MakeError(TEXT("No world available"));
 	}
 
-	// Convert wildcard pattern to regex-like matching
-	// * = any characters, ? = single character
-	FString Pattern = NamePattern;
-	Pattern.ReplaceInline(TEXT("*"), TEXT(".*"));
-	Pattern.ReplaceInline(TEXT("?"), TEXT("."));
+	// A plain pattern matches anywhere in the name
+	FMCPActorQuery Query;
+	Query.NamePattern = FMCPGlobPattern(NamePattern, EMCPGlobLiteral::Substring);
+	Query.bNameOnly = true;
+	Query.ClassName = ActorClass;
+	Query.bExactClass = true;
 
 	TArray<TSharedPtr<FJsonValue>> MatchedActors;
-	for (TActorIterator<AActor> It(World); It; ++It)
+	for (AActor* Actor : ActorIndex->Query(World, Query))
 	{
-		AActor* Actor = *It;
-		if (!Actor) continue;
-
-		// Filter by class if specified
-		if (!ActorClass.IsEmpty() && Actor->GetClass()->GetName() != ActorClass)
-		{
-			continue;
-		}
-
-		// Check if name matches pattern (simple wildcard matching)
-		FString ActorName = Actor->GetName();
-		bool bMatches = false;
-
-		if (NamePattern.Contains(TEXT("*")) || NamePattern.Contains(TEXT("?")))
-		{
-			// Simple wildcard matching - check if pattern matches
-			FString Remaining = ActorName;
-			TArray<FString> Parts;
-			NamePattern.ParseIntoArray(Parts, TEXT("*"), true);
-
-			if (Parts.Num() == 0)
-			{
-				bMatches = true; // Pattern is just "*"
-			}
-			else
-			{
-				bMatches = true;
-				int32 SearchStart = 0;
-
-				for (int32 i = 0; i < Parts.Num(); i++)
-				{
-					if (Parts[i].IsEmpty()) continue;
-
-					int32 FoundIndex = Remaining.Find(Parts[i], ESearchCase::IgnoreCase, ESearchDir::FromStart, SearchStart);
-					if (FoundIndex == INDEX_NONE || (i == 0 && !NamePattern.StartsWith(TEXT("*")) && FoundIndex != 0))
-					{
-						bMatches = false;
-						break;
-					}
-					SearchStart = FoundIndex + Parts[i].Len();
-				}
+		TSharedPtr<FJsonObject> ActorObj = MakeShared<FJsonObject>();
+		ActorObj->SetStringField(TEXT("name"), Actor->GetName());
+		ActorObj->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
+		ActorObj->SetStringField(TEXT("label"), Actor->GetActorLabel());
 
-				// Check end match
-				if (bMatches && !NamePattern.EndsWith(TEXT("*")) && Parts.Num() > 0)
-				{
-					if (!Remaining.EndsWith(Parts.Last()))
-					{
-						bMatches = false;
-					}
-				}
-			}
-		}
-		else
-		{
-			// Exact match or contains
-			bMatches = ActorName.Contains(NamePattern);
-		}
-
-		if (bMatches)
-		{
-			TSharedPtr<FJsonObject> ActorObj = MakeShared<FJsonObject>();
-			ActorObj->SetStringField(TEXT("name"), Actor->GetName());
-			ActorObj->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
-			ActorObj->SetStringField(TEXT("label"), Actor->GetActorLabel());
-
-			FVector Location = Actor->GetActorLocation();
-			ActorObj->SetStringField(TEXT("location"), FString::Printf(TEXT("%.1f, %.1f, %.1f"), Location.X, Location.Y, Location.Z));
+		FVector Location = Actor->GetActorLocation();
+		ActorObj->SetStringField(TEXT("location"), FString::Printf(TEXT("%.1f, %.1f, %.1f"), Location.X, Location.Y, Location.Z));
 
-			MatchedActors.Add(MakeShared<FJsonValueObject>(ActorObj));
-		}
+		MatchedActors.Add(MakeShared<FJsonValueObject>(ActorObj));
 	}
 
 	TSharedPtr<FJsonObject> ResponseData = MakeShared<FJsonObject>();
@@ -465,15 +411,7 @@ FString FMCPServer::HandleGetActorMaterialInfo(const TSharedPtr<FJsonObject>& Pa
 	}
 
 	// Find the actor
-	AActor* FoundActor = nullptr;
-	for (TActorIterator<AActor> It(World); It; ++It)
-	{
-		if (It->GetName() == ActorName)
-		{
-			FoundActor = *It;
-			break;
-		}
-	}
+	AActor* FoundActor = ActorIndex->FindByName(World, FName(*ActorName, FNAME_Find));
 
 	if (!FoundActor)
 	{
@@ -541,17 +479,11 @@ FString FMCPServer::HandleGetSceneSummary(const TSharedPtr<FJsonObject>& Params)
 	}
 
 	// Count actors by class
-	TMap<FString, int32> ActorCountByClass;
+	TMap<FString, int32> ActorCountByClass = ActorIndex->CountByClass(World);
 	int32 TotalActors = 0;
-
-	for (TActorIterator<AActor> It(World); It; ++It)
+	for (const TPair<FString, int32>& Pair : ActorCountByClass)
 	{
-		AActor* Actor = *It;
-		if (!Actor) continue;
-
-		FString ClassName = Actor->GetClass()->GetName();
-		ActorCountByClass.FindOrAdd(ClassName)++;
-		TotalActors++;
+		TotalActors += Pair.Value;
 	}
 
 	// Build response
@@ -0,0 +1,615 @@
+#include "MCPServerActorIndex.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Sort.h"
+#include "Algo/Unique.h"
+#include "Components/ActorComponent.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+#include "MCPServerPaging.h"
+#include "Misc/CoreDelegates.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace MCPActorIndex
+{
+	// Grid cell edge in world units
+	static constexpr double CellSize = 2000.0;
+
+	// Actors covering more cells than this go to the large-actor list instead
+	static constexpr int64 MaxCellsPerActor = 64;
+
+	// Boxes covering more cells than this are answered by scanning every actor
+	static constexpr int64 MaxCellsPerQuery = 4096;
+
+	static FBox GetActorBounds(const AActor* Actor)
+	{
+		const FBox Bounds = Actor->GetComponentsBoundingBox(/*bNonColliding*/ true);
+		if (Bounds.IsValid)
+		{
+			return Bounds;
+		}
+		const FVector Location = Actor->GetActorLocation();
+		return FBox(Location, Location);
+	}
+
+	static bool PathLess(const FString& A, const FString& B)
+	{
+		return FMCPPage::KeyLess(A, B);
+	}
+
+	static bool IsClassMatch(const UClass* Class, const FString& ClassName, bool bExactClass)
+	{
+		for (const UClass* Current = Class; Current; Current = Current->GetSuperClass())
+		{
+			if (Current->GetName() == ClassName)
+			{
+				return true;
+			}
+			if (bExactClass)
+			{
+				break;
+			}
+		}
+		return false;
+	}
+}
+
+FMCPActorIndex::FMCPActorIndex()
+{
+}
+
+FMCPActorIndex::~FMCPActorIndex()
+{
+	UnbindDelegates();
+}
+
+AActor* FMCPActorIndex::FindByName(UWorld* World, FName Name)
+{
+	Prepare(World);
+	if (const TArray<int32, TInlineAllocator<1>>* Slots = SlotsByName.Find(Name))
+	{
+		for (const int32 Slot : *Slots)
+		{
+			AActor* Actor = GetLiveActor(Slot);
+			if (Actor && Actor->GetFName() == Name)
+			{
+				return Actor;
+			}
+		}
+	}
+	return nullptr;
+}
+
+TArray<AActor*> FMCPActorIndex::Query(UWorld* World, const FMCPActorQuery& Query, bool* bOutTruncated, TArray<FString>* OutPaths)
+{
+	Prepare(World);
+
+	// Classes are few; resolve the class filter once instead of walking each actor's hierarchy
+	TSet<TObjectKey<UClass>> MatchingClasses;
+	if (!Query.ClassName.IsEmpty())
+	{
+		for (const TPair<TObjectKey<UClass>, TSet<int32>>& Pair : SlotsByClass)
+		{
+			if (MCPActorIndex::IsClassMatch(Pair.Key.ResolveObjectPtr(), Query.ClassName, Query.bExactClass))
+			{
+				MatchingClasses.Add(Pair.Key);
+			}
+		}
+	}
+
+	// Gather candidates from the most selective index available
+	TArray<int32> Candidates;
+	bool bAllEntries = false;
+	const FString* ExactName = Query.NamePattern.GetExactText();
+	FIntVector MinCell;
+	FIntVector MaxCell;
+	if (ExactName)
+	{
+		if (const TArray<int32, TInlineAllocator<1>>* Slots = SlotsByName.Find(FName(**ExactName, FNAME_Find)))
+		{
+			Candidates.Append(*Slots);
+		}
+		const TArray<int32, TInlineAllocator<1>>* Slots = Query.bNameOnly ? nullptr : SlotsByLabel.Find(*ExactName);
+		if (Slots)
+		{
+			Candidates.Append(*Slots);
+		}
+	}
+	else if (Query.Bounds.IsSet() && GetGridCells(*Query.Bounds, MinCell, MaxCell))
+	{
+		for (int32 X = MinCell.X; X <= MaxCell.X; ++X)
+		{
+			for (int32 Y = MinCell.Y; Y <= MaxCell.Y; ++Y)
+			{
+				for (int32 Z = MinCell.Z; Z <= MaxCell.Z; ++Z)
+				{
+					if (const TArray<int32>* Slots = Grid.Find(FIntVector(X, Y, Z)))
+					{
+						Candidates.Append(*Slots);
+					}
+				}
+			}
+		}
+		Candidates.Append(LargeSlots.Array());
+	}
+	else if (!Query.ClassName.IsEmpty())
+	{
+		for (const TObjectKey<UClass>& Class : MatchingClasses)
+		{
+			Candidates.Append(SlotsByClass.FindChecked(Class).Array());
+		}
+	}
+	else
+	{
+		bAllEntries = true;
+		Candidates.Reserve(Entries.Num());
+		for (auto It = Entries.CreateConstIterator(); It; ++It)
+		{
+			Candidates.Add(It.GetIndex());
+		}
+	}
+
+	if (!bAllEntries)
+	{
+		// Index order, and actors spanning several grid cells only once
+		Candidates.Sort();
+		Candidates.SetNum(Algo::Unique(Candidates));
+	}
+
+	TArray<AActor*> Result;
+	if (bOutTruncated)
+	{
+		*bOutTruncated = false;
+	}
+	for (const int32 Slot : Candidates)
+	{
+		AActor* Actor = GetLiveActor(Slot);
+		if (!Actor)
+		{
+			continue;
+		}
+
+		const FEntry& Entry = Entries[Slot];
+		if (!Query.ClassName.IsEmpty() && !MatchingClasses.Contains(Entry.Class))
+		{
+			continue;
+		}
+		if (Query.Bounds.IsSet() && !Query.Bounds->Intersect(Entry.Bounds))
+		{
+			continue;
+		}
+		if (!Query.NamePattern.IsMatchAll())
+		{
+			TStringBuilder<FName::StringBufferSize> Name;
+			Entry.Name.ToString(Name);
+			if (!Query.NamePattern.Matches(Name.ToView()) && (Query.bNameOnly || !Query.NamePattern.Matches(Entry.Label)))
+			{
+				continue;
+			}
+		}
+
+		if (Result.Num() >= Query.MaxResults)
+		{
+			if (bOutTruncated)
+			{
+				*bOutTruncated = true;
+			}
+			break;
+		}
+		Result.Add(Actor);
+		if (OutPaths)
+		{
+			OutPaths->Add(Entry.Path);
+		}
+	}
+	return Result;
+}
+
+TArray<AActor*> FMCPActorIndex::GetAllActors(UWorld* World)
+{
+	Prepare(World);
+
+	TArray<AActor*> Actors;
+	Actors.Reserve(Entries.Num());
+	for (auto It = Entries.CreateConstIterator(); It; ++It)
+	{
+		if (AActor* Actor = GetLiveActor(It.GetIndex()))
+		{
+			Actors.Add(Actor);
+		}
+	}
+	return Actors;
+}
+
+void FMCPActorIndex::GetActorsByPath(UWorld* World, const FString* AfterPath, int32 MaxCount, TArray<AActor*>& OutActors, TArray<FString>& OutPaths)
+{
+	Prepare(World);
+
+	auto PathOf = [this](int32 Slot) -> const FString& { return Entries[Slot].Path; };
+	if (bPathOrderDirty)
+	{
+		SlotsByPath.Reset(Entries.Num());
+		for (auto It = Entries.CreateConstIterator(); It; ++It)
+		{
+			SlotsByPath.Add(It.GetIndex());
+		}
+		Algo::SortBy(SlotsByPath, PathOf, &MCPActorIndex::PathLess);
+		bPathOrderDirty = false;
+	}
+
+	int32 Position = AfterPath ? Algo::UpperBoundBy(SlotsByPath, *AfterPath, PathOf, &MCPActorIndex::PathLess) : 0;
+	for (; Position < SlotsByPath.Num() && OutActors.Num() < MaxCount; ++Position)
+	{
+		const int32 Slot = SlotsByPath[Position];
+		if (AActor* Actor = GetLiveActor(Slot))
+		{
+			OutActors.Add(Actor);
+			OutPaths.Add(Entries[Slot].Path);
+		}
+	}
+}
+
+TMap<FString, int32> FMCPActorIndex::CountByClass(UWorld* World)
+{
+	Prepare(World);
+
+	TMap<FString, int32> Counts;
+	for (const TPair<TObjectKey<UClass>, TSet<int32>>& Pair : SlotsByClass)
+	{
+		if (const UClass* Class = Pair.Key.ResolveObjectPtr())
+		{
+			Counts.FindOrAdd(Class->GetName()) += Pair.Value.Num();
+		}
+	}
+	return Counts;
+}
+
+void FMCPActorIndex::Refresh(AActor* Actor)
+{
+	const int32* Slot = Actor && !bDirty ? SlotByActor.Find(Actor) : nullptr;
+	if (Slot)
+	{
+		Unlink(*Slot);
+		Link(*Slot);
+	}
+}
+
+void FMCPActorIndex::Prepare(UWorld* World)
+{
+	BindDelegates();
+	if (bDirty || IndexedWorld.Get() != World)
+	{
+		Rebuild(World);
+	}
+}
+
+void FMCPActorIndex::BindDelegates()
+{
+	if (bDelegatesBound || !GEngine)
+	{
+		return;
+	}
+
+	ActorAddedHandle = GEngine->OnLevelActorAdded().AddRaw(this, &FMCPActorIndex::OnLevelActorAdded);
+	ActorDeletedHandle = GEngine->OnLevelActorDeleted().AddRaw(this, &FMCPActorIndex::OnLevelActorDeleted);
+	ActorMovedHandle = GEngine->OnActorMoved().AddRaw(this, &FMCPActorIndex::OnActorMoved);
+	ActorListChangedHandle = GEngine->OnLevelActorListChanged().AddRaw(this, &FMCPActorIndex::MarkDirty);
+	ActorLabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddRaw(this, &FMCPActorIndex::OnActorLabelChanged);
+	ObjectsReplacedHandle = FCoreUObjectDelegates::OnObjectsReplaced.AddRaw(this, &FMCPActorIndex::OnObjectsReplaced);
+	ObjectPropertyChangedHandle = FCoreUObjectDelegates::OnObjectPropertyChanged.AddRaw(this, &FMCPActorIndex::OnObjectPropertyChanged);
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FMCPActorIndex::OnLevelChanged);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FMCPActorIndex::OnLevelChanged);
+	bDelegatesBound = true;
+}
+
+void FMCPActorIndex::UnbindDelegates()
+{
+	if (!bDelegatesBound)
+	{
+		return;
+	}
+
+	if (GEngine)
+	{
+		GEngine->OnLevelActorAdded().Remove(ActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(ActorDeletedHandle);
+		GEngine->OnActorMoved().Remove(ActorMovedHandle);
+		GEngine->OnLevelActorListChanged().Remove(ActorListChangedHandle);
+	}
+	FCoreDelegates::OnActorLabelChanged.Remove(ActorLabelChangedHandle);
+	FCoreUObjectDelegates::OnObjectsReplaced.Remove(ObjectsReplacedHandle);
+	FCoreUObjectDelegates::OnObjectPropertyChanged.Remove(ObjectPropertyChangedHandle);
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	bDelegatesBound = false;
+}
+
+void FMCPActorIndex::Rebuild(UWorld* World)
+{
+	Entries.Empty();
+	SlotByActor.Empty();
+	SlotsByName.Empty();
+	SlotsByLabel.Empty();
+	SlotsByClass.Empty();
+	Grid.Empty();
+	LargeSlots.Empty();
+	// Sorted in one go when a paged listing next needs it, not patched actor by actor
+	SlotsByPath.Empty();
+	bPathOrderDirty = true;
+
+	IndexedWorld = World;
+	bDirty = false;
+	if (!World)
+	{
+		return;
+	}
+
+	for (TActorIterator<AActor> It(World); It; ++It)
+	{
+		if (AActor* Actor = *It)
+		{
+			Add(Actor);
+		}
+	}
+}
+
+void FMCPActorIndex::Add(AActor* Actor)
+{
+	if (SlotByActor.Contains(Actor))
+	{
+		return;
+	}
+
+	FEntry Entry;
+	Entry.Actor = Actor;
+	Entry.Class = Actor->GetClass();
+	const int32 Slot = Entries.Add(MoveTemp(Entry));
+	SlotByActor.Add(Actor, Slot);
+	SlotsByClass.FindOrAdd(Entries[Slot].Class).Add(Slot);
+	Link(Slot);
+}
+
+void FMCPActorIndex::Remove(AActor* Actor)
+{
+	int32 Slot = INDEX_NONE;
+	if (!SlotByActor.RemoveAndCopyValue(Actor, Slot))
+	{
+		return;
+	}
+
+	Unlink(Slot);
+	RemovePathOrder(Slot);
+	const TObjectKey<UClass> Class = Entries[Slot].Class;
+	if (TSet<int32>* Slots = SlotsByClass.Find(Class))
+	{
+		Slots->Remove(Slot);
+		if (Slots->Num() == 0)
+		{
+			SlotsByClass.Remove(Class);
+		}
+	}
+	Entries.RemoveAt(Slot);
+}
+
+void FMCPActorIndex::Link(int32 Slot)
+{
+	// Name, label and bounds can change while the actor stays; the class cannot
+	FEntry& Entry = Entries[Slot];
+	AActor* Actor = Entry.Actor.Get();
+	Entry.Name = Actor->GetFName();
+	Entry.Label = Actor->GetActorLabel();
+	Entry.Bounds = MCPActorIndex::GetActorBounds(Actor);
+
+	// The path order only needs patching on a rename, not on every move
+	FString Path = Actor->GetPathName();
+	if (!Path.Equals(Entry.Path, ESearchCase::CaseSensitive))
+	{
+		if (!Entry.Path.IsEmpty())
+		{
+			RemovePathOrder(Slot);
+		}
+		Entry.Path = MoveTemp(Path);
+		InsertPathOrder(Slot);
+	}
+
+	SlotsByName.FindOrAdd(Entry.Name).Add(Slot);
+	if (!Entry.Label.IsEmpty())
+	{
+		SlotsByLabel.FindOrAdd(Entry.Label).Add(Slot);
+	}
+
+	Entry.bLarge = !GetGridCells(Entry.Bounds, Entry.MinCell, Entry.MaxCell) ||
+		int64(Entry.MaxCell.X - Entry.MinCell.X + 1) * (Entry.MaxCell.Y - Entry.MinCell.Y + 1) * (Entry.MaxCell.Z - Entry.MinCell.Z + 1) > MCPActorIndex::MaxCellsPerActor;
+	if (Entry.bLarge)
+	{
+		LargeSlots.Add(Slot);
+		return;
+	}
+	for (int32 X = Entry.MinCell.X; X <= Entry.MaxCell.X; ++X)
+	{
+		for (int32 Y = Entry.MinCell.Y; Y <= Entry.MaxCell.Y; ++Y)
+		{
+			for (int32 Z = Entry.MinCell.Z; Z <= Entry.MaxCell.Z; ++Z)
+			{
+				Grid.FindOrAdd(FIntVector(X, Y, Z)).Add(Slot);
+			}
+		}
+	}
+}
+
+void FMCPActorIndex::Unlink(int32 Slot)
+{
+	const FEntry& Entry = Entries[Slot];
+
+	if (TArray<int32, TInlineAllocator<1>>* Slots = SlotsByName.Find(Entry.Name))
+	{
+		Slots->RemoveSingleSwap(Slot);
+		if (Slots->Num() == 0)
+		{
+			SlotsByName.Remove(Entry.Name);
+		}
+	}
+	if (TArray<int32, TInlineAllocator<1>>* Slots = SlotsByLabel.Find(Entry.Label))
+	{
+		Slots->RemoveSingleSwap(Slot);
+		if (Slots->Num() == 0)
+		{
+			SlotsByLabel.Remove(Entry.Label);
+		}
+	}
+
+	if (Entry.bLarge)
+	{
+		LargeSlots.Remove(Slot);
+		return;
+	}
+	for (int32 X = Entry.MinCell.X; X <= Entry.MaxCell.X; ++X)
+	{
+		for (int32 Y = Entry.MinCell.Y; Y <= Entry.MaxCell.Y; ++Y)
+		{
+			for (int32 Z = Entry.MinCell.Z; Z <= Entry.MaxCell.Z; ++Z)
+			{
+				const FIntVector Cell(X, Y, Z);
+				if (TArray<int32>* Slots = Grid.Find(Cell))
+				{
+					Slots->RemoveSingleSwap(Slot);
+					if (Slots->Num() == 0)
+					{
+						Grid.Remove(Cell);
+					}
+				}
+			}
+		}
+	}
+}
+
+void FMCPActorIndex::InsertPathOrder(int32 Slot)
+{
+	if (bPathOrderDirty)
+	{
+		return;
+	}
+	auto PathOf = [this](int32 Other) -> const FString& { return Entries[Other].Path; };
+	SlotsByPath.Insert(Slot, Algo::UpperBoundBy(SlotsByPath, Entries[Slot].Path, PathOf, &MCPActorIndex::PathLess));
+}
+
+void FMCPActorIndex::RemovePathOrder(int32 Slot)
+{
+	if (bPathOrderDirty)
+	{
+		return;
+	}
+	const FString& Path = Entries[Slot].Path;
+	auto PathOf = [this](int32 Other) -> const FString& { return Entries[Other].Path; };
+	for (int32 Position = Algo::LowerBoundBy(SlotsByPath, Path, PathOf, &MCPActorIndex::PathLess);
+		Position < SlotsByPath.Num() && Entries[SlotsByPath[Position]].Path.Equals(Path, ESearchCase::CaseSensitive); ++Position)
+	{
+		if (SlotsByPath[Position] == Slot)
+		{
+			SlotsByPath.RemoveAt(Position, EAllowShrinking::No);
+			return;
+		}
+	}
+	// Not where its path puts it; sort again on the next paged lookup
+	bPathOrderDirty = true;
+}
+
+AActor* FMCPActorIndex::GetLiveActor(int32 Slot)
+{
+	AActor* Actor = Entries[Slot].Actor.Get();
+	if (!Actor || Actor->IsActorBeingDestroyed())
+	{
+		// Went away without an event; start over on the next lookup
+		bDirty = true;
+		return nullptr;
+	}
+	return Actor;
+}
+
+bool FMCPActorIndex::GetGridCells(const FBox& Box, FIntVector& OutMin, FIntVector& OutMax) const
+{
+	const FVector Min = Box.Min / MCPActorIndex::CellSize;
+	const FVector Max = Box.Max / MCPActorIndex::CellSize;
+	const double Limit = double(MAX_int32 / 2);
+	if (!Box.IsValid || Min.GetAbsMax() > Limit || Max.GetAbsMax() > Limit)
+	{
+		return false;
+	}
+
+	OutMin = FIntVector(FMath::FloorToInt32(Min.X), FMath::FloorToInt32(Min.Y), FMath::FloorToInt32(Min.Z));
+	OutMax = FIntVector(FMath::FloorToInt32(Max.X), FMath::FloorToInt32(Max.Y), FMath::FloorToInt32(Max.Z));
+	const int64 CellCount = int64(OutMax.X - OutMin.X + 1) * (OutMax.Y - OutMin.Y + 1) * (OutMax.Z - OutMin.Z + 1);
+	return CellCount <= MCPActorIndex::MaxCellsPerQuery;
+}
+
+void FMCPActorIndex::OnLevelActorAdded(AActor* Actor)
+{
+	if (!bDirty && Actor && Actor->GetWorld() == IndexedWorld.Get())
+	{
+		Add(Actor);
+	}
+}
+
+void FMCPActorIndex::OnLevelActorDeleted(AActor* Actor)
+{
+	if (!bDirty && Actor)
+	{
+		Remove(Actor);
+	}
+}
+
+void FMCPActorIndex::OnActorMoved(AActor* Actor)
+{
+	Refresh(Actor);
+}
+
+void FMCPActorIndex::OnActorLabelChanged(AActor* Actor)
+{
+	// Setting a label can rename the actor object as well
+	Refresh(Actor);
+}
+
+void FMCPActorIndex::OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event)
+{
+	if (bDirty || !Object)
+	{
+		return;
+	}
+
+	// A component's transform, mesh or extent moves its owner's bounds; only actors of the
+	// indexed world are in SlotByActor, so anything else falls through the lookup in Refresh
+	if (AActor* Actor = Cast<AActor>(Object))
+	{
+		Refresh(Actor);
+	}
+	else if (const UActorComponent* Component = Cast<UActorComponent>(Object))
+	{
+		Refresh(Component->GetOwner());
+	}
+}
+
+void FMCPActorIndex::OnObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap)
+{
+	if (bDirty)
+	{
+		return;
+	}
+	for (const TPair<UObject*, UObject*>& Pair : ReplacementMap)
+	{
+		if (Pair.Key && Pair.Key->IsA<AActor>() && SlotByActor.Contains(static_cast<AActor*>(Pair.Key)))
+		{
+			// Reinstanced actors get a new class; cheaper to rebuild once than to patch every bucket
+			MarkDirty();
+			return;
+		}
+	}
+}
+
+void FMCPActorIndex::OnLevelChanged(ULevel* Level, UWorld* World)
+{
+	if (World && World == IndexedWorld.Get())
+	{
+		MarkDirty();
+	}
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MCPServerGlob.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtr.h"
+
+class AActor;
+struct FPropertyChangedEvent;
+class ULevel;
+class UWorld;
+
+/** Filter for FMCPActorIndex::Query. Empty or unset members match every actor. */
+struct FMCPActorQuery
+{
+	// Matched against the actor name and, unless bNameOnly is set, its label
+	FMCPGlobPattern NamePattern;
+	bool bNameOnly = false;
+
+	// Actor class name; subclasses match too unless bExactClass is set
+	FString ClassName;
+	bool bExactClass = false;
+
+	// Actors whose bounds intersect this box
+	TOptional<FBox> Bounds;
+
+	int32 MaxResults = MAX_int32;
+};
+
+/**
+ * Actors of the editor world by name, label, class and location.
+ *
+ * Built on first use with one pass over the world, then kept current from the engine's
+ * level-actor added, deleted and moved events, actor label changes, property edits on actors
+ * and their components, and object replacement (blueprint reinstancing). Commands that change
+ * an actor without raising those events call Refresh. Level streaming, actor list resets and a change of editor world
+ * trigger a rebuild on the next lookup. Spatial queries use a uniform hash grid; actors too
+ * large for it are kept in a list that every spatial query checks. Paged listings seek in a
+ * path name order that is sorted once after a rebuild and then patched as actors come, go
+ * and are renamed.
+ *
+ * Game thread only.
+ */
+class FMCPActorIndex
+{
+public:
+	FMCPActorIndex();
+	~FMCPActorIndex();
+
+	/** The actor with this object name, or null. */
+	AActor* FindByName(UWorld* World, FName Name);
+
+	/**
+	 * Matching actors in index order, at most Query.MaxResults. Sets bOutTruncated if there were
+	 * more, and fills OutPaths, when given, with their path names.
+	 */
+	TArray<AActor*> Query(UWorld* World, const FMCPActorQuery& Query, bool* bOutTruncated = nullptr, TArray<FString>* OutPaths = nullptr);
+
+	/** Every actor in index order. */
+	TArray<AActor*> GetAllActors(UWorld* World);
+
+	/**
+	 * Up to MaxCount actors and their path names in path order (FMCPPage::KeyLess), starting
+	 * after AfterPath when given: a binary search plus the actors returned.
+	 */
+	void GetActorsByPath(UWorld* World, const FString* AfterPath, int32 MaxCount, TArray<AActor*>& OutActors, TArray<FString>& OutPaths);
+
+	/** Actor count per class name. */
+	TMap<FString, int32> CountByClass(UWorld* World);
+
+	/** Re-reads the name, label and bounds of an indexed actor after it was changed in place. */
+	void Refresh(AActor* Actor);
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		FName Name;
+		FString Label;
+		FString Path;
+		TObjectKey<UClass> Class;
+		FBox Bounds;
+		// Grid cells covered by Bounds; unused for large actors
+		FIntVector MinCell;
+		FIntVector MaxCell;
+		bool bLarge = false;
+	};
+
+	void Prepare(UWorld* World);
+	void BindDelegates();
+	void UnbindDelegates();
+	void Rebuild(UWorld* World);
+	void Add(AActor* Actor);
+	void Remove(AActor* Actor);
+	void Link(int32 Slot);
+	void Unlink(int32 Slot);
+	void InsertPathOrder(int32 Slot);
+	void RemovePathOrder(int32 Slot);
+	AActor* GetLiveActor(int32 Slot);
+	bool GetGridCells(const FBox& Box, FIntVector& OutMin, FIntVector& OutMax) const;
+
+	void OnLevelActorAdded(AActor* Actor);
+	void OnLevelActorDeleted(AActor* Actor);
+	void OnActorMoved(AActor* Actor);
+	void OnActorLabelChanged(AActor* Actor);
+	void OnObjectPropertyChanged(UObject* Object, FPropertyChangedEvent& Event);
+	void OnObjectsReplaced(const TMap<UObject*, UObject*>& ReplacementMap);
+	void OnLevelChanged(ULevel* Level, UWorld* World);
+	void MarkDirty() { bDirty = true; }
+
+	TWeakObjectPtr<UWorld> IndexedWorld;
+	bool bDirty = true;
+
+	TSparseArray<FEntry> Entries;
+	TMap<TObjectKey<AActor>, int32> SlotByActor;
+	TMap<FName, TArray<int32, TInlineAllocator<1>>> SlotsByName;
+	// FString keys hash and compare case-insensitively
+	TMap<FString, TArray<int32, TInlineAllocator<1>>> SlotsByLabel;
+	TMap<TObjectKey<UClass>, TSet<int32>> SlotsByClass;
+	TMap<FIntVector, TArray<int32>> Grid;
+	TSet<int32> LargeSlots;
+
+	// Slots sorted by Path; rebuilt on the next paged lookup while bPathOrderDirty
+	TArray<int32> SlotsByPath;
+	bool bPathOrderDirty = true;
+
+	bool bDelegatesBound = false;
+	FDelegateHandle ActorAddedHandle;
+	FDelegateHandle ActorDeletedHandle;
+	FDelegateHandle ActorMovedHandle;
+	FDelegateHandle ActorListChangedHandle;
+	FDelegateHandle ActorLabelChangedHandle;
+	FDelegateHandle ObjectsReplacedHandle;
+	FDelegateHandle ObjectPropertyChangedHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+};
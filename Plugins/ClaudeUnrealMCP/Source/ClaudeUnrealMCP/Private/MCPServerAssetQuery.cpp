@@ -0,0 +1,126 @@
+#include "MCPServerAssetQuery.h"
+#include "MCPServerGlob.h"
+#include "Misc/PackageName.h"
+#include "String/Find.h"
+#include "Engine/Blueprint.h"
+#include "Animation/AnimBlueprint.h"
+#include "WidgetBlueprint.h"
+#include "Engine/UserDefinedStruct.h"
+#include "Engine/UserDefinedEnum.h"
+#include "Engine/DataTable.h"
+#include "Engine/World.h"
+#include "InputAction.h"
+#include "InputMappingContext.h"
+
+namespace MCPAssetQuery
+{
+	// Object path of one tag value: export text (Class'/Script/Engine.Actor'), possibly quoted
+	static FString ToObjectPath(FStringView Value)
+	{
+		FString Text = FString(Value).TrimStartAndEnd();
+		Text.TrimQuotesInline();
+		const FString Path = FPackageName::ExportTextPathToObjectPath(Text);
+		return Path == TEXT("None") ? FString() : Path;
+	}
+
+	void AddPackagePathFilter(FARFilter& Filter, const FMCPGlobPattern& PathPattern)
+	{
+		// "/Game/Blue" and "/Game/*/Enemies" both live under "/Game"; package path names compare
+		// case-insensitively, so the folded prefix works as is
+		const FString Prefix = PathPattern.GetLiteralPrefix();
+		int32 LastSlash = INDEX_NONE;
+		if (Prefix.FindLastChar(TEXT('/'), LastSlash) && LastSlash > 0)
+		{
+			Filter.PackagePaths.Add(FName(FStringView(Prefix).Left(LastSlash)));
+			Filter.bRecursivePaths = true;
+		}
+	}
+
+	FTopLevelAssetPath FindAssetClassPath(const FString& ClassName)
+	{
+		if (ClassName.StartsWith(TEXT("/")))
+		{
+			return FTopLevelAssetPath(ClassName);
+		}
+
+		// Resolving an arbitrary short name means searching live objects, which is not safe off
+		// the game thread; the asset classes these commands are asked about are known up front
+		static const TMap<FString, FTopLevelAssetPath> KnownClasses = []()
+		{
+			TMap<FString, FTopLevelAssetPath> Classes;
+			for (UClass* Class : { UBlueprint::StaticClass(), UAnimBlueprint::StaticClass(), UWidgetBlueprint::StaticClass(),
+				UUserDefinedStruct::StaticClass(), UUserDefinedEnum::StaticClass(), UDataTable::StaticClass(),
+				UWorld::StaticClass(), UInputAction::StaticClass(), UInputMappingContext::StaticClass() })
+			{
+				Classes.Add(Class->GetName(), Class->GetClassPathName());
+			}
+			return Classes;
+		}();
+
+		// TMap<FString> keys hash and compare case-insensitively
+		const FTopLevelAssetPath* Found = KnownClasses.Find(ClassName);
+		return Found ? *Found : FTopLevelAssetPath();
+	}
+
+	FString GetClassTag(const FAssetData& Asset, FName Tag)
+	{
+		FString Value;
+		return Asset.GetTagValue(Tag, Value) ? ToObjectPath(Value) : FString();
+	}
+
+	TArray<FString> GetImplementedInterfaces(const FAssetData& Asset)
+	{
+		TArray<FString> Interfaces;
+		FString Value;
+		if (!Asset.GetTagValue(FBlueprintTags::ImplementedInterfaces, Value))
+		{
+			return Interfaces;
+		}
+
+		// Either the exported FBPInterfaceDescription array, "((Interface=<path>,Graphs=(...)),...)",
+		// or a plain comma-separated list of paths
+		static const FStringView InterfaceKey = TEXTVIEW("Interface=");
+		const FStringView Text = Value;
+		const bool bDescriptions = Text.TrimStart().StartsWith(TEXT('('));
+
+		int32 Pos = 0;
+		while (Pos < Text.Len())
+		{
+			int32 Start = Pos;
+			if (bDescriptions)
+			{
+				const int32 KeyAt = UE::String::FindFirst(Text.RightChop(Pos), InterfaceKey, ESearchCase::CaseSensitive);
+				if (KeyAt == INDEX_NONE)
+				{
+					break;
+				}
+				Start = Pos + KeyAt + InterfaceKey.Len();
+			}
+
+			// The path ends at the next separator outside quotes
+			int32 End = Start;
+			bool bQuoted = false;
+			while (End < Text.Len() && (bQuoted || (Text[End] != TEXT(',') && Text[End] != TEXT(')'))))
+			{
+				if (Text[End] == TEXT('"'))
+				{
+					bQuoted = !bQuoted;
+				}
+				++End;
+			}
+
+			const FString Path = ToObjectPath(Text.Mid(Start, End - Start));
+			if (!Path.IsEmpty())
+			{
+				Interfaces.Add(Path);
+			}
+			Pos = End + 1;
+		}
+		return Interfaces;
+	}
+
+	FString GetObjectName(const FString& ObjectPath)
+	{
+		return FPackageName::ObjectPathToObjectName(ObjectPath);
+	}
+}
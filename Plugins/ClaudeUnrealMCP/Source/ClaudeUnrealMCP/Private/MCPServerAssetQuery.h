@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/ARFilter.h"
+#include "AssetRegistry/AssetData.h"
+
+class FMCPGlobPattern;
+
+/**
+ * Asset registry helpers for the commands that answer from registry data alone, without
+ * loading a package. Safe to use from any thread.
+ */
+namespace MCPAssetQuery
+{
+	/**
+	 * Limits a registry filter to the folder a path pattern's literal start names, searched
+	 * recursively, so the registry returns only that subtree. Results still have to be matched
+	 * against the pattern itself.
+	 */
+	void AddPackagePathFilter(FARFilter& Filter, const FMCPGlobPattern& PathPattern);
+
+	/**
+	 * The class path for a class given as a path (/Script/Engine.Blueprint) or as the short name
+	 * of a common asset class (Blueprint, WidgetBlueprint, DataTable, ...). Empty if neither.
+	 */
+	FTopLevelAssetPath FindAssetClassPath(const FString& ClassName);
+
+	/** Object path held by a class-reference tag such as ParentClass; empty without the tag. */
+	FString GetClassTag(const FAssetData& Asset, FName Tag);
+
+	/** Paths of the interfaces a blueprint's ImplementedInterfaces tag lists. */
+	TArray<FString> GetImplementedInterfaces(const FAssetData& Asset);
+
+	/** "Actor" for "/Script/Engine.Actor", "BP_Base_C" for "/Game/BP_Base.BP_Base_C". */
+	FString GetObjectName(const FString& ObjectPath);
+}
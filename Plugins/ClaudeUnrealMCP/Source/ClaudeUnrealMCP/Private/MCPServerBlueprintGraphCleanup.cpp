@@ -55,6 +55,7 @@
 #include "EnhancedInputComponent.h"
 #include "Components/ActorComponent.h"
 #include "Kismet2/ComponentEditorUtils.h"
+#include "MCPServerTypeRegistry.h"
 
 FString FMCPServer::HandleDeleteFunctionGraph(const TSharedPtr<FJsonObject>& Params)
 {
@@ -429,7 +430,12 @@ FString FMCPServer::HandleModifyStructField(const TSharedPtr<FJsonObject>& Param
 						ScriptStruct = LoadObject<UScriptStruct>(nullptr, *PackagePath);
 					}
 
-					// Last resort: iterate through all UScriptStruct objects
+					// Last resort: any loaded struct with that name
+					if (!ScriptStruct)
+					{
+						ScriptStruct = FMCPTypeRegistry::Get().FindFirst<UScriptStruct>(FName(*NewType));
+					}
+
 					if (!ScriptStruct)
 					{
 						TArray<FString> FoundStructNames;
@@ -441,12 +447,6 @@ FString FMCPServer::HandleModifyStructField(const TSharedPtr<FJsonObject>& Param
 							{
 								FoundStructNames.Add(FString::Printf(TEXT("%s (%s)"), *StructName, *It->GetPathName()));
 							}
-
-							if (StructName == NewType)
-							{
-								ScriptStruct = *It;
-								break;
-							}
 						}
 
 						// If not found, include debug info about similar structs
@@ -55,6 +55,7 @@
 #include "EnhancedInputComponent.h"
 #include "Components/ActorComponent.h"
 #include "Kismet2/ComponentEditorUtils.h"
+#include "MCPServerTypeRegistry.h"
 
 FString FMCPServer::HandleDeleteInterfaceFunction(const TSharedPtr<FJsonObject>& Params)
 {
@@ -202,14 +203,7 @@ FString FMCPServer::HandleModifyInterfaceFunctionParameter(const TSharedPtr<FJso
 		}
 		if (!FoundStruct)
 		{
-			for (TObjectIterator<UScriptStruct> It; It; ++It)
-			{
-				if (It->GetName() == StructNameToFind)
-				{
-					FoundStruct = *It;
-					break;
-				}
-			}
+			FoundStruct = FMCPTypeRegistry::Get().FindFirst<UScriptStruct>(FName(*StructNameToFind));
 		}
 		if (!FoundStruct)
 		{
@@ -229,15 +223,7 @@ FString FMCPServer::HandleModifyInterfaceFunctionParameter(const TSharedPtr<FJso
 			FString ModuleName;
 			Remainder.Split(TEXT("."), &ModuleName, &EnumNameToFind);
 		}
-		UEnum* FoundEnum = nullptr;
-		for (TObjectIterator<UEnum> It; It; ++It)
-		{
-			if (It->GetName() == EnumNameToFind)
-			{
-				FoundEnum = *It;
-				break;
-			}
-		}
+		UEnum* FoundEnum = FMCPTypeRegistry::Get().FindFirst<UEnum>(FName(*EnumNameToFind));
 		if (!FoundEnum)
 		{
 			return MakeError(FString::Printf(TEXT("Enum type not found: %s"), *EnumTypePath));
@@ -267,32 +253,17 @@ FString FMCPServer::HandleModifyInterfaceFunctionParameter(const TSharedPtr<FJso
 			}
 		}
 
-		// Fall back to TObjectIterator name search
+		// Fall back to a name lookup
 		if (!TypeObject)
 		{
-			for (TObjectIterator<UScriptStruct> It; It; ++It)
-			{
-				UScriptStruct* Struct = *It;
-				if (Struct->GetName() == TypeNameToFind)
-				{
-					TypeObject = Struct;
-					break;
-				}
-			}
+			TypeObject = FMCPTypeRegistry::Get().FindFirst<UScriptStruct>(FName(*TypeNameToFind));
 		}
 
-		// If not found as struct, try classes
+		// If not found as struct, try classes; the engine's name hash covers them, and the
+		// registry leaves them out since classes come and go with every blueprint compile
 		if (!TypeObject)
 		{
-			for (TObjectIterator<UClass> It; It; ++It)
-			{
-				UClass* Class = *It;
-				if (Class->GetName() == TypeNameToFind)
-				{
-					TypeObject = Class;
-					break;
-				}
-			}
+			TypeObject = FindFirstObject<UClass>(*TypeNameToFind, EFindFirstObjectOptions::None);
 		}
 
 		// Fallback to standard FindObject/LoadObject with full path
@@ -384,9 +355,9 @@ FString FMCPServer::HandleModifyInterfaceFunctionParameter(const TSharedPtr<FJso
 	// Reconstruct the node to reflect the changes
 	TargetNode->ReconstructNode();
 
-	// Mark the blueprint as modified and compile to update the generated class
+	// Mark the blueprint as modified; the generated class is updated with the next compile flush
 	FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
-	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	QueueCompile(Blueprint);
 
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetStringField(TEXT("message"), TEXT("Interface function parameter modified successfully"));
@@ -56,6 +56,10 @@
 #include "Components/ActorComponent.h"
 #include "Kismet2/ComponentEditorUtils.h"
 #include "MCPServerHelpers.h"
+#include "MCPServerResolveCache.h"
+#include "MCPServerJobs.h"
+#include "MCPServerCompileQueue.h"
+#include "FileHelpers.h"
 
 FString FMCPServer::HandleReparentBlueprint(const TSharedPtr<FJsonObject>& Params)
 {
@@ -73,7 +77,7 @@ FString FMCPServer::HandleReparentBlueprint(const TSharedPtr<FJsonObject>& Param
 		return MakeError(FString::Printf(TEXT("Blueprint not found: %s"), *BlueprintPath));
 	}
 
-	UClass* NewParent = ResolveParentClass(ParentClassPath);
+	UClass* NewParent = ResolveCache->FindClass(ParentClassPath);
 	if (!NewParent)
 	{
 		return MakeError(FString::Printf(TEXT("Parent class not found: %s"), *ParentClassPath));
@@ -99,90 +103,172 @@ FString FMCPServer::HandleReparentBlueprint(const TSharedPtr<FJsonObject>& Param
 	return MakeResponse(true, Data);
 }
 
-FString FMCPServer::HandleCompileBlueprint(const TSharedPtr<FJsonObject>& Params)
+namespace MCPCompileBlueprint
 {
-	if (!Params.IsValid() || !Params->HasField(TEXT("path")))
+	// compile_blueprint's report for one blueprint
+	static void WriteResult(const FMCPCompileResult& Result, const TSharedPtr<FJsonObject>& Data)
 	{
-		return MakeError(TEXT("Missing 'path' parameter"));
-	}
+		Data->SetBoolField(TEXT("compiled"), Result.bCompiled);
+		Data->SetStringField(TEXT("status"), Result.Status);
 
-	FString Path = Params->GetStringField(TEXT("path"));
-	UBlueprint* Blueprint = LoadBlueprintFromPath(Path);
+		auto ToMessageArray = [](const TArray<FString>& Messages, EMessageSeverity::Type Severity)
+		{
+			TArray<TSharedPtr<FJsonValue>> MessagesArray;
+			for (const FString& Message : Messages)
+			{
+				TSharedPtr<FJsonObject> MsgObj = MakeShared<FJsonObject>();
+				MsgObj->SetStringField(TEXT("message"), Message);
+				MsgObj->SetStringField(TEXT("severity"), FString::FromInt((int32)Severity));
+				MessagesArray.Add(MakeShared<FJsonValueObject>(MsgObj));
+			}
+			return MessagesArray;
+		};
+
+		Data->SetArrayField(TEXT("errors"), ToMessageArray(Result.Messages.Errors, EMessageSeverity::Error));
+		Data->SetArrayField(TEXT("warnings"), ToMessageArray(Result.Messages.Warnings, EMessageSeverity::Warning));
+		Data->SetNumberField(TEXT("error_count"), Result.Messages.ErrorCount);
+		Data->SetNumberField(TEXT("warning_count"), Result.Messages.WarningCount);
+	}
+}
 
-	if (!Blueprint)
+FString FMCPServer::HandleCompileBlueprint(const TSharedPtr<FJsonObject>& Params)
+{
+	// "paths" compiles several blueprints in one pass; "path" keeps the single-blueprint response
+	TArray<FString> Paths;
+	const bool bMultiple = Params.IsValid() && Params->TryGetStringArrayField(TEXT("paths"), Paths);
+	if (!bMultiple)
 	{
-		return MakeError(FString::Printf(TEXT("Blueprint not found: %s"), *Path));
+		if (!Params.IsValid() || !Params->HasField(TEXT("path")))
+		{
+			return MakeError(TEXT("Missing 'path' or 'paths' parameter"));
+		}
+		Paths.Add(Params->GetStringField(TEXT("path")));
 	}
 
-	// Compile the blueprint
-	FCompilerResultsLog CompileLog;
-	FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::None, &CompileLog);
-
-	bool bSuccess = (Blueprint->Status == BS_UpToDate || Blueprint->Status == BS_UpToDateWithWarnings);
-
-	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-	Data->SetBoolField(TEXT("compiled"), bSuccess);
-
-	// Get blueprint status string
-	FString StatusString;
-	switch (Blueprint->Status)
+	TArray<UBlueprint*> Blueprints;
+	for (const FString& Path : Paths)
 	{
-	case BS_Unknown: StatusString = TEXT("Unknown"); break;
-	case BS_Dirty: StatusString = TEXT("Dirty"); break;
-	case BS_Error: StatusString = TEXT("Error"); break;
-	case BS_UpToDate: StatusString = TEXT("UpToDate"); break;
-	case BS_BeingCreated: StatusString = TEXT("BeingCreated"); break;
-	case BS_UpToDateWithWarnings: StatusString = TEXT("UpToDateWithWarnings"); break;
-	default: StatusString = TEXT("Unknown");
+		UBlueprint* Blueprint = LoadBlueprintFromPath(Path);
+		if (!Blueprint)
+		{
+			return MakeError(FString::Printf(TEXT("Blueprint not found: %s"), *Path));
+		}
+		Blueprints.Add(Blueprint);
 	}
-	Data->SetStringField(TEXT("status"), StatusString);
-
-	// Capture compilation errors and warnings
-	TArray<TSharedPtr<FJsonValue>> ErrorsArray;
-	TArray<TSharedPtr<FJsonValue>> WarningsArray;
 
-	for (const TSharedRef<FTokenizedMessage>& Message : CompileLog.Messages)
+	// Blueprints waiting in the compile queue go through the same pass
+	TArray<FMCPCompileResult> Results;
+	if (CompileQueue.IsValid())
+	{
+		Results = CompileQueue->Compile(Blueprints);
+	}
+	else
 	{
-		TSharedPtr<FJsonObject> MsgObj = MakeShared<FJsonObject>();
-		MsgObj->SetStringField(TEXT("message"), Message->ToText().ToString());
-		MsgObj->SetStringField(TEXT("severity"), FString::FromInt((int32)Message->GetSeverity()));
+		for (UBlueprint* Blueprint : Blueprints)
+		{
+			Results.Add(FMCPCompileQueue::CompileBlueprint(Blueprint));
+		}
+	}
 
-		if (Message->GetSeverity() == EMessageSeverity::Error)
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	TArray<TSharedPtr<FJsonValue>> BlueprintsArray;
+	TArray<FString> Failed;
+	for (const FMCPCompileResult& Result : Results)
+	{
+		const bool bRequested = Blueprints.Contains(Result.Blueprint.Get());
+		if (bRequested && !Result.bCompiled)
 		{
-			ErrorsArray.Add(MakeShared<FJsonValueObject>(MsgObj));
+			Failed.Add(FString::Printf(TEXT("%s (status: %s, %d errors)"), *Result.Path, *Result.Status, Result.Messages.ErrorCount));
 		}
-		else if (Message->GetSeverity() == EMessageSeverity::Warning)
+
+		if (!bMultiple && Result.Blueprint.Get() == Blueprints[0])
 		{
-			WarningsArray.Add(MakeShared<FJsonValueObject>(MsgObj));
+			MCPCompileBlueprint::WriteResult(Result, Data);
+			continue;
 		}
+
+		TSharedPtr<FJsonObject> BPObj = MakeShared<FJsonObject>();
+		BPObj->SetStringField(TEXT("path"), Result.Path);
+		BPObj->SetBoolField(TEXT("requested"), bRequested);
+		MCPCompileBlueprint::WriteResult(Result, BPObj);
+		BlueprintsArray.Add(MakeShared<FJsonValueObject>(BPObj));
 	}
 
-	// If Blueprint has Error status but CompileLog captured no messages,
-	// add a synthetic error so callers know something is wrong
-	if (!bSuccess && ErrorsArray.Num() == 0)
+	// With a single path these are the queued blueprints compiled alongside it
+	if (bMultiple || BlueprintsArray.Num() > 0)
 	{
-		TSharedPtr<FJsonObject> MsgObj = MakeShared<FJsonObject>();
-		MsgObj->SetStringField(TEXT("message"), TEXT("Blueprint has Error status after compilation (errors may have occurred during asset loading/validation)"));
-		MsgObj->SetStringField(TEXT("severity"), FString::FromInt((int32)EMessageSeverity::Error));
-		ErrorsArray.Add(MakeShared<FJsonValueObject>(MsgObj));
+		Data->SetArrayField(TEXT("blueprints"), BlueprintsArray);
+	}
+	if (bMultiple)
+	{
+		Data->SetNumberField(TEXT("compiled_count"), Results.Num());
+		Data->SetNumberField(TEXT("failed_count"), Failed.Num());
 	}
-
-	Data->SetArrayField(TEXT("errors"), ErrorsArray);
-	Data->SetArrayField(TEXT("warnings"), WarningsArray);
-	Data->SetNumberField(TEXT("error_count"), ErrorsArray.Num());
-	Data->SetNumberField(TEXT("warning_count"), WarningsArray.Num());
 
 	// Return success=false when compilation actually failed, so callers
 	// who only check 'success' will catch it
-	if (!bSuccess)
+	if (Failed.Num() > 0)
 	{
-		FString ErrorMsg = FString::Printf(TEXT("Compilation failed (status: %s, %d errors)"), *StatusString, ErrorsArray.Num());
+		FString ErrorMsg = FString::Printf(TEXT("Compilation failed: %s"), *FString::Join(Failed, TEXT(", ")));
 		return MakeResponse(false, Data, ErrorMsg);
 	}
 
 	return MakeResponse(true, Data);
 }
 
+TSharedPtr<FJsonObject> FMCPServer::FlushCompileQueue(TArray<FString>& OutFailed)
+{
+	if (!CompileQueue.IsValid() || CompileQueue->IsEmpty())
+	{
+		return nullptr;
+	}
+
+	const TArray<FMCPCompileResult> Results = CompileQueue->Flush();
+	if (Results.Num() == 0)
+	{
+		return nullptr;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> BlueprintsArray;
+	for (const FMCPCompileResult& Result : Results)
+	{
+		if (!Result.bCompiled)
+		{
+			OutFailed.Add(Result.Path);
+		}
+
+		TSharedPtr<FJsonObject> BPObj = MakeShared<FJsonObject>();
+		BPObj->SetStringField(TEXT("path"), Result.Path);
+		MCPCompileBlueprint::WriteResult(Result, BPObj);
+		BlueprintsArray.Add(MakeShared<FJsonValueObject>(BPObj));
+	}
+
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetArrayField(TEXT("blueprints"), BlueprintsArray);
+	Data->SetNumberField(TEXT("compiled_count"), Results.Num());
+	Data->SetNumberField(TEXT("failed_count"), OutFailed.Num());
+	return Data;
+}
+
+FString FMCPServer::HandleFlush(const TSharedPtr<FJsonObject>& Params)
+{
+	TArray<FString> Failed;
+	TSharedPtr<FJsonObject> Data = FlushCompileQueue(Failed);
+	if (!Data.IsValid())
+	{
+		Data = MakeShared<FJsonObject>();
+		Data->SetArrayField(TEXT("blueprints"), TArray<TSharedPtr<FJsonValue>>());
+		Data->SetNumberField(TEXT("compiled_count"), 0);
+		Data->SetNumberField(TEXT("failed_count"), 0);
+	}
+
+	if (Failed.Num() > 0)
+	{
+		return MakeResponse(false, Data, FString::Printf(TEXT("Compilation failed: %s"), *FString::Join(Failed, TEXT(", "))));
+	}
+	return MakeResponse(true, Data);
+}
+
 FString FMCPServer::HandleSaveAsset(const TSharedPtr<FJsonObject>& Params)
 {
 	if (!Params.IsValid() || !Params->HasField(TEXT("path")))
@@ -192,6 +278,10 @@ FString FMCPServer::HandleSaveAsset(const TSharedPtr<FJsonObject>& Params)
 
 	FString Path = Params->GetStringField(TEXT("path"));
 
+	// Save blueprints with their pending compiles applied
+	TArray<FString> CompileFailed;
+	FlushCompileQueue(CompileFailed);
+
 	// Try to load as blueprint first
 	UObject* Asset = LoadObject<UBlueprint>(nullptr, *Path);
 	if (!Asset)
@@ -230,75 +320,149 @@ FString FMCPServer::HandleSaveAsset(const TSharedPtr<FJsonObject>& Params)
 	return MakeResponse(true, Data);
 }
 
-FString FMCPServer::HandleSaveAll(const TSharedPtr<FJsonObject>& Params)
+/**
+ * Saves every dirty package, one package per step. Packages are serialized on the game thread
+ * and their files written in the background; the last step waits for the writes to land.
+ */
+class FSaveAllJob : public FMCPJob
 {
-	// Save all dirty packages
-	TArray<UPackage*> DirtyPackages;
+public:
+	FSaveAllJob()
+	{
+		// The editor's own dirty lists; maps and content are tracked separately
+		TArray<UPackage*> DirtyPackages;
+		FEditorFileUtils::GetDirtyWorldPackages(DirtyPackages);
+		FEditorFileUtils::GetDirtyContentPackages(DirtyPackages);
+		TotalDirty = DirtyPackages.Num();
+
+		for (UPackage* Package : DirtyPackages)
+		{
+			// Skip packages that don't have a valid path (e.g., temp packages)
+			if (Package && !Package->HasAnyFlags(RF_Transient) && FPackageName::IsValidLongPackageName(Package->GetName()))
+			{
+				Packages.Add(Package);
+			}
+		}
 
-	// Get all dirty packages
-	for (TObjectIterator<UPackage> It; It; ++It)
+		Phase = TEXT("saving");
+		Total = Packages.Num();
+	}
+
+	virtual ~FSaveAllJob() override
 	{
-		UPackage* Package = *It;
-		if (Package && Package->IsDirty() && !Package->HasAnyFlags(RF_Transient))
+		WaitForWrites();
+	}
+
+	virtual bool Step() override
+	{
+		if (Done < Packages.Num())
 		{
-			DirtyPackages.Add(Package);
+			SavePackage(Packages[Done].Get());
+			++Done;
+			return true;
 		}
+
+		Phase = TEXT("writing");
+		Current.Reset();
+		WaitForWrites();
+		return false;
 	}
 
-	int32 SavedCount = 0;
-	int32 FailedCount = 0;
-	TArray<FString> FailedPackages;
+	virtual TSharedPtr<FJsonObject> BuildResult() override
+	{
+		// A cancelled run still finishes the files it started
+		WaitForWrites();
+
+		TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+		Data->SetNumberField(TEXT("saved_count"), SavedPackages.Num());
+		Data->SetNumberField(TEXT("failed_count"), FailedPackages.Num());
+		Data->SetNumberField(TEXT("total_dirty"), TotalDirty);
+
+		auto ToArray = [](const TArray<FString>& Names)
+		{
+			TArray<TSharedPtr<FJsonValue>> NamesArray;
+			for (const FString& Name : Names)
+			{
+				NamesArray.Add(MakeShared<FJsonValueString>(Name));
+			}
+			return NamesArray;
+		};
+		Data->SetArrayField(TEXT("saved_packages"), ToArray(SavedPackages));
+		if (FailedPackages.Num() > 0)
+		{
+			Data->SetArrayField(TEXT("failed_packages"), ToArray(FailedPackages));
+		}
+
+		Data->SetStringField(TEXT("message"), GetMessage());
+		return Data;
+	}
 
-	for (UPackage* Package : DirtyPackages)
+	virtual FString GetError() const override
 	{
-		FString PackageName = Package->GetName();
+		return FailedPackages.Num() > 0 ? GetMessage() : FString();
+	}
 
-		// Skip packages that don't have a valid path (e.g., temp packages)
-		if (!FPackageName::IsValidLongPackageName(PackageName))
+private:
+	void SavePackage(UPackage* Package)
+	{
+		// Gone since the job started, so nothing is left to save
+		if (!Package || !Package->IsDirty())
 		{
-			continue;
+			return;
 		}
 
-		FString PackageFileName = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
+		const FString PackageName = Package->GetName();
+		Current = PackageName;
+
+		const FString& Extension = Package->ContainsMap() ? FPackageName::GetMapPackageExtension() : FPackageName::GetAssetPackageExtension();
+		const FString PackageFileName = FPackageName::LongPackageNameToFilename(PackageName, Extension);
 
+		// Serialize now, write the file on a background thread
 		FSavePackageArgs SaveArgs;
 		SaveArgs.TopLevelFlags = RF_Standalone;
+		SaveArgs.SaveFlags = SAVE_Async;
+		bWritesPending = true;
 
 		if (UPackage::SavePackage(Package, nullptr, *PackageFileName, SaveArgs))
 		{
-			SavedCount++;
+			SavedPackages.Add(PackageName);
 		}
 		else
 		{
-			FailedCount++;
 			FailedPackages.Add(PackageName);
 		}
 	}
 
-	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-	Data->SetNumberField(TEXT("saved_count"), SavedCount);
-	Data->SetNumberField(TEXT("failed_count"), FailedCount);
-	Data->SetNumberField(TEXT("total_dirty"), DirtyPackages.Num());
-
-	if (FailedPackages.Num() > 0)
+	void WaitForWrites()
 	{
-		TArray<TSharedPtr<FJsonValue>> FailedArray;
-		for (const FString& FailedPkg : FailedPackages)
+		if (bWritesPending)
 		{
-			FailedArray.Add(MakeShared<FJsonValueString>(FailedPkg));
+			UPackage::WaitForAsyncFileWrites();
+			bWritesPending = false;
 		}
-		Data->SetArrayField(TEXT("failed_packages"), FailedArray);
 	}
 
-	FString Message = FString::Printf(TEXT("Saved %d package(s), %d failed"), SavedCount, FailedCount);
-	Data->SetStringField(TEXT("message"), Message);
-
-	if (FailedCount > 0)
+	FString GetMessage() const
 	{
-		return MakeResponse(false, Data, Message);
+		return FString::Printf(TEXT("Saved %d package(s), %d failed"), SavedPackages.Num(), FailedPackages.Num());
 	}
 
-	return MakeResponse(true, Data);
+	TArray<TWeakObjectPtr<UPackage>> Packages;
+	int32 TotalDirty = 0;
+	TArray<FString> SavedPackages;
+	TArray<FString> FailedPackages;
+	bool bWritesPending = false;
+};
+
+FString FMCPServer::HandleSaveAll(const TSharedPtr<FJsonObject>& Params)
+{
+	// Save blueprints with their pending compiles applied
+	TArray<FString> CompileFailed;
+	FlushCompileQueue(CompileFailed);
+
+	// With "async": true this returns a job id right away and saves over several frames,
+	// reporting each package as it goes
+	return RunJob(MakeShared<FSaveAllJob>(), TEXT("save_all"), Params);
 }
 
 FString FMCPServer::HandleSetBlueprintCompileSettings(const TSharedPtr<FJsonObject>& Params)
@@ -0,0 +1,284 @@
+#include "MCPServerCompileCache.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Hash/Blake3.h"
+#include "IO/IoHash.h"
+#include "HAL/FileManager.h"
+#include "Misc/EngineVersion.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/Package.h"
+
+namespace MCPCompileCache
+{
+	// Bump when the file layout or the fingerprint scheme changes
+	static constexpr int32 FileVersion = 1;
+
+	static TArray<TSharedPtr<FJsonValue>> ToJsonArray(const TArray<FString>& Strings)
+	{
+		TArray<TSharedPtr<FJsonValue>> Array;
+		Array.Reserve(Strings.Num());
+		for (const FString& String : Strings)
+		{
+			Array.Add(MakeShared<FJsonValueString>(String));
+		}
+		return Array;
+	}
+
+	static TArray<FString> FromJsonArray(const TSharedPtr<FJsonObject>& Object, const TCHAR* Field)
+	{
+		TArray<FString> Strings;
+		Object->TryGetStringArrayField(Field, Strings);
+		return Strings;
+	}
+}
+
+FMCPCompileCache::FMCPCompileCache()
+	: SessionId(FGuid::NewGuid())
+{
+	PackageMarkedDirtyHandle = UPackage::PackageMarkedDirtyEvent.AddRaw(this, &FMCPCompileCache::OnPackageMarkedDirty);
+}
+
+FMCPCompileCache::~FMCPCompileCache()
+{
+	UPackage::PackageMarkedDirtyEvent.Remove(PackageMarkedDirtyHandle);
+}
+
+void FMCPCompileCache::BeginScan()
+{
+	if (!bLoaded)
+	{
+		Load();
+	}
+
+	// Blueprints compile against native classes too; rebuilt code invalidates everything
+	const FString CurrentBuildKey = ComputeBuildKey();
+	if (CurrentBuildKey != BuildKey)
+	{
+		if (Records.Num() > 0)
+		{
+			UE_LOG(LogTemp, Log, TEXT("ClaudeUnrealMCP: Engine or project binaries changed; discarding %d cached compile results"), Records.Num());
+		}
+		Records.Reset();
+		BuildKey = CurrentBuildKey;
+		bModified = true;
+	}
+
+	PackageTokens.Reset();
+	Dependencies.Reset();
+}
+
+FString FMCPCompileCache::ComputeFingerprint(FName PackageName)
+{
+	// Everything reachable through hard dependencies, cycles included, hashed in name order
+	TSet<FName> Closure;
+	TArray<FName> Stack;
+	Stack.Add(PackageName);
+	while (Stack.Num() > 0)
+	{
+		const FName Current = Stack.Pop(EAllowShrinking::No);
+		bool bAlreadyInSet = false;
+		Closure.Add(Current, &bAlreadyInSet);
+		if (!bAlreadyInSet)
+		{
+			Stack.Append(GetDependencies(Current));
+		}
+	}
+
+	TArray<FName> SortedPackages = Closure.Array();
+	SortedPackages.Sort(FNameLexicalLess());
+
+	FBlake3 Hasher;
+	for (const FName Package : SortedPackages)
+	{
+		const FString Entry = FString::Printf(TEXT("%s=%s\n"), *Package.ToString(), *GetPackageToken(Package));
+		Hasher.Update(*Entry, Entry.Len() * sizeof(TCHAR));
+	}
+	return LexToString(FIoHash(Hasher.Finalize()));
+}
+
+const FMCPCompileRecord* FMCPCompileCache::Find(FName PackageName, const FString& Fingerprint) const
+{
+	const FMCPCompileRecord* Record = Records.Find(PackageName);
+	return Record && Record->Fingerprint == Fingerprint ? Record : nullptr;
+}
+
+void FMCPCompileCache::Store(FName PackageName, FMCPCompileRecord&& Record)
+{
+	Records.Add(PackageName, MoveTemp(Record));
+	bModified = true;
+}
+
+void FMCPCompileCache::Save()
+{
+	if (!bModified)
+	{
+		return;
+	}
+
+	TSharedPtr<FJsonObject> Blueprints = MakeShared<FJsonObject>();
+	for (const TPair<FName, FMCPCompileRecord>& Pair : Records)
+	{
+		const FMCPCompileRecord& Record = Pair.Value;
+		TSharedPtr<FJsonObject> RecordObj = MakeShared<FJsonObject>();
+		RecordObj->SetStringField(TEXT("fingerprint"), Record.Fingerprint);
+		RecordObj->SetNumberField(TEXT("error_count"), Record.ErrorCount);
+		RecordObj->SetNumberField(TEXT("warning_count"), Record.WarningCount);
+		RecordObj->SetArrayField(TEXT("errors"), MCPCompileCache::ToJsonArray(Record.Errors));
+		RecordObj->SetArrayField(TEXT("warnings"), MCPCompileCache::ToJsonArray(Record.Warnings));
+		Blueprints->SetObjectField(Pair.Key.ToString(), RecordObj);
+	}
+
+	TSharedPtr<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetNumberField(TEXT("version"), MCPCompileCache::FileVersion);
+	Root->SetStringField(TEXT("build"), BuildKey);
+	Root->SetObjectField(TEXT("blueprints"), Blueprints);
+
+	FString Output;
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Output);
+	FJsonSerializer::Serialize(Root.ToSharedRef(), Writer);
+
+	if (FFileHelper::SaveStringToFile(Output, *GetCacheFilePath(), FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		bModified = false;
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ClaudeUnrealMCP: Failed to save compile cache to %s"), *GetCacheFilePath());
+	}
+}
+
+void FMCPCompileCache::Load()
+{
+	bLoaded = true;
+
+	FString Input;
+	if (!FFileHelper::LoadFileToString(Input, *GetCacheFilePath()))
+	{
+		return;
+	}
+
+	TSharedPtr<FJsonObject> Root;
+	TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::Create(Input);
+	int32 Version = 0;
+	if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid() ||
+		!Root->TryGetNumberField(TEXT("version"), Version) || Version != MCPCompileCache::FileVersion)
+	{
+		UE_LOG(LogTemp, Log, TEXT("ClaudeUnrealMCP: Ignoring compile cache in an unknown format"));
+		return;
+	}
+
+	Root->TryGetStringField(TEXT("build"), BuildKey);
+
+	const TSharedPtr<FJsonObject>* Blueprints = nullptr;
+	if (!Root->TryGetObjectField(TEXT("blueprints"), Blueprints))
+	{
+		return;
+	}
+
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : (*Blueprints)->Values)
+	{
+		const TSharedPtr<FJsonObject> RecordObj = Pair.Value->AsObject();
+		if (!RecordObj.IsValid())
+		{
+			continue;
+		}
+
+		FMCPCompileRecord Record;
+		RecordObj->TryGetStringField(TEXT("fingerprint"), Record.Fingerprint);
+		RecordObj->TryGetNumberField(TEXT("error_count"), Record.ErrorCount);
+		RecordObj->TryGetNumberField(TEXT("warning_count"), Record.WarningCount);
+		Record.Errors = MCPCompileCache::FromJsonArray(RecordObj, TEXT("errors"));
+		Record.Warnings = MCPCompileCache::FromJsonArray(RecordObj, TEXT("warnings"));
+		Records.Add(FName(*Pair.Key), MoveTemp(Record));
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("ClaudeUnrealMCP: Loaded %d cached compile results"), Records.Num());
+}
+
+void FMCPCompileCache::OnPackageMarkedDirty(UPackage* Package, bool bWasDirty)
+{
+	if (Package)
+	{
+		++DirtyGenerations.FindOrAdd(Package->GetFName());
+		PackageTokens.Remove(Package->GetFName());
+	}
+}
+
+const FString& FMCPCompileCache::GetPackageToken(FName PackageName)
+{
+	if (const FString* Token = PackageTokens.Find(PackageName))
+	{
+		return *Token;
+	}
+
+	const IAssetRegistry& AssetRegistry = FAssetRegistryModule::GetRegistry();
+	const TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName);
+	FString Token = PackageData.IsSet() ? LexToString(PackageData->GetPackageSavedHash()) : FString(TEXT("missing"));
+
+	// Unsaved edits are not in the saved hash
+	const UPackage* Package = FindPackage(nullptr, *PackageName.ToString());
+	if (Package && Package->IsDirty())
+	{
+		Token += FString::Printf(TEXT(":%s:%u"), *SessionId.ToString(), DirtyGenerations.FindRef(PackageName));
+	}
+
+	return PackageTokens.Add(PackageName, MoveTemp(Token));
+}
+
+const TArray<FName>& FMCPCompileCache::GetDependencies(FName PackageName)
+{
+	if (const TArray<FName>* Cached = Dependencies.Find(PackageName))
+	{
+		return *Cached;
+	}
+
+	TArray<FName> PackageDependencies;
+	FAssetRegistryModule::GetRegistry().GetDependencies(PackageName, PackageDependencies,
+		UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+
+	// Native packages are covered by the build key
+	PackageDependencies.RemoveAll([](FName Dependency)
+	{
+		return Dependency.ToString().StartsWith(TEXT("/Script/"));
+	});
+
+	return Dependencies.Add(PackageName, MoveTemp(PackageDependencies));
+}
+
+FString FMCPCompileCache::GetCacheFilePath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("ClaudeUnrealMCP"), TEXT("CompileStatusCache.json"));
+}
+
+FString FMCPCompileCache::ComputeBuildKey()
+{
+	// Engine version plus the timestamp of every loaded module binary that belongs to the project
+	FString Key = FEngineVersion::Current().ToString();
+
+	TArray<FModuleStatus> Modules;
+	FModuleManager::Get().QueryModules(Modules);
+	Modules.Sort([](const FModuleStatus& A, const FModuleStatus& B) { return A.Name < B.Name; });
+
+	const FString ProjectDir = FPaths::ConvertRelativePathToFull(FPaths::ProjectDir());
+	for (const FModuleStatus& Module : Modules)
+	{
+		const FString FilePath = FPaths::ConvertRelativePathToFull(Module.FilePath);
+		if (!Module.bIsLoaded || FilePath.IsEmpty() || !FilePath.StartsWith(ProjectDir))
+		{
+			continue;
+		}
+
+		Key += FString::Printf(TEXT("|%s@%s"), *Module.Name, *IFileManager::Get().GetTimeStamp(*FilePath).ToIso8601());
+	}
+
+	FBlake3 Hasher;
+	Hasher.Update(*Key, Key.Len() * sizeof(TCHAR));
+	return LexToString(FIoHash(Hasher.Finalize()));
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UPackage;
+
+/** Last known compile result of one blueprint. */
+struct FMCPCompileRecord
+{
+	// Fingerprint of the blueprint and everything it depends on when it was compiled
+	FString Fingerprint;
+
+	int32 ErrorCount = 0;
+	int32 WarningCount = 0;
+	TArray<FString> Errors;
+	TArray<FString> Warnings;
+};
+
+/**
+ * Remembers blueprint compile results between runs of check_all_blueprints, and between
+ * editor sessions (the cache is saved under Saved/ClaudeUnrealMCP).
+ *
+ * A record is reused only while the blueprint's fingerprint is unchanged. The fingerprint
+ * covers the saved-package hash of the blueprint and of every package it depends on,
+ * directly or indirectly, through hard package dependencies in the asset registry.
+ * Packages with unsaved changes also contribute a counter that is bumped each time they
+ * are marked dirty, so edits made in the editor invalidate records as well. The whole
+ * cache is dropped when the engine version or any project module binary changes.
+ *
+ * Game thread only.
+ */
+class FMCPCompileCache
+{
+public:
+	FMCPCompileCache();
+	~FMCPCompileCache();
+
+	/** Start a scan: loads the cache on first use and forgets lookups memoized by earlier scans. */
+	void BeginScan();
+
+	/** Fingerprint of the package's current state, including its dependencies. */
+	FString ComputeFingerprint(FName PackageName);
+
+	/** Record for the package if it was made from the same fingerprint, else null. */
+	const FMCPCompileRecord* Find(FName PackageName, const FString& Fingerprint) const;
+	void Store(FName PackageName, FMCPCompileRecord&& Record);
+
+	/** Write the cache to disk if it changed since it was loaded or last saved. */
+	void Save();
+
+private:
+	void Load();
+	void OnPackageMarkedDirty(UPackage* Package, bool bWasDirty);
+	const FString& GetPackageToken(FName PackageName);
+	const TArray<FName>& GetDependencies(FName PackageName);
+
+	static FString GetCacheFilePath();
+	static FString ComputeBuildKey();
+
+	TMap<FName, FMCPCompileRecord> Records;
+	FString BuildKey;
+	bool bLoaded = false;
+	bool bModified = false;
+
+	// Dirty-marking counters for this session. SessionId keeps them from matching the
+	// counters of another session in fingerprints that were saved to disk.
+	TMap<FName, uint32> DirtyGenerations;
+	FGuid SessionId;
+
+	// Asset registry lookups memoized for the duration of one scan
+	TMap<FName, FString> PackageTokens;
+	TMap<FName, TArray<FName>> Dependencies;
+
+	FDelegateHandle PackageMarkedDirtyHandle;
+};
@@ -0,0 +1,175 @@
+#include "MCPServerCompileQueue.h"
+#include "Engine/Blueprint.h"
+#include "Kismet2/BlueprintEditorUtils.h"
+#include "Kismet2/KismetEditorUtilities.h"
+#include "Kismet2/CompilerResultsLog.h"
+
+namespace MCPCompileQueue
+{
+	static const TCHAR* GetStatusName(EBlueprintStatus Status)
+	{
+		switch (Status)
+		{
+		case BS_Dirty: return TEXT("Dirty");
+		case BS_Error: return TEXT("Error");
+		case BS_UpToDate: return TEXT("UpToDate");
+		case BS_BeingCreated: return TEXT("BeingCreated");
+		case BS_UpToDateWithWarnings: return TEXT("UpToDateWithWarnings");
+		default: return TEXT("Unknown");
+		}
+	}
+
+	// Blueprints among Blueprints that Blueprint depends on: its parent blueprints and whatever its graphs reference
+	static TArray<UBlueprint*> GetDependencies(UBlueprint* Blueprint, const TSet<UBlueprint*>& Blueprints)
+	{
+		TArray<UBlueprint*> Dependencies;
+
+		for (UClass* Class = Blueprint->ParentClass; Class; Class = Class->GetSuperClass())
+		{
+			UBlueprint* Parent = UBlueprint::GetBlueprintFromClass(Class);
+			if (Parent && Blueprints.Contains(Parent))
+			{
+				Dependencies.AddUnique(Parent);
+			}
+		}
+
+		TSet<TWeakObjectPtr<UBlueprint>> Referenced;
+		TSet<TWeakObjectPtr<UStruct>> ReferencedStructs;
+		FBlueprintEditorUtils::GatherDependencies(Blueprint, Referenced, ReferencedStructs);
+		for (const TWeakObjectPtr<UBlueprint>& Dependency : Referenced)
+		{
+			UBlueprint* DependencyBlueprint = Dependency.Get();
+			if (DependencyBlueprint && DependencyBlueprint != Blueprint && Blueprints.Contains(DependencyBlueprint))
+			{
+				Dependencies.AddUnique(DependencyBlueprint);
+			}
+		}
+		return Dependencies;
+	}
+
+	// Depth-first: a blueprint is placed after everything it depends on. Cycles between
+	// blueprints are broken wherever the walk first closes them.
+	static void Visit(UBlueprint* Blueprint, const TSet<UBlueprint*>& Blueprints, TSet<UBlueprint*>& Visited, TArray<UBlueprint*>& OutOrder)
+	{
+		bool bAlreadyVisited = false;
+		Visited.Add(Blueprint, &bAlreadyVisited);
+		if (bAlreadyVisited)
+		{
+			return;
+		}
+
+		for (UBlueprint* Dependency : GetDependencies(Blueprint, Blueprints))
+		{
+			Visit(Dependency, Blueprints, Visited, OutOrder);
+		}
+		OutOrder.Add(Blueprint);
+	}
+}
+
+void FMCPCompileQueue::Add(UBlueprint* Blueprint)
+{
+	if (Blueprint)
+	{
+		Pending.AddUnique(Blueprint);
+		LastAddTime = FPlatformTime::Seconds();
+	}
+}
+
+double FMCPCompileQueue::GetSecondsSinceLastAdd() const
+{
+	return FPlatformTime::Seconds() - LastAddTime;
+}
+
+TArray<FMCPCompileResult> FMCPCompileQueue::Flush()
+{
+	return Compile(TArray<UBlueprint*>());
+}
+
+TArray<FMCPCompileResult> FMCPCompileQueue::Compile(const TArray<UBlueprint*>& Blueprints)
+{
+	// Requested first, then queued, each in the order given
+	TArray<UBlueprint*> Candidates;
+	TSet<UBlueprint*> ToCompile;
+	auto AddCandidate = [&Candidates, &ToCompile](UBlueprint* Blueprint)
+	{
+		bool bAlreadyAdded = false;
+		ToCompile.Add(Blueprint, &bAlreadyAdded);
+		if (!bAlreadyAdded)
+		{
+			Candidates.Add(Blueprint);
+		}
+	};
+
+	for (UBlueprint* Blueprint : Blueprints)
+	{
+		if (Blueprint)
+		{
+			AddCandidate(Blueprint);
+		}
+	}
+
+	// Queued blueprints compiled since they were queued are already current
+	for (const TWeakObjectPtr<UBlueprint>& Queued : Pending)
+	{
+		UBlueprint* Blueprint = Queued.Get();
+		if (Blueprint && (Blueprint->Status == BS_Dirty || Blueprint->Status == BS_Unknown))
+		{
+			AddCandidate(Blueprint);
+		}
+	}
+	Pending.Reset();
+
+	TArray<UBlueprint*> Order;
+	Order.Reserve(ToCompile.Num());
+	TSet<UBlueprint*> Visited;
+	for (UBlueprint* Blueprint : Candidates)
+	{
+		MCPCompileQueue::Visit(Blueprint, ToCompile, Visited, Order);
+	}
+
+	TArray<FMCPCompileResult> Results;
+	Results.Reserve(Order.Num());
+	for (int32 Index = 0; Index < Order.Num(); ++Index)
+	{
+		// One garbage collection after the last compile covers the whole pass
+		Results.Add(CompileBlueprint(Order[Index], Index == Order.Num() - 1));
+	}
+	return Results;
+}
+
+FMCPCompileResult FMCPCompileQueue::CompileBlueprint(UBlueprint* Blueprint, bool bCollectGarbage)
+{
+	FCompilerResultsLog CompileLog;
+	FKismetEditorUtilities::CompileBlueprint(Blueprint,
+		bCollectGarbage ? EBlueprintCompileOptions::None : EBlueprintCompileOptions::SkipGarbageCollection, &CompileLog);
+
+	FMCPCompileResult Result;
+	Result.Blueprint = Blueprint;
+	Result.Path = Blueprint->GetPathName();
+	Result.bCompiled = Blueprint->Status == BS_UpToDate || Blueprint->Status == BS_UpToDateWithWarnings;
+	Result.Status = MCPCompileQueue::GetStatusName(Blueprint->Status);
+
+	FMCPCompileRecord& Messages = Result.Messages;
+	for (const TSharedRef<FTokenizedMessage>& Message : CompileLog.Messages)
+	{
+		if (Message->GetSeverity() == EMessageSeverity::Error)
+		{
+			Messages.ErrorCount++;
+			Messages.Errors.Add(Message->ToText().ToString());
+		}
+		else if (Message->GetSeverity() == EMessageSeverity::Warning)
+		{
+			Messages.WarningCount++;
+			Messages.Warnings.Add(Message->ToText().ToString());
+		}
+	}
+
+	// If the compile failed but CompileLog captured no messages,
+	// add a synthetic error so callers know something is wrong
+	if (Messages.ErrorCount == 0 && !Result.bCompiled)
+	{
+		Messages.ErrorCount++;
+		Messages.Errors.Add(TEXT("Blueprint has Error status after compilation (errors may have occurred during asset loading/validation)"));
+	}
+	return Result;
+}
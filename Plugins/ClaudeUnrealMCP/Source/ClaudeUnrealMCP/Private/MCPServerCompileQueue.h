@@ -0,0 +1,64 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/WeakObjectPtr.h"
+#include "MCPServerCompileCache.h"
+
+class UBlueprint;
+
+/** What one full compile of a blueprint produced. */
+struct FMCPCompileResult
+{
+	TWeakObjectPtr<UBlueprint> Blueprint;
+	FString Path;
+
+	// True when the blueprint ended up UpToDate or UpToDateWithWarnings
+	bool bCompiled = false;
+
+	// EBlueprintStatus name: UpToDate, UpToDateWithWarnings, Error, Dirty, ...
+	FString Status;
+
+	// Messages from the compiler log; Fingerprint is left empty
+	FMCPCompileRecord Messages;
+};
+
+/**
+ * Blueprints edited by mutating commands that still need a full compile.
+ *
+ * Handlers that change a graph mark the blueprint modified and add it here instead of compiling
+ * on the spot, so forty edits to one blueprint cost one compile. Adding a blueprint that is
+ * already queued does nothing. Flush compiles the queue in one pass: dependencies (parent
+ * blueprints and the blueprints a graph references) before the blueprints that use them, and
+ * garbage is collected once at the end rather than after every compile. Blueprints something
+ * else compiled in the meantime (the editor's Compile button, a save, PIE) are skipped.
+ *
+ * Game thread only.
+ */
+class FMCPCompileQueue
+{
+public:
+	/** Note that a blueprint needs a full compile before its generated class is current. */
+	void Add(UBlueprint* Blueprint);
+
+	bool IsEmpty() const { return Pending.IsEmpty(); }
+	int32 Num() const { return Pending.Num(); }
+
+	/** Seconds since the last blueprint was added. */
+	double GetSecondsSinceLastAdd() const;
+
+	/** Compile every queued blueprint that still needs it. Results are in compile order. */
+	TArray<FMCPCompileResult> Flush();
+
+	/**
+	 * Compile the given blueprints, whatever their status, together with the queued ones in the
+	 * same pass. Results cover both, in compile order.
+	 */
+	TArray<FMCPCompileResult> Compile(const TArray<UBlueprint*>& Blueprints);
+
+	/** Compile one blueprint right away and collect its log. */
+	static FMCPCompileResult CompileBlueprint(UBlueprint* Blueprint, bool bCollectGarbage = true);
+
+private:
+	TArray<TWeakObjectPtr<UBlueprint>> Pending;
+	double LastAddTime = 0.0;
+};
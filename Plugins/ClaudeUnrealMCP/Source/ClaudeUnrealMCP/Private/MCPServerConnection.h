@@ -0,0 +1,114 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Queue.h"
+#include "HAL/ThreadSafeBool.h"
+#include "HAL/ThreadSafeCounter.h"
+#include "HAL/ThreadSafeCounter64.h"
+#include "MCPServerFraming.h"
+
+class FSocket;
+
+/** Wire encoding of messages sent to a client. */
+enum class EMCPEncoding : uint8
+{
+	// One condensed JSON document per line
+	Json,
+
+	// One CBOR (RFC 8949) item per "$<length>:cbor\n" length-prefixed frame
+	Cbor
+};
+
+/** Compression applied to outgoing frame payloads. */
+enum class EMCPCompression : uint8
+{
+	None,
+
+	// zlib stream (RFC 1950); frames carry a ":zlib" tag after their other tags
+	Zlib
+};
+
+/** A response frame on its way to the socket. */
+struct FMCPOutboundFrame
+{
+	TArray<uint8> Data;
+
+	// Handed back through FMCPServerReactor::FOnFrameSent once the frame is fully written
+	int32 Tag = INDEX_NONE;
+	double QueuedTime = 0.0;
+};
+
+/**
+ * One long-lived client connection.
+ *
+ * Requests are JSON documents framed by a newline or a "$<length>\n" prefix (see
+ * FMCPFrameReader). A request may carry an "id" field; the response for it echoes the
+ * same id, so a client can keep several requests in flight on one socket and match
+ * responses that come back out of order.
+ *
+ * Responses are JSON lines unless the client negotiated another encoding with the
+ * "hello" command. Every outgoing frame describes its own encoding, so a client can
+ * always tell the two apart. Clients that also ask for chunking may get large responses
+ * as a series of bounded frames tagged with a stream number (see FMCPResponseWriter).
+ *
+ * The socket and the receive/send buffers belong to the reactor's I/O thread. Other
+ * threads only push frames onto OutboundQueue and read the flags.
+ */
+struct FMCPConnection
+{
+	FMCPConnection(FSocket* InSocket, uint32 InConnectionId)
+		: Socket(InSocket)
+		, ConnectionId(InConnectionId)
+		, LastActivityTime(FPlatformTime::Seconds())
+	{
+	}
+
+	FSocket* Socket = nullptr;
+	uint32 ConnectionId = 0;
+
+	// Bytes received but not yet split into complete requests
+	FMCPFrameReader Reader;
+
+	// Encoded response frames waiting to be written; filled from the game thread
+	TQueue<FMCPOutboundFrame, EQueueMode::Mpsc> OutboundQueue;
+
+	// Frame currently being written and how much of it has gone out
+	TArray<uint8> SendBuffer;
+	int32 SendOffset = 0;
+	int32 SendTag = INDEX_NONE;
+	double SendQueuedTime = 0.0;
+
+	// Bytes queued but not yet picked up by the I/O thread; producers of large responses
+	// wait on this so a slow reader cannot make the server buffer everything
+	FThreadSafeCounter64 QueuedBytes;
+
+	// Requests dispatched to the game thread whose responses have not been queued yet
+	FThreadSafeCounter InFlightRequests;
+
+	// Encoding for responses to requests dispatched from now on. Changed by "hello", which
+	// runs inline on the I/O thread, so requests after it in the stream see the new value.
+	EMCPEncoding ResponseEncoding = EMCPEncoding::Json;
+
+	// Set by "hello". Frames are compressed on the I/O thread right before they are written,
+	// and only when their payload is at least CompressionThreshold bytes.
+	EMCPCompression ResponseCompression = EMCPCompression::None;
+	int32 CompressionThreshold = 4 * 1024;
+
+	// Set by "hello"; large streamed responses may then be split into chunk frames
+	FThreadSafeBool bChunkedResponses = false;
+
+	// Numbers the chunk streams sent on this connection
+	FThreadSafeCounter NextStreamId;
+
+	FThreadSafeBool bClosed = false;
+	double LastActivityTime = 0.0;
+
+	// Set once the peer has stopped sending (a half-close, or a broken connection). Nothing
+	// more is read; the connection closes when every request in flight has been answered and
+	// written. I/O thread only.
+	bool bReadClosed = false;
+};
+
+using FMCPConnectionRef = TSharedRef<FMCPConnection, ESPMode::ThreadSafe>;
+using FMCPConnectionPtr = TSharedPtr<FMCPConnection, ESPMode::ThreadSafe>;
+using FMCPConnectionWeakPtr = TWeakPtr<FMCPConnection, ESPMode::ThreadSafe>;
@@ -1,4 +1,20 @@
 #include "MCPServer.h"
+#include "MCPServerConnection.h"
+#include "MCPServerReactor.h"
+#include "MCPServerDispatch.h"
+#include "MCPServerJobs.h"
+#include "MCPServerEncoding.h"
+#include "MCPServerCompileCache.h"
+#include "MCPServerCompileQueue.h"
+#include "MCPServerTypeIndex.h"
+#include "MCPServerTypeRegistry.h"
+#include "MCPServerActorIndex.h"
+#include "MCPServerGraphSnapshots.h"
+#include "MCPServerResolveCache.h"
+#include "MCPServerGlob.h"
+#include "MCPServerPaging.h"
+#include "MCPServerStats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 #include "Engine/Blueprint.h"
 #include "Animation/AnimBlueprint.h"
 #include "WidgetBlueprint.h"
@@ -18,6 +34,7 @@
 #include "Dom/JsonObject.h"
 #include "Serialization/JsonSerializer.h"
 #include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
 #include "Kismet2/BlueprintEditorUtils.h"
 #include "Kismet2/KismetEditorUtilities.h"
 #include "Kismet2/CompilerResultsLog.h"
@@ -51,6 +68,9 @@
 
 FMCPServer::FMCPServer()
 {
+	TArray<FString> CommandNames;
+	GetCommandTable().GetKeys(CommandNames);
+	Stats = MakeUnique<FMCPServerStats>(CommandNames);
 }
 
 FMCPServer::~FMCPServer()
@@ -60,19 +80,28 @@ FMCPServer::~FMCPServer()
 
 bool FMCPServer::Start(int32 Port)
 {
-	FIPv4Endpoint Endpoint(FIPv4Address::Any, Port);
+	// All socket I/O runs on one dedicated thread; complete requests come back through DispatchRequest
+	Reactor = MakeUnique<FMCPServerReactor>(
+		FMCPServerReactor::FOnRequest::CreateRaw(this, &FMCPServer::DispatchRequest),
+		FMCPServerReactor::FOnFrameSent::CreateRaw(this, &FMCPServer::RecordFrameSent));
 
-	Listener = new FTcpListener(Endpoint);
-	Listener->OnConnectionAccepted().BindRaw(this, &FMCPServer::HandleConnection);
-
-	if (Listener->Init())
+	if (Reactor->Start(Port))
 	{
 		bRunning = true;
+		GameThreadQueueTicker = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FMCPServer::TickGameThreadQueue));
+		JobTicker = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateRaw(this, &FMCPServer::TickJobs));
+		CompileCache = MakeShared<FMCPCompileCache>();
+		CompileQueue = MakeShared<FMCPCompileQueue>();
+		TypeIndex = MakeShared<FMCPTypeReferenceIndex>();
+		ActorIndex = MakeShared<FMCPActorIndex>();
+		GraphSnapshots = MakeShared<FMCPGraphSnapshotCache>();
+		ResolveCache = MakeShared<FMCPResolveCache>();
 		return true;
 	}
 
-	delete Listener;
-	Listener = nullptr;
+	Reactor.Reset();
 	return false;
 }
 
@@ -80,170 +109,363 @@ void FMCPServer::Stop()
 {
 	bRunning = false;
 
-	if (Listener)
+	// Worker commands capture this server and send through the reactor; let them finish
+	// before either goes away. No new ones start once bRunning is clear (see DispatchRequest).
+	const double StopDeadline = FPlatformTime::Seconds() + 5.0;
+	while (ActiveWorkerCommands.GetValue() > 0 && FPlatformTime::Seconds() < StopDeadline)
+	{
+		FPlatformProcess::Sleep(0.001f);
+	}
+
+	if (Reactor)
 	{
-		Listener->Stop();
-		delete Listener;
-		Listener = nullptr;
+		Reactor->Shutdown();
+		Reactor.Reset();
 	}
 
-	FScopeLock Lock(&ClientSocketsLock);
-	for (FSocket* Socket : ClientSockets)
+	if (GameThreadQueueTicker.IsValid())
 	{
-		Socket->Close();
-		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Socket);
+		FTSTicker::GetCoreTicker().RemoveTicker(GameThreadQueueTicker);
+		GameThreadQueueTicker.Reset();
 	}
-	ClientSockets.Empty();
+	GameThreadQueue.Empty();
+
+	if (JobTicker.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(JobTicker);
+		JobTicker.Reset();
+	}
+	Jobs.Empty();
+	ResponseStreams.Empty();
+
+	if (CompileCache.IsValid())
+	{
+		CompileCache->Save();
+		CompileCache.Reset();
+	}
+	// Anything still queued stays marked modified; the editor compiles it before PIE or on save
+	CompileQueue.Reset();
+	TypeIndex.Reset();
+	ActorIndex.Reset();
+	GraphSnapshots.Reset();
+	ResolveCache.Reset();
 }
 
-bool FMCPServer::HandleConnection(FSocket* ClientSocket, const FIPv4Endpoint& ClientEndpoint)
+void FMCPServer::DispatchRequest(const FMCPConnectionRef& Connection, FUtf8StringView Payload)
 {
-	if (!bRunning) return false;
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("MCPServer Dispatch", MCPServerChannel);
+	const double ReceivedTime = FPlatformTime::Seconds();
 
-	UE_LOG(LogTemp, Log, TEXT("ClaudeUnrealMCP: Client connected from %s"), *ClientEndpoint.ToString());
+	// Parse JSON command straight from the received UTF-8 bytes
+	TSharedPtr<FJsonObject> JsonObject;
+	TSharedRef<TJsonReader<UTF8CHAR>> Reader = TJsonReaderFactory<UTF8CHAR>::CreateFromView(Payload);
+	if (!FJsonSerializer::Deserialize(Reader, JsonObject) || !JsonObject.IsValid())
+	{
+		QueueResponse(*Connection, Connection->ResponseEncoding, nullptr, MakeError(TEXT("Invalid JSON")));
+		return;
+	}
+
+	TSharedRef<FMCPPendingCommand, ESPMode::ThreadSafe> Pending = MakeShared<FMCPPendingCommand, ESPMode::ThreadSafe>();
+	Pending->JsonCommand = JsonObject;
+	Pending->Connection = Connection;
+	Pending->Encoding = Connection->ResponseEncoding;
+	Pending->ReceivedTime = ReceivedTime;
+
+	// Optional client-chosen id; echoed back so responses can be matched out of order
+	Pending->RequestId = JsonObject->TryGetField(TEXT("id"));
 
+	FString Command;
+	JsonObject->TryGetStringField(TEXT("command"), Command);
+	if (const FCommandEntry* Entry = GetCommandTable().Find(Command))
 	{
-		FScopeLock Lock(&ClientSocketsLock);
-		ClientSockets.Add(ClientSocket);
+		Pending->Threading = Entry->Threading;
+		Pending->StatsCommand = Stats->FindCommand(Command);
 	}
 
-	// Handle client in async task
-	AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this, ClientSocket]()
+	Connection->InFlightRequests.Increment();
+
+	if (Pending->Threading == EMCPCommandThreading::Connection)
 	{
-		HandleClient(ClientSocket);
-	});
+		// Connection options apply to every request after this one in the stream, so they are
+		// changed right here on the I/O thread before the next frame is dispatched
+		ExecutePendingCommand(*Pending);
+		return;
+	}
 
-	return true;
+	if (Pending->Threading == EMCPCommandThreading::AssetRegistryOnly)
+	{
+		// Asset registry queries are thread-safe; run them in parallel off the game thread.
+		// Counted before bRunning is checked, so Stop either waits for this one or it never starts.
+		ActiveWorkerCommands.Increment();
+		if (!bRunning)
+		{
+			ActiveWorkerCommands.Decrement();
+			Connection->InFlightRequests.Decrement();
+			return;
+		}
+		AsyncTask(ENamedThreads::AnyBackgroundThreadNormalTask, [this, Pending]()
+		{
+			ExecutePendingCommand(*Pending);
+			ActiveWorkerCommands.Decrement();
+		});
+		return;
+	}
+
+	// Everything else runs on the game thread for UE API safety, in arrival order. The I/O
+	// thread keeps reading, so several requests from the same connection can be queued at once.
+	GameThreadQueue.Enqueue(Pending);
 }
 
-void FMCPServer::HandleClient(FSocket* ClientSocket)
+void FMCPServer::ExecutePendingCommand(FMCPPendingCommand& Pending)
 {
-	// Enable TCP settings for better connection handling
-	ClientSocket->SetLinger(false, 0);      // Don't wait on close
-	ClientSocket->SetNoDelay(true);         // Disable Nagle's algorithm for low latency
-	ClientSocket->SetNonBlocking(false);     // Use blocking mode for simpler logic
-
-	TArray<uint8> Buffer;
-	Buffer.SetNumUninitialized(65536);
+	FMCPConnectionPtr Connection = Pending.Connection.Pin();
+	if (!bRunning || !Connection.IsValid() || Connection->bClosed)
+	{
+		return;
+	}
 
-	// Handle ONE request per connection, then close
-	// This prevents stale connection accumulation
-	uint32 PendingDataSize = 0;
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("MCPServer Request", MCPServerChannel);
+	const int32 StatsCommand = Pending.StatsCommand;
 	const double StartTime = FPlatformTime::Seconds();
-	const double MaxWaitTime = 5.0; // Wait max 5 seconds for data
+	Stats->RecordSeconds(StatsCommand, EMCPStat::QueueWait, StartTime - Pending.ReceivedTime);
 
-	while (bRunning && (FPlatformTime::Seconds() - StartTime) < MaxWaitTime)
+	FMCPRequestContext Context(Connection, Pending.Encoding, Pending.RequestId);
+	Context.SendFrame = [this, Connection, StatsCommand](TArray<uint8>&& Frame)
 	{
-		// Check socket state first
-		ESocketConnectionState State = ClientSocket->GetConnectionState();
-		if (State != ESocketConnectionState::SCS_Connected)
+		if (Reactor)
+		{
+			Reactor->Send(*Connection, MoveTemp(Frame), StatsCommand);
+		}
+	};
+
+	// Allocations are counted process-wide, so commands running on workers at the same time share them
+	const uint64 AllocationsBefore = FMCPServerStats::GetAllocationCount();
+	const FString Response = ProcessCommand(Pending.JsonCommand);
+	const double ExecuteEndTime = FPlatformTime::Seconds();
+	Stats->RecordSeconds(StatsCommand, EMCPStat::Execute, ExecuteEndTime - StartTime);
+	Stats->Record(StatsCommand, EMCPStat::Allocations, FMCPServerStats::GetAllocationCount() - AllocationsBefore);
+
+	if (Context.bResponseSent)
+	{
+		// Already streamed out by the handler; its encoding counted as execution
+	}
+	else if (Context.CapturedResponse.IsValid() && Response.IsEmpty())
+	{
+		QueueMessage(*Connection, Pending.Encoding, Pending.RequestId, Context.CapturedResponse.ToSharedRef(), StatsCommand);
+	}
+	else
+	{
+		QueueResponse(*Connection, Pending.Encoding, Pending.RequestId, Response, StatsCommand);
+	}
+	if (!Context.bResponseSent)
+	{
+		Stats->RecordSeconds(StatsCommand, EMCPStat::Serialize, FPlatformTime::Seconds() - ExecuteEndTime);
+	}
+	if (!Context.bResponseDeferred)
+	{
+		Connection->InFlightRequests.Decrement();
+	}
+}
+
+static thread_local FMCPRequestContext* GCurrentRequestContext = nullptr;
+
+FMCPRequestContext::FMCPRequestContext(const FMCPConnectionPtr& InConnection, EMCPEncoding InEncoding, const TSharedPtr<FJsonValue>& InRequestId)
+	: Connection(InConnection)
+	, Encoding(InEncoding)
+	, RequestId(InRequestId)
+	, Previous(GCurrentRequestContext)
+{
+	GCurrentRequestContext = this;
+}
+
+FMCPRequestContext::~FMCPRequestContext()
+{
+	GCurrentRequestContext = Previous;
+}
+
+FMCPRequestContext* FMCPRequestContext::Get()
+{
+	return GCurrentRequestContext;
+}
+
+bool FMCPServer::TickGameThreadQueue(float DeltaTime)
+{
+	// Once a slice has spent this long, mutating commands wait for the next frame so the
+	// editor keeps ticking. Reads queued ahead of them still run in this slice.
+	static constexpr double MutatingSliceBudgetSeconds = 0.030;
+
+	const double SliceStart = FPlatformTime::Seconds();
+	TSharedPtr<FMCPPendingCommand, ESPMode::ThreadSafe> Pending;
+	while (const TSharedPtr<FMCPPendingCommand, ESPMode::ThreadSafe>* Next = GameThreadQueue.Peek())
+	{
+		if ((*Next)->Threading == EMCPCommandThreading::Mutating &&
+			FPlatformTime::Seconds() - SliceStart > MutatingSliceBudgetSeconds)
 		{
-			UE_LOG(LogTemp, Warning, TEXT("ClaudeUnrealMCP: Client disconnected before sending data"));
 			break;
 		}
 
-		if (ClientSocket->HasPendingData(PendingDataSize) && PendingDataSize > 0)
+		GameThreadQueue.Dequeue(Pending);
+		ExecutePendingCommand(*Pending);
+	}
+
+	// Edits that arrive in quick succession share one compile; once nothing has been queued for
+	// a while and no commands are waiting, bring the edited blueprints up to date
+	static constexpr double CompileQueueIdleSeconds = 1.0;
+
+	if (CompileQueue.IsValid() && !CompileQueue->IsEmpty() && GameThreadQueue.IsEmpty() &&
+		CompileQueue->GetSecondsSinceLastAdd() >= CompileQueueIdleSeconds)
+	{
+		TArray<FString> Failed;
+		FlushCompileQueue(Failed);
+		for (const FString& Path : Failed)
 		{
-			int32 BytesRead = 0;
-			if (ClientSocket->Recv(Buffer.GetData(), Buffer.Num() - 1, BytesRead))
-			{
-				if (BytesRead > 0)
-				{
-					Buffer[BytesRead] = 0;
-					FString Request = UTF8_TO_TCHAR(Buffer.GetData());
-
-					// Parse JSON command
-					TSharedPtr<FJsonObject> JsonObject;
-					TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Request);
-
-					FString Response;
-					if (FJsonSerializer::Deserialize(Reader, JsonObject) && JsonObject.IsValid())
-					{
-						// Process on game thread for UE API safety
-						FString* ResponsePtr = &Response;
-						FEvent* DoneEvent = FPlatformProcess::GetSynchEventFromPool(false);
-
-						AsyncTask(ENamedThreads::GameThread, [this, JsonObject, ResponsePtr, DoneEvent]()
-						{
-							*ResponsePtr = ProcessCommand(JsonObject);
-							DoneEvent->Trigger();
-						});
-
-						DoneEvent->Wait();
-						FPlatformProcess::ReturnSynchEventToPool(DoneEvent);
-					}
-					else
-					{
-						Response = MakeError(TEXT("Invalid JSON"));
-					}
-
-					// Send response
-					Response += TEXT("\n");
-					FTCHARToUTF8 Converter(*Response);
-
-					// Send all data, handling partial sends
-					int32 TotalBytesSent = 0;
-					int32 DataLength = Converter.Length();
-					while (TotalBytesSent < DataLength)
-					{
-						int32 BytesSent = 0;
-						if (!ClientSocket->Send((uint8*)Converter.Get() + TotalBytesSent, DataLength - TotalBytesSent, BytesSent))
-						{
-							UE_LOG(LogTemp, Warning, TEXT("ClaudeUnrealMCP: Failed to send response to client"));
-							break;
-						}
-						TotalBytesSent += BytesSent;
-
-						if (BytesSent == 0)
-						{
-							// No progress, avoid infinite loop
-							UE_LOG(LogTemp, Warning, TEXT("ClaudeUnrealMCP: Socket send returned 0 bytes, aborting"));
-							break;
-						}
-					}
-
-					if (TotalBytesSent == DataLength)
-					{
-						UE_LOG(LogTemp, Log, TEXT("ClaudeUnrealMCP: Successfully sent %d bytes"), DataLength);
-					}
-					else
-					{
-						UE_LOG(LogTemp, Warning, TEXT("ClaudeUnrealMCP: Partial send - sent %d of %d bytes"), TotalBytesSent, DataLength);
-					}
-
-					// Close connection after handling ONE request
-					// This prevents connection reuse issues and stale connections
-					break;
-				}
-				else
-				{
-					// Zero bytes read means connection closed
-					break;
-				}
-			}
-			else
-			{
-				// Recv failed, connection likely dead
-				UE_LOG(LogTemp, Warning, TEXT("ClaudeUnrealMCP: Socket recv failed"));
-				break;
-			}
+			UE_LOG(LogTemp, Warning, TEXT("ClaudeUnrealMCP: Deferred compile of %s failed"), *Path);
 		}
-		else
+	}
+
+	return true;
+}
+
+void FMCPServer::QueueResponse(FMCPConnection& Connection, EMCPEncoding Encoding, const TSharedPtr<FJsonValue>& RequestId, const FString& Response, int32 StatsCommand)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("MCPServer Serialize", MCPServerChannel);
+
+	if (Encoding != EMCPEncoding::Json)
+	{
+		// Handlers that build their JSON by hand (batch) still have to honour the negotiated encoding
+		TSharedPtr<FJsonObject> Message;
+		TSharedRef<TJsonReader<TCHAR>> Reader = TJsonReaderFactory<TCHAR>::Create(Response);
+		if (FJsonSerializer::Deserialize(Reader, Message) && Message.IsValid())
 		{
-			// No data yet, sleep briefly
-			FPlatformProcess::Sleep(0.01f);
+			QueueMessage(Connection, Encoding, RequestId, Message.ToSharedRef(), StatsCommand);
+			return;
 		}
 	}
 
-	// Clean up connection
-	ClientSocket->Close();
+	if (Reactor)
+	{
+		Reactor->Send(Connection, MCPEncoding::EncodeJsonFrame(RequestId, Response), StatsCommand);
+	}
+}
 
+void FMCPServer::QueueMessage(FMCPConnection& Connection, EMCPEncoding Encoding, const TSharedPtr<FJsonValue>& RequestId, const TSharedRef<FJsonObject>& Message, int32 StatsCommand)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("MCPServer Serialize", MCPServerChannel);
+	if (Reactor)
 	{
-		FScopeLock Lock(&ClientSocketsLock);
-		ClientSockets.Remove(ClientSocket);
+		Reactor->Send(Connection, MCPEncoding::EncodeFrame(Encoding, RequestId, Message), StatsCommand);
 	}
+}
 
-	ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ClientSocket);
+void FMCPServer::RecordFrameSent(int32 StatsCommand, double Seconds, int32 Bytes)
+{
+	// Called on the I/O thread for every frame, job events included (those carry no command)
+	Stats->RecordSeconds(StatsCommand, EMCPStat::Send, Seconds);
+	Stats->Record(StatsCommand, EMCPStat::ResponseBytes, Bytes);
+}
+
+const TMap<FString, FMCPServer::FCommandEntry>& FMCPServer::GetCommandTable()
+{
+	constexpr EMCPCommandThreading AssetRegistryOnly = EMCPCommandThreading::AssetRegistryOnly;
+	constexpr EMCPCommandThreading ReadOnly = EMCPCommandThreading::ReadOnly;
+	constexpr EMCPCommandThreading Mutating = EMCPCommandThreading::Mutating;
+
+	static const TMap<FString, FCommandEntry> CommandTable = {
+		{TEXT("ping"), {&FMCPServer::HandlePing, AssetRegistryOnly}},
+		{TEXT("hello"), {&FMCPServer::HandleHello, EMCPCommandThreading::Connection}},
+		{TEXT("get_server_stats"), {&FMCPServer::HandleGetServerStats, AssetRegistryOnly}},
+		{TEXT("list_structs"), {&FMCPServer::HandleListStructs, ReadOnly}},
+		{TEXT("list_blueprints"), {&FMCPServer::HandleListBlueprints, AssetRegistryOnly}},
+		{TEXT("query_assets"), {&FMCPServer::HandleQueryAssets, AssetRegistryOnly}},
+		{TEXT("check_all_blueprints"), {&FMCPServer::HandleCheckAllBlueprints, Mutating}},
+		{TEXT("read_blueprint"), {&FMCPServer::HandleReadBlueprint, ReadOnly}},
+		{TEXT("read_variables"), {&FMCPServer::HandleReadVariables, ReadOnly}},
+		{TEXT("read_class_defaults"), {&FMCPServer::HandleReadClassDefaults, ReadOnly}},
+		{TEXT("read_components"), {&FMCPServer::HandleReadComponents, ReadOnly}},
+		{TEXT("read_component_properties"), {&FMCPServer::HandleReadComponentProperties, ReadOnly}},
+		{TEXT("read_event_graph"), {&FMCPServer::HandleReadEventGraph, ReadOnly}},
+		{TEXT("read_event_graph_detailed"), {&FMCPServer::HandleReadEventGraphDetailed, ReadOnly}},
+		{TEXT("read_function_graphs"), {&FMCPServer::HandleReadFunctionGraphs, ReadOnly}},
+		{TEXT("read_timelines"), {&FMCPServer::HandleReadTimelines, ReadOnly}},
+		{TEXT("read_interface"), {&FMCPServer::HandleReadInterface, ReadOnly}},
+		{TEXT("read_user_defined_struct"), {&FMCPServer::HandleReadUserDefinedStruct, ReadOnly}},
+		{TEXT("read_user_defined_enum"), {&FMCPServer::HandleReadUserDefinedEnum, ReadOnly}},
+		{TEXT("list_actors"), {&FMCPServer::HandleListActors, ReadOnly}},
+		{TEXT("read_actor_components"), {&FMCPServer::HandleReadActorComponents, ReadOnly}},
+		{TEXT("read_actor_component_properties"), {&FMCPServer::HandleReadActorComponentProperties, ReadOnly}},
+		{TEXT("find_actors_by_name"), {&FMCPServer::HandleFindActorsByName, ReadOnly}},
+		{TEXT("get_actor_material_info"), {&FMCPServer::HandleGetActorMaterialInfo, ReadOnly}},
+		{TEXT("get_scene_summary"), {&FMCPServer::HandleGetSceneSummary, ReadOnly}},
+		{TEXT("query_actors"), {&FMCPServer::HandleQueryActors, ReadOnly}},
+		{TEXT("add_component"), {&FMCPServer::HandleAddComponent, Mutating}},
+		{TEXT("set_component_property"), {&FMCPServer::HandleSetComponentProperty, Mutating}},
+		{TEXT("set_blueprint_cdo_class_reference"), {&FMCPServer::HandleSetBlueprintCDOClassReference, Mutating}},
+		{TEXT("replace_component_map_value"), {&FMCPServer::HandleReplaceComponentMapValue, Mutating}},
+		{TEXT("replace_blueprint_array_value"), {&FMCPServer::HandleReplaceBlueprintArrayValue, Mutating}},
+		{TEXT("add_input_mapping"), {&FMCPServer::HandleAddInputMapping, Mutating}},
+		{TEXT("reparent_blueprint"), {&FMCPServer::HandleReparentBlueprint, Mutating}},
+		{TEXT("compile_blueprint"), {&FMCPServer::HandleCompileBlueprint, Mutating}},
+		{TEXT("flush"), {&FMCPServer::HandleFlush, Mutating}},
+		{TEXT("save_asset"), {&FMCPServer::HandleSaveAsset, Mutating}},
+		{TEXT("save_all"), {&FMCPServer::HandleSaveAll, Mutating}},
+		{TEXT("delete_interface_function"), {&FMCPServer::HandleDeleteInterfaceFunction, Mutating}},
+		{TEXT("modify_interface_function_parameter"), {&FMCPServer::HandleModifyInterfaceFunctionParameter, Mutating}},
+		{TEXT("delete_function_graph"), {&FMCPServer::HandleDeleteFunctionGraph, Mutating}},
+		{TEXT("clear_event_graph"), {&FMCPServer::HandleClearEventGraph, Mutating}},
+		{TEXT("empty_graph"), {&FMCPServer::HandleClearEventGraph, Mutating}},
+		{TEXT("refresh_nodes"), {&FMCPServer::HandleRefreshNodes, Mutating}},
+		{TEXT("break_orphaned_pins"), {&FMCPServer::HandleBreakOrphanedPins, Mutating}},
+		{TEXT("delete_user_defined_struct"), {&FMCPServer::HandleDeleteUserDefinedStruct, Mutating}},
+		{TEXT("modify_struct_field"), {&FMCPServer::HandleModifyStructField, Mutating}},
+		{TEXT("set_blueprint_compile_settings"), {&FMCPServer::HandleSetBlueprintCompileSettings, Mutating}},
+		{TEXT("modify_function_metadata"), {&FMCPServer::HandleModifyFunctionMetadata, Mutating}},
+		{TEXT("capture_screenshot"), {&FMCPServer::HandleCaptureScreenshot, Mutating}},
+		{TEXT("remove_error_nodes"), {&FMCPServer::HandleRemoveErrorNodes, Mutating}},
+		{TEXT("clear_animation_blueprint_tags"), {&FMCPServer::HandleClearAnimationBlueprintTags, Mutating}},
+		{TEXT("clear_anim_graph"), {&FMCPServer::HandleClearAnimGraph, Mutating}},
+		{TEXT("create_blueprint_function"), {&FMCPServer::HandleCreateBlueprintFunction, Mutating}},
+		{TEXT("add_function_input"), {&FMCPServer::HandleAddFunctionInput, Mutating}},
+		{TEXT("add_function_output"), {&FMCPServer::HandleAddFunctionOutput, Mutating}},
+		{TEXT("rename_blueprint_function"), {&FMCPServer::HandleRenameBlueprintFunction, Mutating}},
+		{TEXT("read_actor_properties"), {&FMCPServer::HandleReadActorProperties, ReadOnly}},
+		{TEXT("set_actor_properties"), {&FMCPServer::HandleSetActorProperties, Mutating}},
+		{TEXT("set_actor_component_property"), {&FMCPServer::HandleSetActorComponentProperty, Mutating}},
+		{TEXT("reconstruct_actor"), {&FMCPServer::HandleReconstructActor, Mutating}},
+		{TEXT("clear_component_map_value_array"), {&FMCPServer::HandleClearComponentMapValueArray, Mutating}},
+		{TEXT("replace_component_class"), {&FMCPServer::HandleReplaceComponentClass, Mutating}},
+		{TEXT("delete_component"), {&FMCPServer::HandleDeleteComponent, Mutating}},
+		{TEXT("set_blueprint_cdo_property"), {&FMCPServer::HandleSetBlueprintCDOProperty, Mutating}},
+		{TEXT("remove_implemented_interface"), {&FMCPServer::HandleRemoveImplementedInterface, Mutating}},
+		{TEXT("add_implemented_interface"), {&FMCPServer::HandleAddImplementedInterface, Mutating}},
+		{TEXT("migrate_interface_references"), {&FMCPServer::HandleMigrateInterfaceReferences, Mutating}},
+		{TEXT("connect_nodes"), {&FMCPServer::HandleConnectNodes, Mutating}},
+		{TEXT("disconnect_pin"), {&FMCPServer::HandleDisconnectPin, Mutating}},
+		{TEXT("add_set_struct_node"), {&FMCPServer::HandleAddSetStructNode, Mutating}},
+		{TEXT("delete_node"), {&FMCPServer::HandleDeleteNode, Mutating}},
+		{TEXT("read_input_mapping_context"), {&FMCPServer::HandleReadInputMappingContext, ReadOnly}},
+		{TEXT("migrate_struct_references"), {&FMCPServer::HandleMigrateStructReferences, Mutating}},
+		{TEXT("migrate_enum_references"), {&FMCPServer::HandleMigrateEnumReferences, Mutating}},
+		{TEXT("plan_migration"), {&FMCPServer::HandlePlanMigration, ReadOnly}},
+		{TEXT("fix_property_access_paths"), {&FMCPServer::HandleFixPropertyAccessPaths, Mutating}},
+		{TEXT("clean_property_access_paths"), {&FMCPServer::HandleCleanPropertyAccessPaths, Mutating}},
+		{TEXT("fix_struct_sub_pins"), {&FMCPServer::HandleFixStructSubPins, Mutating}},
+		{TEXT("rename_local_variable"), {&FMCPServer::HandleRenameLocalVariable, Mutating}},
+		{TEXT("fix_pin_enum_type"), {&FMCPServer::HandleFixPinEnumType, Mutating}},
+		{TEXT("fix_enum_defaults"), {&FMCPServer::HandleFixEnumDefaults, Mutating}},
+		{TEXT("force_fix_enum_pin_defaults"), {&FMCPServer::HandleForceFixEnumPinDefaults, Mutating}},
+		{TEXT("fix_asset_struct_reference"), {&FMCPServer::HandleFixAssetStructReference, Mutating}},
+		{TEXT("reconstruct_node"), {&FMCPServer::HandleReconstructNode, Mutating}},
+		{TEXT("set_pin_default"), {&FMCPServer::HandleSetPinDefault, Mutating}},
+		{TEXT("restore_struct_node_pins"), {&FMCPServer::HandleRestoreStructNodePins, Mutating}},
+		{TEXT("fix_struct_enum_field_defaults"), {&FMCPServer::HandleFixStructEnumFieldDefaults, Mutating}},
+		{TEXT("fix_optional_struct_pin_defaults"), {&FMCPServer::HandleFixOptionalStructPinDefaults, Mutating}},
+		{TEXT("set_struct_field_default"), {&FMCPServer::HandleSetStructFieldDefault, Mutating}},
+		{TEXT("migrate_chooser_table"), {&FMCPServer::HandleMigrateChooserTable, Mutating}},
+		{TEXT("batch"), {&FMCPServer::HandleBatch, Mutating}},
+		{TEXT("get_job_status"), {&FMCPServer::HandleGetJobStatus, ReadOnly}},
+		{TEXT("cancel_job"), {&FMCPServer::HandleCancelJob, ReadOnly}}
+	};
+	return CommandTable;
 }
 
 FString FMCPServer::ProcessCommand(const TSharedPtr<FJsonObject>& JsonCommand)
@@ -251,148 +473,243 @@ FString FMCPServer::ProcessCommand(const TSharedPtr<FJsonObject>& JsonCommand)
 	FString Command = JsonCommand->GetStringField(TEXT("command"));
 	TSharedPtr<FJsonObject> Params = JsonCommand->GetObjectField(TEXT("params"));
 
-	if (Command == TEXT("ping"))
+	if (const FCommandEntry* Entry = GetCommandTable().Find(Command))
 	{
-		TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-		Data->SetStringField(TEXT("message"), TEXT("pong"));
-		return MakeResponse(true, Data);
+		// Named after the command, so batch sub-commands show up on their own too
+		TRACE_CPUPROFILER_EVENT_SCOPE_TEXT_ON_CHANNEL(*Command, MCPServerChannel);
+		return (this->*(Entry->Handler))(Params);
 	}
-	else if (Command == TEXT("list_structs"))
+
+	return MakeError(FString::Printf(TEXT("Unknown command: %s"), *Command));
+}
+
+FString FMCPServer::HandlePing(const TSharedPtr<FJsonObject>& Params)
+{
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetStringField(TEXT("message"), TEXT("pong"));
+	return MakeResponse(true, Data);
+}
+
+FString FMCPServer::HandleHello(const TSharedPtr<FJsonObject>& Params)
+{
+	// Runs on the I/O thread (see the command table), so it may only touch the connection
+	FMCPRequestContext* Context = FMCPRequestContext::Get();
+	if (!Context || !Context->Connection.IsValid())
 	{
-		// Debug command to list all registered UScriptStruct objects matching a pattern
-		FString Pattern = TEXT("FS_");
-		if (Params.IsValid() && Params->HasField(TEXT("pattern")))
+		return MakeError(TEXT("hello must be sent over a client connection"));
+	}
+
+	FString EncodingName;
+	if (Params.IsValid() && Params->TryGetStringField(TEXT("encoding"), EncodingName))
+	{
+		EMCPEncoding Encoding;
+		if (!MCPEncoding::FromString(EncodingName, Encoding))
 		{
-			Pattern = Params->GetStringField(TEXT("pattern"));
+			return MakeError(FString::Printf(TEXT("Unsupported encoding: %s"), *EncodingName));
 		}
 
-		TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-		TArray<TSharedPtr<FJsonValue>> StructsArray;
+		// This response still goes out in the old encoding; every later one uses the new one
+		Context->Connection->ResponseEncoding = Encoding;
+	}
 
-		for (TObjectIterator<UScriptStruct> It; It; ++It)
+	FString CompressionName;
+	if (Params.IsValid() && Params->TryGetStringField(TEXT("compression"), CompressionName))
+	{
+		EMCPCompression Compression;
+		if (!MCPEncoding::FromString(CompressionName, Compression))
 		{
-			UScriptStruct* Struct = *It;
-			if (Struct->GetName().Contains(Pattern))
-			{
-				TSharedPtr<FJsonObject> StructInfo = MakeShared<FJsonObject>();
-				StructInfo->SetStringField(TEXT("name"), Struct->GetName());
-				StructInfo->SetStringField(TEXT("path"), Struct->GetPathName());
-				StructsArray.Add(MakeShared<FJsonValueObject>(StructInfo));
-			}
+			return MakeError(FString::Printf(TEXT("Unsupported compression: %s"), *CompressionName));
 		}
+		Context->Connection->ResponseCompression = Compression;
+	}
 
-		Data->SetArrayField(TEXT("structs"), StructsArray);
-		Data->SetNumberField(TEXT("count"), StructsArray.Num());
-		return MakeResponse(true, Data);
-	}
-
-	using FCommandHandler = FString (FMCPServer::*)(const TSharedPtr<FJsonObject>&);
-	static const TMap<FString, FCommandHandler> CommandHandlers = {
-		{TEXT("list_blueprints"), &FMCPServer::HandleListBlueprints},
-		{TEXT("check_all_blueprints"), &FMCPServer::HandleCheckAllBlueprints},
-		{TEXT("read_blueprint"), &FMCPServer::HandleReadBlueprint},
-		{TEXT("read_variables"), &FMCPServer::HandleReadVariables},
-		{TEXT("read_class_defaults"), &FMCPServer::HandleReadClassDefaults},
-		{TEXT("read_components"), &FMCPServer::HandleReadComponents},
-		{TEXT("read_component_properties"), &FMCPServer::HandleReadComponentProperties},
-		{TEXT("read_event_graph"), &FMCPServer::HandleReadEventGraph},
-		{TEXT("read_event_graph_detailed"), &FMCPServer::HandleReadEventGraphDetailed},
-		{TEXT("read_function_graphs"), &FMCPServer::HandleReadFunctionGraphs},
-		{TEXT("read_timelines"), &FMCPServer::HandleReadTimelines},
-		{TEXT("read_interface"), &FMCPServer::HandleReadInterface},
-		{TEXT("read_user_defined_struct"), &FMCPServer::HandleReadUserDefinedStruct},
-		{TEXT("read_user_defined_enum"), &FMCPServer::HandleReadUserDefinedEnum},
-		{TEXT("list_actors"), &FMCPServer::HandleListActors},
-		{TEXT("read_actor_components"), &FMCPServer::HandleReadActorComponents},
-		{TEXT("read_actor_component_properties"), &FMCPServer::HandleReadActorComponentProperties},
-		{TEXT("find_actors_by_name"), &FMCPServer::HandleFindActorsByName},
-		{TEXT("get_actor_material_info"), &FMCPServer::HandleGetActorMaterialInfo},
-		{TEXT("get_scene_summary"), &FMCPServer::HandleGetSceneSummary},
-		{TEXT("add_component"), &FMCPServer::HandleAddComponent},
-		{TEXT("set_component_property"), &FMCPServer::HandleSetComponentProperty},
-		{TEXT("set_blueprint_cdo_class_reference"), &FMCPServer::HandleSetBlueprintCDOClassReference},
-		{TEXT("replace_component_map_value"), &FMCPServer::HandleReplaceComponentMapValue},
-		{TEXT("replace_blueprint_array_value"), &FMCPServer::HandleReplaceBlueprintArrayValue},
-		{TEXT("add_input_mapping"), &FMCPServer::HandleAddInputMapping},
-		{TEXT("reparent_blueprint"), &FMCPServer::HandleReparentBlueprint},
-		{TEXT("compile_blueprint"), &FMCPServer::HandleCompileBlueprint},
-		{TEXT("save_asset"), &FMCPServer::HandleSaveAsset},
-		{TEXT("save_all"), &FMCPServer::HandleSaveAll},
-		{TEXT("delete_interface_function"), &FMCPServer::HandleDeleteInterfaceFunction},
-		{TEXT("modify_interface_function_parameter"), &FMCPServer::HandleModifyInterfaceFunctionParameter},
-		{TEXT("delete_function_graph"), &FMCPServer::HandleDeleteFunctionGraph},
-		{TEXT("clear_event_graph"), &FMCPServer::HandleClearEventGraph},
-		{TEXT("empty_graph"), &FMCPServer::HandleClearEventGraph},
-		{TEXT("refresh_nodes"), &FMCPServer::HandleRefreshNodes},
-		{TEXT("break_orphaned_pins"), &FMCPServer::HandleBreakOrphanedPins},
-		{TEXT("delete_user_defined_struct"), &FMCPServer::HandleDeleteUserDefinedStruct},
-		{TEXT("modify_struct_field"), &FMCPServer::HandleModifyStructField},
-		{TEXT("set_blueprint_compile_settings"), &FMCPServer::HandleSetBlueprintCompileSettings},
-		{TEXT("modify_function_metadata"), &FMCPServer::HandleModifyFunctionMetadata},
-		{TEXT("capture_screenshot"), &FMCPServer::HandleCaptureScreenshot},
-		{TEXT("remove_error_nodes"), &FMCPServer::HandleRemoveErrorNodes},
-		{TEXT("clear_animation_blueprint_tags"), &FMCPServer::HandleClearAnimationBlueprintTags},
-		{TEXT("clear_anim_graph"), &FMCPServer::HandleClearAnimGraph},
-		{TEXT("create_blueprint_function"), &FMCPServer::HandleCreateBlueprintFunction},
-		{TEXT("add_function_input"), &FMCPServer::HandleAddFunctionInput},
-		{TEXT("add_function_output"), &FMCPServer::HandleAddFunctionOutput},
-		{TEXT("rename_blueprint_function"), &FMCPServer::HandleRenameBlueprintFunction},
-		{TEXT("read_actor_properties"), &FMCPServer::HandleReadActorProperties},
-		{TEXT("set_actor_properties"), &FMCPServer::HandleSetActorProperties},
-		{TEXT("set_actor_component_property"), &FMCPServer::HandleSetActorComponentProperty},
-		{TEXT("reconstruct_actor"), &FMCPServer::HandleReconstructActor},
-		{TEXT("clear_component_map_value_array"), &FMCPServer::HandleClearComponentMapValueArray},
-		{TEXT("replace_component_class"), &FMCPServer::HandleReplaceComponentClass},
-		{TEXT("delete_component"), &FMCPServer::HandleDeleteComponent},
-		{TEXT("set_blueprint_cdo_property"), &FMCPServer::HandleSetBlueprintCDOProperty},
-		{TEXT("remove_implemented_interface"), &FMCPServer::HandleRemoveImplementedInterface},
-		{TEXT("add_implemented_interface"), &FMCPServer::HandleAddImplementedInterface},
-		{TEXT("migrate_interface_references"), &FMCPServer::HandleMigrateInterfaceReferences},
-		{TEXT("connect_nodes"), &FMCPServer::HandleConnectNodes},
-		{TEXT("disconnect_pin"), &FMCPServer::HandleDisconnectPin},
-		{TEXT("add_set_struct_node"), &FMCPServer::HandleAddSetStructNode},
-		{TEXT("delete_node"), &FMCPServer::HandleDeleteNode},
-		{TEXT("read_input_mapping_context"), &FMCPServer::HandleReadInputMappingContext},
-		{TEXT("migrate_struct_references"), &FMCPServer::HandleMigrateStructReferences},
-		{TEXT("migrate_enum_references"), &FMCPServer::HandleMigrateEnumReferences},
-		{TEXT("fix_property_access_paths"), &FMCPServer::HandleFixPropertyAccessPaths},
-		{TEXT("clean_property_access_paths"), &FMCPServer::HandleCleanPropertyAccessPaths},
-		{TEXT("fix_struct_sub_pins"), &FMCPServer::HandleFixStructSubPins},
-		{TEXT("rename_local_variable"), &FMCPServer::HandleRenameLocalVariable},
-		{TEXT("fix_pin_enum_type"), &FMCPServer::HandleFixPinEnumType},
-		{TEXT("fix_enum_defaults"), &FMCPServer::HandleFixEnumDefaults},
-		{TEXT("force_fix_enum_pin_defaults"), &FMCPServer::HandleForceFixEnumPinDefaults},
-		{TEXT("fix_asset_struct_reference"), &FMCPServer::HandleFixAssetStructReference},
-		{TEXT("reconstruct_node"), &FMCPServer::HandleReconstructNode},
-		{TEXT("set_pin_default"), &FMCPServer::HandleSetPinDefault},
-		{TEXT("restore_struct_node_pins"), &FMCPServer::HandleRestoreStructNodePins},
-		{TEXT("fix_struct_enum_field_defaults"), &FMCPServer::HandleFixStructEnumFieldDefaults},
-		{TEXT("fix_optional_struct_pin_defaults"), &FMCPServer::HandleFixOptionalStructPinDefaults},
-		{TEXT("set_struct_field_default"), &FMCPServer::HandleSetStructFieldDefault},
-		{TEXT("migrate_chooser_table"), &FMCPServer::HandleMigrateChooserTable}
-	};
+	int32 CompressionThreshold = 0;
+	if (Params.IsValid() && Params->TryGetNumberField(TEXT("compression_threshold"), CompressionThreshold))
+	{
+		Context->Connection->CompressionThreshold = FMath::Max(CompressionThreshold, 0);
+	}
 
-	if (const FCommandHandler* Handler = CommandHandlers.Find(Command))
+	bool bChunking = false;
+	if (Params.IsValid() && Params->TryGetBoolField(TEXT("chunking"), bChunking))
 	{
-		return (this->**Handler)(Params);
+		Context->Connection->bChunkedResponses = bChunking;
 	}
 
-	return MakeError(FString::Printf(TEXT("Unknown command: %s"), *Command));
+	TArray<TSharedPtr<FJsonValue>> Encodings;
+	Encodings.Add(MakeShared<FJsonValueString>(MCPEncoding::ToString(EMCPEncoding::Json)));
+	Encodings.Add(MakeShared<FJsonValueString>(MCPEncoding::ToString(EMCPEncoding::Cbor)));
+
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetStringField(TEXT("encoding"), MCPEncoding::ToString(Context->Connection->ResponseEncoding));
+	Data->SetArrayField(TEXT("encodings"), Encodings);
+	Data->SetBoolField(TEXT("chunking"), Context->Connection->bChunkedResponses);
+	Data->SetStringField(TEXT("compression"), MCPEncoding::ToString(Context->Connection->ResponseCompression));
+	Data->SetNumberField(TEXT("compression_threshold"), Context->Connection->CompressionThreshold);
+	return MakeResponse(true, Data);
 }
 
-UBlueprint* FMCPServer::LoadBlueprintFromPath(const FString& Path)
+FString FMCPServer::HandleListStructs(const TSharedPtr<FJsonObject>& Params)
 {
-	FString FullPath = Path;
-	if (!FullPath.StartsWith(TEXT("/")))
+	// Debug command to list all registered UScriptStruct objects matching a pattern
+	FString Pattern = TEXT("FS_");
+	if (Params.IsValid() && Params->HasField(TEXT("pattern")))
+	{
+		Pattern = Params->GetStringField(TEXT("pattern"));
+	}
+
+	FMCPPage Page(TEXT("list_structs"));
+	FString PageError;
+	if (!Page.Init(Params, PageError))
+	{
+		return MakeError(PageError);
+	}
+
+	// A plain pattern matches anywhere in the name
+	const FMCPGlobPattern NamePattern(Pattern, EMCPGlobLiteral::Substring);
+	TStringBuilder<FName::StringBufferSize> NameString;
+
+	TArray<UScriptStruct*> Structs;
+	FMCPTypeRegistry& TypeRegistry = FMCPTypeRegistry::Get();
+	for (const FName Name : TypeRegistry.GetAllNames())
+	{
+		NameString.Reset();
+		Name.ToString(NameString);
+		if (!NamePattern.Matches(NameString.ToView()))
+		{
+			continue;
+		}
+		for (UScriptStruct* Struct : TypeRegistry.FindAll<UScriptStruct>(Name))
+		{
+			Page.Offer(Struct->GetPathName(), Structs.Add(Struct));
+		}
+	}
+
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	TArray<TSharedPtr<FJsonValue>> StructsArray;
+	for (const int32 Index : Page.Finish())
+	{
+		UScriptStruct* Struct = Structs[Index];
+		TSharedPtr<FJsonObject> StructInfo = MakeShared<FJsonObject>();
+		StructInfo->SetStringField(TEXT("name"), Struct->GetName());
+		StructInfo->SetStringField(TEXT("path"), Struct->GetPathName());
+		StructsArray.Add(MakeShared<FJsonValueObject>(StructInfo));
+	}
+
+	Data->SetArrayField(TEXT("structs"), StructsArray);
+	Data->SetNumberField(TEXT("count"), StructsArray.Num());
+	Page.WriteCursor(Data);
+	return MakeResponse(true, Data);
+}
+
+FString FMCPServer::HandleBatch(const TSharedPtr<FJsonObject>& Params)
+{
+	const TArray<TSharedPtr<FJsonValue>>* Commands = nullptr;
+	if (!Params.IsValid() || !Params->TryGetArrayField(TEXT("commands"), Commands))
+	{
+		return MakeError(TEXT("Missing 'commands' array parameter"));
+	}
+
+	bool bStopOnError = false;
+	Params->TryGetBoolField(TEXT("stop_on_error"), bStopOnError);
+
+	// Sub-responses are spliced together as strings, so keep MakeResponse producing them. A
+	// context is also where each sub-command's success flag comes back, so make one if needed.
+	FMCPRequestContext* Context = FMCPRequestContext::Get();
+	TOptional<FMCPRequestContext> LocalContext;
+	if (!Context)
+	{
+		Context = &LocalContext.Emplace(nullptr, EMCPEncoding::Json, nullptr);
+	}
+	++Context->NestingDepth;
+
+	// Every sub-command runs here, inside the single game-thread task that is running the
+	// batch. Sub-responses are already serialized JSON objects, so they are spliced into the
+	// results array as-is rather than parsed and re-serialized.
+	FString Results;
+	int32 Executed = 0;
+	int32 Failed = 0;
+	bool bStopped = false;
+
+	for (int32 Index = 0; Index < Commands->Num(); ++Index)
 	{
-		FullPath = TEXT("/Game/") + Path;
+		const TSharedPtr<FJsonObject>* SubCommand = nullptr;
+		FString SubResponse;
+		Context->ResponseSucceeded.Reset();
+		if (!(*Commands)[Index]->TryGetObject(SubCommand) || !(*SubCommand)->HasTypedField<EJson::String>(TEXT("command")))
+		{
+			SubResponse = MakeError(FString::Printf(TEXT("Batch entry %d is not a {command, params} object"), Index));
+		}
+		else if ((*SubCommand)->GetStringField(TEXT("command")) == TEXT("batch"))
+		{
+			SubResponse = MakeError(TEXT("Nested batch commands are not supported"));
+		}
+		else if (const FCommandEntry* Entry = GetCommandTable().Find((*SubCommand)->GetStringField(TEXT("command")));
+			Entry && Entry->Threading == EMCPCommandThreading::Connection)
+		{
+			SubResponse = MakeError(TEXT("Connection commands (hello) cannot run inside a batch"));
+		}
+		else
+		{
+			SubResponse = ProcessCommand(*SubCommand);
+		}
+
+		++Executed;
+		const bool bSucceeded = Context->ResponseSucceeded.Get(true);
+		if (!bSucceeded)
+		{
+			++Failed;
+		}
+
+		if (!Results.IsEmpty())
+		{
+			Results += TEXT(",");
+		}
+		Results += SubResponse;
+
+		if (!bSucceeded && bStopOnError)
+		{
+			bStopped = Index < Commands->Num() - 1;
+			break;
+		}
 	}
-	if (!FullPath.EndsWith(TEXT(".") + FPackageName::GetAssetPackageExtension()))
+
+	--Context->NestingDepth;
+	Context->ResponseSucceeded.Reset();
+
+	// Every blueprint the batch edited is compiled once, here, in dependency order
+	FString Compile;
+	TArray<FString> CompileFailed;
+	if (TSharedPtr<FJsonObject> CompileData = FlushCompileQueue(CompileFailed))
+	{
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Compile);
+		FJsonSerializer::Serialize(CompileData.ToSharedRef(), Writer);
+		Compile = TEXT(",\"compile\":") + Compile;
+	}
+
+	return FString::Printf(
+		TEXT("{\"success\":true,\"data\":{\"results\":[%s],\"count\":%d,\"executed\":%d,\"failed\":%d,\"stopped_on_error\":%s%s}}"),
+		*Results, Commands->Num(), Executed, Failed, bStopped ? TEXT("true") : TEXT("false"), *Compile);
+}
+
+UBlueprint* FMCPServer::LoadBlueprintFromPath(const FString& Path)
+{
+	if (ResolveCache.IsValid())
 	{
-		// Just load by object path
+		return ResolveCache->FindBlueprint(Path);
 	}
+	return LoadObject<UBlueprint>(nullptr, *FMCPResolveCache::NormalizeBlueprintPath(Path));
+}
 
-	return LoadObject<UBlueprint>(nullptr, *FullPath);
+void FMCPServer::QueueCompile(UBlueprint* Blueprint)
+{
+	if (CompileQueue.IsValid())
+	{
+		CompileQueue->Add(Blueprint);
+	}
+	else
+	{
+		FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	}
 }
 
 
@@ -411,8 +728,21 @@ FString FMCPServer::MakeResponse(bool bSuccess, const TSharedPtr<FJsonObject>& D
 		Response->SetStringField(TEXT("error"), Error);
 	}
 
+	// Binary encodings are written from the tree itself; skip building the JSON text
+	FMCPRequestContext* Context = FMCPRequestContext::Get();
+	if (Context)
+	{
+		Context->ResponseSucceeded = bSuccess;
+	}
+	if (Context && Context->Encoding != EMCPEncoding::Json && Context->NestingDepth == 0)
+	{
+		Context->CapturedResponse = Response;
+		return FString();
+	}
+
+	// Condensed output: responses are newline-framed, so they must not contain raw newlines
 	FString OutputString;
-	TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&OutputString);
+	TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&OutputString);
 	FJsonSerializer::Serialize(Response.ToSharedRef(), Writer);
 
 	return OutputString;
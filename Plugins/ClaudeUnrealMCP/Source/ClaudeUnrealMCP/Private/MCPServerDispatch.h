@@ -0,0 +1,79 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "MCPServerConnection.h"
+
+/** Where a command is allowed to run. Every entry in the command table declares one. */
+enum class EMCPCommandThreading : uint8
+{
+	// Only queries the asset registry (or touches no engine state at all); runs on worker threads in parallel
+	AssetRegistryOnly,
+
+	// Reads UObjects; runs on the game thread, batched with the other queued reads in one slice per frame
+	ReadOnly,
+
+	// Changes editor state; runs on the game thread and may be deferred to the next frame when the slice is over budget
+	Mutating,
+
+	// Only changes options of the calling connection; runs inline on the I/O thread before later requests are dispatched
+	Connection
+};
+
+/** A parsed request waiting for its handler to run. */
+struct FMCPPendingCommand
+{
+	TSharedPtr<FJsonObject> JsonCommand;
+	TSharedPtr<FJsonValue> RequestId;
+	FMCPConnectionWeakPtr Connection;
+	EMCPCommandThreading Threading = EMCPCommandThreading::Mutating;
+
+	// Connection's response encoding when the request was read
+	EMCPEncoding Encoding = EMCPEncoding::Json;
+
+	// Record of the command in the server stats, and when the request was read
+	int32 StatsCommand = INDEX_NONE;
+	double ReceivedTime = 0.0;
+};
+
+/**
+ * State of the request being executed on the current thread. Handlers keep their plain
+ * (Params) -> FString signature; whatever needs the calling connection looks it up here.
+ */
+struct FMCPRequestContext
+{
+	FMCPRequestContext(const FMCPConnectionPtr& InConnection, EMCPEncoding InEncoding, const TSharedPtr<FJsonValue>& InRequestId);
+	~FMCPRequestContext();
+
+	/** Innermost request executing on this thread, or null outside of command execution. */
+	static FMCPRequestContext* Get();
+
+	FMCPConnectionPtr Connection;
+	EMCPEncoding Encoding = EMCPEncoding::Json;
+	TSharedPtr<FJsonValue> RequestId;
+
+	// For binary encodings MakeResponse parks the response tree here and returns an empty
+	// string, so it is encoded once, straight into the outgoing frame, instead of via JSON text
+	TSharedPtr<FJsonObject> CapturedResponse;
+
+	// Queues an encoded frame on the calling connection, for handlers that send their own response
+	TFunction<void(TArray<uint8>&&)> SendFrame;
+
+	// Set once the response has gone out through SendFrame (FMCPResponseWriter); the handler's
+	// return value is then ignored
+	bool bResponseSent = false;
+
+	// Set when the rest of the response was parked (FMCPServer::RunResponseStream); the request
+	// stays in flight until the stream finishes
+	bool bResponseDeferred = false;
+
+	// Greater than zero while a command runs other commands (batch); those need real strings
+	int32 NestingDepth = 0;
+
+	// Success flag of the last response built by MakeResponse; batch reads it per sub-command.
+	// Unset when the handler streamed its response instead (FMCPResponseWriter only writes successes)
+	TOptional<bool> ResponseSucceeded;
+
+private:
+	FMCPRequestContext* Previous = nullptr;
+};
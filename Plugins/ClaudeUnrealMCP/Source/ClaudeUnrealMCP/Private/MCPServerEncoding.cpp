@@ -0,0 +1,306 @@
+#include "MCPServerEncoding.h"
+#include "MCPServerResponseWriter.h"
+#include "CborWriter.h"
+#include "Misc/Compression.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+
+namespace MCPEncoding
+{
+	// Room reserved in front of a length-prefixed payload for its "$<length>:<tags>\n" header
+	static constexpr int32 MaxHeaderBytes = 64;
+
+	static void WriteCborObject(FCborWriter& Writer, const FJsonObject& Object, const TSharedPtr<FJsonValue>& RequestId);
+
+	static void WriteCborValue(FCborWriter& Writer, const TSharedPtr<FJsonValue>& Value)
+	{
+		if (!Value.IsValid())
+		{
+			Writer.WriteNull();
+			return;
+		}
+
+		switch (Value->Type)
+		{
+		case EJson::String:
+			Writer.WriteValue(Value->AsString());
+			break;
+
+		case EJson::Number:
+		{
+			// JSON numbers are doubles; integral ones (counts, indices) get the compact integer form
+			const double Number = Value->AsNumber();
+			if (FMath::IsFinite(Number) && Number == FMath::RoundToDouble(Number) && FMath::Abs(Number) < 9.0e15)
+			{
+				Writer.WriteValue(static_cast<int64>(Number));
+			}
+			else
+			{
+				Writer.WriteValue(Number);
+			}
+			break;
+		}
+
+		case EJson::Boolean:
+			Writer.WriteValue(Value->AsBool());
+			break;
+
+		case EJson::Array:
+		{
+			const TArray<TSharedPtr<FJsonValue>>& Array = Value->AsArray();
+			Writer.WriteContainerStart(ECborCode::Array, Array.Num());
+			for (const TSharedPtr<FJsonValue>& Element : Array)
+			{
+				WriteCborValue(Writer, Element);
+			}
+			break;
+		}
+
+		case EJson::Object:
+			WriteCborObject(Writer, *Value->AsObject(), nullptr);
+			break;
+
+		case EJson::None:
+		case EJson::Null:
+		default:
+			Writer.WriteNull();
+			break;
+		}
+	}
+
+	static void WriteCborObject(FCborWriter& Writer, const FJsonObject& Object, const TSharedPtr<FJsonValue>& RequestId)
+	{
+		Writer.WriteContainerStart(ECborCode::Map, Object.Values.Num() + (RequestId.IsValid() ? 1 : 0));
+
+		if (RequestId.IsValid())
+		{
+			Writer.WriteValue(FString(TEXT("id")));
+			WriteCborValue(Writer, RequestId);
+		}
+
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object.Values)
+		{
+			Writer.WriteValue(Field.Key);
+			WriteCborValue(Writer, Field.Value);
+		}
+	}
+
+	static TArray<uint8> EncodeCborFrame(const TSharedPtr<FJsonValue>& RequestId, const FJsonObject& Message)
+	{
+		TArray<uint8> Frame;
+		BeginPrefixedFrame(Frame);
+		{
+			FMemoryWriter Archive(Frame, false, true);
+			FCborWriter Writer(&Archive, ECborEndianness::StandardCompliant);
+			WriteCborObject(Writer, Message, RequestId);
+		}
+		FinishPrefixedFrame(Frame, EMCPEncoding::Cbor);
+		return Frame;
+	}
+
+	void BeginPrefixedFrame(TArray<uint8>& Frame)
+	{
+		// Payloads are encoded straight into the frame after a gap for the header, which is
+		// closed once the length is known; the payload is never copied into a second buffer
+		Frame.Reset();
+		Frame.AddUninitialized(MaxHeaderBytes);
+	}
+
+	// Fills the gap left by BeginPrefixedFrame with "$<length>:<tags>\n" and closes the rest of it
+	static void FillHeader(TArray<uint8>& Frame, const ANSICHAR* Tags)
+	{
+		const int32 PayloadLength = Frame.Num() - MaxHeaderBytes;
+		ANSICHAR Header[MaxHeaderBytes];
+		const int32 HeaderLength = FCStringAnsi::Snprintf(Header, MaxHeaderBytes, "$%d:%s\n", PayloadLength, Tags);
+		check(HeaderLength > 0 && HeaderLength < MaxHeaderBytes);
+
+		const int32 HeaderStart = MaxHeaderBytes - HeaderLength;
+		FMemory::Memcpy(Frame.GetData() + HeaderStart, Header, HeaderLength);
+		Frame.RemoveAt(0, HeaderStart, EAllowShrinking::No);
+	}
+
+	void FinishPrefixedFrame(TArray<uint8>& Frame, EMCPEncoding Encoding, const ANSICHAR* ExtraTags)
+	{
+		ANSICHAR Tags[MaxHeaderBytes];
+		if (ExtraTags && *ExtraTags)
+		{
+			FCStringAnsi::Snprintf(Tags, MaxHeaderBytes, "%s:%s", TCHAR_TO_ANSI(ToString(Encoding)), ExtraTags);
+		}
+		else
+		{
+			FCStringAnsi::Strncpy(Tags, TCHAR_TO_ANSI(ToString(Encoding)), MaxHeaderBytes);
+		}
+		FillHeader(Frame, Tags);
+	}
+
+	bool CompressFrame(TArray<uint8>& Frame, EMCPCompression Compression, int32 MinPayloadBytes)
+	{
+		if (Compression != EMCPCompression::Zlib || Frame.Num() == 0)
+		{
+			return false;
+		}
+
+		// Find the payload and the tags that describe it; JSON lines become prefixed frames
+		ANSICHAR Tags[MaxHeaderBytes];
+		int32 PayloadStart = 0;
+		int32 PayloadEnd = Frame.Num();
+		if (Frame[0] == '$')
+		{
+			const int32 HeaderEnd = Frame.Find('\n');
+			if (HeaderEnd == INDEX_NONE)
+			{
+				return false;
+			}
+
+			int32 TagStart = 1;
+			while (TagStart < HeaderEnd && Frame[TagStart] != ':')
+			{
+				++TagStart;
+			}
+
+			const int32 TagLength = HeaderEnd - TagStart - 1;
+			if (TagLength <= 0 || TagLength + 6 >= MaxHeaderBytes)
+			{
+				return false;
+			}
+			FMemory::Memcpy(Tags, Frame.GetData() + TagStart + 1, TagLength);
+			Tags[TagLength] = '\0';
+			PayloadStart = HeaderEnd + 1;
+		}
+		else
+		{
+			FCStringAnsi::Strncpy(Tags, "json", MaxHeaderBytes);
+			if (Frame.Last() == '\n')
+			{
+				--PayloadEnd;
+			}
+		}
+
+		const int32 PayloadLength = PayloadEnd - PayloadStart;
+		if (PayloadLength < MinPayloadBytes)
+		{
+			return false;
+		}
+
+		const int32 Bound = FCompression::CompressMemoryBound(NAME_Zlib, PayloadLength);
+		TArray<uint8> Compressed = FMCPBufferPool::Get().Acquire();
+		BeginPrefixedFrame(Compressed);
+		Compressed.AddUninitialized(Bound);
+
+		int32 CompressedLength = Bound;
+		if (!FCompression::CompressMemory(NAME_Zlib, Compressed.GetData() + MaxHeaderBytes, CompressedLength, Frame.GetData() + PayloadStart, PayloadLength)
+			|| CompressedLength >= PayloadLength)
+		{
+			// Incompressible payloads go out as they are
+			FMCPBufferPool::Get().Release(MoveTemp(Compressed));
+			return false;
+		}
+
+		Compressed.SetNum(MaxHeaderBytes + CompressedLength, EAllowShrinking::No);
+		FCStringAnsi::Strncat(Tags, ":zlib", MaxHeaderBytes);
+		FillHeader(Compressed, Tags);
+
+		FMCPBufferPool::Get().Release(MoveTemp(Frame));
+		Frame = MoveTemp(Compressed);
+		return true;
+	}
+
+	const TCHAR* ToString(EMCPCompression Compression)
+	{
+		switch (Compression)
+		{
+		case EMCPCompression::None: return TEXT("none");
+		case EMCPCompression::Zlib: return TEXT("zlib");
+		}
+		return TEXT("none");
+	}
+
+	bool FromString(const FString& Name, EMCPCompression& OutCompression)
+	{
+		if (Name.Equals(TEXT("none"), ESearchCase::IgnoreCase))
+		{
+			OutCompression = EMCPCompression::None;
+			return true;
+		}
+		// zlib is deflate with a small header and checksum; accept either name
+		if (Name.Equals(TEXT("zlib"), ESearchCase::IgnoreCase) || Name.Equals(TEXT("deflate"), ESearchCase::IgnoreCase))
+		{
+			OutCompression = EMCPCompression::Zlib;
+			return true;
+		}
+		return false;
+	}
+
+	const TCHAR* ToString(EMCPEncoding Encoding)
+	{
+		switch (Encoding)
+		{
+		case EMCPEncoding::Json: return TEXT("json");
+		case EMCPEncoding::Cbor: return TEXT("cbor");
+		}
+		return TEXT("json");
+	}
+
+	bool FromString(const FString& Name, EMCPEncoding& OutEncoding)
+	{
+		if (Name.Equals(TEXT("json"), ESearchCase::IgnoreCase))
+		{
+			OutEncoding = EMCPEncoding::Json;
+			return true;
+		}
+		if (Name.Equals(TEXT("cbor"), ESearchCase::IgnoreCase))
+		{
+			OutEncoding = EMCPEncoding::Cbor;
+			return true;
+		}
+		return false;
+	}
+
+	TArray<uint8> EncodeFrame(EMCPEncoding Encoding, const TSharedPtr<FJsonValue>& RequestId, const TSharedRef<FJsonObject>& Message)
+	{
+		if (Encoding == EMCPEncoding::Cbor)
+		{
+			return EncodeCborFrame(RequestId, *Message);
+		}
+
+		FString Response;
+		TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+			TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&Response);
+		FJsonSerializer::Serialize(Message, Writer);
+		return EncodeJsonFrame(RequestId, Response);
+	}
+
+	TArray<uint8> EncodeJsonFrame(const TSharedPtr<FJsonValue>& RequestId, const FString& Response)
+	{
+		// Splice the request id into the already-serialized response object instead of
+		// rebuilding it: {"id":<id>,"success":...}
+		FString Framed;
+		if (RequestId.IsValid() && Response.StartsWith(TEXT("{")))
+		{
+			// The id is echoed exactly as the client sent it, whatever its JSON type. The writer
+			// escapes control characters, which would otherwise split the newline-delimited frame.
+			TSharedRef<FJsonObject> IdObject = MakeShared<FJsonObject>();
+			IdObject->SetField(TEXT("id"), RequestId);
+			FString IdPrefix;
+			TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer =
+				TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&IdPrefix);
+			FJsonSerializer::Serialize(IdObject, Writer);
+			IdPrefix.LeftChopInline(1); // drop the closing brace: {"id":<id>
+
+			Framed.Reserve(Response.Len() + IdPrefix.Len() + 2);
+			Framed += IdPrefix;
+			Framed += Response.Len() > 2 ? TEXT(",") : TEXT("");
+			Framed += Response.Mid(1);
+		}
+		else
+		{
+			Framed = Response;
+		}
+		Framed += TEXT("\n");
+
+		FTCHARToUTF8 Converter(*Framed);
+		return TArray<uint8>(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+	}
+}
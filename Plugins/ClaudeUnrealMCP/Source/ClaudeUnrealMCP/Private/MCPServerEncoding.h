@@ -0,0 +1,50 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "MCPServerConnection.h"
+
+/**
+ * Serializes outgoing messages in a connection's encoding.
+ *
+ * JSON frames are a condensed document followed by a newline. Binary frames are
+ * length-prefixed with the encoding named in the header:
+ *
+ *     $<payload byte count>:cbor\n<payload>
+ *
+ * JSON may use the same framing (":json"). A response split into chunks carries
+ * "chunk=<stream>" after the encoding, and ":last" on its final chunk; the payloads of
+ * one stream concatenated form the message. A ":zlib" tag means the frame's own payload
+ * is compressed; it is inflated before anything else (including chunk joining).
+ *
+ * A request id, when present, becomes the first "id" member of the message.
+ */
+namespace MCPEncoding
+{
+	const TCHAR* ToString(EMCPEncoding Encoding);
+	bool FromString(const FString& Name, EMCPEncoding& OutEncoding);
+
+	/** Encode Message as one complete frame, ready for the reactor. */
+	TArray<uint8> EncodeFrame(EMCPEncoding Encoding, const TSharedPtr<FJsonValue>& RequestId, const TSharedRef<FJsonObject>& Message);
+
+	/** Wrap an already-serialized JSON response in a JSON frame, splicing in the request id. */
+	TArray<uint8> EncodeJsonFrame(const TSharedPtr<FJsonValue>& RequestId, const FString& Response);
+
+	/**
+	 * For encoders writing a payload directly into a length-prefixed frame: BeginPrefixedFrame
+	 * leaves room for the header, the payload is appended after it, and FinishPrefixedFrame
+	 * fills the header in. ExtraTags (e.g. "chunk=3") follow the encoding in the header.
+	 */
+	void BeginPrefixedFrame(TArray<uint8>& Frame);
+	void FinishPrefixedFrame(TArray<uint8>& Frame, EMCPEncoding Encoding, const ANSICHAR* ExtraTags = nullptr);
+
+	const TCHAR* ToString(EMCPCompression Compression);
+	bool FromString(const FString& Name, EMCPCompression& OutCompression);
+
+	/**
+	 * Compress a complete frame in place when its payload is at least MinPayloadBytes and
+	 * shrinks. The result is always length-prefixed and gets a ":zlib" tag after the
+	 * frame's other tags. Returns false when the frame was left as it was.
+	 */
+	bool CompressFrame(TArray<uint8>& Frame, EMCPCompression Compression, int32 MinPayloadBytes);
+}
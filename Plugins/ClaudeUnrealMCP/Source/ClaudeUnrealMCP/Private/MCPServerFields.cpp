@@ -0,0 +1,184 @@
+#include "MCPServerFields.h"
+#include "UObject/UnrealType.h"
+
+namespace MCPFields
+{
+	static void SkipWhitespace(const FString& Text, int32& Pos)
+	{
+		while (Pos < Text.Len() && FChar::IsWhitespace(Text[Pos]))
+		{
+			++Pos;
+		}
+	}
+
+	static bool IsNameChar(TCHAR Char)
+	{
+		return FChar::IsAlnum(Char) || Char == TEXT('_');
+	}
+}
+
+bool FMCPFieldSelection::Init(const TSharedPtr<FJsonObject>& Params, FString& OutError)
+{
+	if (!Params.IsValid())
+	{
+		return true;
+	}
+
+	if (Params->HasField(TEXT("max_depth")))
+	{
+		int32 RequestedDepth = 0;
+		if (!Params->TryGetNumberField(TEXT("max_depth"), RequestedDepth) || RequestedDepth < 0)
+		{
+			OutError = TEXT("'max_depth' must be a non-negative number");
+			return false;
+		}
+		MaxDepth = RequestedDepth;
+	}
+
+	// A string list, or an array of them that read as one list
+	FString FieldsText;
+	const TArray<TSharedPtr<FJsonValue>>* FieldsArray = nullptr;
+	if (Params->TryGetArrayField(TEXT("fields"), FieldsArray))
+	{
+		for (const TSharedPtr<FJsonValue>& Value : *FieldsArray)
+		{
+			FString Item;
+			if (!Value.IsValid() || !Value->TryGetString(Item))
+			{
+				OutError = TEXT("'fields' must be a string or an array of strings");
+				return false;
+			}
+			if (!FieldsText.IsEmpty())
+			{
+				FieldsText += TEXT(',');
+			}
+			FieldsText += Item;
+		}
+	}
+	else if (Params->HasField(TEXT("fields")) && !Params->TryGetStringField(TEXT("fields"), FieldsText))
+	{
+		OutError = TEXT("'fields' must be a string or an array of strings");
+		return false;
+	}
+
+	if (FieldsText.TrimStartAndEnd().IsEmpty())
+	{
+		return true;
+	}
+
+	TSharedPtr<FNode> Root = MakeShared<FNode>();
+	int32 Pos = 0;
+	if (!ParseList(FieldsText, Pos, *Root, OutError))
+	{
+		return false;
+	}
+	if (Pos < FieldsText.Len())
+	{
+		OutError = FString::Printf(TEXT("Unexpected '%c' at %d in 'fields'"), FieldsText[Pos], Pos);
+		return false;
+	}
+	Node = Root;
+	return true;
+}
+
+bool FMCPFieldSelection::ParseList(const FString& Text, int32& Pos, FNode& Out, FString& OutError)
+{
+	// list := name [ '{' list '}' ] { ',' name [ '{' list '}' ] }
+	while (true)
+	{
+		MCPFields::SkipWhitespace(Text, Pos);
+		const int32 NameStart = Pos;
+		while (Pos < Text.Len() && MCPFields::IsNameChar(Text[Pos]))
+		{
+			++Pos;
+		}
+		if (Pos == NameStart)
+		{
+			OutError = FString::Printf(TEXT("Expected a field name at %d in 'fields'"), Pos);
+			return false;
+		}
+		const FString Name = Text.Mid(NameStart, Pos - NameStart);
+
+		TSharedPtr<FNode> Child;
+		MCPFields::SkipWhitespace(Text, Pos);
+		if (Pos < Text.Len() && Text[Pos] == TEXT('{'))
+		{
+			++Pos;
+			Child = MakeShared<FNode>();
+			if (!ParseList(Text, Pos, *Child, OutError))
+			{
+				return false;
+			}
+			if (Pos >= Text.Len() || Text[Pos] != TEXT('}'))
+			{
+				OutError = FString::Printf(TEXT("Missing '}' for '%s' in 'fields'"), *Name);
+				return false;
+			}
+			++Pos;
+			MCPFields::SkipWhitespace(Text, Pos);
+		}
+
+		// Naming a field twice merges the selections; a whole selection wins
+		TPair<FString, TSharedPtr<FNode>>* Existing = Out.Children.FindByPredicate(
+			[&Name](const TPair<FString, TSharedPtr<FNode>>& Pair) { return Pair.Key.Equals(Name, ESearchCase::IgnoreCase); });
+		if (Existing)
+		{
+			TSharedPtr<FNode>& ExistingChild = Existing->Value;
+			if (ExistingChild.IsValid() && Child.IsValid())
+			{
+				ExistingChild->Children.Append(Child->Children);
+			}
+			else
+			{
+				ExistingChild.Reset();
+			}
+		}
+		else
+		{
+			Out.Children.Emplace(Name, Child);
+		}
+
+		if (Pos < Text.Len() && Text[Pos] == TEXT(','))
+		{
+			++Pos;
+			continue;
+		}
+		return true;
+	}
+}
+
+const TPair<FString, TSharedPtr<FMCPFieldSelection::FNode>>* FMCPFieldSelection::FNode::Find(FStringView Field) const
+{
+	// Selections are a handful of names; a scan beats hashing
+	for (const TPair<FString, TSharedPtr<FNode>>& Child : Children)
+	{
+		if (FStringView(Child.Key).Equals(Field, ESearchCase::IgnoreCase))
+		{
+			return &Child;
+		}
+	}
+	return nullptr;
+}
+
+bool FMCPFieldSelection::Has(FStringView Field) const
+{
+	return !Node.IsValid() || Node->Find(Field) != nullptr;
+}
+
+FMCPFieldSelection FMCPFieldSelection::Nested(FStringView Field) const
+{
+	FMCPFieldSelection Result;
+	Result.MaxDepth = MaxDepth < 0 ? -1 : FMath::Max(MaxDepth - 1, 0);
+	if (Node.IsValid())
+	{
+		const TPair<FString, TSharedPtr<FNode>>* Child = Node->Find(Field);
+		Result.Node = Child ? Child->Value : nullptr;
+	}
+	return Result;
+}
+
+bool IsNestedProperty(const FProperty* Property)
+{
+	return Property->IsA<FStructProperty>() || Property->IsA<FArrayProperty>() ||
+		Property->IsA<FMapProperty>() || Property->IsA<FSetProperty>();
+}
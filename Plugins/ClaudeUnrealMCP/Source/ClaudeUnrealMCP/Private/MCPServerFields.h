@@ -0,0 +1,69 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+class FProperty;
+
+/**
+ * Which fields of each item a reader writes, from the "fields" and "max_depth" parameters.
+ *
+ * "fields" names the item's fields, with braces selecting inside a nested one:
+ * "id,class,pins{name,default_value},connections". A field named without braces comes whole;
+ * names are case-insensitive and unknown ones are ignored. It may also be an array of such
+ * lists. "max_depth" caps how many levels of objects and arrays below the item are written:
+ * 0 keeps only the item's own plain values. Without either parameter everything is selected.
+ *
+ * Handlers test a field before computing its value, so work nobody asked for (node titles,
+ * pin defaults, exported struct values) is never done.
+ *
+ *     FMCPFieldSelection Fields;
+ *     if (!Fields.Init(Params, Error)) return MakeError(Error);
+ *     if (Fields.Has(TEXT("title"))) { ... }
+ *     if (Fields.HasNested(TEXT("pins"))) { const FMCPFieldSelection PinFields = Fields.Nested(TEXT("pins")); ... }
+ *
+ * Safe to use from any thread.
+ */
+class FMCPFieldSelection
+{
+public:
+	/** Selects everything. */
+	FMCPFieldSelection() = default;
+
+	/** Reads "fields" and "max_depth". False, with OutError set, if either is malformed. */
+	bool Init(const TSharedPtr<FJsonObject>& Params, FString& OutError);
+
+	/** True when no field list applies at this level, so every field is selected. */
+	bool SelectsAll() const { return !Node.IsValid(); }
+
+	/** Whether a plain (string, number, bool) field is selected. */
+	bool Has(FStringView Field) const;
+
+	/** Whether an object or array field is selected and still within max_depth. */
+	bool HasNested(FStringView Field) const { return MaxDepth != 0 && Has(Field); }
+
+	/** The selection inside a nested field, one level deeper. Only meaningful once HasNested passed. */
+	FMCPFieldSelection Nested(FStringView Field) const;
+
+private:
+	struct FNode
+	{
+		// A null child selects that field whole
+		TArray<TPair<FString, TSharedPtr<FNode>>> Children;
+
+		const TPair<FString, TSharedPtr<FNode>>* Find(FStringView Field) const;
+	};
+
+	static bool ParseList(const FString& Text, int32& Pos, FNode& Out, FString& OutError);
+
+	// Null selects every field
+	TSharedPtr<const FNode> Node;
+	// Levels left below this one; negative is unlimited
+	int32 MaxDepth = -1;
+};
+
+/**
+ * Whether a property's value is nested data (a struct or container) rather than a plain value,
+ * for readers that export property values as text: such values count one level deep.
+ */
+bool IsNestedProperty(const FProperty* Property);
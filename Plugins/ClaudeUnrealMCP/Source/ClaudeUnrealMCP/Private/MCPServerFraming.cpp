@@ -0,0 +1,211 @@
+#include "MCPServerFraming.h"
+
+FMCPRingBuffer::FMCPRingBuffer(int32 InitialCapacity)
+{
+	const int32 Capacity = FMath::RoundUpToPowerOfTwo(FMath::Max(InitialCapacity, 1024));
+	Storage.SetNumUninitialized(Capacity);
+	Mask = Capacity - 1;
+}
+
+void FMCPRingBuffer::Grow(int32 MinFree)
+{
+	const int32 Used = Num();
+	const int64 Required = static_cast<int64>(Used) + MinFree;
+	int64 NewCapacity = Storage.Num();
+	while (NewCapacity < Required)
+	{
+		NewCapacity *= 2;
+	}
+	check(NewCapacity <= MAX_int32);
+
+	// Re-lay the live bytes out from index 0 in the new storage
+	TArray<uint8> NewStorage;
+	NewStorage.SetNumUninitialized(static_cast<int32>(NewCapacity));
+	TArray<uint8> Unused;
+	const TArrayView<const uint8> Live = Peek(Used, Unused);
+	FMemory::Memcpy(NewStorage.GetData(), Live.GetData(), Used);
+
+	Storage = MoveTemp(NewStorage);
+	Mask = NewCapacity - 1;
+	ReadPos = 0;
+	WritePos = Used;
+}
+
+TArrayView<uint8> FMCPRingBuffer::GetWriteRegion(int32 MinSize)
+{
+	if (Storage.Num() - Num() < MinSize)
+	{
+		Grow(MinSize);
+	}
+
+	const int32 Capacity = Storage.Num();
+	const int32 WriteIndex = static_cast<int32>(WritePos & Mask);
+	const int32 ReadIndex = static_cast<int32>(ReadPos & Mask);
+
+	// Free space runs to the end of storage, or up to the read index if the data has wrapped
+	const int32 End = (WriteIndex < ReadIndex) ? ReadIndex : Capacity;
+	return TArrayView<uint8>(Storage.GetData() + WriteIndex, End - WriteIndex);
+}
+
+void FMCPRingBuffer::CommitWrite(int32 Count)
+{
+	check(Count >= 0 && Num() + Count <= Storage.Num());
+	WritePos += Count;
+}
+
+int32 FMCPRingBuffer::Find(uint8 Byte, int32 StartOffset) const
+{
+	const int32 Used = Num();
+	const int32 Capacity = Storage.Num();
+	const uint8* Data = Storage.GetData();
+
+	int32 Offset = StartOffset;
+	while (Offset < Used)
+	{
+		// Scan one contiguous span at a time
+		const int32 Index = static_cast<int32>((ReadPos + Offset) & Mask);
+		const int32 SpanLength = FMath::Min(Used - Offset, Capacity - Index);
+		if (const void* Hit = memchr(Data + Index, Byte, SpanLength))
+		{
+			return Offset + static_cast<int32>(static_cast<const uint8*>(Hit) - (Data + Index));
+		}
+		Offset += SpanLength;
+	}
+
+	return INDEX_NONE;
+}
+
+TArrayView<const uint8> FMCPRingBuffer::Peek(int32 Count, TArray<uint8>& Scratch) const
+{
+	check(Count <= Num());
+
+	const int32 Capacity = Storage.Num();
+	const int32 ReadIndex = static_cast<int32>(ReadPos & Mask);
+	if (ReadIndex + Count <= Capacity)
+	{
+		return TArrayView<const uint8>(Storage.GetData() + ReadIndex, Count);
+	}
+
+	const int32 FirstPart = Capacity - ReadIndex;
+	Scratch.SetNumUninitialized(Count, EAllowShrinking::No);
+	FMemory::Memcpy(Scratch.GetData(), Storage.GetData() + ReadIndex, FirstPart);
+	FMemory::Memcpy(Scratch.GetData() + FirstPart, Storage.GetData(), Count - FirstPart);
+	return TArrayView<const uint8>(Scratch.GetData(), Count);
+}
+
+void FMCPRingBuffer::Consume(int32 Count)
+{
+	check(Count <= Num());
+	ReadPos += Count;
+
+	if (ReadPos == WritePos)
+	{
+		// Rewind when empty so the next Recv gets the largest contiguous region
+		Reset();
+	}
+}
+
+void FMCPRingBuffer::Reset()
+{
+	ReadPos = 0;
+	WritePos = 0;
+}
+
+FMCPFrameReader::EResult FMCPFrameReader::NextFrame(TArrayView<const uint8>& OutPayload, FString& OutError)
+{
+	if (PendingConsume > 0)
+	{
+		Buffer.Consume(PendingConsume);
+		PendingConsume = 0;
+		ScanOffset = 0;
+	}
+
+	// Skip blank lines between frames
+	while (ScanOffset == 0 && !Buffer.IsEmpty())
+	{
+		const uint8 First = Buffer[0];
+		if (First != '\n' && First != '\r' && First != ' ' && First != '\t')
+		{
+			break;
+		}
+		Buffer.Consume(1);
+	}
+
+	if (Buffer.IsEmpty())
+	{
+		return EResult::NeedMore;
+	}
+
+	if (Buffer[0] == '$')
+	{
+		// Length-prefixed frame: $<byte count>\n<payload>
+		static constexpr int32 MaxHeaderBytes = 16;
+
+		const int32 HeaderEnd = Buffer.Find('\n');
+		if (HeaderEnd == INDEX_NONE)
+		{
+			if (Buffer.Num() > MaxHeaderBytes)
+			{
+				OutError = TEXT("Malformed length prefix");
+				return EResult::Error;
+			}
+			return EResult::NeedMore;
+		}
+
+		int64 Length = 0;
+		int32 Digits = 0;
+		for (int32 Index = 1; Index < HeaderEnd; ++Index)
+		{
+			const uint8 Char = Buffer[Index];
+			if (Char == '\r' && Index == HeaderEnd - 1)
+			{
+				break;
+			}
+			if (Char < '0' || Char > '9' || ++Digits > 10)
+			{
+				OutError = TEXT("Malformed length prefix");
+				return EResult::Error;
+			}
+			Length = Length * 10 + (Char - '0');
+		}
+
+		if (Digits == 0 || Length > MaxFrameBytes)
+		{
+			OutError = FString::Printf(TEXT("Invalid frame length (limit is %d bytes)"), MaxFrameBytes);
+			return EResult::Error;
+		}
+
+		if (Buffer.Num() < HeaderEnd + 1 + Length)
+		{
+			return EResult::NeedMore;
+		}
+
+		Buffer.Consume(HeaderEnd + 1);
+		OutPayload = Buffer.Peek(static_cast<int32>(Length), Scratch);
+		PendingConsume = static_cast<int32>(Length);
+		return EResult::Frame;
+	}
+
+	// Newline-delimited frame; resume the scan where the previous partial read stopped
+	const int32 LineEnd = Buffer.Find('\n', ScanOffset);
+	if (LineEnd == INDEX_NONE)
+	{
+		ScanOffset = Buffer.Num();
+		if (Buffer.Num() > MaxFrameBytes)
+		{
+			OutError = FString::Printf(TEXT("Request exceeds %d bytes without a newline"), MaxFrameBytes);
+			return EResult::Error;
+		}
+		return EResult::NeedMore;
+	}
+
+	int32 Length = LineEnd;
+	if (Length > 0 && Buffer[Length - 1] == '\r')
+	{
+		--Length;
+	}
+
+	OutPayload = Buffer.Peek(Length, Scratch);
+	PendingConsume = LineEnd + 1;
+	return EResult::Frame;
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Growable byte ring buffer used for socket receive data.
+ *
+ * Data is written straight into free space (GetWriteRegion/CommitWrite) so Recv needs no
+ * scratch copy. Capacity is always a power of two and doubles when a write does not fit.
+ */
+class FMCPRingBuffer
+{
+public:
+	explicit FMCPRingBuffer(int32 InitialCapacity = 64 * 1024);
+
+	int32 Num() const { return static_cast<int32>(WritePos - ReadPos); }
+	bool IsEmpty() const { return WritePos == ReadPos; }
+
+	uint8 operator[](int32 Offset) const { return Storage[(ReadPos + Offset) & Mask]; }
+
+	/** Contiguous free space at the write position, growing the buffer to at least MinSize. */
+	TArrayView<uint8> GetWriteRegion(int32 MinSize);
+	void CommitWrite(int32 Count);
+
+	/** Offset of the first Byte at or after StartOffset, or INDEX_NONE. */
+	int32 Find(uint8 Byte, int32 StartOffset = 0) const;
+
+	/**
+	 * View of the first Count bytes. Points into the buffer when the bytes do not wrap;
+	 * otherwise they are copied into Scratch. Valid until the next write or Consume.
+	 */
+	TArrayView<const uint8> Peek(int32 Count, TArray<uint8>& Scratch) const;
+
+	void Consume(int32 Count);
+	void Reset();
+
+private:
+	void Grow(int32 MinFree);
+
+	TArray<uint8> Storage;
+	int64 ReadPos = 0;
+	int64 WritePos = 0;
+	int64 Mask = 0;
+};
+
+/**
+ * Splits a byte stream into request frames.
+ *
+ * Two framings are accepted on the same connection:
+ *   - newline-delimited:  <json>\n
+ *   - length-prefixed:    $<byte count>\n<payload>   (payload may contain newlines)
+ *
+ * Frames can arrive split across any number of reads; the reader keeps partial data
+ * until the frame is complete.
+ */
+class FMCPFrameReader
+{
+public:
+	enum class EResult : uint8
+	{
+		Frame,      // OutPayload holds one complete frame
+		NeedMore,   // Wait for more bytes
+		Error       // Stream is malformed or over the size limit; drop the connection
+	};
+
+	// Upper bound for a single request frame
+	static constexpr int32 MaxFrameBytes = 256 * 1024 * 1024;
+
+	FMCPRingBuffer& GetBuffer() { return Buffer; }
+	bool HasPartialFrame() const { return !Buffer.IsEmpty(); }
+
+	/**
+	 * Extract the next complete frame. OutPayload stays valid until the next call to
+	 * NextFrame or any write to the buffer.
+	 */
+	EResult NextFrame(TArrayView<const uint8>& OutPayload, FString& OutError);
+
+private:
+	FMCPRingBuffer Buffer;
+	TArray<uint8> Scratch;
+
+	// Frame consumed by the previous NextFrame call, released lazily so OutPayload stays valid
+	int32 PendingConsume = 0;
+
+	// Where to resume scanning for a newline so large frames are not rescanned on every read
+	int32 ScanOffset = 0;
+};
@@ -0,0 +1,262 @@
+#include "MCPServerGlob.h"
+#include "String/Find.h"
+
+namespace MCPGlob
+{
+	static TCHAR Fold(TCHAR Char, ESearchCase::Type SearchCase)
+	{
+		return SearchCase == ESearchCase::IgnoreCase ? FChar::ToLower(Char) : Char;
+	}
+}
+
+FMCPGlobPattern::FMCPGlobPattern()
+{
+	Steps.Add({ EStep::AnyString, 0 });
+}
+
+FMCPGlobPattern::FMCPGlobPattern(const FString& Pattern, EMCPGlobLiteral Literal, ESearchCase::Type InSearchCase)
+	: Source(Pattern)
+	, SearchCase(InSearchCase)
+{
+	bool bHasWildcard = false;
+	for (int32 Index = 0; Index < Pattern.Len(); ++Index)
+	{
+		TCHAR Char = Pattern[Index];
+		if (Char == TEXT('*'))
+		{
+			// Runs of '*' match the same as one
+			if (Steps.Num() == 0 || Steps.Last().Kind != EStep::AnyString)
+			{
+				Steps.Add({ EStep::AnyString, 0 });
+			}
+			bHasWildcard = true;
+		}
+		else if (Char == TEXT('?'))
+		{
+			Steps.Add({ EStep::AnyChar, 0 });
+			bHasWildcard = true;
+		}
+		else if (Char == TEXT('[') && ParseClass(Pattern, Index))
+		{
+			bHasWildcard = true;
+		}
+		else
+		{
+			if (Char == TEXT('\\') && Index + 1 < Pattern.Len())
+			{
+				Char = Pattern[++Index];
+			}
+			Steps.Add({ EStep::Char, int32(MCPGlob::Fold(Char, SearchCase)) });
+		}
+	}
+
+	if (!bHasWildcard && Steps.Num() > 0)
+	{
+		if (Literal == EMCPGlobLiteral::Substring)
+		{
+			Steps.Insert({ EStep::AnyString, 0 }, 0);
+		}
+		if (Literal == EMCPGlobLiteral::Prefix || Literal == EMCPGlobLiteral::Substring)
+		{
+			Steps.Add({ EStep::AnyString, 0 });
+		}
+	}
+
+	// An empty filter is no filter
+	if (Steps.Num() == 0 && Literal != EMCPGlobLiteral::Exact)
+	{
+		Steps.Add({ EStep::AnyString, 0 });
+	}
+
+	Classify();
+}
+
+bool FMCPGlobPattern::Matches(FStringView Input) const
+{
+	switch (Shape)
+	{
+	case EShape::All:
+		return true;
+	case EShape::Exact:
+		return Input.Equals(Text, SearchCase);
+	case EShape::Prefix:
+		return Input.StartsWith(Text, SearchCase);
+	case EShape::Suffix:
+		return Input.EndsWith(Text, SearchCase);
+	case EShape::Contains:
+		return UE::String::FindFirst(Input, Text, SearchCase) != INDEX_NONE;
+	default:
+		return MatchesGeneral(Input);
+	}
+}
+
+FString FMCPGlobPattern::GetLiteralPrefix() const
+{
+	FString Prefix;
+	for (const FStep& Step : Steps)
+	{
+		if (Step.Kind != EStep::Char)
+		{
+			break;
+		}
+		Prefix.AppendChar(TCHAR(Step.Value));
+	}
+	return Prefix;
+}
+
+bool FMCPGlobPattern::ParseClass(const FString& Pattern, int32& InOutIndex)
+{
+	FCharClass Class;
+	int32 Index = InOutIndex + 1;
+	if (Index < Pattern.Len() && (Pattern[Index] == TEXT('!') || Pattern[Index] == TEXT('^')))
+	{
+		Class.bNegated = true;
+		++Index;
+	}
+
+	// A ']' right after the opening bracket is a member, not the end
+	const int32 First = Index;
+	for (; Index < Pattern.Len(); ++Index)
+	{
+		TCHAR Low = Pattern[Index];
+		if (Low == TEXT(']') && Index > First)
+		{
+			InOutIndex = Index;
+			Steps.Add({ EStep::Class, Classes.Add(MoveTemp(Class)) });
+			return true;
+		}
+		if (Low == TEXT('\\') && Index + 1 < Pattern.Len())
+		{
+			Low = Pattern[++Index];
+		}
+
+		TCHAR High = Low;
+		if (Index + 2 < Pattern.Len() && Pattern[Index + 1] == TEXT('-') && Pattern[Index + 2] != TEXT(']'))
+		{
+			Index += 2;
+			High = Pattern[Index];
+			if (High == TEXT('\\') && Index + 1 < Pattern.Len())
+			{
+				High = Pattern[++Index];
+			}
+		}
+		Class.Ranges.Emplace(FMath::Min(Low, High), FMath::Max(Low, High));
+	}
+
+	// Unterminated; the caller takes '[' literally
+	return false;
+}
+
+void FMCPGlobPattern::Classify()
+{
+	int32 Begin = 0;
+	int32 End = Steps.Num();
+	const bool bLeadingStar = End > 0 && Steps[0].Kind == EStep::AnyString;
+	const bool bTrailingStar = End > int32(bLeadingStar) && Steps.Last().Kind == EStep::AnyString;
+	Begin += int32(bLeadingStar);
+	End -= int32(bTrailingStar);
+
+	for (int32 Index = Begin; Index < End; ++Index)
+	{
+		if (Steps[Index].Kind != EStep::Char)
+		{
+			Shape = EShape::General;
+			return;
+		}
+	}
+
+	Text.Reset(End - Begin);
+	for (int32 Index = Begin; Index < End; ++Index)
+	{
+		Text.AppendChar(TCHAR(Steps[Index].Value));
+	}
+
+	if (bLeadingStar && (bTrailingStar || Text.IsEmpty()))
+	{
+		Shape = Text.IsEmpty() ? EShape::All : EShape::Contains;
+	}
+	else if (bLeadingStar)
+	{
+		Shape = EShape::Suffix;
+	}
+	else if (bTrailingStar)
+	{
+		Shape = EShape::Prefix;
+	}
+	else
+	{
+		Shape = EShape::Exact;
+	}
+}
+
+bool FMCPGlobPattern::MatchesGeneral(FStringView Input) const
+{
+	// Only the most recent '*' needs a backtrack point: whatever an earlier one could
+	// still absorb, the later one can absorb just as well
+	int32 StepIndex = 0;
+	int32 InputIndex = 0;
+	int32 StarStep = INDEX_NONE;
+	int32 StarInput = 0;
+	while (InputIndex < Input.Len())
+	{
+		if (StepIndex < Steps.Num() && Steps[StepIndex].Kind == EStep::AnyString)
+		{
+			StarStep = StepIndex++;
+			StarInput = InputIndex;
+		}
+		else if (StepIndex < Steps.Num() && MatchesStep(Steps[StepIndex], Input[InputIndex]))
+		{
+			++StepIndex;
+			++InputIndex;
+		}
+		else if (StarStep != INDEX_NONE)
+		{
+			StepIndex = StarStep + 1;
+			InputIndex = ++StarInput;
+		}
+		else
+		{
+			return false;
+		}
+	}
+
+	while (StepIndex < Steps.Num() && Steps[StepIndex].Kind == EStep::AnyString)
+	{
+		++StepIndex;
+	}
+	return StepIndex == Steps.Num();
+}
+
+bool FMCPGlobPattern::MatchesStep(const FStep& Step, TCHAR Char) const
+{
+	switch (Step.Kind)
+	{
+	case EStep::Char:
+		return TCHAR(Step.Value) == MCPGlob::Fold(Char, SearchCase);
+	case EStep::AnyChar:
+		return true;
+	case EStep::Class:
+	{
+		const FCharClass& Class = Classes[Step.Value];
+		auto InRanges = [&Class](TCHAR Candidate)
+		{
+			for (const TPair<TCHAR, TCHAR>& Range : Class.Ranges)
+			{
+				if (Candidate >= Range.Key && Candidate <= Range.Value)
+				{
+					return true;
+				}
+			}
+			return false;
+		};
+		bool bIn = InRanges(Char);
+		if (!bIn && SearchCase == ESearchCase::IgnoreCase)
+		{
+			bIn = InRanges(FChar::ToLower(Char)) || InRanges(FChar::ToUpper(Char));
+		}
+		return bIn != Class.bNegated;
+	}
+	default:
+		return false;
+	}
+}
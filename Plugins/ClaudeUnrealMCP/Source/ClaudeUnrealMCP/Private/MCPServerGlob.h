@@ -0,0 +1,104 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/StringView.h"
+
+/** How a pattern without any wildcard is compared, so plain strings keep each command's old meaning. */
+enum class EMCPGlobLiteral : uint8
+{
+	// The whole text must equal the pattern
+	Exact,
+
+	// The text must start with the pattern (package path filters)
+	Prefix,
+
+	// The pattern may appear anywhere in the text
+	Substring
+};
+
+/**
+ * Name pattern shared by the listing and search commands, compiled once and matched many times.
+ *
+ * Syntax: '*' matches any run of characters (including '/'), '?' any single character,
+ * "[abc]" / "[a-z]" one character of a set, "[!abc]" or "[^abc]" one character not in it, and
+ * '\' makes the next character literal. A '[' without a closing ']' is literal. Matching is
+ * case-insensitive by default.
+ *
+ * Patterns that reduce to plain text, a prefix, a suffix or a substring are matched with a
+ * single string comparison. Everything else runs through a flat list of single-character
+ * steps with one backtrack point for the last '*', so a match never takes more than
+ * pattern length times text length steps. Safe to use from any thread.
+ */
+class FMCPGlobPattern
+{
+public:
+	/** Matches everything. */
+	FMCPGlobPattern();
+
+	explicit FMCPGlobPattern(const FString& Pattern, EMCPGlobLiteral Literal = EMCPGlobLiteral::Exact,
+		ESearchCase::Type InSearchCase = ESearchCase::IgnoreCase);
+
+	bool Matches(FStringView Text) const;
+
+	/** True if every text matches, e.g. for an empty filter or "*". */
+	bool IsMatchAll() const { return Shape == EShape::All; }
+
+	/** The text a match must equal, if the pattern has no wildcards; lets callers use a hash lookup instead. */
+	const FString* GetExactText() const { return Shape == EShape::Exact ? &Text : nullptr; }
+
+	/**
+	 * The literal text every match starts with, up to the first wildcard; empty if a match can
+	 * start with anything. Case-folded unless the pattern is case-sensitive.
+	 */
+	FString GetLiteralPrefix() const;
+
+	/** The pattern as given. */
+	const FString& GetSource() const { return Source; }
+
+private:
+	enum class EShape : uint8
+	{
+		All,
+		Exact,
+		Prefix,
+		Suffix,
+		Contains,
+		General
+	};
+
+	enum class EStep : uint8
+	{
+		Char,
+		AnyChar,
+		AnyString,
+		Class
+	};
+
+	struct FStep
+	{
+		EStep Kind = EStep::Char;
+		// Case-folded character for Char, index into Classes for Class
+		int32 Value = 0;
+	};
+
+	struct FCharClass
+	{
+		TArray<TPair<TCHAR, TCHAR>, TInlineAllocator<4>> Ranges;
+		bool bNegated = false;
+	};
+
+	bool ParseClass(const FString& Pattern, int32& InOutIndex);
+	void Classify();
+	bool MatchesGeneral(FStringView Input) const;
+	bool MatchesStep(const FStep& Step, TCHAR Char) const;
+
+	FString Source;
+	ESearchCase::Type SearchCase = ESearchCase::IgnoreCase;
+	EShape Shape = EShape::All;
+
+	// Literal characters of the Exact/Prefix/Suffix/Contains shapes, case-folded unless case-sensitive
+	FString Text;
+
+	TArray<FStep> Steps;
+	TArray<FCharClass> Classes;
+};
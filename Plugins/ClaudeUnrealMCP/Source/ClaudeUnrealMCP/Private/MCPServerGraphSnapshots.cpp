@@ -0,0 +1,343 @@
+#include "MCPServerGraphSnapshots.h"
+#include "Algo/BinarySearch.h"
+#include "Editor.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "K2Node_Event.h"
+#include "K2Node_CallFunction.h"
+#include "K2Node_VariableGet.h"
+#include "K2Node_VariableSet.h"
+#include "Hash/xxhash.h"
+#include "UObject/Package.h"
+
+namespace MCPGraphSnapshots
+{
+	struct FNodeHasher
+	{
+		FXxHash64Builder Builder;
+
+		void Add(const void* Data, uint64 Size) { Builder.Update(Data, Size); }
+		void Add(uint32 Value) { Add(&Value, sizeof(Value)); }
+		void Add(const FGuid& Guid) { Add(&Guid, sizeof(Guid)); }
+		// Names are hashed by identity; snapshots never outlive the editor session
+		void Add(FName Name)
+		{
+			Add(Name.GetDisplayIndex().ToUnstableInt());
+			Add(uint32(Name.GetNumber()));
+		}
+		// Length first so adjacent strings cannot run into each other
+		void Add(const FString& String)
+		{
+			Add(uint32(String.Len()));
+			Add(*String, String.Len() * sizeof(TCHAR));
+		}
+		void Add(const UObject* Object) { Add(Object ? Object->GetPathName() : FString()); }
+	};
+
+	// Covers what the graph readers write for a node, except the title, which is costly to
+	// build and follows from the rest
+	static uint64 HashNode(UEdGraphNode* Node)
+	{
+		FNodeHasher Hasher;
+		Hasher.Add(Node->GetClass());
+
+		if (UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
+		{
+			Hasher.Add(EventNode->GetFunctionName());
+		}
+		else if (UK2Node_CallFunction* FuncNode = Cast<UK2Node_CallFunction>(Node))
+		{
+			Hasher.Add(FuncNode->GetFunctionName());
+		}
+		else if (UK2Node_VariableGet* GetNode = Cast<UK2Node_VariableGet>(Node))
+		{
+			Hasher.Add(GetNode->GetVarName());
+		}
+		else if (UK2Node_VariableSet* SetNode = Cast<UK2Node_VariableSet>(Node))
+		{
+			Hasher.Add(SetNode->GetVarName());
+		}
+
+		// Property access path
+		if (FTextProperty* TextPathProp = CastField<FTextProperty>(Node->GetClass()->FindPropertyByName(TEXT("TextPath"))))
+		{
+			Hasher.Add(TextPathProp->GetPropertyValue_InContainer(Node).ToString());
+		}
+
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (!Pin) continue;
+
+			Hasher.Add(Pin->PinName);
+			Hasher.Add(uint32(Pin->Direction));
+
+			const FEdGraphPinType& PinType = Pin->PinType;
+			Hasher.Add(PinType.PinCategory);
+			Hasher.Add(PinType.PinSubCategory);
+			Hasher.Add(PinType.PinSubCategoryObject.Get());
+			Hasher.Add(uint32(PinType.ContainerType) | uint32(PinType.bIsReference) << 8 | uint32(PinType.bIsConst) << 9);
+
+			Hasher.Add(Pin->DefaultValue);
+			Hasher.Add(Pin->DefaultTextValue.ToString());
+			Hasher.Add(Pin->DefaultObject);
+
+			Hasher.Add(uint32(Pin->LinkedTo.Num()));
+			for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				if (LinkedPin && LinkedPin->GetOwningNode())
+				{
+					Hasher.Add(LinkedPin->GetOwningNode()->NodeGuid);
+					Hasher.Add(LinkedPin->PinName);
+				}
+			}
+		}
+
+		return Hasher.Builder.Finalize().Hash;
+	}
+}
+
+FMCPGraphSnapshotCache::FMCPGraphSnapshotCache()
+	// Low bits count snapshots within a second; leaves versions well inside a JSON number's exact range
+	: LastVersion(FDateTime::UtcNow().ToUnixTimestamp() << 16)
+{
+	PackageMarkedDirtyHandle = UPackage::PackageMarkedDirtyEvent.AddRaw(this, &FMCPGraphSnapshotCache::OnPackageMarkedDirty);
+}
+
+FMCPGraphSnapshotCache::~FMCPGraphSnapshotCache()
+{
+	UPackage::PackageMarkedDirtyEvent.Remove(PackageMarkedDirtyHandle);
+	if (GEditor && BlueprintCompiledHandle.IsValid())
+	{
+		GEditor->OnBlueprintCompiled().Remove(BlueprintCompiledHandle);
+	}
+
+	for (TPair<TObjectKey<UEdGraph>, FGraphEntry>& Pair : Entries)
+	{
+		if (UEdGraph* Graph = Pair.Value.Graph.Get())
+		{
+			Graph->RemoveOnGraphChangedHandler(Pair.Value.GraphChangedHandle);
+		}
+	}
+}
+
+int64 FMCPGraphSnapshotCache::GetVersion(UEdGraph* Graph)
+{
+	return Refresh(Graph).Snapshots.Last().Version;
+}
+
+bool FMCPGraphSnapshotCache::GetDelta(UEdGraph* Graph, int64 SinceVersion, FMCPGraphDelta& OutDelta)
+{
+	const FGraphEntry& Entry = Refresh(Graph);
+	const FSnapshot& Current = Entry.Snapshots.Last();
+
+	// The graph looked like the newest snapshot taken at or before SinceVersion; none means the
+	// version predates what is kept for this graph
+	const FSnapshot* Base = nullptr;
+	for (int32 Index = Entry.Snapshots.Num() - 1; Index >= 0; --Index)
+	{
+		if (Entry.Snapshots[Index].Version <= SinceVersion)
+		{
+			Base = &Entry.Snapshots[Index];
+			break;
+		}
+	}
+	if (!Base)
+	{
+		return false;
+	}
+
+	OutDelta.Version = Current.Version;
+	if (Base == &Current)
+	{
+		return true;
+	}
+
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (!Node) continue;
+
+		const uint64* OldHash = Base->NodeHashes.Find(Node->NodeGuid);
+		const uint64* NewHash = Current.NodeHashes.Find(Node->NodeGuid);
+		if (!OldHash || (NewHash && *NewHash != *OldHash))
+		{
+			OutDelta.ChangedNodes.Add(Node);
+		}
+	}
+	for (const TPair<FGuid, uint64>& Pair : Base->NodeHashes)
+	{
+		if (!Current.NodeHashes.Contains(Pair.Key))
+		{
+			OutDelta.RemovedNodes.Add(Pair.Key);
+		}
+	}
+
+	for (const FMCPGraphLink& Link : Current.Links)
+	{
+		if (!Base->Links.Contains(Link))
+		{
+			OutDelta.AddedLinks.Add(Link);
+		}
+	}
+	for (const FMCPGraphLink& Link : Base->Links)
+	{
+		if (!Current.Links.Contains(Link))
+		{
+			OutDelta.RemovedLinks.Add(Link);
+		}
+	}
+	return true;
+}
+
+TArray<UEdGraphNode*> FMCPGraphSnapshotCache::GetNodesInIdOrder(UEdGraph* Graph, const FGuid* AfterNode, int32 MaxCount)
+{
+	FGraphEntry& Entry = Refresh(Graph);
+
+	// Adding or removing a node changes the node hashes, so an unchanged version means an unchanged node set
+	const int64 Version = Entry.Snapshots.Last().Version;
+	if (Entry.NodeOrderVersion != Version)
+	{
+		Entry.NodeOrder.Reset(Graph->Nodes.Num());
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (Node)
+			{
+				Entry.NodeOrder.Add({ Node->NodeGuid, Node });
+			}
+		}
+		Entry.NodeOrder.Sort([](const TPair<FGuid, TWeakObjectPtr<UEdGraphNode>>& A, const TPair<FGuid, TWeakObjectPtr<UEdGraphNode>>& B)
+		{
+			return A.Key < B.Key;
+		});
+		Entry.NodeOrderVersion = Version;
+	}
+
+	int32 Position = AfterNode ? Algo::UpperBoundBy(Entry.NodeOrder, *AfterNode,
+		[](const TPair<FGuid, TWeakObjectPtr<UEdGraphNode>>& Pair) { return Pair.Key; }) : 0;
+
+	TArray<UEdGraphNode*> Nodes;
+	for (; Position < Entry.NodeOrder.Num() && Nodes.Num() < MaxCount; ++Position)
+	{
+		if (UEdGraphNode* Node = Entry.NodeOrder[Position].Value.Get())
+		{
+			Nodes.Add(Node);
+		}
+	}
+	return Nodes;
+}
+
+FMCPGraphSnapshotCache::FGraphEntry& FMCPGraphSnapshotCache::Refresh(UEdGraph* Graph)
+{
+	BindDelegates();
+
+	FGraphEntry* Entry = Entries.Find(Graph);
+	if (!Entry)
+	{
+		RemoveDeadEntries();
+		Entry = &Entries.Add(Graph);
+		Entry->Graph = Graph;
+		Entry->GraphChangedHandle = Graph->AddOnGraphChangedHandler(
+			FOnGraphChanged::FDelegate::CreateRaw(this, &FMCPGraphSnapshotCache::OnGraphChanged));
+	}
+
+	const uint32 Generation = GetGeneration(Graph);
+	if (Entry->Snapshots.Num() > 0 && !Entry->bStale && Entry->Generation == Generation)
+	{
+		return *Entry;
+	}
+	Entry->bStale = false;
+	Entry->Generation = Generation;
+
+	FSnapshot Snapshot = TakeSnapshot(Graph);
+	if (Entry->Snapshots.Num() > 0)
+	{
+		const FSnapshot& Previous = Entry->Snapshots.Last();
+		if (Previous.NodeHashes.OrderIndependentCompareEqual(Snapshot.NodeHashes) &&
+			Previous.Links.Num() == Snapshot.Links.Num() && Previous.Links.Includes(Snapshot.Links))
+		{
+			// Notified, but nothing the readers show changed
+			return *Entry;
+		}
+	}
+
+	Snapshot.Version = ++LastVersion;
+	if (Entry->Snapshots.Num() == MaxSnapshotsPerGraph)
+	{
+		Entry->Snapshots.RemoveAt(0);
+	}
+	Entry->Snapshots.Add(MoveTemp(Snapshot));
+	return *Entry;
+}
+
+FMCPGraphSnapshotCache::FSnapshot FMCPGraphSnapshotCache::TakeSnapshot(UEdGraph* Graph) const
+{
+	FSnapshot Snapshot;
+	Snapshot.NodeHashes.Reserve(Graph->Nodes.Num());
+	for (UEdGraphNode* Node : Graph->Nodes)
+	{
+		if (!Node) continue;
+
+		Snapshot.NodeHashes.Add(Node->NodeGuid, MCPGraphSnapshots::HashNode(Node));
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (!Pin || Pin->Direction != EGPD_Output) continue;
+
+			for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				if (LinkedPin && LinkedPin->GetOwningNode())
+				{
+					Snapshot.Links.Add({ Node->NodeGuid, Pin->PinName, LinkedPin->GetOwningNode()->NodeGuid, LinkedPin->PinName });
+				}
+			}
+		}
+	}
+	return Snapshot;
+}
+
+uint32 FMCPGraphSnapshotCache::GetGeneration(UEdGraph* Graph) const
+{
+	// Both counters only grow, so the sum changes whenever either does
+	return CompileGeneration + PackageGenerations.FindRef(Graph->GetOutermost()->GetFName());
+}
+
+void FMCPGraphSnapshotCache::RemoveDeadEntries()
+{
+	for (auto It = Entries.CreateIterator(); It; ++It)
+	{
+		if (!It->Value.Graph.IsValid())
+		{
+			It.RemoveCurrent();
+		}
+	}
+}
+
+void FMCPGraphSnapshotCache::BindDelegates()
+{
+	// GEditor may not exist yet when the server starts
+	if (!BlueprintCompiledHandle.IsValid() && GEditor)
+	{
+		BlueprintCompiledHandle = GEditor->OnBlueprintCompiled().AddRaw(this, &FMCPGraphSnapshotCache::OnBlueprintCompiled);
+	}
+}
+
+void FMCPGraphSnapshotCache::OnGraphChanged(const FEdGraphEditAction& Action)
+{
+	if (FGraphEntry* Entry = Action.Graph ? Entries.Find(Action.Graph) : nullptr)
+	{
+		Entry->bStale = true;
+	}
+}
+
+void FMCPGraphSnapshotCache::OnPackageMarkedDirty(UPackage* Package, bool bWasDirty)
+{
+	if (Package)
+	{
+		++PackageGenerations.FindOrAdd(Package->GetFName());
+	}
+}
+
+void FMCPGraphSnapshotCache::OnBlueprintCompiled()
+{
+	// Compiling reconstructs nodes, which can change pins without dirtying anything
+	++CompileGeneration;
+}
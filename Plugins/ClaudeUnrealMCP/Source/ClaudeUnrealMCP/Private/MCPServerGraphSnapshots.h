@@ -0,0 +1,128 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UBlueprint;
+class UEdGraph;
+class UEdGraphNode;
+class UPackage;
+struct FEdGraphEditAction;
+
+/** One pin-to-pin link, output side first. */
+struct FMCPGraphLink
+{
+	FGuid FromNode;
+	FName FromPin;
+	FGuid ToNode;
+	FName ToPin;
+
+	bool operator==(const FMCPGraphLink& Other) const
+	{
+		return FromNode == Other.FromNode && FromPin == Other.FromPin && ToNode == Other.ToNode && ToPin == Other.ToPin;
+	}
+
+	friend uint32 GetTypeHash(const FMCPGraphLink& Link)
+	{
+		return HashCombineFast(HashCombineFast(GetTypeHash(Link.FromNode), GetTypeHash(Link.FromPin)),
+			HashCombineFast(GetTypeHash(Link.ToNode), GetTypeHash(Link.ToPin)));
+	}
+};
+
+/** What changed in a graph between an earlier snapshot version and now. */
+struct FMCPGraphDelta
+{
+	int64 Version = 0;
+
+	// Added or changed nodes, in graph order
+	TArray<UEdGraphNode*> ChangedNodes;
+	TArray<FGuid> RemovedNodes;
+	TArray<FMCPGraphLink> AddedLinks;
+	TArray<FMCPGraphLink> RemovedLinks;
+};
+
+/**
+ * Structural snapshots of the graphs the graph readers have returned, so a client can ask
+ * for only what changed since its last read.
+ *
+ * A snapshot holds a content hash per node (what the readers write for it, minus the title)
+ * and the set of links. Graphs are hashed again only after a change notification: the
+ * graph's own change event, its package being marked dirty, or any blueprint compile. A new
+ * snapshot gets a version only if its content differs from the previous one. Versions come
+ * from one counter seeded from the clock, so the newest version handed out in a response is a
+ * point in time valid for every graph in it, and a version from an earlier server run
+ * predates every snapshot and gets a full read. The last few snapshots of each graph are kept.
+ *
+ * Game thread only.
+ */
+class FMCPGraphSnapshotCache
+{
+public:
+	FMCPGraphSnapshotCache();
+	~FMCPGraphSnapshotCache();
+
+	/** Version of the graph's current content, taking a new snapshot if it may have changed. */
+	int64 GetVersion(UEdGraph* Graph);
+
+	/**
+	 * Changes from the graph's content at SinceVersion (a version an earlier read returned along
+	 * with this graph) to now. False if the graph was not snapshotted by then or that snapshot
+	 * is no longer kept.
+	 */
+	bool GetDelta(UEdGraph* Graph, int64 SinceVersion, FMCPGraphDelta& OutDelta);
+
+	/**
+	 * Up to MaxCount of the graph's nodes in node id order, starting after AfterNode when given.
+	 * The order is sorted once per snapshot version, so paging through a large graph seeks
+	 * instead of ranking every node on every page.
+	 */
+	TArray<UEdGraphNode*> GetNodesInIdOrder(UEdGraph* Graph, const FGuid* AfterNode, int32 MaxCount);
+
+	/** Newest version handed out so far. */
+	int64 GetLatestVersion() const { return LastVersion; }
+
+private:
+	struct FSnapshot
+	{
+		int64 Version = 0;
+		TMap<FGuid, uint64> NodeHashes;
+		TSet<FMCPGraphLink> Links;
+	};
+
+	struct FGraphEntry
+	{
+		TWeakObjectPtr<UEdGraph> Graph;
+		FDelegateHandle GraphChangedHandle;
+		bool bStale = true;
+		uint32 Generation = 0;
+		// Oldest first
+		TArray<FSnapshot> Snapshots;
+		// Nodes by id for paged reads, and the snapshot version they were sorted at
+		TArray<TPair<FGuid, TWeakObjectPtr<UEdGraphNode>>> NodeOrder;
+		int64 NodeOrderVersion = 0;
+	};
+
+	// Snapshots kept per graph
+	static constexpr int32 MaxSnapshotsPerGraph = 8;
+
+	FGraphEntry& Refresh(UEdGraph* Graph);
+	FSnapshot TakeSnapshot(UEdGraph* Graph) const;
+	uint32 GetGeneration(UEdGraph* Graph) const;
+	void RemoveDeadEntries();
+	void BindDelegates();
+
+	void OnGraphChanged(const FEdGraphEditAction& Action);
+	void OnPackageMarkedDirty(UPackage* Package, bool bWasDirty);
+	void OnBlueprintCompiled();
+
+	TMap<TObjectKey<UEdGraph>, FGraphEntry> Entries;
+	int64 LastVersion = 0;
+
+	// Bumped by the notifications that can change graphs without a graph change event
+	TMap<FName, uint32> PackageGenerations;
+	uint32 CompileGeneration = 0;
+
+	FDelegateHandle PackageMarkedDirtyHandle;
+	FDelegateHandle BlueprintCompiledHandle;
+};
@@ -1,11 +1,9 @@
 #include "MCPServerHelpers.h"
+#include "MCPServerResponseWriter.h"
 #include "Engine/Blueprint.h"
 #include "EdGraph/EdGraph.h"
 #include "EdGraphSchema_K2.h"
 #include "Engine/UserDefinedStruct.h"
-#include "K2Node_SetFieldsInStruct.h"
-#include "K2Node_BreakStruct.h"
-#include "K2Node_MakeStruct.h"
 
 UClass* ResolveParentClass(const FString& ParentClassPath)
 {
@@ -63,6 +61,22 @@ void SerializePinType(const FEdGraphPinType& PinType, TSharedPtr<FJsonObject>& O
 	OutObj->SetBoolField(TEXT("is_const"), PinType.bIsConst);
 }
 
+// Streaming counterpart of SerializePinType; writes the same members into the open object
+void WritePinType(FMCPResponseWriter& Writer, const FEdGraphPinType& PinType)
+{
+	Writer.WriteString(TEXT("category"), PinType.PinCategory.ToString());
+	Writer.WriteString(TEXT("subcategory"), PinType.PinSubCategory.ToString());
+	if (PinType.PinSubCategoryObject.IsValid())
+	{
+		Writer.WriteString(TEXT("subcategory_object"), PinType.PinSubCategoryObject->GetName());
+	}
+	Writer.WriteBool(TEXT("is_array"), PinType.ContainerType == EPinContainerType::Array);
+	Writer.WriteBool(TEXT("is_set"), PinType.ContainerType == EPinContainerType::Set);
+	Writer.WriteBool(TEXT("is_map"), PinType.ContainerType == EPinContainerType::Map);
+	Writer.WriteBool(TEXT("is_reference"), PinType.bIsReference);
+	Writer.WriteBool(TEXT("is_const"), PinType.bIsConst);
+}
+
 void SerializeProperty(const FProperty* Prop, TSharedPtr<FJsonObject>& OutObj)
 {
 	OutObj->SetStringField(TEXT("name"), Prop->GetName());
@@ -105,104 +119,6 @@ void SerializeProperty(const FProperty* Prop, TSharedPtr<FJsonObject>& OutObj)
 	}
 }
 
-static bool IsMatchingStruct(UObject* PinObj, UUserDefinedStruct* OldStruct)
-{
-	if (!PinObj) return false;
-	if (PinObj == OldStruct) return true;
-	// Name-based fallback: UE can have multiple loaded instances of the same struct
-	return PinObj->GetName() == OldStruct->GetName();
-}
-
-bool DoesBlueprintReferenceStruct(UBlueprint* Blueprint, UUserDefinedStruct* OldStruct)
-{
-	// Check variables
-	for (const FBPVariableDescription& Var : Blueprint->NewVariables)
-	{
-		if (Var.VarType.PinCategory == UEdGraphSchema_K2::PC_Struct &&
-			IsMatchingStruct(Var.VarType.PinSubCategoryObject.Get(), OldStruct))
-		{
-			return true;
-		}
-	}
-
-	// Check graph nodes
-	TArray<UEdGraph*> AllGraphs;
-	Blueprint->GetAllGraphs(AllGraphs);
-	for (UEdGraph* Graph : AllGraphs)
-	{
-		for (UEdGraphNode* Node : Graph->Nodes)
-		{
-			if (!Node) continue;
-
-			// Check struct nodes directly
-			if (UK2Node_BreakStruct* BreakNode = Cast<UK2Node_BreakStruct>(Node))
-			{
-				if (BreakNode->StructType && BreakNode->StructType->GetName() == OldStruct->GetName()) return true;
-			}
-			else if (UK2Node_MakeStruct* MakeNode = Cast<UK2Node_MakeStruct>(Node))
-			{
-				if (MakeNode->StructType && MakeNode->StructType->GetName() == OldStruct->GetName()) return true;
-			}
-			else if (UK2Node_SetFieldsInStruct* SetNode = Cast<UK2Node_SetFieldsInStruct>(Node))
-			{
-				if (SetNode->StructType && SetNode->StructType->GetName() == OldStruct->GetName()) return true;
-			}
-
-			for (UEdGraphPin* Pin : Node->Pins)
-			{
-				if (Pin && Pin->PinType.PinCategory == UEdGraphSchema_K2::PC_Struct &&
-					IsMatchingStruct(Pin->PinType.PinSubCategoryObject.Get(), OldStruct))
-				{
-					return true;
-				}
-			}
-		}
-	}
-
-	return false;
-}
-
-bool DoesBlueprintReferenceEnum(UBlueprint* Blueprint, UEnum* EnumToFind)
-{
-	// Check variables
-	for (const FBPVariableDescription& Var : Blueprint->NewVariables)
-	{
-		if (Var.VarType.PinSubCategoryObject.Get() == EnumToFind)
-		{
-			return true;
-		}
-	}
-
-	// Check all graphs including sub-graphs
-	TArray<UEdGraph*> AllGraphs;
-	Blueprint->GetAllGraphs(AllGraphs);
-	TArray<UEdGraph*> GraphsToProcess = AllGraphs;
-	while (GraphsToProcess.Num() > 0)
-	{
-		UEdGraph* Graph = GraphsToProcess.Pop();
-		for (UEdGraphNode* Node : Graph->Nodes)
-		{
-			if (!Node) continue;
-			for (UEdGraphPin* Pin : Node->Pins)
-			{
-				if (Pin && Pin->PinType.PinSubCategoryObject.Get() == EnumToFind)
-				{
-					return true;
-				}
-			}
-			for (UEdGraph* SubGraph : Node->GetSubGraphs())
-			{
-				if (SubGraph && !AllGraphs.Contains(SubGraph))
-				{
-					AllGraphs.Add(SubGraph);
-					GraphsToProcess.Add(SubGraph);
-				}
-			}
-		}
-	}
-	return false;
-}
-
 void SaveNodeConnections(UEdGraphNode* Node, TArray<FSavedPinConnection>& OutConnections)
 {
 	for (UEdGraphPin* Pin : Node->Pins)
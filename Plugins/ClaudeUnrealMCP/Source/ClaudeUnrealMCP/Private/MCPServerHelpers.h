@@ -5,11 +5,9 @@
 #include "EdGraph/EdGraphPin.h"
 #include "UObject/UnrealType.h"
 
-class UBlueprint;
-class UUserDefinedStruct;
-class UEnum;
 class UEdGraph;
 class UEdGraphNode;
+class FMCPResponseWriter;
 
 struct FSavedPinConnection
 {
@@ -21,9 +19,8 @@ struct FSavedPinConnection
 
 UClass* ResolveParentClass(const FString& ParentClassPath);
 void SerializePinType(const FEdGraphPinType& PinType, TSharedPtr<FJsonObject>& OutObj);
+void WritePinType(FMCPResponseWriter& Writer, const FEdGraphPinType& PinType);
 void SerializeProperty(const FProperty* Prop, TSharedPtr<FJsonObject>& OutObj);
-bool DoesBlueprintReferenceStruct(UBlueprint* Blueprint, UUserDefinedStruct* OldStruct);
-bool DoesBlueprintReferenceEnum(UBlueprint* Blueprint, UEnum* EnumToFind);
 void SaveNodeConnections(UEdGraphNode* Node, TArray<FSavedPinConnection>& OutConnections);
 void RestoreNodeConnections(
 	UEdGraphNode* Node,
@@ -0,0 +1,333 @@
+#include "MCPServer.h"
+#include "MCPServerConnection.h"
+#include "MCPServerDispatch.h"
+#include "MCPServerJobs.h"
+#include "MCPServerResponseWriter.h"
+#include "MCPServerStats.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Dom/JsonObject.h"
+
+namespace MCPJobs
+{
+	// Game-thread time all running jobs may use per frame
+	static constexpr double SliceBudgetSeconds = 0.020;
+
+	// Minimum spacing between progress events for one job
+	static constexpr double ProgressEventIntervalSeconds = 0.25;
+
+	// Finished jobs stay pollable for this long, up to MaxFinishedJobs of them
+	static constexpr double FinishedRetentionSeconds = 600.0;
+	static constexpr int32 MaxFinishedJobs = 32;
+
+	static const TCHAR* StatusToString(EMCPJobStatus Status)
+	{
+		switch (Status)
+		{
+		case EMCPJobStatus::Running: return TEXT("running");
+		case EMCPJobStatus::Succeeded: return TEXT("succeeded");
+		case EMCPJobStatus::Failed: return TEXT("failed");
+		case EMCPJobStatus::Cancelled: return TEXT("cancelled");
+		}
+		return TEXT("unknown");
+	}
+}
+
+FString FMCPServer::RunJob(const TSharedRef<FMCPJob>& Job, const FString& Command, const TSharedPtr<FJsonObject>& Params)
+{
+	bool bAsync = false;
+	if (Params.IsValid())
+	{
+		Params->TryGetBoolField(TEXT("async"), bAsync);
+	}
+
+	if (!bAsync)
+	{
+		// Synchronous callers keep the old behaviour: the whole job runs inside this request
+		while (Job->Step())
+		{
+		}
+		const FString Error = Job->GetError();
+		return MakeResponse(Error.IsEmpty(), Job->BuildResult(), Error);
+	}
+
+	TSharedPtr<FMCPJobEntry> Entry = MakeShared<FMCPJobEntry>();
+	Entry->JobId = NextJobId++;
+	Entry->Command = Command;
+	Entry->Job = Job;
+	if (const FMCPRequestContext* Context = FMCPRequestContext::Get())
+	{
+		Entry->Connection = Context->Connection;
+		Entry->Encoding = Context->Encoding;
+	}
+	Entry->StartTime = FPlatformTime::Seconds();
+	Entry->Done = Job->GetDone();
+	Entry->Total = Job->GetTotal();
+	Entry->Phase = Job->GetPhase();
+	Entry->Current = Job->GetCurrent();
+	Jobs.Add(Entry);
+
+	UE_LOG(LogTemp, Log, TEXT("ClaudeUnrealMCP: Started job %u (%s)"), Entry->JobId, *Command);
+
+	return MakeResponse(true, DescribeJob(*Entry, false));
+}
+
+bool FMCPServer::TickJobs(float DeltaTime)
+{
+	const double Now = FPlatformTime::Seconds();
+
+	TArray<TSharedPtr<FMCPJobEntry>> Running;
+	for (const TSharedPtr<FMCPJobEntry>& Entry : Jobs)
+	{
+		if (Entry->Status != EMCPJobStatus::Running)
+		{
+			continue;
+		}
+
+		if (Entry->bCancelRequested)
+		{
+			FinishJob(*Entry, true);
+		}
+		else
+		{
+			Running.Add(Entry);
+		}
+	}
+
+	// Parked responses whose clients have caught up go first: someone is waiting on each of them
+	const double SliceEnd = Now + MCPJobs::SliceBudgetSeconds;
+	for (int32 StreamIndex = 0; StreamIndex < ResponseStreams.Num() && FPlatformTime::Seconds() < SliceEnd; )
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("MCPServer Response Stream Step", MCPServerChannel);
+		FMCPResponseStream& Stream = *ResponseStreams[StreamIndex];
+		if (Stream.IsWaiting())
+		{
+			++StreamIndex;
+		}
+		else if (!Stream.Step())
+		{
+			FinishResponseStream(Stream);
+			ResponseStreams.RemoveAt(StreamIndex);
+		}
+	}
+
+	// Round-robin one step at a time so a single large job cannot starve the others
+	int32 Index = 0;
+	while (Running.Num() > 0 && FPlatformTime::Seconds() < SliceEnd)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("MCPServer Job Step", MCPServerChannel);
+		Index %= Running.Num();
+		FMCPJobEntry& Entry = *Running[Index];
+
+		// Nothing to do this tick; it is looked at again on the next one
+		if (Entry.Job->IsWaiting())
+		{
+			Running.RemoveAt(Index);
+			continue;
+		}
+
+		const bool bMoreWork = Entry.Job->Step();
+		Entry.Done = Entry.Job->GetDone();
+		Entry.Total = Entry.Job->GetTotal();
+		Entry.Phase = Entry.Job->GetPhase();
+		Entry.Current = Entry.Job->GetCurrent();
+
+		if (bMoreWork)
+		{
+			++Index;
+		}
+		else
+		{
+			FinishJob(Entry, false);
+			Running.RemoveAt(Index);
+		}
+	}
+
+	for (const TSharedPtr<FMCPJobEntry>& Entry : Running)
+	{
+		if (Now - Entry->LastProgressEventTime >= MCPJobs::ProgressEventIntervalSeconds)
+		{
+			Entry->LastProgressEventTime = Now;
+			SendJobEvent(*Entry, TEXT("job_progress"), DescribeJob(*Entry, false));
+		}
+	}
+
+	// Forget finished jobs once they are old, or once too many have piled up
+	int32 FinishedCount = 0;
+	for (int32 EntryIndex = Jobs.Num() - 1; EntryIndex >= 0; --EntryIndex)
+	{
+		const FMCPJobEntry& Entry = *Jobs[EntryIndex];
+		if (Entry.Status == EMCPJobStatus::Running)
+		{
+			continue;
+		}
+
+		if (++FinishedCount > MCPJobs::MaxFinishedJobs || Now - Entry.FinishTime > MCPJobs::FinishedRetentionSeconds)
+		{
+			Jobs.RemoveAt(EntryIndex);
+		}
+	}
+
+	return true;
+}
+
+FString FMCPServer::RunResponseStream(const TSharedRef<FMCPResponseStream>& Stream)
+{
+	FMCPResponseWriter& Writer = Stream->GetWriter();
+
+	// Most responses are done before their client falls behind; only the rest is parked
+	while (!Stream->IsWaiting())
+	{
+		if (!Stream->Step())
+		{
+			return Writer.Finish();
+		}
+	}
+
+	// IsWaiting is only ever true for a writer streaming to the calling connection
+	FMCPRequestContext* Context = FMCPRequestContext::Get();
+	check(Context && Writer.IsStreaming());
+	Writer.Defer();
+	Context->bResponseSent = true;
+	Context->bResponseDeferred = true;
+	ResponseStreams.Add(Stream);
+	return FString();
+}
+
+void FMCPServer::FinishResponseStream(FMCPResponseStream& Stream)
+{
+	FMCPResponseWriter& Writer = Stream.GetWriter();
+	Writer.Finish();
+	Writer.GetConnection()->InFlightRequests.Decrement();
+}
+
+void FMCPServer::FinishJob(FMCPJobEntry& Entry, bool bCancelled)
+{
+	Entry.Result = Entry.Job->BuildResult();
+	if (bCancelled)
+	{
+		Entry.Result->SetBoolField(TEXT("cancelled"), true);
+	}
+	const FString Error = Entry.Job->GetError();
+	if (!Error.IsEmpty())
+	{
+		Entry.Result->SetStringField(TEXT("error"), Error);
+	}
+
+	Entry.Status = bCancelled ? EMCPJobStatus::Cancelled
+		: Error.IsEmpty() ? EMCPJobStatus::Succeeded
+		: EMCPJobStatus::Failed;
+	Entry.FinishTime = FPlatformTime::Seconds();
+	Entry.Done = Entry.Job->GetDone();
+	Entry.Total = Entry.Job->GetTotal();
+	Entry.Phase = Entry.Job->GetPhase();
+	Entry.Current.Reset();
+
+	// Release whatever the job was holding on to; only the result is kept
+	Entry.Job.Reset();
+
+	UE_LOG(LogTemp, Log, TEXT("ClaudeUnrealMCP: Job %u (%s) %s after %.1fs"),
+		Entry.JobId, *Entry.Command, MCPJobs::StatusToString(Entry.Status), Entry.FinishTime - Entry.StartTime);
+
+	SendJobEvent(Entry, TEXT("job_complete"), DescribeJob(Entry, true));
+}
+
+void FMCPServer::SendJobEvent(const FMCPJobEntry& Entry, const TCHAR* EventName, const TSharedPtr<FJsonObject>& Payload)
+{
+	FMCPConnectionPtr Connection = Entry.Connection.Pin();
+	if (!Connection.IsValid() || Connection->bClosed)
+	{
+		return;
+	}
+
+	// Events carry no request id; clients tell them apart from responses by the "event" field
+	TSharedPtr<FJsonObject> Event = MakeShared<FJsonObject>();
+	Event->SetStringField(TEXT("event"), EventName);
+	Event->Values.Append(Payload->Values);
+
+	QueueMessage(*Connection, Entry.Encoding, nullptr, Event.ToSharedRef());
+}
+
+TSharedPtr<FJsonObject> FMCPServer::DescribeJob(const FMCPJobEntry& Entry, bool bIncludeResult) const
+{
+	const double EndTime = Entry.Status == EMCPJobStatus::Running ? FPlatformTime::Seconds() : Entry.FinishTime;
+
+	TSharedPtr<FJsonObject> JobObj = MakeShared<FJsonObject>();
+	JobObj->SetNumberField(TEXT("job_id"), Entry.JobId);
+	JobObj->SetStringField(TEXT("command"), Entry.Command);
+	JobObj->SetStringField(TEXT("status"), MCPJobs::StatusToString(Entry.Status));
+	JobObj->SetStringField(TEXT("phase"), Entry.Phase);
+	JobObj->SetNumberField(TEXT("done"), Entry.Done);
+	JobObj->SetNumberField(TEXT("total"), Entry.Total);
+	if (!Entry.Current.IsEmpty())
+	{
+		JobObj->SetStringField(TEXT("current"), Entry.Current);
+	}
+	JobObj->SetNumberField(TEXT("elapsed_seconds"), EndTime - Entry.StartTime);
+
+	if (bIncludeResult && Entry.Result.IsValid())
+	{
+		JobObj->SetObjectField(TEXT("result"), Entry.Result);
+	}
+
+	return JobObj;
+}
+
+FString FMCPServer::HandleGetJobStatus(const TSharedPtr<FJsonObject>& Params)
+{
+	uint32 JobId = 0;
+	if (!Params.IsValid() || !Params->TryGetNumberField(TEXT("job_id"), JobId))
+	{
+		// No id: list every known job without results
+		TArray<TSharedPtr<FJsonValue>> JobsArray;
+		for (const TSharedPtr<FMCPJobEntry>& Entry : Jobs)
+		{
+			JobsArray.Add(MakeShared<FJsonValueObject>(DescribeJob(*Entry, false)));
+		}
+
+		TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+		Data->SetArrayField(TEXT("jobs"), JobsArray);
+		Data->SetNumberField(TEXT("count"), JobsArray.Num());
+		return MakeResponse(true, Data);
+	}
+
+	for (const TSharedPtr<FMCPJobEntry>& Entry : Jobs)
+	{
+		if (Entry->JobId == JobId)
+		{
+			return MakeResponse(true, DescribeJob(*Entry, true));
+		}
+	}
+
+	return MakeError(FString::Printf(TEXT("Unknown job_id: %u"), JobId));
+}
+
+FString FMCPServer::HandleCancelJob(const TSharedPtr<FJsonObject>& Params)
+{
+	uint32 JobId = 0;
+	if (!Params.IsValid() || !Params->TryGetNumberField(TEXT("job_id"), JobId))
+	{
+		return MakeError(TEXT("Missing 'job_id' parameter"));
+	}
+
+	for (const TSharedPtr<FMCPJobEntry>& Entry : Jobs)
+	{
+		if (Entry->JobId != JobId)
+		{
+			continue;
+		}
+
+		if (Entry->Status != EMCPJobStatus::Running)
+		{
+			return MakeError(FString::Printf(TEXT("Job %u has already finished"), JobId));
+		}
+
+		// Takes effect before the job's next step; work already done is not rolled back
+		Entry->bCancelRequested = true;
+
+		TSharedPtr<FJsonObject> Data = DescribeJob(*Entry, false);
+		Data->SetBoolField(TEXT("cancel_requested"), true);
+		return MakeResponse(true, Data);
+	}
+
+	return MakeError(FString::Printf(TEXT("Unknown job_id: %u"), JobId));
+}
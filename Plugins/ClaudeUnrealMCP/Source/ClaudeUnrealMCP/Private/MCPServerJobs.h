@@ -0,0 +1,83 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "MCPServerConnection.h"
+
+/**
+ * A long-running command split into small steps.
+ *
+ * Jobs run on the game thread. The server calls Step repeatedly within a per-frame time
+ * budget and resumes on the next tick, so the editor keeps responding while e.g. every
+ * blueprint in the project is compiled. A step should do one bounded piece of work, such
+ * as loading or compiling one asset. UObjects held across steps must be kept alive by
+ * the job itself; garbage collection can run between ticks.
+ */
+class FMCPJob
+{
+public:
+	virtual ~FMCPJob() = default;
+
+	/** Do the next piece of work. Returns false once there is nothing left to do. */
+	virtual bool Step() = 0;
+
+	/** Response data for the work done so far; called once, after the last step or on cancel. */
+	virtual TSharedPtr<FJsonObject> BuildResult() = 0;
+
+	/** Why the job as a whole failed, once it has finished; empty if it succeeded. */
+	virtual FString GetError() const { return FString(); }
+
+	/** True while the job cannot make progress (e.g. its client has not caught up); it is skipped until a later tick. */
+	virtual bool IsWaiting() { return false; }
+
+	int32 GetDone() const { return Done; }
+	int32 GetTotal() const { return Total; }
+	const FString& GetPhase() const { return Phase; }
+	const FString& GetCurrent() const { return Current; }
+
+protected:
+	// Progress reported to clients: Done of Total items in the current phase, and the item
+	// being worked on, if the job names them
+	int32 Done = 0;
+	int32 Total = 0;
+	FString Phase;
+	FString Current;
+};
+
+enum class EMCPJobStatus : uint8
+{
+	Running,
+	Succeeded,
+
+	// Ran to the end, but the job reported an error through GetError
+	Failed,
+
+	Cancelled
+};
+
+/** Server-side bookkeeping for one async job. */
+struct FMCPJobEntry
+{
+	uint32 JobId = 0;
+	FString Command;
+	TSharedPtr<FMCPJob> Job;
+	EMCPJobStatus Status = EMCPJobStatus::Running;
+	bool bCancelRequested = false;
+
+	// Connection that started the job; receives its progress and completion events
+	FMCPConnectionWeakPtr Connection;
+	EMCPEncoding Encoding = EMCPEncoding::Json;
+
+	// Last progress reported by the job; kept after the job object is released
+	int32 Done = 0;
+	int32 Total = 0;
+	FString Phase;
+	FString Current;
+
+	// Finished response data, kept so the job can still be polled after completion
+	TSharedPtr<FJsonObject> Result;
+
+	double StartTime = 0.0;
+	double FinishTime = 0.0;
+	double LastProgressEventTime = 0.0;
+};
@@ -0,0 +1,44 @@
+#include "MCPServerMigrationAnalysis.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "Async/ParallelFor.h"
+
+TArray<UEdGraph*> MCPMigrationAnalysis::GetAllGraphs(const UBlueprint* Blueprint)
+{
+	TArray<UEdGraph*> AllGraphs;
+	Blueprint->GetAllGraphs(AllGraphs);
+
+	// Add sub-graphs recursively (GetAllGraphs may not include node sub-graphs)
+	TSet<UEdGraph*> Seen(AllGraphs);
+	TArray<UEdGraph*> GraphsToProcess = AllGraphs;
+	while (GraphsToProcess.Num() > 0)
+	{
+		UEdGraph* Graph = GraphsToProcess.Pop();
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (!Node) continue;
+			for (UEdGraph* SubGraph : Node->GetSubGraphs())
+			{
+				if (!SubGraph) continue;
+				bool bAlreadySeen = false;
+				Seen.Add(SubGraph, &bAlreadySeen);
+				if (!bAlreadySeen)
+				{
+					AllGraphs.Add(SubGraph);
+					GraphsToProcess.Add(SubGraph);
+				}
+			}
+		}
+	}
+	return AllGraphs;
+}
+
+void MCPMigrationAnalysis::ForEachBlueprint(int32 Num, TFunctionRef<void(int32 Index)> Analyze)
+{
+	// Blueprints range from a handful of nodes to thousands, so tasks pick up one at a time
+	ParallelFor(Num, [&Analyze](int32 Index)
+	{
+		Analyze(Index);
+	}, EParallelForFlags::Unbalanced);
+}
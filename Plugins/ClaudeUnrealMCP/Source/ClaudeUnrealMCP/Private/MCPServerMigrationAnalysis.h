@@ -0,0 +1,34 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/Function.h"
+
+class UBlueprint;
+class UEdGraph;
+
+/**
+ * The read-only half of a struct or enum migration.
+ *
+ * A migration first walks every graph of every affected blueprint to find the variables, nodes
+ * and pins that reference the old type, and only then edits them. The walk reads and never
+ * writes, so it runs one blueprint per worker task and produces a list of edits per blueprint;
+ * applying those edits goes through node reconstruction and the schema and stays on the game
+ * thread. The game thread waits for the walk, so nothing can edit, compile or collect the
+ * blueprints meanwhile and every task sees the graphs exactly as they were when it began.
+ */
+namespace MCPMigrationAnalysis
+{
+	/**
+	 * Every graph of the blueprint, including node sub-graphs GetAllGraphs can miss. Only reads,
+	 * so it may be called from an analysis task.
+	 */
+	TArray<UEdGraph*> GetAllGraphs(const UBlueprint* Blueprint);
+
+	/**
+	 * Run Analyze(Index) for every index in [0, Num) on worker threads and return once all have
+	 * finished. Analyze must only read blueprints and write its own Index's output.
+	 *
+	 * Game thread only.
+	 */
+	void ForEachBlueprint(int32 Num, TFunctionRef<void(int32 Index)> Analyze);
+}
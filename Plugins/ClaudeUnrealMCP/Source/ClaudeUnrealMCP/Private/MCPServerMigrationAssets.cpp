@@ -57,6 +57,7 @@
 #include "EnhancedInputComponent.h"
 #include "Components/ActorComponent.h"
 #include "Kismet2/ComponentEditorUtils.h"
+#include "MCPServerTypeRegistry.h"
 
 FString FMCPServer::HandleFixAssetStructReference(const TSharedPtr<FJsonObject>& Params)
 {
@@ -87,23 +88,7 @@ FString FMCPServer::HandleFixAssetStructReference(const TSharedPtr<FJsonObject>&
 	}
 
 	// Load new struct
-	UScriptStruct* NewStruct = nullptr;
-	FString TypeNameToFind = NewStructPath;
-	if (NewStructPath.StartsWith(TEXT("/Script/")))
-	{
-		FString Remainder = NewStructPath;
-		Remainder.RemoveFromStart(TEXT("/Script/"));
-		FString ModuleName;
-		Remainder.Split(TEXT("."), &ModuleName, &TypeNameToFind);
-	}
-	for (TObjectIterator<UScriptStruct> It; It; ++It)
-	{
-		if (It->GetName() == TypeNameToFind)
-		{
-			NewStruct = *It;
-			break;
-		}
-	}
+	UScriptStruct* NewStruct = FMCPTypeRegistry::Get().FindFirst<UScriptStruct>(FName(*FMCPTypeRegistry::GetScriptTypeName(NewStructPath)));
 	if (!NewStruct)
 	{
 		return MakeError(FString::Printf(TEXT("New struct not found: %s"), *NewStructPath));
@@ -327,23 +312,7 @@ FString FMCPServer::HandleMigrateChooserTable(const TSharedPtr<FJsonObject>& Par
 			FString NewStructPath;
 			if (!Pair.Value.IsValid() || !Pair.Value->TryGetString(NewStructPath)) continue;
 
-			FString TypeNameToFind = NewStructPath;
-			if (NewStructPath.StartsWith(TEXT("/Script/")))
-			{
-				FString Remainder = NewStructPath;
-				Remainder.RemoveFromStart(TEXT("/Script/"));
-				FString ModuleName;
-				Remainder.Split(TEXT("."), &ModuleName, &TypeNameToFind);
-			}
-			UScriptStruct* FoundStruct = nullptr;
-			for (TObjectIterator<UScriptStruct> It; It; ++It)
-			{
-				if (It->GetName() == TypeNameToFind)
-				{
-					FoundStruct = *It;
-					break;
-				}
-			}
+			UScriptStruct* FoundStruct = FMCPTypeRegistry::Get().FindFirst<UScriptStruct>(FName(*FMCPTypeRegistry::GetScriptTypeName(NewStructPath)));
 			if (!FoundStruct)
 			{
 				return MakeError(FString::Printf(TEXT("New struct not found: %s (for old struct %s)"), *NewStructPath, *OldStructName));
@@ -355,23 +324,7 @@ FString FMCPServer::HandleMigrateChooserTable(const TSharedPtr<FJsonObject>& Par
 	if (Params->HasField(TEXT("new_struct_path")) && StructMap.Num() == 0)
 	{
 		FString NewStructPath = Params->GetStringField(TEXT("new_struct_path"));
-		FString TypeNameToFind = NewStructPath;
-		if (NewStructPath.StartsWith(TEXT("/Script/")))
-		{
-			FString Remainder = NewStructPath;
-			Remainder.RemoveFromStart(TEXT("/Script/"));
-			FString ModuleName;
-			Remainder.Split(TEXT("."), &ModuleName, &TypeNameToFind);
-		}
-		UScriptStruct* NewStruct = nullptr;
-		for (TObjectIterator<UScriptStruct> It; It; ++It)
-		{
-			if (It->GetName() == TypeNameToFind)
-			{
-				NewStruct = *It;
-				break;
-			}
-		}
+		UScriptStruct* NewStruct = FMCPTypeRegistry::Get().FindFirst<UScriptStruct>(FName(*FMCPTypeRegistry::GetScriptTypeName(NewStructPath)));
 		if (!NewStruct)
 		{
 			return MakeError(FString::Printf(TEXT("New struct not found: %s"), *NewStructPath));
@@ -56,109 +56,262 @@
 #include "Components/ActorComponent.h"
 #include "Kismet2/ComponentEditorUtils.h"
 #include "MCPServerHelpers.h"
-
-FString FMCPServer::HandleMigrateEnumReferences(const TSharedPtr<FJsonObject>& Params)
+#include "MCPServerJobs.h"
+#include "MCPServerTypeRegistry.h"
+#include "MCPServerTypeIndex.h"
+#include "Misc/PackageName.h"
+#include "MCPServerGlob.h"
+#include "UObject/StrongObjectPtr.h"
+#include "MCPServerMigrationAnalysis.h"
+
+/**
+ * Enum migration as a job: struct fields first, then a scan for affected blueprints, then
+ * the per-blueprint migration. Each step handles one asset, except that affected blueprints are
+ * loaded in batches and a whole batch is analyzed in one step across worker threads; the edits
+ * found are then applied one blueprint per step.
+ */
+class FMigrateEnumReferencesJob : public FMCPJob
 {
-	if (!Params.IsValid())
+public:
+	explicit FMigrateEnumReferencesJob(const TSharedRef<FMCPTypeReferenceIndex>& InTypeIndex)
+		: TypeIndex(InTypeIndex)
 	{
-		return MakeError(TEXT("Missing parameters"));
 	}
 
-	FString SourceEnumPath = Params->GetStringField(TEXT("source_enum_path"));
-	FString TargetEnumPath = Params->GetStringField(TEXT("target_enum_path"));
-	bool bDryRun = Params->HasField(TEXT("dry_run")) ? Params->GetBoolField(TEXT("dry_run")) : false;
-	bool bSkipStructFields = Params->HasField(TEXT("skip_struct_fields")) ? Params->GetBoolField(TEXT("skip_struct_fields")) : false;
-
-	// Optional: skip specific blueprint paths (e.g. ABPs with PropertyAccess nodes that break on enum type change)
-	TSet<FString> SkipBlueprintPaths;
-	if (Params->HasField(TEXT("skip_blueprint_paths")))
+	bool Init(const TSharedPtr<FJsonObject>& Params, FString& OutError)
 	{
-		const TArray<TSharedPtr<FJsonValue>>& SkipArray = Params->GetArrayField(TEXT("skip_blueprint_paths"));
-		for (const auto& Val : SkipArray)
+		FString SourceEnumPath = Params->GetStringField(TEXT("source_enum_path"));
+		FString TargetEnumPath = Params->GetStringField(TEXT("target_enum_path"));
+		bDryRun = Params->HasField(TEXT("dry_run")) ? Params->GetBoolField(TEXT("dry_run")) : false;
+		bSkipStructFields = Params->HasField(TEXT("skip_struct_fields")) ? Params->GetBoolField(TEXT("skip_struct_fields")) : false;
+
+		// Optional: skip specific blueprint paths (e.g. ABPs with PropertyAccess nodes that break on enum type change)
+		if (Params->HasField(TEXT("skip_blueprint_paths")))
 		{
-			SkipBlueprintPaths.Add(Val->AsString());
+			const TArray<TSharedPtr<FJsonValue>>& SkipArray = Params->GetArrayField(TEXT("skip_blueprint_paths"));
+			for (const auto& Val : SkipArray)
+			{
+				SkipBlueprintPaths.Add(Val->AsString());
+			}
 		}
-	}
 
-	// Optional: only process a specific blueprint path (whitelist mode)
-	FString OnlyBlueprintPath = Params->HasField(TEXT("blueprint_path")) ? Params->GetStringField(TEXT("blueprint_path")) : TEXT("");
+		// Optional: only process a specific blueprint path, or a list of them such as one chunk of
+		// a plan_migration plan (whitelist mode). Others are not even loaded.
+		TArray<FString> OnlyBlueprintPaths;
+		Params->TryGetStringArrayField(TEXT("blueprint_paths"), OnlyBlueprintPaths);
+		if (Params->HasField(TEXT("blueprint_path")))
+		{
+			OnlyBlueprintPaths.Add(Params->GetStringField(TEXT("blueprint_path")));
+		}
+		bOnlyListedBlueprints = Params->HasField(TEXT("blueprint_paths")) || Params->HasField(TEXT("blueprint_path"));
+		for (const FString& OnlyPath : OnlyBlueprintPaths)
+		{
+			OnlyPackages.Add(FName(*FPackageName::ObjectPathToPackageName(OnlyPath)));
+		}
 
-	if (SourceEnumPath.IsEmpty() || TargetEnumPath.IsEmpty())
-	{
-		return MakeError(TEXT("Missing source_enum_path or target_enum_path"));
-	}
+		if (SourceEnumPath.IsEmpty() || TargetEnumPath.IsEmpty())
+		{
+			OutError = TEXT("Missing source_enum_path or target_enum_path");
+			return false;
+		}
 
-	// Load old enum (UserDefinedEnum)
-	UUserDefinedEnum* OldEnum = LoadObject<UUserDefinedEnum>(nullptr, *SourceEnumPath);
-	if (!OldEnum)
-	{
-		return MakeError(FString::Printf(TEXT("Could not load source UserDefinedEnum: %s"), *SourceEnumPath));
-	}
+		// Load old enum (UserDefinedEnum)
+		OldEnum = LoadObject<UUserDefinedEnum>(nullptr, *SourceEnumPath);
+		if (!OldEnum)
+		{
+			OutError = FString::Printf(TEXT("Could not load source UserDefinedEnum: %s"), *SourceEnumPath);
+			return false;
+		}
+		KeepOldEnumAlive.Reset(OldEnum);
 
-	// Find new enum (C++ UEnum)
-	UEnum* NewEnum = nullptr;
-	for (TObjectIterator<UEnum> It; It; ++It)
-	{
-		if (It->GetPathName() == TargetEnumPath)
+		// Find new enum (C++ UEnum)
+		NewEnum = FMCPTypeRegistry::Get().FindByPath<UEnum>(TargetEnumPath);
+		if (!NewEnum)
 		{
-			NewEnum = *It;
-			break;
+			OutError = FString::Printf(TEXT("Could not find target UEnum: %s"), *TargetEnumPath);
+			return false;
 		}
-	}
-	if (!NewEnum)
-	{
-		return MakeError(FString::Printf(TEXT("Could not find target UEnum: %s"), *TargetEnumPath));
-	}
 
-	// Build value name mapping: BP enum display names -> C++ enum names
-	// BP UserDefinedEnum values have display names like "Walk" and internal names like "E_Gait::NewEnumerator0"
-	// C++ enum has values like "E_Gait::Walk"
-	TMap<FName, FName> ValueNameMap;          // OldInternalName -> NewInternalName
-	TMap<FString, FString> DisplayToNewValue; // DisplayName -> NewInternalName (for default value remapping)
-	TArray<TSharedPtr<FJsonValue>> ValueMappingsArray;
-	for (int32 i = 0; i < OldEnum->NumEnums() - 1; ++i) // -1 to skip _MAX
-	{
-		FText DisplayText = OldEnum->GetDisplayNameTextByIndex(i);
-		FString DisplayName = DisplayText.ToString();
-		FName OldValueName = FName(*OldEnum->GetNameStringByIndex(i));
+		// Build value name mapping: BP enum display names -> C++ enum names
+		// BP UserDefinedEnum values have display names like "Walk" and internal names like "E_Gait::NewEnumerator0"
+		// C++ enum has values like "E_Gait::Walk"
+		for (int32 i = 0; i < OldEnum->NumEnums() - 1; ++i) // -1 to skip _MAX
+		{
+			FText DisplayText = OldEnum->GetDisplayNameTextByIndex(i);
+			FString DisplayName = DisplayText.ToString();
+			FName OldValueName = FName(*OldEnum->GetNameStringByIndex(i));
 
-		// Find matching C++ enum value by display name
-		for (int32 j = 0; j < NewEnum->NumEnums() - 1; ++j)
+			// Find matching C++ enum value by display name
+			for (int32 j = 0; j < NewEnum->NumEnums() - 1; ++j)
+			{
+				FString NewDisplayName = NewEnum->GetDisplayNameTextByIndex(j).ToString();
+				if (NewDisplayName == DisplayName)
+				{
+					FName NewValueName = FName(*NewEnum->GetNameStringByIndex(j));
+					ValueNameMap.Add(OldValueName, NewValueName);
+					DisplayToNewValue.Add(DisplayName, NewValueName.ToString());
+
+					TSharedPtr<FJsonObject> Mapping = MakeShared<FJsonObject>();
+					Mapping->SetStringField(TEXT("display_name"), DisplayName);
+					Mapping->SetStringField(TEXT("old_value"), OldValueName.ToString());
+					Mapping->SetStringField(TEXT("new_value"), NewValueName.ToString());
+					ValueMappingsArray.Add(MakeShared<FJsonValueObject>(Mapping));
+					break;
+				}
+			}
+		}
+
+		// Build default value fix map for legacy and display values
+		for (const auto& Pair : DisplayToNewValue)
+		{
+			DefaultFixMap.Add(Pair.Key, Pair.Value);
+		}
+		for (int32 i = 0; i < NewEnum->NumEnums() - 1; ++i)
 		{
-			FString NewDisplayName = NewEnum->GetDisplayNameTextByIndex(j).ToString();
-			if (NewDisplayName == DisplayName)
+			FString NewName = NewEnum->GetNameStringByIndex(i);
+			if (NewName.Contains(TEXT("::")))
 			{
-				FName NewValueName = FName(*NewEnum->GetNameStringByIndex(j));
-				ValueNameMap.Add(OldValueName, NewValueName);
-				DisplayToNewValue.Add(DisplayName, NewValueName.ToString());
-
-				TSharedPtr<FJsonObject> Mapping = MakeShared<FJsonObject>();
-				Mapping->SetStringField(TEXT("display_name"), DisplayName);
-				Mapping->SetStringField(TEXT("old_value"), OldValueName.ToString());
-				Mapping->SetStringField(TEXT("new_value"), NewValueName.ToString());
-				ValueMappingsArray.Add(MakeShared<FJsonValueObject>(Mapping));
-				break;
+				NewName = NewName.RightChop(NewName.Find(TEXT("::")) + 2);
 			}
+			DefaultFixMap.Add(FString::Printf(TEXT("NewEnumerator%d"), i), NewName);
 		}
+
+		IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+		// --- Phase 0: Update UserDefinedStruct field definitions ---
+		// BP structs may have fields typed as BP enums. Break/Set/Make nodes derive
+		// sub-pin types from the struct definition, so we must update the source.
+		// SKIP when skip_struct_fields=true: avoids corrupting BP struct assets with C++ enum pointers
+		// (causes CppForm assertion crash on reload when struct SubCategoryObject points to C++ UEnum)
+		if (!bSkipStructFields)
+		{
+			AssetRegistry.GetAssetsByClass(UUserDefinedStruct::StaticClass()->GetClassPathName(), AllStructAssets, true);
+		}
+		// else: Phase 0 skipped — struct field SubCategoryObject left as BP enum to avoid CppForm crash
+
+		BeginPhase(EPhase::StructFields, TEXT("fixing_struct_fields"), AllStructAssets.Num());
+		return true;
 	}
 
-	// Build default value fix map for legacy and display values
-	TMap<FString, FString> DefaultFixMap;
-	for (const auto& Pair : DisplayToNewValue)
+	virtual bool Step() override
 	{
-		DefaultFixMap.Add(Pair.Key, Pair.Value);
+		switch (CurrentPhase)
+		{
+		case EPhase::StructFields:
+			if (Done < AllStructAssets.Num())
+			{
+				FixStructFields(AllStructAssets[Done++]);
+				return true;
+			}
+			// Only blueprints that may use the enum are loaded, and only if the index has not seen them yet
+			CandidatePackages = TypeIndex->GetCandidatePackages(OldEnum);
+			BeginPhase(EPhase::FindAffected, TEXT("finding_affected_blueprints"), CandidatePackages.Num());
+			return true;
+
+		case EPhase::FindAffected:
+			if (Done < CandidatePackages.Num())
+			{
+				ScanBlueprint(CandidatePackages[Done++]);
+				return true;
+			}
+			BeginPhase(EPhase::Migrate, TEXT("migrating_blueprints"), AffectedBlueprintPaths.Num());
+			return true;
+
+		case EPhase::Migrate:
+			// Apply the analyzed batch, one blueprint per step
+			if (bBatchAnalyzed)
+			{
+				if (NextToApply < Batch.Num())
+				{
+					ApplyEdits(Batch[NextToApply++]);
+					++Done;
+					return true;
+				}
+				Batch.Reset();
+				NextToApply = 0;
+				bBatchAnalyzed = false;
+			}
+			// Load the next batch one blueprint per step, then analyze all of it at once
+			if (NextToLoad < AffectedBlueprintPaths.Num() && Batch.Num() < AnalyzeBatchSize)
+			{
+				if (UBlueprint* Blueprint = Cast<UBlueprint>(AffectedBlueprintPaths[NextToLoad].TryLoad()))
+				{
+					Batch.Emplace(Blueprint);
+				}
+				else
+				{
+					++Done;
+				}
+				++NextToLoad;
+				return true;
+			}
+			if (Batch.Num() > 0)
+			{
+				AnalyzeBatch();
+				bBatchAnalyzed = true;
+				return true;
+			}
+			CurrentPhase = EPhase::Finished;
+			return false;
+
+		case EPhase::Finished:
+			break;
+		}
+		return false;
 	}
-	for (int32 i = 0; i < NewEnum->NumEnums() - 1; ++i)
+
+	virtual TSharedPtr<FJsonObject> BuildResult() override
 	{
-		FString NewName = NewEnum->GetNameStringByIndex(i);
-		if (NewName.Contains(TEXT("::")))
+		// Build response
+		TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+		Data->SetBoolField(TEXT("dry_run"), bDryRun);
+		Data->SetStringField(TEXT("source_enum"), OldEnum->GetPathName());
+		Data->SetStringField(TEXT("target_enum"), NewEnum->GetPathName());
+		Data->SetNumberField(TEXT("value_mappings_count"), ValueNameMap.Num());
+		Data->SetArrayField(TEXT("value_name_mapping"), ValueMappingsArray);
+		Data->SetNumberField(TEXT("blueprints_affected"), AffectedBlueprintPaths.Num());
+		Data->SetArrayField(TEXT("affected_blueprints"), BlueprintReportsArray);
+		Data->SetNumberField(TEXT("total_pins_migrated"), TotalPinsMigrated);
+		Data->SetNumberField(TEXT("total_variables_migrated"), TotalVariablesMigrated);
+		Data->SetNumberField(TEXT("struct_fields_fixed"), TotalStructFieldsFixed);
+		if (StructFieldReportsArray.Num() > 0)
 		{
-			NewName = NewName.RightChop(NewName.Find(TEXT("::")) + 2);
+			Data->SetArrayField(TEXT("struct_fields"), StructFieldReportsArray);
+		}
+		if (StructDiagArray.Num() > 0)
+		{
+			Data->SetArrayField(TEXT("struct_diagnostics"), StructDiagArray);
+		}
+		if (CurrentPhase != EPhase::Finished)
+		{
+			Data->SetStringField(TEXT("message"), TEXT("Enum migration stopped before completion"));
+		}
+		else
+		{
+			Data->SetStringField(TEXT("message"),
+				bDryRun ? TEXT("Dry run complete - no changes made") : TEXT("Enum migration complete"));
 		}
-		DefaultFixMap.Add(FString::Printf(TEXT("NewEnumerator%d"), i), NewName);
+		return Data;
+	}
+
+private:
+	enum class EPhase : uint8
+	{
+		StructFields,
+		FindAffected,
+		Migrate,
+		Finished
+	};
+
+	void BeginPhase(EPhase NewPhase, const TCHAR* PhaseName, int32 ItemCount)
+	{
+		CurrentPhase = NewPhase;
+		Phase = PhaseName;
+		Done = 0;
+		Total = ItemCount;
 	}
 
-	auto RemapEnumDefault = [&DefaultFixMap](FString& Value) -> bool
+	bool RemapEnumDefault(FString& Value) const
 	{
 		if (Value.IsEmpty())
 		{
@@ -173,622 +326,694 @@ FString FMCPServer::HandleMigrateEnumReferences(const TSharedPtr<FJsonObject>& P
 			}
 		}
 		return false;
-	};
-
-	// --- Phase 0: Update UserDefinedStruct field definitions ---
-	// BP structs may have fields typed as BP enums. Break/Set/Make nodes derive
-	// sub-pin types from the struct definition, so we must update the source.
-	// SKIP when skip_struct_fields=true: avoids corrupting BP struct assets with C++ enum pointers
-	// (causes CppForm assertion crash on reload when struct SubCategoryObject points to C++ UEnum)
-	FAssetRegistryModule& AssetRegistryModule = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AssetRegistry = AssetRegistryModule.Get();
-
-	int32 TotalStructFieldsFixed = 0;
-	TArray<TSharedPtr<FJsonValue>> StructFieldReportsArray;
-	TArray<TSharedPtr<FJsonValue>> StructDiagArray;
-	if (bSkipStructFields)
-	{
-		// Phase 0 skipped — struct field SubCategoryObject left as BP enum to avoid CppForm crash
 	}
-	else
-	{
-		TArray<FAssetData> AllStructAssets;
-		AssetRegistry.GetAssetsByClass(UUserDefinedStruct::StaticClass()->GetClassPathName(), AllStructAssets, true);
 
+	void FixStructFields(const FAssetData& StructAssetData)
+	{
 		FString OldEnumName = OldEnum->GetName();
 
-		for (const FAssetData& StructAssetData : AllStructAssets)
-		{
-			UUserDefinedStruct* UDStruct = Cast<UUserDefinedStruct>(StructAssetData.GetAsset());
-			if (!UDStruct) continue;
+		UUserDefinedStruct* UDStruct = Cast<UUserDefinedStruct>(StructAssetData.GetAsset());
+		if (!UDStruct) return;
 
-			TArray<FStructVariableDescription>& Variables = const_cast<TArray<FStructVariableDescription>&>(
-				FStructureEditorUtils::GetVarDesc(UDStruct)
-			);
+		TArray<FStructVariableDescription>& Variables = const_cast<TArray<FStructVariableDescription>&>(
+			FStructureEditorUtils::GetVarDesc(UDStruct)
+		);
 
-			bool bStructModified = false;
-			for (FStructVariableDescription& Variable : Variables)
-			{
-				// Diagnostic: dump ALL fields that have any SubCategoryObject referencing enum name
-				FString SubCatPath = Variable.SubCategoryObject.ToSoftObjectPath().ToString();
-				bool bSubCatMatchesName = SubCatPath.Contains(OldEnumName);
+		bool bStructModified = false;
+		for (FStructVariableDescription& Variable : Variables)
+		{
+			// Diagnostic: dump ALL fields that have any SubCategoryObject referencing enum name
+			FString SubCatPath = Variable.SubCategoryObject.ToSoftObjectPath().ToString();
+			bool bSubCatMatchesName = SubCatPath.Contains(OldEnumName);
 
-				// Also check the compiled FProperty for this field
-				FString CompiledEnumPath;
-				if (FProperty* Prop = UDStruct->FindPropertyByName(Variable.VarName))
+			// Also check the compiled FProperty for this field
+			FString CompiledEnumPath;
+			if (FProperty* Prop = UDStruct->FindPropertyByName(Variable.VarName))
+			{
+				if (FByteProperty* ByteProp = CastField<FByteProperty>(Prop))
 				{
-					if (FByteProperty* ByteProp = CastField<FByteProperty>(Prop))
+					if (ByteProp->Enum)
 					{
-						if (ByteProp->Enum)
+						CompiledEnumPath = ByteProp->Enum->GetPathName();
+						if (!bSubCatMatchesName && ByteProp->Enum->GetName() == OldEnumName)
 						{
-							CompiledEnumPath = ByteProp->Enum->GetPathName();
-							if (!bSubCatMatchesName && ByteProp->Enum->GetName() == OldEnumName)
-							{
-								bSubCatMatchesName = true; // compiled property references this enum
-							}
+							bSubCatMatchesName = true; // compiled property references this enum
 						}
 					}
-					else if (FEnumProperty* EnumProp = CastField<FEnumProperty>(Prop))
+				}
+				else if (FEnumProperty* EnumProp = CastField<FEnumProperty>(Prop))
+				{
+					if (EnumProp->GetEnum())
 					{
-						if (EnumProp->GetEnum())
+						CompiledEnumPath = EnumProp->GetEnum()->GetPathName();
+						if (!bSubCatMatchesName && EnumProp->GetEnum()->GetName() == OldEnumName)
 						{
-							CompiledEnumPath = EnumProp->GetEnum()->GetPathName();
-							if (!bSubCatMatchesName && EnumProp->GetEnum()->GetName() == OldEnumName)
-							{
-								bSubCatMatchesName = true;
-							}
+							bSubCatMatchesName = true;
 						}
 					}
 				}
+			}
 
-				if (bSubCatMatchesName)
-				{
-					TSharedPtr<FJsonObject> Diag = MakeShared<FJsonObject>();
-					Diag->SetStringField(TEXT("struct"), UDStruct->GetName());
-					Diag->SetStringField(TEXT("field"), Variable.FriendlyName);
-					Diag->SetStringField(TEXT("var_name"), Variable.VarName.ToString());
-					Diag->SetStringField(TEXT("category"), Variable.Category.ToString());
-					Diag->SetStringField(TEXT("sub_category"), Variable.SubCategory.ToString());
-					Diag->SetStringField(TEXT("sub_category_object_path"), SubCatPath);
-					Diag->SetStringField(TEXT("compiled_enum_path"), CompiledEnumPath);
-
-					UObject* ResolvedObj = Variable.SubCategoryObject.LoadSynchronous();
-					Diag->SetStringField(TEXT("resolved_obj"), ResolvedObj ? ResolvedObj->GetPathName() : TEXT("null"));
-					Diag->SetStringField(TEXT("old_enum_path"), OldEnum->GetPathName());
-					Diag->SetBoolField(TEXT("matches_old_enum"), ResolvedObj == OldEnum);
-					Diag->SetStringField(TEXT("resolved_class"), ResolvedObj ? ResolvedObj->GetClass()->GetName() : TEXT("null"));
-					Diag->SetBoolField(TEXT("subcat_is_null"), SubCatPath.IsEmpty());
-
-					StructDiagArray.Add(MakeShared<FJsonValueObject>(Diag));
-				}
+			if (bSubCatMatchesName)
+			{
+				TSharedPtr<FJsonObject> Diag = MakeShared<FJsonObject>();
+				Diag->SetStringField(TEXT("struct"), UDStruct->GetName());
+				Diag->SetStringField(TEXT("field"), Variable.FriendlyName);
+				Diag->SetStringField(TEXT("var_name"), Variable.VarName.ToString());
+				Diag->SetStringField(TEXT("category"), Variable.Category.ToString());
+				Diag->SetStringField(TEXT("sub_category"), Variable.SubCategory.ToString());
+				Diag->SetStringField(TEXT("sub_category_object_path"), SubCatPath);
+				Diag->SetStringField(TEXT("compiled_enum_path"), CompiledEnumPath);
 
-				// Try multiple matching strategies for the actual fix
 				UObject* ResolvedObj = Variable.SubCategoryObject.LoadSynchronous();
-				bool bMatchesOld = (ResolvedObj == OldEnum);
+				Diag->SetStringField(TEXT("resolved_obj"), ResolvedObj ? ResolvedObj->GetPathName() : TEXT("null"));
+				Diag->SetStringField(TEXT("old_enum_path"), OldEnum->GetPathName());
+				Diag->SetBoolField(TEXT("matches_old_enum"), ResolvedObj == OldEnum);
+				Diag->SetStringField(TEXT("resolved_class"), ResolvedObj ? ResolvedObj->GetClass()->GetName() : TEXT("null"));
+				Diag->SetBoolField(TEXT("subcat_is_null"), SubCatPath.IsEmpty());
 
-				// Also match by compiled property enum pointer
-				if (!bMatchesOld && !CompiledEnumPath.IsEmpty())
+				StructDiagArray.Add(MakeShared<FJsonValueObject>(Diag));
+			}
+
+			// Try multiple matching strategies for the actual fix
+			UObject* ResolvedObj = Variable.SubCategoryObject.LoadSynchronous();
+			bool bMatchesOld = (ResolvedObj == OldEnum);
+
+			// Also match by compiled property enum pointer
+			if (!bMatchesOld && !CompiledEnumPath.IsEmpty())
+			{
+				if (FProperty* Prop = UDStruct->FindPropertyByName(Variable.VarName))
+				{
+					UEnum* CompiledEnum = nullptr;
+					if (FByteProperty* ByteProp = CastField<FByteProperty>(Prop))
+						CompiledEnum = ByteProp->Enum;
+					else if (FEnumProperty* EnumProp = CastField<FEnumProperty>(Prop))
+						CompiledEnum = EnumProp->GetEnum();
+
+					if (CompiledEnum == OldEnum)
+						bMatchesOld = true;
+				}
+			}
+
+			if (bMatchesOld)
+			{
+				if (!bDryRun)
 				{
+					Variable.SubCategoryObject = TSoftObjectPtr<UObject>(NewEnum);
+
+					// Also directly update the COMPILED FByteProperty::Enum pointer
+					// This is critical because Break/Make/SetFieldsInStruct nodes derive
+					// pin types from the compiled property, not from SubCategoryObject
 					if (FProperty* Prop = UDStruct->FindPropertyByName(Variable.VarName))
 					{
-						UEnum* CompiledEnum = nullptr;
 						if (FByteProperty* ByteProp = CastField<FByteProperty>(Prop))
-							CompiledEnum = ByteProp->Enum;
+						{
+							ByteProp->Enum = NewEnum;
+						}
 						else if (FEnumProperty* EnumProp = CastField<FEnumProperty>(Prop))
-							CompiledEnum = EnumProp->GetEnum();
-
-						if (CompiledEnum == OldEnum)
-							bMatchesOld = true;
+						{
+							// EnumProperty doesn't have a simple setter, but we can
+							// use the internal pointer if available
+						}
 					}
-				}
 
-				if (bMatchesOld)
-				{
-					if (!bDryRun)
+					// Remap default value if set
+					if (!Variable.DefaultValue.IsEmpty())
 					{
-						Variable.SubCategoryObject = TSoftObjectPtr<UObject>(NewEnum);
-
-						// Also directly update the COMPILED FByteProperty::Enum pointer
-						// This is critical because Break/Make/SetFieldsInStruct nodes derive
-						// pin types from the compiled property, not from SubCategoryObject
-						if (FProperty* Prop = UDStruct->FindPropertyByName(Variable.VarName))
+						FName OldVal = FName(*Variable.DefaultValue);
+						if (const FName* NewVal = ValueNameMap.Find(OldVal))
 						{
-							if (FByteProperty* ByteProp = CastField<FByteProperty>(Prop))
-							{
-								ByteProp->Enum = NewEnum;
-							}
-							else if (FEnumProperty* EnumProp = CastField<FEnumProperty>(Prop))
-							{
-								// EnumProperty doesn't have a simple setter, but we can
-								// use the internal pointer if available
-							}
+							Variable.DefaultValue = NewVal->ToString();
 						}
-
-						// Remap default value if set
-						if (!Variable.DefaultValue.IsEmpty())
+						else if (const FString* NewValStr = DisplayToNewValue.Find(Variable.DefaultValue))
 						{
-							FName OldVal = FName(*Variable.DefaultValue);
-							if (const FName* NewVal = ValueNameMap.Find(OldVal))
-							{
-								Variable.DefaultValue = NewVal->ToString();
-							}
-							else if (const FString* NewValStr = DisplayToNewValue.Find(Variable.DefaultValue))
-							{
-								Variable.DefaultValue = *NewValStr;
-							}
+							Variable.DefaultValue = *NewValStr;
 						}
 					}
+				}
 
-					bStructModified = true;
-					TotalStructFieldsFixed++;
+				bStructModified = true;
+				TotalStructFieldsFixed++;
 
-					TSharedPtr<FJsonObject> FieldReport = MakeShared<FJsonObject>();
-					FieldReport->SetStringField(TEXT("struct"), UDStruct->GetName());
-					FieldReport->SetStringField(TEXT("field"), Variable.FriendlyName);
-					StructFieldReportsArray.Add(MakeShared<FJsonValueObject>(FieldReport));
-				}
+				TSharedPtr<FJsonObject> FieldReport = MakeShared<FJsonObject>();
+				FieldReport->SetStringField(TEXT("struct"), UDStruct->GetName());
+				FieldReport->SetStringField(TEXT("field"), Variable.FriendlyName);
+				StructFieldReportsArray.Add(MakeShared<FJsonValueObject>(FieldReport));
 			}
+		}
 
-			if (bStructModified && !bDryRun)
-			{
-				UDStruct->MarkPackageDirty();
-			}
+		if (bStructModified && !bDryRun)
+		{
+			UDStruct->MarkPackageDirty();
 		}
 	}
 
-	// Find all affected blueprints
-	TArray<FAssetData> AllBlueprintAssets;
-	AssetRegistry.GetAssetsByClass(UBlueprint::StaticClass()->GetClassPathName(), AllBlueprintAssets, true);
-
-	TArray<UBlueprint*> AffectedBlueprints;
-	for (const FAssetData& AssetData : AllBlueprintAssets)
+	void ScanBlueprint(FName PackageName)
 	{
-		UBlueprint* Blueprint = Cast<UBlueprint>(AssetData.GetAsset());
-		if (!Blueprint) continue;
+		// Whitelist: only process the listed blueprints
+		if (bOnlyListedBlueprints && !OnlyPackages.Contains(PackageName))
+		{
+			return;
+		}
+
+		const FMCPBlueprintTypeReferences* References = TypeIndex->GetBlueprintReferences(PackageName);
+		if (!References || !References->ReferencesType(OldEnum, EMCPTypeMatch::Exact)) return;
 
-		// Whitelist: only process a specific blueprint
-		if (!OnlyBlueprintPath.IsEmpty())
+		const FString BPPath = References->Blueprint.ToString();
+		const FString PackagePath = PackageName.ToString();
+
+		// Skip blueprints in the skip list
+		for (const FString& SkipPath : SkipBlueprintPaths)
 		{
-			FString BPPath = Blueprint->GetPathName();
-			FString PackagePath = Blueprint->GetOutermost()->GetPathName();
-			if (BPPath != OnlyBlueprintPath && !BPPath.StartsWith(OnlyBlueprintPath + TEXT(".")) && PackagePath != OnlyBlueprintPath)
+			if (BPPath == SkipPath || BPPath.StartsWith(SkipPath + TEXT(".")) || PackagePath == SkipPath)
 			{
-				continue;
+				return;
 			}
 		}
 
-		// Skip blueprints in the skip list
-		if (SkipBlueprintPaths.Num() > 0)
+		AffectedBlueprintPaths.Add(References->Blueprint);
+	}
+
+	/** What one blueprint needs changed. AnalyzeBlueprint finds it, ApplyEdits carries it out. */
+	struct FBlueprintEdits
+	{
+		explicit FBlueprintEdits(UBlueprint* InBlueprint)
+			: Blueprint(InBlueprint)
+		{
+		}
+
+		// Held from load until applied so the blueprint cannot be collected in between
+		TStrongObjectPtr<UBlueprint> Blueprint;
+
+		// Everything below is found again and checked when applied: other commands and garbage
+		// collection run between steps, and compiling another blueprint of the batch can
+		// reconstruct nodes here that call into it
+		TArray<FGuid> Variables;
+
+		TArray<TWeakObjectPtr<UK2Node_SwitchEnum>> SwitchNodes;
+		TArray<TWeakObjectPtr<UK2Node_CastByteToEnum>> CastNodes;
+		TArray<TWeakObjectPtr<UK2Node_Select>> SelectNodes;
+
+		struct FPinEdit
 		{
-			FString BPPath = Blueprint->GetPathName();
-			// Strip _C suffix if present, and also check the package path
-			FString PackagePath = Blueprint->GetOutermost()->GetPathName();
-			bool bShouldSkip = false;
-			for (const FString& SkipPath : SkipBlueprintPaths)
+			// Found again by node and pin id when applied
+			FEdGraphPinReference Pin;
+
+			// Typed as the old enum; otherwise already NewEnum with a stale default
+			bool bRetype = false;
+
+			TOptional<FString> DefaultValue;
+			TOptional<FString> AutogeneratedDefaultValue;
+		};
+		TArray<FPinEdit> Pins;
+
+		// Each switch, cast and select node counts once, other pins only when a default changes
+		int32 GetPinCount() const
+		{
+			int32 Count = SwitchNodes.Num() + CastNodes.Num() + SelectNodes.Num();
+			for (const FPinEdit& Edit : Pins)
 			{
-				if (BPPath == SkipPath || BPPath.StartsWith(SkipPath + TEXT(".")) || PackagePath == SkipPath)
+				if (Edit.DefaultValue.IsSet() || Edit.AutogeneratedDefaultValue.IsSet())
 				{
-					bShouldSkip = true;
-					break;
+					Count++;
 				}
 			}
-			if (bShouldSkip)
+			return Count;
+		}
+	};
+
+	// Remap default value: try internal name first, then display name, then legacy names
+	bool RemapPinDefault(const FString& Value, FString& OutValue) const
+	{
+		if (Value.IsEmpty())
+		{
+			return false;
+		}
+		if (const FName* NewVal = ValueNameMap.Find(FName(*Value, FNAME_Find)))
+		{
+			OutValue = NewVal->ToString();
+			return true;
+		}
+		if (const FString* NewValStr = DisplayToNewValue.Find(Value))
+		{
+			OutValue = *NewValStr;
+			return true;
+		}
+		OutValue = Value;
+		return RemapEnumDefault(OutValue);
+	}
+
+	void AnalyzePinDefaults(const UEdGraphPin* Pin, FBlueprintEdits::FPinEdit& Edit) const
+	{
+		FString NewValue;
+		if (RemapPinDefault(Pin->DefaultValue, NewValue))
+		{
+			Edit.DefaultValue = NewValue;
+		}
+
+		FString NewAutogeneratedValue = Pin->AutogeneratedDefaultValue;
+		if (RemapEnumDefault(NewAutogeneratedValue))
+		{
+			Edit.AutogeneratedDefaultValue = NewAutogeneratedValue;
+		}
+	}
+
+	/** Find everything in one blueprint that references the old enum. Only reads; runs on a worker thread. */
+	void AnalyzeBlueprint(FBlueprintEdits& Edits) const
+	{
+		const UBlueprint* Blueprint = Edits.Blueprint.Get();
+
+		for (const FBPVariableDescription& Var : Blueprint->NewVariables)
+		{
+			if (Var.VarType.PinSubCategoryObject.Get() == OldEnum)
 			{
-				continue;
+				Edits.Variables.Add(Var.VarGuid);
 			}
 		}
 
-		if (DoesBlueprintReferenceEnum(Blueprint, OldEnum))
+		for (UEdGraph* Graph : MCPMigrationAnalysis::GetAllGraphs(Blueprint))
 		{
-			AffectedBlueprints.Add(Blueprint);
+			for (UEdGraphNode* Node : Graph->Nodes)
+			{
+				if (!Node) continue;
+
+				// Switch on Enum nodes get their entries and pin names remapped, then their pins
+				// retyped like any other
+				if (UK2Node_SwitchEnum* SwitchNode = Cast<UK2Node_SwitchEnum>(Node))
+				{
+					if (SwitchNode->Enum == OldEnum)
+					{
+						Edits.SwitchNodes.Add(SwitchNode);
+					}
+				}
+
+				// Byte to Enum nodes are reconstructed, which retypes their pins
+				if (UK2Node_CastByteToEnum* CastNode = Cast<UK2Node_CastByteToEnum>(Node))
+				{
+					if (CastNode->Enum == OldEnum)
+					{
+						Edits.CastNodes.Add(CastNode);
+						continue;
+					}
+				}
+
+				// Select nodes are fully handled on their own
+				if (UK2Node_Select* SelectNode = Cast<UK2Node_Select>(Node))
+				{
+					if (SelectNode->GetEnum() == OldEnum)
+					{
+						Edits.SelectNodes.Add(SelectNode);
+						continue;
+					}
+				}
+
+				for (UEdGraphPin* Pin : Node->Pins)
+				{
+					const UObject* PinEnum = Pin->PinType.PinSubCategoryObject.Get();
+					if (PinEnum == OldEnum)
+					{
+						FBlueprintEdits::FPinEdit Edit;
+						Edit.Pin = FEdGraphPinReference(Pin);
+						Edit.bRetype = true;
+						AnalyzePinDefaults(Pin, Edit);
+						Edits.Pins.Add(MoveTemp(Edit));
+					}
+					// Cleanup pass: fix pins already typed as NewEnum but with stale NewEnumerator* defaults
+					// (happens when struct reconstruction set C++ enum type but preserved old default values)
+					else if (PinEnum == NewEnum && !Pin->DefaultValue.IsEmpty())
+					{
+						FBlueprintEdits::FPinEdit Edit;
+						Edit.Pin = FEdGraphPinReference(Pin);
+						AnalyzePinDefaults(Pin, Edit);
+						if (Edit.DefaultValue.IsSet() || Edit.AutogeneratedDefaultValue.IsSet())
+						{
+							Edits.Pins.Add(MoveTemp(Edit));
+						}
+					}
+				}
+			}
 		}
 	}
 
-	TArray<TSharedPtr<FJsonValue>> BlueprintReportsArray;
-	int32 TotalPinsMigrated = 0;
-	int32 TotalVariablesMigrated = 0;
+	/** Analyze the loaded batch across worker threads; the game thread waits, so the graphs hold still. */
+	void AnalyzeBatch()
+	{
+		MCPMigrationAnalysis::ForEachBlueprint(Batch.Num(), [this](int32 Index)
+		{
+			AnalyzeBlueprint(Batch[Index]);
+		});
+	}
 
-	for (UBlueprint* Blueprint : AffectedBlueprints)
+	void ApplyEdits(const FBlueprintEdits& Edits)
 	{
+		UBlueprint* Blueprint = Edits.Blueprint.Get();
+
 		TSharedPtr<FJsonObject> BPReport = MakeShared<FJsonObject>();
 		BPReport->SetStringField(TEXT("path"), Blueprint->GetPathName());
 		BPReport->SetStringField(TEXT("name"), Blueprint->GetName());
 
-		int32 PinCount = 0;
-		int32 VarCount = 0;
+		// Dry run: the analysis already has the counts
+		int32 PinCount = Edits.GetPinCount();
+		int32 VarCount = Edits.Variables.Num();
 
 		if (!bDryRun)
 		{
-			// Migrate variables
-			for (FBPVariableDescription& Var : Blueprint->NewVariables)
+			// Only what still references the old enum is changed and counted; anything removed or
+			// already migrated since the analysis is skipped
+			PinCount = 0;
+			VarCount = 0;
+
+			for (const FGuid& VarGuid : Edits.Variables)
 			{
-				if (Var.VarType.PinSubCategoryObject.Get() == OldEnum)
+				FBPVariableDescription* Var = Blueprint->NewVariables.FindByPredicate([&VarGuid](const FBPVariableDescription& Candidate)
 				{
-					Var.VarType.PinSubCategoryObject = NewEnum;
-					VarCount++;
+					return Candidate.VarGuid == VarGuid;
+				});
+				if (Var && Var->VarType.PinSubCategoryObject.Get() == OldEnum)
+				{
+					Var->VarType.PinSubCategoryObject = NewEnum;
+					++VarCount;
 				}
 			}
-
-			// Collect all graphs (use GetAllGraphs like struct migration)
-			TArray<UEdGraph*> AllGraphs;
-			Blueprint->GetAllGraphs(AllGraphs);
-
-			// Add sub-graphs recursively (GetAllGraphs may miss node sub-graphs)
-			TArray<UEdGraph*> GraphsToProcess = AllGraphs;
-			while (GraphsToProcess.Num() > 0)
+			for (const TWeakObjectPtr<UK2Node_SwitchEnum>& SwitchNode : Edits.SwitchNodes)
 			{
-				UEdGraph* Graph = GraphsToProcess.Pop();
-				for (UEdGraphNode* Node : Graph->Nodes)
+				if (SwitchNode.IsValid() && SwitchNode->Enum == OldEnum)
 				{
-					for (UEdGraph* SubGraph : Node->GetSubGraphs())
-					{
-						if (SubGraph && !AllGraphs.Contains(SubGraph))
-						{
-							AllGraphs.Add(SubGraph);
-							GraphsToProcess.Add(SubGraph);
-						}
-					}
+					ApplySwitchNode(SwitchNode.Get());
+					++PinCount;
 				}
 			}
-
-			// Migrate all pins in all graphs (NO ReconstructNode — pin names don't change for enums)
-			for (UEdGraph* Graph : AllGraphs)
+			for (const TWeakObjectPtr<UK2Node_CastByteToEnum>& CastNode : Edits.CastNodes)
 			{
-				for (UEdGraphNode* Node : Graph->Nodes)
+				if (CastNode.IsValid() && CastNode->Enum == OldEnum && CastNode->GetGraph())
 				{
-					// Handle Switch on Enum nodes — update internal Enum reference
-					// Do NOT call SetEnum() as it rebuilds pins and breaks connections
-					if (UK2Node_SwitchEnum* SwitchNode = Cast<UK2Node_SwitchEnum>(Node))
-					{
-						if (SwitchNode->Enum == OldEnum)
-						{
-							// Build pin FName rename map: OldEnum::OldInternalName → NewEnum::NewValueName
-							// Pin FNames use qualified format "EnumName::ValueName"
-							FString OldEnumPrefix = OldEnum->GetName() + TEXT("::");
-							FString NewEnumPrefix = NewEnum->GetName() + TEXT("::");
+					ApplyCastNode(CastNode.Get(), CastNode->GetGraph());
+					++PinCount;
+				}
+			}
+			for (const TWeakObjectPtr<UK2Node_Select>& SelectNode : Edits.SelectNodes)
+			{
+				if (SelectNode.IsValid() && SelectNode->GetEnum() == OldEnum)
+				{
+					ApplySelectNode(SelectNode.Get());
+					++PinCount;
+				}
+			}
 
-							// Remap EnumEntries from old internal names to new names
-							for (FName& Entry : SwitchNode->EnumEntries)
-							{
-								if (const FName* NewVal = ValueNameMap.Find(Entry))
-								{
-									Entry = *NewVal;
-								}
-							}
+			// NO ReconstructNode — pin names don't change for enums
+			for (const FBlueprintEdits::FPinEdit& Edit : Edits.Pins)
+			{
+				UEdGraphPin* Pin = Edit.Pin.Get();
+				if (!Pin) continue;
 
-							// Rename Switch node pin FNames from BP-style to C++-style
-							// so they match what the C++ enum generates on reload
-							for (UEdGraphPin* Pin : SwitchNode->Pins)
-							{
-								if (!Pin || Pin->Direction != EGPD_Output) continue;
-								FString PinNameStr = Pin->PinName.ToString();
-								// Check if pin name starts with the enum prefix (qualified name)
-								if (PinNameStr.StartsWith(OldEnumPrefix))
-								{
-									FString OldValuePart = PinNameStr.RightChop(OldEnumPrefix.Len());
-									FName OldValueFName(*OldValuePart);
-									if (const FName* NewVal = ValueNameMap.Find(OldValueFName))
-									{
-										Pin->PinName = FName(*(NewEnumPrefix + NewVal->ToString()));
-									}
-								}
-								else
-								{
-									// Try bare name (without prefix) in case pin uses display name
-									FName BareName = Pin->PinName;
-									if (const FName* NewVal = ValueNameMap.Find(BareName))
-									{
-										Pin->PinName = FName(*(NewEnumPrefix + NewVal->ToString()));
-									}
-								}
-							}
+				const UObject* PinEnum = Pin->PinType.PinSubCategoryObject.Get();
+				if (PinEnum != (Edit.bRetype ? OldEnum : NewEnum)) continue;
 
-							// Directly update enum pointer without reconstructing
-							SwitchNode->Enum = NewEnum;
-							PinCount++;
-							// Fall through to also update pin types below
-						}
-					}
+				if (Edit.bRetype)
+				{
+					Pin->PinType.PinSubCategoryObject = NewEnum;
+				}
+				if (Edit.DefaultValue.IsSet())
+				{
+					Pin->DefaultValue = Edit.DefaultValue.GetValue();
+				}
+				if (Edit.AutogeneratedDefaultValue.IsSet())
+				{
+					Pin->AutogeneratedDefaultValue = Edit.AutogeneratedDefaultValue.GetValue();
+				}
+				if (Edit.DefaultValue.IsSet() || Edit.AutogeneratedDefaultValue.IsSet())
+				{
+					++PinCount;
+				}
+			}
 
-					// Handle Byte to Enum conversion nodes — update Enum field and reconstruct
-					if (UK2Node_CastByteToEnum* CastNode = Cast<UK2Node_CastByteToEnum>(Node))
-					{
-						if (CastNode->Enum == OldEnum)
-						{
-							// Save connections (simple: just byte input and enum output)
-							struct FCastPinConn { FName PinName; EEdGraphPinDirection Dir; FGuid RemoteGuid; FName RemotePin; };
-							TArray<FCastPinConn> SavedConns;
-							for (UEdGraphPin* Pin : CastNode->Pins)
-							{
-								if (!Pin) continue;
-								for (UEdGraphPin* Linked : Pin->LinkedTo)
-								{
-									if (Linked && Linked->GetOwningNode())
-										SavedConns.Add({Pin->PinName, Pin->Direction, Linked->GetOwningNode()->NodeGuid, Linked->PinName});
-								}
-								Pin->BreakAllPinLinks();
-							}
+			// Finalize — no RefreshAllNodes to avoid breaking connections
+			FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+		}
 
-							CastNode->Enum = NewEnum;
-							CastNode->ReconstructNode();
+		TotalPinsMigrated += PinCount;
+		TotalVariablesMigrated += VarCount;
 
-							// Restore connections
-							for (const FCastPinConn& C : SavedConns)
-							{
-								UEdGraphPin* OurPin = nullptr;
-								for (UEdGraphPin* Pin : CastNode->Pins)
-								{
-									if (Pin && Pin->PinName == C.PinName && Pin->Direction == C.Dir) { OurPin = Pin; break; }
-								}
-								if (!OurPin)
-								{
-									// Try matching by direction only (pin names might change)
-									for (UEdGraphPin* Pin : CastNode->Pins)
-									{
-										if (Pin && Pin->Direction == C.Dir && Pin->LinkedTo.Num() == 0) { OurPin = Pin; break; }
-									}
-								}
-								if (OurPin)
-								{
-									for (UEdGraphNode* SN : Graph->Nodes)
-									{
-										if (SN && SN->NodeGuid == C.RemoteGuid)
-										{
-											for (UEdGraphPin* RP : SN->Pins)
-											{
-												if (RP && RP->PinName == C.RemotePin) { OurPin->MakeLinkTo(RP); break; }
-											}
-											break;
-										}
-									}
-								}
-							}
-							PinCount++;
-							continue; // Skip generic pin loop — reconstruction handled pins
-						}
-					}
+		BPReport->SetNumberField(TEXT("pins_migrated"), PinCount);
+		BPReport->SetNumberField(TEXT("variables_migrated"), VarCount);
+		BlueprintReportsArray.Add(MakeShared<FJsonValueObject>(BPReport));
+	}
 
-					// Handle Select nodes — update private fields via reflection (no SetEnum/ReconstructNode)
-					if (UK2Node_Select* SelectNode = Cast<UK2Node_Select>(Node))
-					{
-						if (SelectNode->GetEnum() == OldEnum)
-						{
-							UClass* SelectClass = SelectNode->GetClass();
+	// Switch on Enum: update the internal Enum reference.
+	// Do NOT call SetEnum() as it rebuilds pins and breaks connections
+	void ApplySwitchNode(UK2Node_SwitchEnum* SwitchNode)
+	{
+		// Build pin FName rename map: OldEnum::OldInternalName → NewEnum::NewValueName
+		// Pin FNames use qualified format "EnumName::ValueName"
+		FString OldEnumPrefix = OldEnum->GetName() + TEXT("::");
+		FString NewEnumPrefix = NewEnum->GetName() + TEXT("::");
 
-							// 1. Update private Enum field
-							FObjectProperty* EnumProp = CastField<FObjectProperty>(SelectClass->FindPropertyByName(TEXT("Enum")));
-							if (EnumProp)
-							{
-								void** EnumPtr = EnumProp->ContainerPtrToValuePtr<void*>(SelectNode);
-								*EnumPtr = NewEnum;
-							}
+		// Remap EnumEntries from old internal names to new names
+		for (FName& Entry : SwitchNode->EnumEntries)
+		{
+			if (const FName* NewVal = ValueNameMap.Find(Entry))
+			{
+				Entry = *NewVal;
+			}
+		}
 
-							// 2. Update private IndexPinType.PinSubCategoryObject
-							FStructProperty* IndexPinTypeProp = CastField<FStructProperty>(SelectClass->FindPropertyByName(TEXT("IndexPinType")));
-							if (IndexPinTypeProp)
-							{
-								FEdGraphPinType* IndexPinTypePtr = IndexPinTypeProp->ContainerPtrToValuePtr<FEdGraphPinType>(SelectNode);
-								IndexPinTypePtr->PinSubCategoryObject = NewEnum;
-							}
+		// Rename Switch node pin FNames from BP-style to C++-style
+		// so they match what the C++ enum generates on reload
+		for (UEdGraphPin* Pin : SwitchNode->Pins)
+		{
+			if (!Pin || Pin->Direction != EGPD_Output) continue;
+			FString PinNameStr = Pin->PinName.ToString();
+			// Check if pin name starts with the enum prefix (qualified name)
+			if (PinNameStr.StartsWith(OldEnumPrefix))
+			{
+				FString OldValuePart = PinNameStr.RightChop(OldEnumPrefix.Len());
+				FName OldValueFName(*OldValuePart);
+				if (const FName* NewVal = ValueNameMap.Find(OldValueFName))
+				{
+					Pin->PinName = FName(*(NewEnumPrefix + NewVal->ToString()));
+				}
+			}
+			else
+			{
+				// Try bare name (without prefix) in case pin uses display name
+				FName BareName = Pin->PinName;
+				if (const FName* NewVal = ValueNameMap.Find(BareName))
+				{
+					Pin->PinName = FName(*(NewEnumPrefix + NewVal->ToString()));
+				}
+			}
+		}
 
-							// 3. Build new EnumEntries from NewEnum and update private field
-							TArray<FName> NewEnumEntries;
-							for (int32 i = 0; i < NewEnum->NumEnums() - 1; ++i)
-							{
-								bool bHidden = NewEnum->HasMetaData(TEXT("Hidden"), i) || NewEnum->HasMetaData(TEXT("Spacer"), i);
-								if (!bHidden)
-								{
-									NewEnumEntries.Add(FName(*NewEnum->GetNameStringByIndex(i)));
-								}
-							}
+		// Directly update enum pointer without reconstructing
+		SwitchNode->Enum = NewEnum;
+	}
 
-							FArrayProperty* EnumEntriesProp = CastField<FArrayProperty>(SelectClass->FindPropertyByName(TEXT("EnumEntries")));
-							if (EnumEntriesProp)
-							{
-								TArray<FName>* EntriesPtr = EnumEntriesProp->ContainerPtrToValuePtr<TArray<FName>>(SelectNode);
-
-								// 4. Rename option pins: map old entry names to new entry names
-								// Old EnumEntries has the BP enum internal names (NewEnumerator0, etc.)
-								TArray<FName> OldEntries = *EntriesPtr;
-								for (int32 i = 0; i < OldEntries.Num() && i < NewEnumEntries.Num(); ++i)
-								{
-									FName OldPinName = OldEntries[i];
-									FName NewPinName = NewEnumEntries[i];
-									for (UEdGraphPin* Pin : SelectNode->Pins)
-									{
-										if (Pin && Pin->PinName == OldPinName)
-										{
-											Pin->PinName = NewPinName;
-											// Also update default value if it matches old enum value
-											if (!Pin->DefaultValue.IsEmpty())
-											{
-												FName OldVal = FName(*Pin->DefaultValue);
-												if (const FName* NewVal = ValueNameMap.Find(OldVal))
-												{
-													Pin->DefaultValue = NewVal->ToString();
-												}
-												else if (const FString* NewValStr = DisplayToNewValue.Find(Pin->DefaultValue))
-												{
-													Pin->DefaultValue = *NewValStr;
-												}
-											}
-											break;
-										}
-									}
-								}
-
-								// Write new EnumEntries
-								*EntriesPtr = NewEnumEntries;
-							}
+	// Byte to Enum: update the Enum field and reconstruct, keeping the node's links
+	void ApplyCastNode(UK2Node_CastByteToEnum* CastNode, UEdGraph* Graph)
+	{
+		// Save connections (simple: just byte input and enum output)
+		struct FCastPinConn { FName PinName; EEdGraphPinDirection Dir; FGuid RemoteGuid; FName RemotePin; };
+		TArray<FCastPinConn> SavedConns;
+		for (UEdGraphPin* Pin : CastNode->Pins)
+		{
+			if (!Pin) continue;
+			for (UEdGraphPin* Linked : Pin->LinkedTo)
+			{
+				if (Linked && Linked->GetOwningNode())
+					SavedConns.Add({Pin->PinName, Pin->Direction, Linked->GetOwningNode()->NodeGuid, Linked->PinName});
+			}
+			Pin->BreakAllPinLinks();
+		}
 
-							// 5. Update Index pin's PinSubCategoryObject
-							for (UEdGraphPin* Pin : SelectNode->Pins)
-							{
-								if (Pin && Pin->PinName == TEXT("Index"))
-								{
-									Pin->PinType.PinSubCategoryObject = NewEnum;
-									// Remap default value
-									if (!Pin->DefaultValue.IsEmpty())
-									{
-										FName OldVal = FName(*Pin->DefaultValue);
-										if (const FName* NewVal = ValueNameMap.Find(OldVal))
-										{
-											Pin->DefaultValue = NewVal->ToString();
-										}
-										else if (const FString* NewValStr = DisplayToNewValue.Find(Pin->DefaultValue))
-										{
-											Pin->DefaultValue = *NewValStr;
-										}
-									}
-									break;
-								}
-							}
+		CastNode->Enum = NewEnum;
+		CastNode->ReconstructNode();
 
-							PinCount++;
-							continue; // Skip generic pin loop — Select fully handled
+		// Restore connections
+		for (const FCastPinConn& C : SavedConns)
+		{
+			UEdGraphPin* OurPin = nullptr;
+			for (UEdGraphPin* Pin : CastNode->Pins)
+			{
+				if (Pin && Pin->PinName == C.PinName && Pin->Direction == C.Dir) { OurPin = Pin; break; }
+			}
+			if (!OurPin)
+			{
+				// Try matching by direction only (pin names might change)
+				for (UEdGraphPin* Pin : CastNode->Pins)
+				{
+					if (Pin && Pin->Direction == C.Dir && Pin->LinkedTo.Num() == 0) { OurPin = Pin; break; }
+				}
+			}
+			if (OurPin)
+			{
+				for (UEdGraphNode* SN : Graph->Nodes)
+				{
+					if (SN && SN->NodeGuid == C.RemoteGuid)
+					{
+						for (UEdGraphPin* RP : SN->Pins)
+						{
+							if (RP && RP->PinName == C.RemotePin) { OurPin->MakeLinkTo(RP); break; }
 						}
+						break;
 					}
+				}
+			}
+		}
+	}
 
-					for (UEdGraphPin* Pin : Node->Pins)
-					{
-						if (Pin->PinType.PinSubCategoryObject.Get() == OldEnum)
-						{
-							Pin->PinType.PinSubCategoryObject = NewEnum;
+	// Select: update private fields via reflection (no SetEnum/ReconstructNode)
+	void ApplySelectNode(UK2Node_Select* SelectNode)
+	{
+		UClass* SelectClass = SelectNode->GetClass();
 
-							// Remap default value: try internal name first, then display name
-							bool bDefaultFixed = false;
-							if (!Pin->DefaultValue.IsEmpty())
-							{
-								FName OldVal = FName(*Pin->DefaultValue);
-								if (const FName* NewVal = ValueNameMap.Find(OldVal))
-								{
-									Pin->DefaultValue = NewVal->ToString();
-									bDefaultFixed = true;
-								}
-								else if (const FString* NewValStr = DisplayToNewValue.Find(Pin->DefaultValue))
-								{
-									Pin->DefaultValue = *NewValStr;
-									bDefaultFixed = true;
-								}
-								else
-								{
-									bDefaultFixed = RemapEnumDefault(Pin->DefaultValue);
-								}
-							}
+		// 1. Update private Enum field
+		FObjectProperty* EnumProp = CastField<FObjectProperty>(SelectClass->FindPropertyByName(TEXT("Enum")));
+		if (EnumProp)
+		{
+			void** EnumPtr = EnumProp->ContainerPtrToValuePtr<void*>(SelectNode);
+			*EnumPtr = NewEnum;
+		}
 
-							bool bAutoFixed = RemapEnumDefault(Pin->AutogeneratedDefaultValue);
+		// 2. Update private IndexPinType.PinSubCategoryObject
+		FStructProperty* IndexPinTypeProp = CastField<FStructProperty>(SelectClass->FindPropertyByName(TEXT("IndexPinType")));
+		if (IndexPinTypeProp)
+		{
+			FEdGraphPinType* IndexPinTypePtr = IndexPinTypeProp->ContainerPtrToValuePtr<FEdGraphPinType>(SelectNode);
+			IndexPinTypePtr->PinSubCategoryObject = NewEnum;
+		}
 
-							if (bDefaultFixed || bAutoFixed)
-							{
-								PinCount++;
-							}
-						}
-						// Cleanup pass: fix pins already typed as NewEnum but with stale NewEnumerator* defaults
-						// (happens when struct reconstruction set C++ enum type but preserved old default values)
-						else if (Pin->PinType.PinSubCategoryObject.Get() == NewEnum && !Pin->DefaultValue.IsEmpty())
+		// 3. Build new EnumEntries from NewEnum and update private field
+		TArray<FName> NewEnumEntries;
+		for (int32 i = 0; i < NewEnum->NumEnums() - 1; ++i)
+		{
+			bool bHidden = NewEnum->HasMetaData(TEXT("Hidden"), i) || NewEnum->HasMetaData(TEXT("Spacer"), i);
+			if (!bHidden)
+			{
+				NewEnumEntries.Add(FName(*NewEnum->GetNameStringByIndex(i)));
+			}
+		}
+
+		FArrayProperty* EnumEntriesProp = CastField<FArrayProperty>(SelectClass->FindPropertyByName(TEXT("EnumEntries")));
+		if (EnumEntriesProp)
+		{
+			TArray<FName>* EntriesPtr = EnumEntriesProp->ContainerPtrToValuePtr<TArray<FName>>(SelectNode);
+
+			// 4. Rename option pins: map old entry names to new entry names
+			// Old EnumEntries has the BP enum internal names (NewEnumerator0, etc.)
+			TArray<FName> OldEntries = *EntriesPtr;
+			for (int32 i = 0; i < OldEntries.Num() && i < NewEnumEntries.Num(); ++i)
+			{
+				FName OldPinName = OldEntries[i];
+				FName NewPinName = NewEnumEntries[i];
+				for (UEdGraphPin* Pin : SelectNode->Pins)
+				{
+					if (Pin && Pin->PinName == OldPinName)
+					{
+						Pin->PinName = NewPinName;
+						// Also update default value if it matches old enum value
+						if (!Pin->DefaultValue.IsEmpty())
 						{
-							bool bDefaultFixed = false;
 							FName OldVal = FName(*Pin->DefaultValue);
 							if (const FName* NewVal = ValueNameMap.Find(OldVal))
 							{
 								Pin->DefaultValue = NewVal->ToString();
-								bDefaultFixed = true;
 							}
 							else if (const FString* NewValStr = DisplayToNewValue.Find(Pin->DefaultValue))
 							{
 								Pin->DefaultValue = *NewValStr;
-								bDefaultFixed = true;
-							}
-							else
-							{
-								bDefaultFixed = RemapEnumDefault(Pin->DefaultValue);
-							}
-
-							bool bAutoFixed = RemapEnumDefault(Pin->AutogeneratedDefaultValue);
-							if (bDefaultFixed || bAutoFixed)
-							{
-								PinCount++;
 							}
 						}
+						break;
 					}
 				}
 			}
 
-			// Finalize — no RefreshAllNodes to avoid breaking connections
-			FBlueprintEditorUtils::MarkBlueprintAsStructurallyModified(Blueprint);
+			// Write new EnumEntries
+			*EntriesPtr = NewEnumEntries;
 		}
-		else
+
+		// 5. Update Index pin's PinSubCategoryObject
+		for (UEdGraphPin* Pin : SelectNode->Pins)
 		{
-			// Dry run: just count
-			for (const FBPVariableDescription& Var : Blueprint->NewVariables)
+			if (Pin && Pin->PinName == TEXT("Index"))
 			{
-				if (Var.VarType.PinSubCategoryObject.Get() == OldEnum)
-					VarCount++;
-			}
-			TArray<UEdGraph*> AllGraphs;
-			AllGraphs.Append(Blueprint->UbergraphPages);
-			AllGraphs.Append(Blueprint->FunctionGraphs);
-			TArray<UEdGraph*> GraphsToProcess = AllGraphs;
-			while (GraphsToProcess.Num() > 0)
-			{
-				UEdGraph* Graph = GraphsToProcess.Pop();
-				for (UEdGraphNode* Node : Graph->Nodes)
+				Pin->PinType.PinSubCategoryObject = NewEnum;
+				// Remap default value
+				if (!Pin->DefaultValue.IsEmpty())
 				{
-					for (UEdGraph* SubGraph : Node->GetSubGraphs())
+					FName OldVal = FName(*Pin->DefaultValue);
+					if (const FName* NewVal = ValueNameMap.Find(OldVal))
 					{
-						if (SubGraph && !AllGraphs.Contains(SubGraph))
-						{
-							AllGraphs.Add(SubGraph);
-							GraphsToProcess.Add(SubGraph);
-						}
+						Pin->DefaultValue = NewVal->ToString();
 					}
-				}
-			}
-			for (UEdGraph* Graph : AllGraphs)
-			{
-				for (UEdGraphNode* Node : Graph->Nodes)
-				{
-					for (UEdGraphPin* Pin : Node->Pins)
+					else if (const FString* NewValStr = DisplayToNewValue.Find(Pin->DefaultValue))
 					{
-						if (Pin->PinType.PinSubCategoryObject.Get() == OldEnum)
-							PinCount++;
+						Pin->DefaultValue = *NewValStr;
 					}
 				}
+				break;
 			}
 		}
+	}
 
-		TotalPinsMigrated += PinCount;
-		TotalVariablesMigrated += VarCount;
+	// Parameters
+	bool bDryRun = false;
+	bool bSkipStructFields = false;
+	TSet<FString> SkipBlueprintPaths;
+	TSet<FName> OnlyPackages;
+	bool bOnlyListedBlueprints = false;
 
-		BPReport->SetNumberField(TEXT("pins_migrated"), PinCount);
-		BPReport->SetNumberField(TEXT("variables_migrated"), VarCount);
-		BlueprintReportsArray.Add(MakeShared<FJsonValueObject>(BPReport));
-	}
+	UUserDefinedEnum* OldEnum = nullptr;
+	UEnum* NewEnum = nullptr;
 
-	// Build response
-	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-	Data->SetBoolField(TEXT("dry_run"), bDryRun);
-	Data->SetStringField(TEXT("source_enum"), OldEnum->GetPathName());
-	Data->SetStringField(TEXT("target_enum"), NewEnum->GetPathName());
-	Data->SetNumberField(TEXT("value_mappings_count"), ValueNameMap.Num());
-	Data->SetArrayField(TEXT("value_name_mapping"), ValueMappingsArray);
-	Data->SetNumberField(TEXT("blueprints_affected"), AffectedBlueprints.Num());
-	Data->SetArrayField(TEXT("affected_blueprints"), BlueprintReportsArray);
-	Data->SetNumberField(TEXT("total_pins_migrated"), TotalPinsMigrated);
-	Data->SetNumberField(TEXT("total_variables_migrated"), TotalVariablesMigrated);
-	Data->SetNumberField(TEXT("struct_fields_fixed"), TotalStructFieldsFixed);
-	if (StructFieldReportsArray.Num() > 0)
+	// The BP enum is an asset and could be collected between steps; C++ enums never are
+	TStrongObjectPtr<UUserDefinedEnum> KeepOldEnumAlive;
+
+	TMap<FName, FName> ValueNameMap;          // OldInternalName -> NewInternalName
+	TMap<FString, FString> DisplayToNewValue; // DisplayName -> NewInternalName (for default value remapping)
+	TMap<FString, FString> DefaultFixMap;
+	TArray<TSharedPtr<FJsonValue>> ValueMappingsArray;
+
+	EPhase CurrentPhase = EPhase::StructFields;
+	TArray<FAssetData> AllStructAssets;
+	TSharedRef<FMCPTypeReferenceIndex> TypeIndex;
+	TArray<FName> CandidatePackages;
+
+	// Resolved again when migrated, since the loaded blueprint may be collected in between
+	TArray<FSoftObjectPath> AffectedBlueprintPaths;
+
+	// Blueprints loaded and analyzed together, then applied one per step
+	static constexpr int32 AnalyzeBatchSize = 32;
+	TArray<FBlueprintEdits> Batch;
+	int32 NextToLoad = 0;
+	int32 NextToApply = 0;
+	bool bBatchAnalyzed = false;
+
+	int32 TotalStructFieldsFixed = 0;
+	TArray<TSharedPtr<FJsonValue>> StructFieldReportsArray;
+	TArray<TSharedPtr<FJsonValue>> StructDiagArray;
+
+	TArray<TSharedPtr<FJsonValue>> BlueprintReportsArray;
+	int32 TotalPinsMigrated = 0;
+	int32 TotalVariablesMigrated = 0;
+};
+
+FString FMCPServer::HandleMigrateEnumReferences(const TSharedPtr<FJsonObject>& Params)
+{
+	if (!Params.IsValid())
 	{
-		Data->SetArrayField(TEXT("struct_fields"), StructFieldReportsArray);
+		return MakeError(TEXT("Missing parameters"));
 	}
-	if (StructDiagArray.Num() > 0)
+
+	TSharedRef<FMigrateEnumReferencesJob> Job = MakeShared<FMigrateEnumReferencesJob>(TypeIndex.ToSharedRef());
+	FString Error;
+	if (!Job->Init(Params, Error))
 	{
-		Data->SetArrayField(TEXT("struct_diagnostics"), StructDiagArray);
+		return MakeError(Error);
 	}
-	Data->SetStringField(TEXT("message"),
-		bDryRun ? TEXT("Dry run complete - no changes made") : TEXT("Enum migration complete"));
 
-	return MakeResponse(true, Data);
+	// With "async": true this returns a job id right away and migrates over several frames
+	return RunJob(Job, TEXT("migrate_enum_references"), Params);
 }
 
 FString FMCPServer::HandleFixPinEnumType(const TSharedPtr<FJsonObject>& Params)
@@ -812,21 +1037,18 @@ FString FMCPServer::HandleFixPinEnumType(const TSharedPtr<FJsonObject>& Params)
 	}
 
 	// Find both enums
-	UEnum* WrongEnum = nullptr;
-	UEnum* CorrectEnum = nullptr;
-
-	for (TObjectIterator<UEnum> It; It; ++It)
+	FMCPTypeRegistry& TypeRegistry = FMCPTypeRegistry::Get();
+	auto FindEnum = [&TypeRegistry](const FString& EnumPath) -> UEnum*
 	{
-		FString EnumPath = It->GetPathName();
-		if (EnumPath == WrongEnumPath || It->GetName() == FPaths::GetCleanFilename(WrongEnumPath))
-		{
-			WrongEnum = *It;
-		}
-		if (EnumPath == CorrectEnumPath || It->GetName() == FPaths::GetCleanFilename(CorrectEnumPath))
+		if (UEnum* Enum = TypeRegistry.FindByPath<UEnum>(EnumPath))
 		{
-			CorrectEnum = *It;
+			return Enum;
 		}
-	}
+		TArray<UEnum*> SameName = TypeRegistry.FindAll<UEnum>(FName(*FPaths::GetCleanFilename(EnumPath)));
+		return SameName.Num() > 0 ? SameName.Last() : nullptr;
+	};
+	UEnum* WrongEnum = FindEnum(WrongEnumPath);
+	UEnum* CorrectEnum = FindEnum(CorrectEnumPath);
 
 	if (!WrongEnum) return MakeError(FString::Printf(TEXT("Wrong enum not found: %s"), *WrongEnumPath));
 	if (!CorrectEnum) return MakeError(FString::Printf(TEXT("Correct enum not found: %s"), *CorrectEnumPath));
@@ -929,15 +1151,7 @@ FString FMCPServer::HandleFixEnumDefaults(const TSharedPtr<FJsonObject>& Params)
 	UBlueprint* Blueprint = LoadBlueprintFromPath(BPPath);
 	if (!Blueprint) return MakeError(FString::Printf(TEXT("Blueprint not found: %s"), *BPPath));
 
-	UEnum* TargetEnum = nullptr;
-	for (TObjectIterator<UEnum> It; It; ++It)
-	{
-		if (It->GetPathName() == EnumPath)
-		{
-			TargetEnum = *It;
-			break;
-		}
-	}
+	UEnum* TargetEnum = FMCPTypeRegistry::Get().FindByPath<UEnum>(EnumPath);
 	if (!TargetEnum) return MakeError(FString::Printf(TEXT("Enum not found: %s"), *EnumPath));
 
 	// Load old enum if specified (for mapping old internal names)
@@ -1061,15 +1275,7 @@ FString FMCPServer::HandleFixEnumDefaults(const TSharedPtr<FJsonObject>& Params)
 	TArray<TSharedPtr<FJsonValue>> DiagnosticArray;
 
 	// Also find ALL enum objects named the same (to catch BP/C++ duplicates)
-	FString TargetEnumName = TargetEnum->GetName();
-	TArray<UEnum*> AllSameNameEnums;
-	for (TObjectIterator<UEnum> It; It; ++It)
-	{
-		if (It->GetName() == TargetEnumName)
-		{
-			AllSameNameEnums.Add(*It);
-		}
-	}
+	TArray<UEnum*> AllSameNameEnums = FMCPTypeRegistry::Get().FindAll<UEnum>(TargetEnum->GetFName());
 
 	for (UEdGraph* Graph : AllGraphs)
 	{
@@ -1316,19 +1522,12 @@ FString FMCPServer::HandleForceFixEnumPinDefaults(const TSharedPtr<FJsonObject>&
 	const FString BPPath = Params->GetStringField(TEXT("blueprint_path"));
 	const FString EnumPath = Params->GetStringField(TEXT("enum_path"));
 	const FString PinNameFilter = Params->HasField(TEXT("pin_name_contains")) ? Params->GetStringField(TEXT("pin_name_contains")) : FString();
+	const FMCPGlobPattern PinNamePattern(PinNameFilter, EMCPGlobLiteral::Substring);
 
 	UBlueprint* Blueprint = LoadBlueprintFromPath(BPPath);
 	if (!Blueprint) return MakeError(FString::Printf(TEXT("Blueprint not found: %s"), *BPPath));
 
-	UEnum* TargetEnum = nullptr;
-	for (TObjectIterator<UEnum> It; It; ++It)
-	{
-		if (It->GetPathName() == EnumPath)
-		{
-			TargetEnum = *It;
-			break;
-		}
-	}
+	UEnum* TargetEnum = FMCPTypeRegistry::Get().FindByPath<UEnum>(EnumPath);
 	if (!TargetEnum) return MakeError(FString::Printf(TEXT("Enum not found: %s"), *EnumPath));
 
 	auto RemapNewEnumerator = [TargetEnum](const FString& InValue, FString& OutValue) -> bool
@@ -1419,7 +1618,7 @@ FString FMCPServer::HandleForceFixEnumPinDefaults(const TSharedPtr<FJsonObject>&
 				const bool bEnumMatch =
 					(PinEnumObj == TargetEnum) ||
 					(!PinSubCategory.IsEmpty() && (PinSubCategory == TargetEnumName || PinSubCategory.EndsWith(TargetEnumName)));
-				const bool bNameMatch = !PinNameFilter.IsEmpty() && PinNameStr.Contains(PinNameFilter);
+				const bool bNameMatch = !PinNameFilter.IsEmpty() && PinNamePattern.Matches(PinNameStr);
 
 				if (!bEnumMatch && !bNameMatch) continue;
 
@@ -0,0 +1,382 @@
+#include "MCPServer.h"
+#include "MCPServerTypeIndex.h"
+#include "Engine/Blueprint.h"
+#include "Engine/UserDefinedEnum.h"
+#include "Engine/UserDefinedStruct.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Dom/JsonObject.h"
+#include "Misc/PackageName.h"
+
+namespace MCPMigrationPlan
+{
+	// Rough editor costs, for scheduling rather than promises: loading deserializes the package
+	// from disk, a full compile costs a fixed part plus one that grows with the graphs, and each
+	// migrated use means a pin retype or node reconstruction
+	static constexpr double LoadSecondsPerMegabyte = 0.2;
+	static constexpr double CompileSecondsBase = 0.15;
+	static constexpr double CompileSecondsPerMegabyte = 0.4;
+	static constexpr double MigrateSecondsPerUse = 0.002;
+
+	static constexpr int32 DefaultChunkSize = 25;
+
+	struct FPlannedBlueprint
+	{
+		FName PackageName;
+		FString Path;
+		bool bLoaded = false;
+
+		// Counts are only known for blueprints the type index has a current entry for
+		bool bIndexed = false;
+		int32 Variables = 0;
+		int32 Nodes = 0;
+		int32 Pins = 0;
+
+		int64 DiskBytes = 0;
+		double LoadSeconds = 0.0;
+		double CompileSeconds = 0.0;
+		double MigrateSeconds = 0.0;
+
+		// Blueprints in the same stage do not depend on each other
+		int32 Stage = INDEX_NONE;
+
+		double GetSeconds() const { return LoadSeconds + CompileSeconds + MigrateSeconds; }
+	};
+
+	// "/Game/Data/E_Gait" names the asset "/Game/Data/E_Gait.E_Gait"
+	static FSoftObjectPath ToAssetPath(const FString& Path)
+	{
+		FString ObjectPath = Path.TrimStartAndEnd();
+		if (!ObjectPath.Contains(TEXT(".")))
+		{
+			ObjectPath += TEXT(".") + FPackageName::GetShortName(ObjectPath);
+		}
+		return FSoftObjectPath(ObjectPath);
+	}
+
+	// Stage = one past the latest stage of the planned blueprints it hard-depends on, so parents
+	// and referenced blueprints are migrated first. A blueprint in a dependency cycle is treated
+	// as having no dependency on the one that closed the cycle.
+	static int32 AssignStage(int32 Index, TArray<FPlannedBlueprint>& Blueprints, const TMap<FName, int32>& IndexByPackage,
+		TSet<int32>& InProgress)
+	{
+		FPlannedBlueprint& Blueprint = Blueprints[Index];
+		if (Blueprint.Stage != INDEX_NONE)
+		{
+			return Blueprint.Stage;
+		}
+
+		bool bAlreadyInProgress = false;
+		InProgress.Add(Index, &bAlreadyInProgress);
+		if (bAlreadyInProgress)
+		{
+			return INDEX_NONE;
+		}
+
+		TArray<FName> Dependencies;
+		FAssetRegistryModule::GetRegistry().GetDependencies(Blueprint.PackageName, Dependencies,
+			UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+
+		int32 Stage = 0;
+		for (const FName Dependency : Dependencies)
+		{
+			const int32* DependencyIndex = IndexByPackage.Find(Dependency);
+			if (DependencyIndex && *DependencyIndex != Index)
+			{
+				Stage = FMath::Max(Stage, AssignStage(*DependencyIndex, Blueprints, IndexByPackage, InProgress) + 1);
+			}
+		}
+
+		InProgress.Remove(Index);
+		Blueprints[Index].Stage = Stage;
+		return Stage;
+	}
+
+	// Splits one stage into ChunkCount chunks of at most ChunkSize blueprints with similar
+	// estimated times: most expensive first, each into the chunk with the least time so far
+	static TArray<TArray<int32>> MakeChunks(TArray<int32> StageBlueprints, const TArray<FPlannedBlueprint>& Blueprints, int32 ChunkSize,
+		TArray<double>& OutChunkSeconds)
+	{
+		StageBlueprints.Sort([&Blueprints](int32 A, int32 B)
+		{
+			return Blueprints[A].GetSeconds() > Blueprints[B].GetSeconds();
+		});
+
+		const int32 ChunkCount = FMath::DivideAndRoundUp(StageBlueprints.Num(), ChunkSize);
+		TArray<TArray<int32>> Chunks;
+		Chunks.SetNum(ChunkCount);
+		OutChunkSeconds.Init(0.0, ChunkCount);
+
+		for (const int32 Index : StageBlueprints)
+		{
+			int32 Best = INDEX_NONE;
+			for (int32 Chunk = 0; Chunk < ChunkCount; ++Chunk)
+			{
+				if (Chunks[Chunk].Num() < ChunkSize && (Best == INDEX_NONE || OutChunkSeconds[Chunk] < OutChunkSeconds[Best]))
+				{
+					Best = Chunk;
+				}
+			}
+			Chunks[Best].Add(Index);
+			OutChunkSeconds[Best] += Blueprints[Index].GetSeconds();
+		}
+		return Chunks;
+	}
+}
+
+FString FMCPServer::HandlePlanMigration(const TSharedPtr<FJsonObject>& Params)
+{
+	using namespace MCPMigrationPlan;
+
+	if (!Params.IsValid() || !Params->HasField(TEXT("source_path")))
+	{
+		return MakeError(TEXT("Missing 'source_path' parameter"));
+	}
+
+	const FString SourcePath = Params->GetStringField(TEXT("source_path"));
+	const FString TargetPath = Params->HasField(TEXT("target_path")) ? Params->GetStringField(TEXT("target_path")) : FString();
+	const int32 ChunkSize = Params->HasField(TEXT("chunk_size")) ? FMath::Max(1, (int32)Params->GetNumberField(TEXT("chunk_size"))) : DefaultChunkSize;
+
+	// The type is looked up in the registry, not loaded
+	IAssetRegistry& AssetRegistry = FAssetRegistryModule::GetRegistry();
+	const FSoftObjectPath TypePath = ToAssetPath(SourcePath);
+	const FAssetData TypeAsset = AssetRegistry.GetAssetByObjectPath(TypePath);
+	if (!TypeAsset.IsValid())
+	{
+		return MakeError(FString::Printf(TEXT("Asset not found in the asset registry: %s"), *SourcePath));
+	}
+
+	// What migrate_enum_references and migrate_struct_references each treat as a use
+	const bool bEnum = TypeAsset.AssetClassPath == UUserDefinedEnum::StaticClass()->GetClassPathName();
+	const bool bStruct = TypeAsset.AssetClassPath == UUserDefinedStruct::StaticClass()->GetClassPathName();
+	if (!bEnum && !bStruct)
+	{
+		return MakeError(FString::Printf(TEXT("%s is a %s; only UserDefinedEnum and UserDefinedStruct migrations can be planned"),
+			*SourcePath, *TypeAsset.AssetClassPath.GetAssetName().ToString()));
+	}
+	const EMCPTypeMatch Match = bEnum ? EMCPTypeMatch::Exact : EMCPTypeMatch::Name;
+
+	TArray<FPlannedBlueprint> Blueprints;
+	TMap<FName, int32> IndexByPackage;
+	for (const FName PackageName : TypeIndex->GetCandidatePackages(TypePath))
+	{
+		if (bStruct && !PackageName.ToString().StartsWith(TEXT("/Game/")))
+		{
+			continue;
+		}
+
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssetsByPackageName(PackageName, Assets);
+		const FAssetData* BlueprintAsset = Assets.FindByPredicate([](const FAssetData& Asset)
+		{
+			return Asset.IsInstanceOf(UBlueprint::StaticClass());
+		});
+		if (!BlueprintAsset)
+		{
+			continue;
+		}
+
+		FPlannedBlueprint Planned;
+		Planned.PackageName = PackageName;
+		Planned.Path = BlueprintAsset->GetObjectPathString();
+		Planned.bLoaded = BlueprintAsset->IsAssetLoaded();
+
+		// A current index entry settles whether the blueprint is affected, and by how much;
+		// without one the registry's package dependency is the best evidence there is
+		if (const FMCPBlueprintTypeReferences* Entry = TypeIndex->FindBlueprintReferences(PackageName))
+		{
+			if (!Entry->ReferencesType(TypePath, Match))
+			{
+				continue;
+			}
+
+			Planned.bIndexed = true;
+			TSet<FGuid> Nodes;
+			for (const FMCPTypeReference& Reference : Entry->References)
+			{
+				if (!Reference.Matches(TypePath, Match))
+				{
+					continue;
+				}
+
+				if (FCString::Strcmp(Reference.Kind, TEXT("variable")) == 0 || FCString::Strcmp(Reference.Kind, TEXT("local_variable")) == 0)
+				{
+					Planned.Variables += Reference.Count;
+				}
+				else if (FCString::Strcmp(Reference.Kind, TEXT("pin")) == 0)
+				{
+					Planned.Pins += Reference.Count;
+				}
+				if (Reference.NodeGuid.IsValid() && FCString::Strcmp(Reference.Kind, TEXT("local_variable")) != 0)
+				{
+					Nodes.Add(Reference.NodeGuid);
+				}
+			}
+			Planned.Nodes = Nodes.Num();
+			Planned.MigrateSeconds = (Planned.Variables + Planned.Pins + Planned.Nodes) * MigrateSecondsPerUse;
+		}
+
+		if (TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(PackageName))
+		{
+			Planned.DiskBytes = FMath::Max<int64>(PackageData->DiskSize, 0);
+		}
+		const double Megabytes = Planned.DiskBytes / (1024.0 * 1024.0);
+		Planned.LoadSeconds = Planned.bLoaded ? 0.0 : Megabytes * LoadSecondsPerMegabyte;
+		Planned.CompileSeconds = CompileSecondsBase + Megabytes * CompileSecondsPerMegabyte;
+
+		IndexByPackage.Add(PackageName, Blueprints.Num());
+		Blueprints.Add(MoveTemp(Planned));
+	}
+
+	int32 StageCount = 0;
+	TSet<int32> InProgress;
+	for (int32 Index = 0; Index < Blueprints.Num(); ++Index)
+	{
+		StageCount = FMath::Max(StageCount, AssignStage(Index, Blueprints, IndexByPackage, InProgress) + 1);
+	}
+
+	// Per-blueprint report and totals
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	TArray<TSharedPtr<FJsonValue>> BlueprintsArray;
+	int32 IndexedCount = 0;
+	int32 LoadedCount = 0;
+	int32 TotalVariables = 0;
+	int32 TotalNodes = 0;
+	int32 TotalPins = 0;
+	int64 TotalBytes = 0;
+	double TotalLoadSeconds = 0.0;
+	double TotalCompileSeconds = 0.0;
+	double TotalSeconds = 0.0;
+
+	for (const FPlannedBlueprint& Planned : Blueprints)
+	{
+		TSharedPtr<FJsonObject> BPObj = MakeShared<FJsonObject>();
+		BPObj->SetStringField(TEXT("path"), Planned.Path);
+		BPObj->SetNumberField(TEXT("stage"), Planned.Stage);
+		BPObj->SetBoolField(TEXT("loaded"), Planned.bLoaded);
+		BPObj->SetBoolField(TEXT("indexed"), Planned.bIndexed);
+		if (Planned.bIndexed)
+		{
+			BPObj->SetNumberField(TEXT("variables"), Planned.Variables);
+			BPObj->SetNumberField(TEXT("nodes"), Planned.Nodes);
+			BPObj->SetNumberField(TEXT("pins"), Planned.Pins);
+		}
+		BPObj->SetNumberField(TEXT("disk_bytes"), Planned.DiskBytes);
+		BPObj->SetNumberField(TEXT("estimated_load_seconds"), Planned.LoadSeconds);
+		BPObj->SetNumberField(TEXT("estimated_compile_seconds"), Planned.CompileSeconds);
+		BlueprintsArray.Add(MakeShared<FJsonValueObject>(BPObj));
+
+		IndexedCount += Planned.bIndexed ? 1 : 0;
+		LoadedCount += Planned.bLoaded ? 1 : 0;
+		TotalVariables += Planned.Variables;
+		TotalNodes += Planned.Nodes;
+		TotalPins += Planned.Pins;
+		TotalBytes += Planned.DiskBytes;
+		TotalLoadSeconds += Planned.LoadSeconds;
+		TotalCompileSeconds += Planned.CompileSeconds;
+		TotalSeconds += Planned.GetSeconds();
+	}
+
+	// Ready-to-run parameters for one chunk, when the target is known
+	const TCHAR* Command = bEnum ? TEXT("migrate_enum_references") : TEXT("migrate_struct_references");
+	auto MakeChunkParams = [&](const TArray<TSharedPtr<FJsonValue>>& ChunkPaths)
+	{
+		TSharedPtr<FJsonObject> ChunkParams = MakeShared<FJsonObject>();
+		ChunkParams->SetStringField(bEnum ? TEXT("source_enum_path") : TEXT("source_struct_path"), SourcePath);
+		ChunkParams->SetStringField(bEnum ? TEXT("target_enum_path") : TEXT("target_struct_path"), TargetPath);
+		ChunkParams->SetArrayField(TEXT("blueprint_paths"), ChunkPaths);
+		if (bEnum)
+		{
+			// Struct fields are fixed once, by the prepare stage
+			ChunkParams->SetBoolField(TEXT("skip_struct_fields"), true);
+			ChunkParams->SetBoolField(TEXT("async"), true);
+		}
+		return ChunkParams;
+	};
+
+	// Stages run in order. The chunks of one stage do not depend on each other, so they can run
+	// in any order or in separate requests, but every chunk runs on the one game thread: a
+	// stage takes as long as all of its chunks together.
+	TArray<TSharedPtr<FJsonValue>> StagesArray;
+
+	if (bEnum && !TargetPath.IsEmpty())
+	{
+		// migrate_enum_references updates UserDefinedStruct fields before any blueprint; with an
+		// empty blueprint list that is all it does
+		TSharedPtr<FJsonObject> PrepareParams = MakeChunkParams(TArray<TSharedPtr<FJsonValue>>());
+		PrepareParams->SetBoolField(TEXT("skip_struct_fields"), false);
+
+		TSharedPtr<FJsonObject> ChunkObj = MakeShared<FJsonObject>();
+		ChunkObj->SetArrayField(TEXT("blueprints"), TArray<TSharedPtr<FJsonValue>>());
+		ChunkObj->SetStringField(TEXT("command"), Command);
+		ChunkObj->SetObjectField(TEXT("params"), PrepareParams);
+
+		TArray<TSharedPtr<FJsonValue>> ChunksArray;
+		ChunksArray.Add(MakeShared<FJsonValueObject>(ChunkObj));
+
+		TSharedPtr<FJsonObject> StageObj = MakeShared<FJsonObject>();
+		StageObj->SetStringField(TEXT("stage"), TEXT("prepare"));
+		StageObj->SetArrayField(TEXT("chunks"), ChunksArray);
+		StagesArray.Add(MakeShared<FJsonValueObject>(StageObj));
+	}
+
+	for (int32 Stage = 0; Stage < StageCount; ++Stage)
+	{
+		TArray<int32> StageBlueprints;
+		for (int32 Index = 0; Index < Blueprints.Num(); ++Index)
+		{
+			if (Blueprints[Index].Stage == Stage)
+			{
+				StageBlueprints.Add(Index);
+			}
+		}
+
+		TArray<double> ChunkSeconds;
+		const TArray<TArray<int32>> Chunks = MakeChunks(StageBlueprints, Blueprints, ChunkSize, ChunkSeconds);
+
+		TArray<TSharedPtr<FJsonValue>> ChunksArray;
+		double StageSeconds = 0.0;
+		for (int32 Chunk = 0; Chunk < Chunks.Num(); ++Chunk)
+		{
+			TArray<TSharedPtr<FJsonValue>> ChunkPaths;
+			for (const int32 Index : Chunks[Chunk])
+			{
+				ChunkPaths.Add(MakeShared<FJsonValueString>(Blueprints[Index].Path));
+			}
+
+			TSharedPtr<FJsonObject> ChunkObj = MakeShared<FJsonObject>();
+			ChunkObj->SetArrayField(TEXT("blueprints"), ChunkPaths);
+			ChunkObj->SetNumberField(TEXT("estimated_seconds"), ChunkSeconds[Chunk]);
+			if (!TargetPath.IsEmpty())
+			{
+				ChunkObj->SetStringField(TEXT("command"), Command);
+				ChunkObj->SetObjectField(TEXT("params"), MakeChunkParams(ChunkPaths));
+			}
+			ChunksArray.Add(MakeShared<FJsonValueObject>(ChunkObj));
+			StageSeconds += ChunkSeconds[Chunk];
+		}
+
+		TSharedPtr<FJsonObject> StageObj = MakeShared<FJsonObject>();
+		StageObj->SetNumberField(TEXT("stage"), Stage);
+		StageObj->SetNumberField(TEXT("estimated_seconds"), StageSeconds);
+		StageObj->SetArrayField(TEXT("chunks"), ChunksArray);
+		StagesArray.Add(MakeShared<FJsonValueObject>(StageObj));
+	}
+
+	Data->SetStringField(TEXT("source"), TypePath.ToString());
+	Data->SetStringField(TEXT("kind"), bEnum ? TEXT("enum") : TEXT("struct"));
+	Data->SetNumberField(TEXT("blueprints_affected"), Blueprints.Num());
+	Data->SetNumberField(TEXT("blueprints_indexed"), IndexedCount);
+	Data->SetNumberField(TEXT("blueprints_loaded"), LoadedCount);
+	Data->SetNumberField(TEXT("total_variables"), TotalVariables);
+	Data->SetNumberField(TEXT("total_nodes"), TotalNodes);
+	Data->SetNumberField(TEXT("total_pins"), TotalPins);
+	Data->SetNumberField(TEXT("total_disk_bytes"), TotalBytes);
+	Data->SetNumberField(TEXT("estimated_load_seconds"), TotalLoadSeconds);
+	Data->SetNumberField(TEXT("estimated_compile_seconds"), TotalCompileSeconds);
+	Data->SetNumberField(TEXT("estimated_seconds"), TotalSeconds);
+	Data->SetNumberField(TEXT("chunk_size"), ChunkSize);
+	Data->SetArrayField(TEXT("blueprints"), BlueprintsArray);
+	Data->SetArrayField(TEXT("plan"), StagesArray);
+	return MakeResponse(true, Data);
+}
@@ -247,11 +247,8 @@ FString FMCPServer::HandleConnectNodes(const TSharedPtr<FJsonObject>& Params)
 	// Mark blueprint as modified
 	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
 
-	// Compile the blueprint
-	FKismetEditorUtilities::CompileBlueprint(Blueprint);
-
-	// Check for compilation errors
-	bool bCompiledSuccessfully = (Blueprint->Status != BS_Error);
+	// Compiled with the other pending edits, not per connection
+	QueueCompile(Blueprint);
 
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetStringField(TEXT("message"), TEXT("Nodes connected successfully"));
@@ -259,7 +256,7 @@ FString FMCPServer::HandleConnectNodes(const TSharedPtr<FJsonObject>& Params)
 	Data->SetStringField(TEXT("source_pin"), SourcePinName);
 	Data->SetStringField(TEXT("target_node"), TargetNode->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
 	Data->SetStringField(TEXT("target_pin"), TargetPinName);
-	Data->SetBoolField(TEXT("compiled_successfully"), bCompiledSuccessfully);
+	Data->SetBoolField(TEXT("compile_pending"), true);
 
 	return MakeResponse(true, Data);
 }
@@ -382,8 +379,8 @@ FString FMCPServer::HandleDisconnectPin(const TSharedPtr<FJsonObject>& Params)
 	// Mark blueprint as modified
 	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
 
-	// Compile the blueprint
-	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	// Compiled with the other pending edits
+	QueueCompile(Blueprint);
 
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetStringField(TEXT("message"), FString::Printf(TEXT("Disconnected %d links from pin"), LinksCount));
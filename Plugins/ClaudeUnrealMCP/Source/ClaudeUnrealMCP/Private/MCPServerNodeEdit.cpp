@@ -120,8 +120,8 @@ FString FMCPServer::HandleDeleteNode(const TSharedPtr<FJsonObject>& Params)
 	// Mark blueprint as modified
 	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
 
-	// Compile the blueprint
-	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	// Compiled with the other pending edits
+	QueueCompile(Blueprint);
 
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetStringField(TEXT("message"), TEXT("Node deleted successfully"));
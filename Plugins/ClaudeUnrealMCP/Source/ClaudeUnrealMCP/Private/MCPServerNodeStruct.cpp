@@ -55,6 +55,7 @@
 #include "EnhancedInputComponent.h"
 #include "Components/ActorComponent.h"
 #include "Kismet2/ComponentEditorUtils.h"
+#include "MCPServerTypeRegistry.h"
 
 FString FMCPServer::HandleAddSetStructNode(const TSharedPtr<FJsonObject>& Params)
 {
@@ -100,15 +101,8 @@ FString FMCPServer::HandleAddSetStructNode(const TSharedPtr<FJsonObject>& Params
 
 	if (!Struct)
 	{
-		// Try to find in any package by iterating
-		for (TObjectIterator<UScriptStruct> It; It; ++It)
-		{
-			if (It->GetName() == StructType)
-			{
-				Struct = *It;
-				break;
-			}
-		}
+		// Try to find in any package by name
+		Struct = FMCPTypeRegistry::Get().FindFirst<UScriptStruct>(FName(*StructType));
 	}
 
 	if (!Struct)
@@ -153,8 +147,8 @@ FString FMCPServer::HandleAddSetStructNode(const TSharedPtr<FJsonObject>& Params
 	// Mark blueprint as modified
 	FBlueprintEditorUtils::MarkBlueprintAsModified(Blueprint);
 
-	// Compile the blueprint
-	FKismetEditorUtilities::CompileBlueprint(Blueprint);
+	// Compiled with the other pending edits
+	QueueCompile(Blueprint);
 
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetStringField(TEXT("message"), TEXT("Set struct node created successfully"));
@@ -294,29 +288,6 @@ FString FMCPServer::HandleFixStructEnumFieldDefaults(const TSharedPtr<FJsonObjec
 		return MakeError(FString::Printf(TEXT("Blueprint not found: %s"), *BPPath));
 	}
 
-	// Build a mapping: NewEnumeratorN -> correct C++ enum name for all loaded C++ enums
-	// We'll map by checking each enum
-	TMap<FString, TMap<FString, FString>> EnumFixMaps; // EnumName -> (OldValue -> NewValue)
-	for (TObjectIterator<UEnum> It; It; ++It)
-	{
-		UEnum* Enum = *It;
-		if (!Enum || Cast<UUserDefinedEnum>(Enum)) continue; // skip BP enums
-
-		TMap<FString, FString> FixMap;
-		for (int32 i = 0; i < Enum->NumEnums() - 1; ++i)
-		{
-			FString OldName = FString::Printf(TEXT("NewEnumerator%d"), i);
-			FString NewName = Enum->GetNameStringByIndex(i);
-			// Strip enum prefix if present (e.g., "E_TraversalActionType::None" -> "None")
-			if (NewName.Contains(TEXT("::")))
-			{
-				NewName = NewName.RightChop(NewName.Find(TEXT("::")) + 2);
-			}
-			FixMap.Add(OldName, NewName);
-		}
-		EnumFixMaps.Add(Enum->GetName(), FixMap);
-	}
-
 	int32 VarsFixed = 0;
 	TArray<TSharedPtr<FJsonValue>> FixedArray;
 
@@ -487,13 +458,19 @@ FString FMCPServer::HandleFixStructEnumFieldDefaults(const TSharedPtr<FJsonObjec
 	}
 
 	// Fix struct enum field SubCategoryObject, compiled FByteProperty::Enum, and DefaultValue
-	// Build map of BP enum -> C++ enum by name
-	TMap<FString, UEnum*> CppEnumsByName;
-	for (TObjectIterator<UEnum> It; It; ++It)
+	// BP enum -> C++ enum by name; the last one found wins, as it did with a full scan
+	auto FindCppEnum = [](const FString& EnumName) -> UEnum*
 	{
-		if (!*It || Cast<UUserDefinedEnum>(*It)) continue;
-		CppEnumsByName.Add(It->GetName(), *It);
-	}
+		TArray<UEnum*> SameName = FMCPTypeRegistry::Get().FindAll<UEnum>(FName(*EnumName));
+		for (int32 Index = SameName.Num() - 1; Index >= 0; --Index)
+		{
+			if (!Cast<UUserDefinedEnum>(SameName[Index]))
+			{
+				return SameName[Index];
+			}
+		}
+		return nullptr;
+	};
 
 	TArray<TSharedPtr<FJsonValue>> DiagArray;
 	for (UUserDefinedStruct* UDS : UsedStructs)
@@ -540,8 +517,7 @@ FString FMCPServer::HandleFixStructEnumFieldDefaults(const TSharedPtr<FJsonObjec
 			DiagObj->SetBoolField(TEXT("sub_cat_is_bp"), SubCatObj ? (Cast<UUserDefinedEnum>(SubCatObj) != nullptr) : false);
 
 			// If compiled enum OR SubCategoryObject points to BP enum, fix it
-			UEnum** CppEnumPtr = CppEnumsByName.Find(EnumName);
-			UEnum* CppEnum = CppEnumPtr ? *CppEnumPtr : nullptr;
+			UEnum* CppEnum = FindCppEnum(EnumName);
 
 			bool bFixed = false;
 			if (CppEnum)
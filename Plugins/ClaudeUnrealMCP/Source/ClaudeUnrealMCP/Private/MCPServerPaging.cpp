@@ -0,0 +1,130 @@
+#include "MCPServerPaging.h"
+#include "Misc/Base64.h"
+
+namespace MCPPaging
+{
+	// Bumped if the cursor layout ever changes, so old cursors fail cleanly
+	static const TCHAR* CursorPrefix = TEXT("c1");
+}
+
+FMCPPage::FMCPPage(const TCHAR* InCommand)
+	: Command(InCommand)
+{
+}
+
+bool FMCPPage::Init(const TSharedPtr<FJsonObject>& Params, FString& OutError)
+{
+	if (!Params.IsValid())
+	{
+		return true;
+	}
+
+	int32 RequestedSize = 0;
+	const bool bHasSize = Params->TryGetNumberField(TEXT("page_size"), RequestedSize);
+
+	FString Cursor;
+	const bool bHasCursor = Params->TryGetStringField(TEXT("cursor"), Cursor) && !Cursor.IsEmpty();
+
+	if (!bHasSize && !bHasCursor)
+	{
+		return true;
+	}
+
+	bPaged = true;
+	PageSize = bHasSize ? FMath::Clamp(RequestedSize, 1, MaxPageSize) : DefaultPageSize;
+
+	if (bHasCursor)
+	{
+		// "c1" <tab> command <tab> last key; the key itself may contain anything
+		FString Decoded;
+		FString Prefix;
+		FString Rest;
+		FString CursorCommand;
+		if (!FBase64::Decode(Cursor, Decoded) || !Decoded.Split(TEXT("\t"), &Prefix, &Rest) ||
+			Prefix != MCPPaging::CursorPrefix || !Rest.Split(TEXT("\t"), &CursorCommand, &AfterKey))
+		{
+			OutError = TEXT("Invalid cursor");
+			return false;
+		}
+		if (CursorCommand != Command)
+		{
+			OutError = FString::Printf(TEXT("Cursor belongs to '%s', not '%s'"), *CursorCommand, Command);
+			return false;
+		}
+		bHasAfterKey = true;
+	}
+
+	Candidates.Reserve(PageSize + 1);
+	return true;
+}
+
+void FMCPPage::Offer(FStringView Key, int32 Index)
+{
+	if (!bPaged)
+	{
+		AllIndices.Add(Index);
+		return;
+	}
+
+	if (bHasAfterKey && !KeyLess(AfterKey, Key))
+	{
+		return;
+	}
+
+	auto HeapLess = [](const FCandidate& A, const FCandidate& B)
+	{
+		// Largest key on top
+		return KeyLess(B.Key, A.Key);
+	};
+
+	if (Candidates.Num() <= PageSize)
+	{
+		Candidates.HeapPush({ FString(Key), Index }, HeapLess);
+	}
+	else if (KeyLess(Key, Candidates.HeapTop().Key))
+	{
+		Candidates.HeapPopDiscard(HeapLess, EAllowShrinking::No);
+		Candidates.HeapPush({ FString(Key), Index }, HeapLess);
+	}
+}
+
+TArray<int32> FMCPPage::Finish()
+{
+	if (!bPaged)
+	{
+		return MoveTemp(AllIndices);
+	}
+
+	Candidates.Sort([](const FCandidate& A, const FCandidate& B)
+	{
+		return KeyLess(A.Key, B.Key);
+	});
+
+	const bool bMore = Candidates.Num() > PageSize;
+	if (bMore)
+	{
+		Candidates.SetNum(PageSize);
+		NextCursor = EncodeCursor(Candidates.Last().Key);
+	}
+
+	TArray<int32> Indices;
+	Indices.Reserve(Candidates.Num());
+	for (const FCandidate& Candidate : Candidates)
+	{
+		Indices.Add(Candidate.Index);
+	}
+	return Indices;
+}
+
+void FMCPPage::WriteCursor(const TSharedPtr<FJsonObject>& Data) const
+{
+	if (!NextCursor.IsEmpty())
+	{
+		Data->SetStringField(TEXT("next_cursor"), NextCursor);
+	}
+}
+
+FString FMCPPage::EncodeCursor(const FString& Key) const
+{
+	return FBase64::Encode(FString::Printf(TEXT("%s\t%s\t%s"), MCPPaging::CursorPrefix, Command, *Key));
+}
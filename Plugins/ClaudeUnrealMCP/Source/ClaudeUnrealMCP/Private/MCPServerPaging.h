@@ -0,0 +1,90 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+
+/**
+ * Keyset pagination for the list commands, driven by the "cursor" and "page_size" parameters.
+ *
+ * Every item has a stable, unique key (an object path, a property name). A paged listing
+ * returns items in key order and a "next_cursor" naming the last key sent; the next page
+ * starts after that key. Items added or removed between calls therefore never shift a page:
+ * nothing that stays is skipped or sent twice. Cursors are opaque to clients and carry the
+ * command they came from.
+ *
+ * Handlers offer items' keys and indices, then serialize only the indices Finish returns, so
+ * the per-item work that matters (building the JSON) is bounded by the page size. A source
+ * kept in key order (KeyLess) seeks past GetAfterKey and offers just GetSeekCount items, so
+ * a page costs the seek plus the page. Any other source offers every item on every page: the
+ * page is picked with a bounded heap, but the scan itself stays O(N). Without either
+ * parameter nothing is paged and Finish returns every offered index in offer order, as before.
+ *
+ *     FMCPPage Page(TEXT("read_actor_properties"));
+ *     if (!Page.Init(Params, Error)) return MakeError(Error);
+ *     for (FProperty* Property : ...) Page.Offer(Property->GetName(), Properties.Add(Property));
+ *     for (const int32 Index : Page.Finish()) { ... }
+ *     Page.WriteCursor(Data);
+ *
+ * Safe to use from any thread.
+ */
+class FMCPPage
+{
+public:
+	explicit FMCPPage(const TCHAR* InCommand);
+
+	/** Reads the paging parameters. False, with OutError set, for a malformed cursor or one from another command. */
+	bool Init(const TSharedPtr<FJsonObject>& Params, FString& OutError);
+
+	bool IsPaged() const { return bPaged; }
+
+	/** Consider one item. Cheap for items that cannot be on this page. */
+	void Offer(FStringView Key, int32 Index);
+
+	/** For sources kept in key order: the key to seek past, null on the first page. */
+	const FString* GetAfterKey() const { return bHasAfterKey ? &AfterKey : nullptr; }
+
+	/** For sources kept in key order: how many items from the seek position to offer. */
+	int32 GetSeekCount() const { return PageSize + 1; }
+
+	/** The order pages follow. Keys compare case-sensitively, so every item has exactly one place. */
+	static bool KeyLess(FStringView A, FStringView B)
+	{
+		return A.Compare(B, ESearchCase::CaseSensitive) < 0;
+	}
+
+	/** Indices of this page's items: in key order when paged, otherwise all of them in offer order. */
+	TArray<int32> Finish();
+
+	/** Adds "next_cursor" when items remain after this page. Call after Finish. */
+	void WriteCursor(const TSharedPtr<FJsonObject>& Data) const;
+
+	/** The next page's cursor, empty on the last page. */
+	const FString& GetNextCursor() const { return NextCursor; }
+
+	static constexpr int32 DefaultPageSize = 100;
+	static constexpr int32 MaxPageSize = 10000;
+
+private:
+	struct FCandidate
+	{
+		FString Key;
+		int32 Index;
+	};
+
+	FString EncodeCursor(const FString& Key) const;
+
+	const TCHAR* Command;
+	bool bPaged = false;
+	int32 PageSize = 0;
+
+	// Items come after this key; empty for the first page
+	FString AfterKey;
+	bool bHasAfterKey = false;
+
+	// Max-heap on key holding the smallest PageSize + 1 keys after AfterKey; the extra one
+	// tells whether another page follows
+	TArray<FCandidate> Candidates;
+	TArray<int32> AllIndices;
+
+	FString NextCursor;
+};
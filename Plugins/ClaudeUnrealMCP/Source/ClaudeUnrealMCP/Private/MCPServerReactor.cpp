@@ -0,0 +1,429 @@
+#include "MCPServerReactor.h"
+#include "MCPServerResponseWriter.h"
+#include "MCPServerEncoding.h"
+#include "MCPServerStats.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+#include "Interfaces/IPv4/IPv4Address.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Common/TcpSocketBuilder.h"
+#include "Common/UdpSocketBuilder.h"
+#include "HAL/RunnableThread.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+namespace MCPReactor
+{
+	// Drop connections that have been silent this long with nothing in flight
+	static constexpr double IdleTimeoutSeconds = 300.0;
+
+	// Drop connections that stop sending halfway through a request
+	static constexpr double PartialRequestTimeoutSeconds = 30.0;
+
+	// Longest the reactor blocks before re-checking timeouts; anything to do wakes it earlier
+	static constexpr int32 MaxWaitMs = 500;
+
+	// The wake socket is waited on in slices that start at MinSliceMs after any activity and
+	// double up to MaxSliceMs while nothing happens; a slice bounds how late client bytes are noticed
+	static constexpr int32 MinSliceMs = 1;
+	static constexpr int32 MaxSliceMs = 16;
+
+	static constexpr int32 RecvChunkSize = 65536;
+}
+
+FMCPServerReactor::FMCPServerReactor(FOnRequest InOnRequest, FOnFrameSent InOnFrameSent)
+	: OnRequest(MoveTemp(InOnRequest))
+	, OnFrameSent(MoveTemp(InOnFrameSent))
+{
+}
+
+FMCPServerReactor::~FMCPServerReactor()
+{
+	Shutdown();
+}
+
+bool FMCPServerReactor::Start(int32 Port)
+{
+	const FIPv4Endpoint Endpoint(FIPv4Address::Any, Port);
+	ListenSocket = FTcpSocketBuilder(TEXT("ClaudeUnrealMCPListener"))
+		.AsReusable()
+		.AsNonBlocking()
+		.BoundToEndpoint(Endpoint)
+		.Listening(16);
+
+	if (!ListenSocket)
+	{
+		return false;
+	}
+
+	WakeSocket = FUdpSocketBuilder(TEXT("ClaudeUnrealMCPWake"))
+		.AsNonBlocking()
+		.BoundToAddress(FIPv4Address(127, 0, 0, 1))
+		.BoundToPort(0)
+		.Build();
+	if (WakeSocket)
+	{
+		WakeAddress = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->CreateInternetAddr();
+		WakeSocket->GetAddress(*WakeAddress);
+
+		bStopping = false;
+		Thread = FRunnableThread::Create(this, TEXT("ClaudeUnrealMCPIO"), 0, TPri_Normal);
+	}
+
+	if (!Thread)
+	{
+		Shutdown();
+		return false;
+	}
+
+	return true;
+}
+
+void FMCPServerReactor::Shutdown()
+{
+	if (Thread)
+	{
+		// Run() closes every connection on its way out
+		Thread->Kill(true);
+		delete Thread;
+		Thread = nullptr;
+	}
+
+	if (ListenSocket)
+	{
+		ListenSocket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ListenSocket);
+		ListenSocket = nullptr;
+	}
+
+	if (WakeSocket)
+	{
+		WakeSocket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(WakeSocket);
+		WakeSocket = nullptr;
+	}
+}
+
+void FMCPServerReactor::Stop()
+{
+	bStopping = true;
+	Wake();
+}
+
+void FMCPServerReactor::Send(FMCPConnection& Connection, TArray<uint8>&& Frame, int32 Tag)
+{
+	if (Connection.bClosed)
+	{
+		return;
+	}
+
+	Connection.QueuedBytes.Add(Frame.Num());
+	Connection.OutboundQueue.Enqueue(FMCPOutboundFrame{MoveTemp(Frame), Tag, FPlatformTime::Seconds()});
+	Wake();
+}
+
+void FMCPServerReactor::Wake()
+{
+	// One byte covers any number of wakes; the I/O thread clears the flag once it has drained
+	// the socket, before it looks at the queues again
+	if (WakeSocket && !bWakePending.exchange(true))
+	{
+		const uint8 Byte = 0;
+		int32 BytesSent = 0;
+		WakeSocket->SendTo(&Byte, 1, BytesSent, *WakeAddress);
+	}
+}
+
+void FMCPServerReactor::DrainWakeSocket()
+{
+	uint8 Bytes[64];
+	int32 BytesRead = 0;
+	while (WakeSocket->Recv(Bytes, sizeof(Bytes), BytesRead) && BytesRead > 0)
+	{
+	}
+	bWakePending = false;
+}
+
+uint32 FMCPServerReactor::Run()
+{
+	while (!bStopping)
+	{
+		AcceptConnections();
+
+		const double Now = FPlatformTime::Seconds();
+		for (int32 Index = Connections.Num() - 1; Index >= 0; --Index)
+		{
+			const FMCPConnectionRef Connection = Connections[Index];
+
+			if (Connection->bClosed)
+			{
+				CloseConnection(Connection, TEXT("closed"));
+				continue;
+			}
+			if (!ReadConnection(Connection))
+			{
+				CloseConnection(Connection, TEXT("peer disconnected"));
+				continue;
+			}
+			if (!WriteConnection(*Connection))
+			{
+				CloseConnection(Connection, TEXT("send failed"));
+				continue;
+			}
+			// Responses are queued before their request leaves flight, so checking in this order
+			// cannot miss one
+			if (Connection->bReadClosed && Connection->InFlightRequests.GetValue() == 0 &&
+				Connection->SendBuffer.Num() == 0 && Connection->OutboundQueue.IsEmpty())
+			{
+				CloseConnection(Connection, TEXT("peer disconnected"));
+				continue;
+			}
+
+			const double Silence = Now - Connection->LastActivityTime;
+			if (Connection->InFlightRequests.GetValue() == 0 && Connection->SendBuffer.Num() == 0)
+			{
+				if (Connection->Reader.HasPartialFrame() && Silence > MCPReactor::PartialRequestTimeoutSeconds)
+				{
+					CloseConnection(Connection, TEXT("incomplete request timed out"));
+				}
+				else if (Silence > MCPReactor::IdleTimeoutSeconds)
+				{
+					CloseConnection(Connection, TEXT("idle"));
+				}
+			}
+		}
+
+		WaitForActivity();
+	}
+
+	for (int32 Index = Connections.Num() - 1; Index >= 0; --Index)
+	{
+		CloseConnection(Connections[Index], TEXT("server stopping"));
+	}
+
+	return 0;
+}
+
+void FMCPServerReactor::AcceptConnections()
+{
+	ISocketSubsystem* SocketSubsystem = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM);
+
+	bool bHasPendingConnection = false;
+	while (ListenSocket->HasPendingConnection(bHasPendingConnection) && bHasPendingConnection)
+	{
+		TSharedRef<FInternetAddr> RemoteAddress = SocketSubsystem->CreateInternetAddr();
+		FSocket* ClientSocket = ListenSocket->Accept(*RemoteAddress, TEXT("ClaudeUnrealMCPClient"));
+		if (!ClientSocket)
+		{
+			break;
+		}
+
+		// Enable TCP settings for better connection handling
+		ClientSocket->SetLinger(false, 0);      // Don't wait on close
+		ClientSocket->SetNoDelay(true);         // Disable Nagle's algorithm for low latency
+		ClientSocket->SetNonBlocking(true);     // The reactor never blocks on a single client
+
+		Connections.Add(MakeShared<FMCPConnection, ESPMode::ThreadSafe>(ClientSocket, NextConnectionId++));
+
+		UE_LOG(LogTemp, Log, TEXT("ClaudeUnrealMCP: Client connected from %s"), *RemoteAddress->ToString(true));
+	}
+}
+
+bool FMCPServerReactor::ReadConnection(const FMCPConnectionRef& Connection)
+{
+	FSocket* Socket = Connection->Socket;
+
+	if (Connection->bReadClosed || !Socket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::Zero()))
+	{
+		return true;
+	}
+
+	// Data goes straight into the connection's ring buffer, which grows as needed for large
+	// requests. FSocket::Recv reports a clean close by the peer, like any other error, as
+	// failure, and a would-block as success with nothing read.
+	FMCPRingBuffer& Buffer = Connection->Reader.GetBuffer();
+	bool bReadAnything = false;
+	while (true)
+	{
+		const TArrayView<uint8> Region = Buffer.GetWriteRegion(MCPReactor::RecvChunkSize);
+		int32 BytesRead = 0;
+		if (!Socket->Recv(Region.GetData(), Region.Num(), BytesRead))
+		{
+			// The peer is done sending. A client may half-close right after its last request,
+			// so the requests read so far are still answered; if the connection is broken
+			// instead, the next write fails and closes it.
+			Connection->bReadClosed = true;
+			break;
+		}
+		if (BytesRead <= 0)
+		{
+			// Nothing more for now; a spurious readable wake-up lands here too
+			break;
+		}
+
+		bReadAnything = true;
+		Buffer.CommitWrite(BytesRead);
+		if (BytesRead < Region.Num())
+		{
+			break;
+		}
+	}
+
+	if (!bReadAnything)
+	{
+		return true;
+	}
+
+	Connection->LastActivityTime = FPlatformTime::Seconds();
+
+	// Hand every complete frame to the dispatcher; partial frames stay buffered
+	while (true)
+	{
+		TArrayView<const uint8> Payload;
+		FString FrameError;
+		const FMCPFrameReader::EResult Result = Connection->Reader.NextFrame(Payload, FrameError);
+		if (Result == FMCPFrameReader::EResult::NeedMore)
+		{
+			break;
+		}
+		if (Result == FMCPFrameReader::EResult::Error)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("ClaudeUnrealMCP: %s"), *FrameError);
+			return false;
+		}
+
+		if (Payload.Num() > 0)
+		{
+			OnRequest.ExecuteIfBound(Connection, FUtf8StringView(reinterpret_cast<const UTF8CHAR*>(Payload.GetData()), Payload.Num()));
+		}
+	}
+
+	return true;
+}
+
+bool FMCPServerReactor::WriteConnection(FMCPConnection& Connection)
+{
+	while (true)
+	{
+		if (Connection.SendOffset >= Connection.SendBuffer.Num())
+		{
+			if (Connection.SendBuffer.Num() > 0)
+			{
+				// Sent frames go back to the pool so the next large response starts with capacity
+				FMCPBufferPool::Get().Release(MoveTemp(Connection.SendBuffer));
+			}
+			Connection.SendBuffer.Reset();
+			Connection.SendOffset = 0;
+			FMCPOutboundFrame Frame;
+			if (!Connection.OutboundQueue.Dequeue(Frame))
+			{
+				return true;
+			}
+			Connection.SendBuffer = MoveTemp(Frame.Data);
+			Connection.SendTag = Frame.Tag;
+			Connection.SendQueuedTime = Frame.QueuedTime;
+			Connection.QueuedBytes.Subtract(Connection.SendBuffer.Num());
+
+			// Compressing here keeps the cost off the game thread that produced the frame
+			if (Connection.ResponseCompression != EMCPCompression::None)
+			{
+				TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL_STR("MCPServer Compress", MCPServerChannel);
+				MCPEncoding::CompressFrame(Connection.SendBuffer, Connection.ResponseCompression, Connection.CompressionThreshold);
+			}
+		}
+
+		const int32 Remaining = Connection.SendBuffer.Num() - Connection.SendOffset;
+		int32 BytesSent = 0;
+		if (!Connection.Socket->Send(Connection.SendBuffer.GetData() + Connection.SendOffset, Remaining, BytesSent))
+		{
+			const ESocketErrors Error = ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode();
+			if (Error == SE_EWOULDBLOCK)
+			{
+				// Socket buffer is full; keep the rest for the next pass
+				return true;
+			}
+			UE_LOG(LogTemp, Warning, TEXT("ClaudeUnrealMCP: Failed to send response to client"));
+			return false;
+		}
+
+		Connection.SendOffset += BytesSent;
+		Connection.LastActivityTime = FPlatformTime::Seconds();
+
+		if (Connection.SendOffset >= Connection.SendBuffer.Num())
+		{
+			UE_LOG(LogTemp, Verbose, TEXT("ClaudeUnrealMCP: Successfully sent %d bytes"), Connection.SendBuffer.Num());
+			OnFrameSent.ExecuteIfBound(Connection.SendTag, Connection.LastActivityTime - Connection.SendQueuedTime, Connection.SendBuffer.Num());
+		}
+		else if (BytesSent == 0)
+		{
+			return true;
+		}
+	}
+}
+
+void FMCPServerReactor::CloseConnection(const FMCPConnectionRef& Connection, const TCHAR* Reason)
+{
+	UE_LOG(LogTemp, Log, TEXT("ClaudeUnrealMCP: Closing connection %u (%s)"), Connection->ConnectionId, Reason);
+
+	Connection->bClosed = true;
+	if (Connection->Socket)
+	{
+		Connection->Socket->Close();
+		ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(Connection->Socket);
+		Connection->Socket = nullptr;
+	}
+
+	Connection->OutboundQueue.Empty();
+	Connections.Remove(Connection);
+}
+
+void FMCPServerReactor::WaitForActivity()
+{
+	// The socket subsystem has no public call that waits on several sockets at once. The wake
+	// socket, which Send() and Stop() write to, is waited on in slices, and the listener and
+	// clients are checked between slices without blocking. Slices start short after activity
+	// and lengthen while the server is quiet, so an idle server costs little and a busy one
+	// notices new bytes almost at once.
+	const double WaitEnd = FPlatformTime::Seconds() + MCPReactor::MaxWaitMs / 1000.0;
+	bool bActivity = false;
+	while (!bActivity && FPlatformTime::Seconds() < WaitEnd)
+	{
+		bActivity = HasSocketActivity() ||
+			WakeSocket->Wait(ESocketWaitConditions::WaitForRead, FTimespan::FromMilliseconds(WaitSliceMs));
+		if (!bActivity)
+		{
+			WaitSliceMs = FMath::Min(WaitSliceMs * 2, MCPReactor::MaxSliceMs);
+		}
+	}
+	if (bActivity)
+	{
+		WaitSliceMs = MCPReactor::MinSliceMs;
+	}
+	DrainWakeSocket();
+}
+
+bool FMCPServerReactor::HasSocketActivity() const
+{
+	bool bHasPendingConnection = false;
+	if (ListenSocket->HasPendingConnection(bHasPendingConnection) && bHasPendingConnection)
+	{
+		return true;
+	}
+
+	// Clients with a backed-up frame also count once there is room to write. A client that has
+	// stopped sending stays readable at end of stream, so only its writes are waited for.
+	for (const FMCPConnectionRef& Connection : Connections)
+	{
+		const bool bWrite = Connection->SendBuffer.Num() > 0;
+		if (Connection->bReadClosed && !bWrite)
+		{
+			continue;
+		}
+		const ESocketWaitConditions::Type Condition = Connection->bReadClosed ? ESocketWaitConditions::WaitForWrite
+			: bWrite ? ESocketWaitConditions::WaitForReadOrWrite : ESocketWaitConditions::WaitForRead;
+		if (Connection->Socket->Wait(Condition, FTimespan::Zero()))
+		{
+			return true;
+		}
+	}
+	return false;
+}
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "HAL/ThreadSafeBool.h"
+#include "MCPServerConnection.h"
+#include <atomic>
+
+class FSocket;
+class FRunnableThread;
+class FInternetAddr;
+
+/**
+ * Dedicated I/O thread for the MCP server.
+ *
+ * Owns the listen socket and every client socket: accepts connections, reads and frames
+ * requests, writes queued responses and closes idle or stalled connections. Complete
+ * requests are handed to OnRequest; nothing on this thread touches UObjects.
+ */
+class FMCPServerReactor : public FRunnable
+{
+public:
+	/** Payload is one complete UTF-8 frame and is only valid for the duration of the call. */
+	DECLARE_DELEGATE_TwoParams(FOnRequest, const FMCPConnectionRef& /*Connection*/, FUtf8StringView /*Payload*/);
+
+	/** A frame queued with Send has been written in full. Called on the I/O thread. */
+	DECLARE_DELEGATE_ThreeParams(FOnFrameSent, int32 /*Tag*/, double /*SecondsSinceQueued*/, int32 /*BytesWritten*/);
+
+	FMCPServerReactor(FOnRequest InOnRequest, FOnFrameSent InOnFrameSent);
+	virtual ~FMCPServerReactor() override;
+
+	bool Start(int32 Port);
+	void Shutdown();
+
+	/** Queue an encoded frame for the connection; Tag comes back through OnFrameSent. Safe to call from any thread. */
+	void Send(FMCPConnection& Connection, TArray<uint8>&& Frame, int32 Tag = INDEX_NONE);
+
+	// FRunnable
+	virtual uint32 Run() override;
+	virtual void Stop() override;
+
+private:
+	void AcceptConnections();
+	bool ReadConnection(const FMCPConnectionRef& Connection);
+	bool WriteConnection(FMCPConnection& Connection);
+	void CloseConnection(const FMCPConnectionRef& Connection, const TCHAR* Reason);
+	void WaitForActivity();
+	bool HasSocketActivity() const;
+	void Wake();
+	void DrainWakeSocket();
+
+	FOnRequest OnRequest;
+	FOnFrameSent OnFrameSent;
+
+	FSocket* ListenSocket = nullptr;
+	FRunnableThread* Thread = nullptr;
+	FThreadSafeBool bStopping = false;
+
+	// Only touched on the I/O thread
+	TArray<FMCPConnectionRef> Connections;
+	uint32 NextConnectionId = 1;
+
+	// Loopback UDP socket the I/O thread waits on between checks of the other sockets. Send()
+	// and Stop() write a byte to it so the I/O thread wakes as soon as there is something to do.
+	FSocket* WakeSocket = nullptr;
+	TSharedPtr<FInternetAddr> WakeAddress;
+	std::atomic<bool> bWakePending{ false };
+
+	// Current wait slice in WaitForActivity, in milliseconds. I/O thread only.
+	int32 WaitSliceMs = 1;
+};
@@ -47,6 +47,9 @@
 #include "EnhancedInputComponent.h"
 #include "Components/ActorComponent.h"
 #include "Kismet2/ComponentEditorUtils.h"
+#include "MCPServerActorIndex.h"
+#include "MCPServerPaging.h"
+#include "MCPServerFields.h"
 
 FString FMCPServer::HandleListActors(const TSharedPtr<FJsonObject>& Params)
 {
@@ -56,12 +59,119 @@ FString FMCPServer::HandleListActors(const TSharedPtr<FJsonObject>& Params)
 		return MakeError(TEXT("No world available"));
 	}
 
+	FMCPPage Page(TEXT("list_actors"));
+	FString PageError;
+	if (!Page.Init(Params, PageError))
+	{
+		return MakeError(PageError);
+	}
+
+	TArray<AActor*> Actors;
+	if (Page.IsPaged())
+	{
+		// The index keeps actors in path order: seek to the cursor instead of ranking them all
+		TArray<FString> Paths;
+		ActorIndex->GetActorsByPath(World, Page.GetAfterKey(), Page.GetSeekCount(), Actors, Paths);
+		for (int32 Index = 0; Index < Actors.Num(); ++Index)
+		{
+			Page.Offer(Paths[Index], Index);
+		}
+	}
+	else
+	{
+		// Unpaged, Finish hands back every index in offer order; no key is needed
+		Actors = ActorIndex->GetAllActors(World);
+		for (int32 Index = 0; Index < Actors.Num(); ++Index)
+		{
+			Page.Offer(FStringView(), Index);
+		}
+	}
+
 	TArray<TSharedPtr<FJsonValue>> ActorsArray;
-	for (TActorIterator<AActor> It(World); It; ++It)
+	for (const int32 Index : Page.Finish())
+	{
+		AActor* Actor = Actors[Index];
+		TSharedPtr<FJsonObject> ActorObj = MakeShared<FJsonObject>();
+		ActorObj->SetStringField(TEXT("name"), Actor->GetName());
+		ActorObj->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
+		ActorObj->SetStringField(TEXT("label"), Actor->GetActorLabel());
+
+		FVector Location = Actor->GetActorLocation();
+		ActorObj->SetStringField(TEXT("location"), FString::Printf(TEXT("%.1f, %.1f, %.1f"), Location.X, Location.Y, Location.Z));
+
+		ActorsArray.Add(MakeShared<FJsonValueObject>(ActorObj));
+	}
+
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetArrayField(TEXT("actors"), ActorsArray);
+	Data->SetNumberField(TEXT("count"), ActorsArray.Num());
+	Page.WriteCursor(Data);
+
+	return MakeResponse(true, Data);
+}
+
+FString FMCPServer::HandleQueryActors(const TSharedPtr<FJsonObject>& Params)
+{
+	UWorld* World = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+	if (!World)
+	{
+		return MakeError(TEXT("No world available"));
+	}
+
+	FMCPPage Page(TEXT("query_actors"));
+	FString PageError;
+	if (!Page.Init(Params, PageError))
+	{
+		return MakeError(PageError);
+	}
+
+	FMCPActorQuery Query;
+	if (Params.IsValid())
+	{
+		FString NamePattern;
+		if (Params->TryGetStringField(TEXT("name_pattern"), NamePattern) && !NamePattern.IsEmpty())
+		{
+			Query.NamePattern = FMCPGlobPattern(NamePattern);
+		}
+		Params->TryGetStringField(TEXT("actor_class"), Query.ClassName);
+		Params->TryGetBoolField(TEXT("exact_class"), Query.bExactClass);
+
+		int32 MaxResults = 0;
+		if (Params->TryGetNumberField(TEXT("max_results"), MaxResults) && MaxResults > 0)
+		{
+			Query.MaxResults = MaxResults;
+		}
+
+		const TArray<TSharedPtr<FJsonValue>>* MinArray = nullptr;
+		const TArray<TSharedPtr<FJsonValue>>* MaxArray = nullptr;
+		const bool bHasMin = Params->TryGetArrayField(TEXT("bounds_min"), MinArray);
+		const bool bHasMax = Params->TryGetArrayField(TEXT("bounds_max"), MaxArray);
+		if (bHasMin || bHasMax)
+		{
+			if (!bHasMin || !bHasMax || MinArray->Num() != 3 || MaxArray->Num() != 3)
+			{
+				return MakeError(TEXT("bounds_min and bounds_max must both be given as [x, y, z]"));
+			}
+			const FVector Min((*MinArray)[0]->AsNumber(), (*MinArray)[1]->AsNumber(), (*MinArray)[2]->AsNumber());
+			const FVector Max((*MaxArray)[0]->AsNumber(), (*MaxArray)[1]->AsNumber(), (*MaxArray)[2]->AsNumber());
+			Query.Bounds = FBox(Min.ComponentMin(Max), Min.ComponentMax(Max));
+		}
+	}
+
+	// Filters can match actors anywhere in path order, so every match is ranked, by the path
+	// the index already holds for it
+	bool bTruncated = false;
+	TArray<FString> Paths;
+	const TArray<AActor*> Actors = ActorIndex->Query(World, Query, &bTruncated, &Paths);
+	for (int32 Index = 0; Index < Actors.Num(); ++Index)
 	{
-		AActor* Actor = *It;
-		if (!Actor) continue;
+		Page.Offer(Paths[Index], Index);
+	}
 
+	TArray<TSharedPtr<FJsonValue>> ActorsArray;
+	for (const int32 Index : Page.Finish())
+	{
+		AActor* Actor = Actors[Index];
 		TSharedPtr<FJsonObject> ActorObj = MakeShared<FJsonObject>();
 		ActorObj->SetStringField(TEXT("name"), Actor->GetName());
 		ActorObj->SetStringField(TEXT("class"), Actor->GetClass()->GetName());
@@ -76,6 +186,8 @@ FString FMCPServer::HandleListActors(const TSharedPtr<FJsonObject>& Params)
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetArrayField(TEXT("actors"), ActorsArray);
 	Data->SetNumberField(TEXT("count"), ActorsArray.Num());
+	Data->SetBoolField(TEXT("truncated"), bTruncated);
+	Page.WriteCursor(Data);
 
 	return MakeResponse(true, Data);
 }
@@ -95,29 +207,34 @@ FString FMCPServer::HandleReadActorComponents(const TSharedPtr<FJsonObject>& Par
 		return MakeError(TEXT("No world available"));
 	}
 
-	AActor* FoundActor = nullptr;
-	for (TActorIterator<AActor> It(World); It; ++It)
-	{
-		AActor* Actor = *It;
-		if (Actor && Actor->GetName() == ActorName)
-		{
-			FoundActor = Actor;
-			break;
-		}
-	}
+	AActor* FoundActor = ActorIndex->FindByName(World, FName(*ActorName, FNAME_Find));
 
 	if (!FoundActor)
 	{
 		return MakeError(FString::Printf(TEXT("Actor not found: %s"), *ActorName));
 	}
 
-	TArray<TSharedPtr<FJsonValue>> ComponentsArray;
+	FMCPPage Page(TEXT("read_actor_components"));
+	FString PageError;
+	if (!Page.Init(Params, PageError))
+	{
+		return MakeError(PageError);
+	}
+
 	TInlineComponentArray<UActorComponent*> Components;
 	FoundActor->GetComponents(Components);
+	for (int32 Index = 0; Index < Components.Num(); ++Index)
+	{
+		if (Components[Index])
+		{
+			Page.Offer(Components[Index]->GetName(), Index);
+		}
+	}
 
-	for (UActorComponent* Component : Components)
+	TArray<TSharedPtr<FJsonValue>> ComponentsArray;
+	for (const int32 Index : Page.Finish())
 	{
-		if (!Component) continue;
+		UActorComponent* Component = Components[Index];
 
 		TSharedPtr<FJsonObject> CompObj = MakeShared<FJsonObject>();
 		CompObj->SetStringField(TEXT("name"), Component->GetName());
@@ -133,6 +250,7 @@ FString FMCPServer::HandleReadActorComponents(const TSharedPtr<FJsonObject>& Par
 	Data->SetStringField(TEXT("actor_class"), FoundActor->GetClass()->GetName());
 	Data->SetArrayField(TEXT("components"), ComponentsArray);
 	Data->SetNumberField(TEXT("count"), ComponentsArray.Num());
+	Page.WriteCursor(Data);
 
 	return MakeResponse(true, Data);
 }
@@ -153,16 +271,7 @@ FString FMCPServer::HandleReadActorComponentProperties(const TSharedPtr<FJsonObj
 		return MakeError(TEXT("No world available"));
 	}
 
-	AActor* FoundActor = nullptr;
-	for (TActorIterator<AActor> It(World); It; ++It)
-	{
-		AActor* Actor = *It;
-		if (Actor && Actor->GetName() == ActorName)
-		{
-			FoundActor = Actor;
-			break;
-		}
-	}
+	AActor* FoundActor = ActorIndex->FindByName(World, FName(*ActorName, FNAME_Find));
 
 	if (!FoundActor)
 	{
@@ -189,9 +298,23 @@ FString FMCPServer::HandleReadActorComponentProperties(const TSharedPtr<FJsonObj
 		return MakeError(FString::Printf(TEXT("Component not found on actor '%s': %s"), *ActorName, *ComponentName));
 	}
 
-	TArray<TSharedPtr<FJsonValue>> PropsArray;
+	FMCPPage Page(TEXT("read_actor_component_properties"));
+	FString PageError;
+	if (!Page.Init(Params, PageError))
+	{
+		return MakeError(PageError);
+	}
+
+	FMCPFieldSelection Fields;
+	FString FieldsError;
+	if (!Fields.Init(Params, FieldsError))
+	{
+		return MakeError(FieldsError);
+	}
+
 	UClass* ComponentClass = TargetComponent->GetClass();
 
+	TArray<FProperty*> Properties;
 	for (TFieldIterator<FProperty> PropIt(ComponentClass); PropIt; ++PropIt)
 	{
 		FProperty* Property = *PropIt;
@@ -202,28 +325,45 @@ FString FMCPServer::HandleReadActorComponentProperties(const TSharedPtr<FJsonObj
 			continue;
 		}
 
+		Page.Offer(Property->GetName(), Properties.Add(Property));
+	}
+
+	TArray<TSharedPtr<FJsonValue>> PropsArray;
+	for (const int32 PropertyIndex : Page.Finish())
+	{
+		FProperty* Property = Properties[PropertyIndex];
+
 		TSharedPtr<FJsonObject> PropObj = MakeShared<FJsonObject>();
-		PropObj->SetStringField(TEXT("name"), Property->GetName());
-		PropObj->SetStringField(TEXT("type"), Property->GetClass()->GetName());
+		if (Fields.Has(TEXT("name")))
+		{
+			PropObj->SetStringField(TEXT("name"), Property->GetName());
+		}
+		if (Fields.Has(TEXT("type")))
+		{
+			PropObj->SetStringField(TEXT("type"), Property->GetClass()->GetName());
+		}
 
-		FString Category = Property->GetMetaData(TEXT("Category"));
+		FString Category = Fields.Has(TEXT("category")) ? Property->GetMetaData(TEXT("Category")) : FString();
 		if (!Category.IsEmpty())
 		{
 			PropObj->SetStringField(TEXT("category"), Category);
 		}
 
 		void* ValuePtr = Property->ContainerPtrToValuePtr<void>(TargetComponent);
-		FString ValueStr;
-		Property->ExportTextItem_Direct(ValueStr, ValuePtr, nullptr, TargetComponent, PPF_None);
-		PropObj->SetStringField(TEXT("value"), ValueStr);
+		if (IsNestedProperty(Property) ? Fields.HasNested(TEXT("value")) : Fields.Has(TEXT("value")))
+		{
+			FString ValueStr;
+			Property->ExportTextItem_Direct(ValueStr, ValuePtr, nullptr, TargetComponent, PPF_None);
+			PropObj->SetStringField(TEXT("value"), ValueStr);
+		}
 
 		if (FObjectProperty* ObjProp = CastField<FObjectProperty>(Property))
 		{
 			UObject* ObjValue = ObjProp->GetObjectPropertyValue(ValuePtr);
 			if (ObjValue)
 			{
-				PropObj->SetStringField(TEXT("object_value"), ObjValue->GetPathName());
-				PropObj->SetStringField(TEXT("object_class"), ObjValue->GetClass()->GetName());
+				if (Fields.Has(TEXT("object_value"))) PropObj->SetStringField(TEXT("object_value"), ObjValue->GetPathName());
+				if (Fields.Has(TEXT("object_class"))) PropObj->SetStringField(TEXT("object_class"), ObjValue->GetClass()->GetName());
 			}
 		}
 		else if (FClassProperty* ClassProp = CastField<FClassProperty>(Property))
@@ -231,8 +371,8 @@ FString FMCPServer::HandleReadActorComponentProperties(const TSharedPtr<FJsonObj
 			UClass* ClassValue = Cast<UClass>(ClassProp->GetObjectPropertyValue(ValuePtr));
 			if (ClassValue)
 			{
-				PropObj->SetStringField(TEXT("class_value"), ClassValue->GetPathName());
-				PropObj->SetStringField(TEXT("class_name"), ClassValue->GetName());
+				if (Fields.Has(TEXT("class_value"))) PropObj->SetStringField(TEXT("class_value"), ClassValue->GetPathName());
+				if (Fields.Has(TEXT("class_name"))) PropObj->SetStringField(TEXT("class_name"), ClassValue->GetName());
 			}
 		}
 
@@ -245,6 +385,7 @@ FString FMCPServer::HandleReadActorComponentProperties(const TSharedPtr<FJsonObj
 	Data->SetStringField(TEXT("component_class"), ComponentClass->GetName());
 	Data->SetArrayField(TEXT("properties"), PropsArray);
 	Data->SetNumberField(TEXT("count"), PropsArray.Num());
+	Page.WriteCursor(Data);
 
 	return MakeResponse(true, Data);
 }
@@ -47,6 +47,13 @@
 #include "EnhancedInputComponent.h"
 #include "Components/ActorComponent.h"
 #include "Kismet2/ComponentEditorUtils.h"
+#include "MCPServerJobs.h"
+#include "MCPServerCompileCache.h"
+#include "MCPServerCompileQueue.h"
+#include "MCPServerGlob.h"
+#include "MCPServerPaging.h"
+#include "MCPServerFields.h"
+#include "MCPServerAssetQuery.h"
 
 FString FMCPServer::HandleListBlueprints(const TSharedPtr<FJsonObject>& Params)
 {
@@ -56,37 +63,81 @@ FString FMCPServer::HandleListBlueprints(const TSharedPtr<FJsonObject>& Params)
 		PathFilter = Params->GetStringField(TEXT("path"));
 	}
 
-	FAssetRegistryModule& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+	FMCPPage Page(TEXT("list_blueprints"));
+	FString PageError;
+	if (!Page.Init(Params, PageError))
+	{
+		return MakeError(PageError);
+	}
+
+	// Runs on a worker thread (see the command table); the registry is already loaded, so
+	// fetch it directly instead of going through the module manager
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+
+	// A plain path is a prefix
+	const FMCPGlobPattern PathPattern(PathFilter, EMCPGlobLiteral::Prefix);
+
+	// Blueprints and Animation Blueprints in one query, limited to the folder the path names
+	FARFilter Filter;
+	Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+	Filter.ClassPaths.Add(UAnimBlueprint::StaticClass()->GetClassPathName());
+	MCPAssetQuery::AddPackagePathFilter(Filter, PathPattern);
 
 	TArray<FAssetData> Assets;
-	AssetRegistry.Get().GetAssetsByClass(UBlueprint::StaticClass()->GetClassPathName(), Assets);
+	AssetRegistry.GetAssets(Filter, Assets);
 
-	// Also include Animation Blueprints
-	TArray<FAssetData> AnimAssets;
-	AssetRegistry.Get().GetAssetsByClass(UAnimBlueprint::StaticClass()->GetClassPathName(), AnimAssets);
-	Assets.Append(AnimAssets);
+	TStringBuilder<FName::StringBufferSize> PackagePath;
 
-	TArray<TSharedPtr<FJsonValue>> BlueprintArray;
-	for (const FAssetData& Asset : Assets)
+	TStringBuilder<FName::StringBufferSize> ObjectPath;
+	for (int32 AssetIndex = 0; AssetIndex < Assets.Num(); ++AssetIndex)
 	{
-		FString PackagePath = Asset.PackagePath.ToString();
-		if (PackagePath.StartsWith(PathFilter))
+		const FAssetData& Asset = Assets[AssetIndex];
+		PackagePath.Reset();
+		Asset.PackagePath.ToString(PackagePath);
+		if (PathPattern.Matches(PackagePath.ToView()))
 		{
-			TSharedPtr<FJsonObject> BPObj = MakeShared<FJsonObject>();
-			BPObj->SetStringField(TEXT("name"), Asset.AssetName.ToString());
-			BPObj->SetStringField(TEXT("path"), Asset.GetObjectPathString());
-			BlueprintArray.Add(MakeShared<FJsonValueObject>(BPObj));
+			ObjectPath.Reset();
+			Asset.AppendObjectPath(ObjectPath);
+			Page.Offer(ObjectPath.ToView(), AssetIndex);
 		}
 	}
 
+	TArray<TSharedPtr<FJsonValue>> BlueprintArray;
+	for (const int32 AssetIndex : Page.Finish())
+	{
+		const FAssetData& Asset = Assets[AssetIndex];
+		TSharedPtr<FJsonObject> BPObj = MakeShared<FJsonObject>();
+		BPObj->SetStringField(TEXT("name"), Asset.AssetName.ToString());
+		BPObj->SetStringField(TEXT("path"), Asset.GetObjectPathString());
+		BlueprintArray.Add(MakeShared<FJsonValueObject>(BPObj));
+	}
+
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetArrayField(TEXT("blueprints"), BlueprintArray);
 	Data->SetNumberField(TEXT("count"), BlueprintArray.Num());
+	Page.WriteCursor(Data);
 
 	return MakeResponse(true, Data);
 }
 
-FString FMCPServer::HandleCheckAllBlueprints(const TSharedPtr<FJsonObject>& Params)
+namespace MCPQueryAssets
+{
+	// A class filter matches the class's short name, that name without the generated "_C", or its path
+	static bool MatchesClass(const FMCPGlobPattern& Pattern, const FString& ClassPath)
+	{
+		const FString Name = MCPAssetQuery::GetObjectName(ClassPath);
+		return Pattern.Matches(Name) || (Name.EndsWith(TEXT("_C")) && Pattern.Matches(FStringView(Name).LeftChop(2))) ||
+			Pattern.Matches(ClassPath);
+	}
+
+	// Tags that hold whole serialized graphs; only sent when asked for by name
+	static bool IsBulkTag(FName Tag)
+	{
+		return Tag == FBlueprintTags::FindInBlueprintsData || Tag == FBlueprintTags::UnversionedFindInBlueprintsData;
+	}
+}
+
+FString FMCPServer::HandleQueryAssets(const TSharedPtr<FJsonObject>& Params)
 {
 	FString PathFilter = TEXT("/Game/");
 	if (Params.IsValid() && Params->HasField(TEXT("path")))
@@ -94,116 +145,350 @@ FString FMCPServer::HandleCheckAllBlueprints(const TSharedPtr<FJsonObject>& Para
 		PathFilter = Params->GetStringField(TEXT("path"));
 	}
 
-	bool bIncludeWarnings = false;
-	if (Params.IsValid() && Params->HasField(TEXT("include_warnings")))
+	FMCPPage Page(TEXT("query_assets"));
+	FString PageError;
+	if (!Page.Init(Params, PageError))
 	{
-		bIncludeWarnings = Params->GetBoolField(TEXT("include_warnings"));
+		return MakeError(PageError);
 	}
 
-	FAssetRegistryModule& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+	FMCPFieldSelection Fields;
+	FString FieldsError;
+	if (!Fields.Init(Params, FieldsError))
+	{
+		return MakeError(FieldsError);
+	}
 
-	TArray<FAssetData> Assets;
-	AssetRegistry.Get().GetAssetsByClass(UBlueprint::StaticClass()->GetClassPathName(), Assets);
+	// A plain path is a prefix
+	const FMCPGlobPattern PathPattern(PathFilter, EMCPGlobLiteral::Prefix);
 
-	// Also include Animation Blueprints
-	TArray<FAssetData> AnimAssets;
-	AssetRegistry.Get().GetAssetsByClass(UAnimBlueprint::StaticClass()->GetClassPathName(), AnimAssets);
-	Assets.Append(AnimAssets);
+	FARFilter Filter;
+	MCPAssetQuery::AddPackagePathFilter(Filter, PathPattern);
 
-	// Also include Widget Blueprints (UMG widgets, EditorUtilityWidgets)
-	TArray<FAssetData> WidgetAssets;
-	AssetRegistry.Get().GetAssetsByClass(UWidgetBlueprint::StaticClass()->GetClassPathName(), WidgetAssets);
-	Assets.Append(WidgetAssets);
+	// Classes, subclasses included unless exact_class; blueprints of every kind by default
+	TArray<FString> ClassNames;
+	if (Params.IsValid() && !Params->TryGetStringArrayField(TEXT("class"), ClassNames) && Params->HasField(TEXT("class")))
+	{
+		ClassNames.Add(Params->GetStringField(TEXT("class")));
+	}
+	if (ClassNames.Num() == 0)
+	{
+		ClassNames.Add(TEXT("Blueprint"));
+	}
+	for (const FString& ClassName : ClassNames)
+	{
+		const FTopLevelAssetPath ClassPath = MCPAssetQuery::FindAssetClassPath(ClassName);
+		if (ClassPath.IsNull())
+		{
+			return MakeError(FString::Printf(TEXT("Unknown asset class '%s'; give its path, e.g. /Script/Engine.Blueprint"), *ClassName));
+		}
+		Filter.ClassPaths.Add(ClassPath);
+	}
+	Filter.bRecursiveClasses = !(Params.IsValid() && Params->HasField(TEXT("exact_class")) && Params->GetBoolField(TEXT("exact_class")));
 
-	TArray<TSharedPtr<FJsonValue>> BlueprintsWithErrors;
-	int32 TotalChecked = 0;
-	int32 TotalErrors = 0;
-	int32 TotalWarnings = 0;
+	// Exact tag values are matched inside the registry
+	const TSharedPtr<FJsonObject>* TagsObj = nullptr;
+	if (Params.IsValid() && Params->TryGetObjectField(TEXT("tags"), TagsObj))
+	{
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Tag : (*TagsObj)->Values)
+		{
+			Filter.TagsAndValues.Add(FName(*Tag.Key), Tag.Value.IsValid() ? TOptional<FString>(Tag.Value->AsString()) : TOptional<FString>());
+		}
+	}
 
-	for (const FAssetData& Asset : Assets)
+	const FMCPGlobPattern NamePattern(Params.IsValid() && Params->HasField(TEXT("name_pattern")) ? Params->GetStringField(TEXT("name_pattern")) : FString(),
+		EMCPGlobLiteral::Substring);
+	const bool bParentFilter = Params.IsValid() && Params->HasField(TEXT("parent_class"));
+	const FMCPGlobPattern ParentPattern(bParentFilter ? Params->GetStringField(TEXT("parent_class")) : FString());
+	const bool bInterfaceFilter = Params.IsValid() && Params->HasField(TEXT("implements_interface"));
+	const FMCPGlobPattern InterfacePattern(bInterfaceFilter ? Params->GetStringField(TEXT("implements_interface")) : FString());
+
+	// Runs on a worker thread (see the command table), like list_blueprints; nothing is loaded
+	IAssetRegistry& AssetRegistry = IAssetRegistry::GetChecked();
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssets(Filter, Assets);
+
+	TStringBuilder<FName::StringBufferSize> PackagePath;
+	TStringBuilder<FName::StringBufferSize> AssetName;
+	TStringBuilder<FName::StringBufferSize> ObjectPath;
+	for (int32 AssetIndex = 0; AssetIndex < Assets.Num(); ++AssetIndex)
 	{
-		FString PackagePath = Asset.PackagePath.ToString();
-		if (!PackagePath.StartsWith(PathFilter))
+		const FAssetData& Asset = Assets[AssetIndex];
+
+		PackagePath.Reset();
+		Asset.PackagePath.ToString(PackagePath);
+		AssetName.Reset();
+		Asset.AssetName.ToString(AssetName);
+		if (!PathPattern.Matches(PackagePath.ToView()) || !NamePattern.Matches(AssetName.ToView()))
+		{
+			continue;
+		}
+		if (bParentFilter && !MCPQueryAssets::MatchesClass(ParentPattern, MCPAssetQuery::GetClassTag(Asset, FBlueprintTags::ParentClassPath)))
+		{
+			continue;
+		}
+		if (bInterfaceFilter && !MCPAssetQuery::GetImplementedInterfaces(Asset).ContainsByPredicate(
+			[&InterfacePattern](const FString& Interface) { return MCPQueryAssets::MatchesClass(InterfacePattern, Interface); }))
 		{
 			continue;
 		}
 
-		FString BlueprintPath = Asset.GetObjectPathString();
-		UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
+		ObjectPath.Reset();
+		Asset.AppendObjectPath(ObjectPath);
+		Page.Offer(ObjectPath.ToView(), AssetIndex);
+	}
 
-		if (!Blueprint)
+	TArray<TSharedPtr<FJsonValue>> AssetArray;
+	for (const int32 AssetIndex : Page.Finish())
+	{
+		const FAssetData& Asset = Assets[AssetIndex];
+		TSharedPtr<FJsonObject> AssetObj = MakeShared<FJsonObject>();
+		if (Fields.Has(TEXT("name")))
 		{
-			continue;
+			AssetObj->SetStringField(TEXT("name"), Asset.AssetName.ToString());
+		}
+		if (Fields.Has(TEXT("path")))
+		{
+			AssetObj->SetStringField(TEXT("path"), Asset.GetObjectPathString());
+		}
+		if (Fields.Has(TEXT("class")))
+		{
+			AssetObj->SetStringField(TEXT("class"), Asset.AssetClassPath.GetAssetName().ToString());
 		}
 
-		TotalChecked++;
+		// Blueprint metadata, straight from the registry tags
+		if (Fields.Has(TEXT("parent_class")))
+		{
+			const FString ParentClass = MCPAssetQuery::GetClassTag(Asset, FBlueprintTags::ParentClassPath);
+			if (!ParentClass.IsEmpty())
+			{
+				AssetObj->SetStringField(TEXT("parent_class"), ParentClass);
+			}
+		}
+		if (Fields.Has(TEXT("native_parent_class")))
+		{
+			const FString NativeParentClass = MCPAssetQuery::GetClassTag(Asset, FBlueprintTags::NativeParentClassPath);
+			if (!NativeParentClass.IsEmpty())
+			{
+				AssetObj->SetStringField(TEXT("native_parent_class"), NativeParentClass);
+			}
+		}
+		FString BlueprintType;
+		if (Fields.Has(TEXT("blueprint_type")) && Asset.GetTagValue(FBlueprintTags::BlueprintType, BlueprintType))
+		{
+			AssetObj->SetStringField(TEXT("blueprint_type"), BlueprintType);
+		}
+		if (Fields.HasNested(TEXT("implemented_interfaces")) && Asset.TagsAndValues.Contains(FBlueprintTags::ImplementedInterfaces))
+		{
+			TArray<TSharedPtr<FJsonValue>> InterfaceArray;
+			for (const FString& Interface : MCPAssetQuery::GetImplementedInterfaces(Asset))
+			{
+				InterfaceArray.Add(MakeShared<FJsonValueString>(Interface));
+			}
+			AssetObj->SetArrayField(TEXT("implemented_interfaces"), InterfaceArray);
+		}
 
-		// Compile the blueprint
-		FCompilerResultsLog CompileLog;
-		FKismetEditorUtilities::CompileBlueprint(Blueprint, EBlueprintCompileOptions::None, &CompileLog);
+		// Every other tag (NumReplicatedProperties, IsDataOnly, ...); tags{Name,...} picks some
+		if (Fields.HasNested(TEXT("tags")))
+		{
+			const FMCPFieldSelection TagFields = Fields.Nested(TEXT("tags"));
+			const bool bAllTags = TagFields.SelectsAll();
+			TSharedPtr<FJsonObject> TagsOut = MakeShared<FJsonObject>();
+			Asset.TagsAndValues.ForEach([&](const TPair<FName, FAssetTagValueRef>& Tag)
+			{
+				if (bAllTags ? !MCPQueryAssets::IsBulkTag(Tag.Key) : TagFields.Has(Tag.Key.ToString()))
+				{
+					TagsOut->SetStringField(Tag.Key.ToString(), Tag.Value.AsString());
+				}
+			});
+			AssetObj->SetObjectField(TEXT("tags"), TagsOut);
+		}
 
-		// Count errors and warnings
-		int32 ErrorCount = 0;
-		int32 WarningCount = 0;
-		TArray<TSharedPtr<FJsonValue>> ErrorsArray;
-		TArray<TSharedPtr<FJsonValue>> WarningsArray;
+		AssetArray.Add(MakeShared<FJsonValueObject>(AssetObj));
+	}
 
-		for (const TSharedRef<FTokenizedMessage>& Message : CompileLog.Messages)
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetArrayField(TEXT("assets"), AssetArray);
+	Data->SetNumberField(TEXT("count"), AssetArray.Num());
+	Page.WriteCursor(Data);
+
+	return MakeResponse(true, Data);
+}
+
+/** Compiles every blueprint under a path, one blueprint per step. */
+class FCheckAllBlueprintsJob : public FMCPJob
+{
+public:
+	FCheckAllBlueprintsJob(const FString& PathFilter, bool bInIncludeWarnings, const TSharedRef<FMCPCompileCache>& InCompileCache, bool bInUseCache)
+		: bIncludeWarnings(bInIncludeWarnings)
+		, CompileCache(InCompileCache)
+		, bUseCache(bInUseCache)
+	{
+		CompileCache->BeginScan();
+
+		FAssetRegistryModule& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+
+		const FMCPGlobPattern PathPattern(PathFilter, EMCPGlobLiteral::Prefix);
+
+		// Blueprints, Animation Blueprints and Widget Blueprints (UMG widgets,
+		// EditorUtilityWidgets) in one query, limited to the folder the path names
+		FARFilter Filter;
+		Filter.ClassPaths.Add(UBlueprint::StaticClass()->GetClassPathName());
+		Filter.ClassPaths.Add(UAnimBlueprint::StaticClass()->GetClassPathName());
+		Filter.ClassPaths.Add(UWidgetBlueprint::StaticClass()->GetClassPathName());
+		MCPAssetQuery::AddPackagePathFilter(Filter, PathPattern);
+
+		TArray<FAssetData> AllAssets;
+		AssetRegistry.Get().GetAssets(Filter, AllAssets);
+
+		TStringBuilder<FName::StringBufferSize> PackagePath;
+		for (FAssetData& Asset : AllAssets)
 		{
-			if (Message->GetSeverity() == EMessageSeverity::Error)
+			PackagePath.Reset();
+			Asset.PackagePath.ToString(PackagePath);
+			if (PathPattern.Matches(PackagePath.ToView()))
 			{
-				ErrorCount++;
-				TSharedPtr<FJsonObject> MsgObj = MakeShared<FJsonObject>();
-				MsgObj->SetStringField(TEXT("message"), Message->ToText().ToString());
-				ErrorsArray.Add(MakeShared<FJsonValueObject>(MsgObj));
+				Assets.Add(MoveTemp(Asset));
 			}
-			else if (Message->GetSeverity() == EMessageSeverity::Warning)
+		}
+
+		Phase = TEXT("compiling");
+		Total = Assets.Num();
+	}
+
+	virtual bool Step() override
+	{
+		if (Done >= Assets.Num())
+		{
+			return false;
+		}
+
+		CheckBlueprint(Assets[Done]);
+		++Done;
+		return Done < Assets.Num();
+	}
+
+	virtual TSharedPtr<FJsonObject> BuildResult() override
+	{
+		TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+		Data->SetNumberField(TEXT("total_checked"), TotalChecked);
+		Data->SetNumberField(TEXT("compiled"), TotalCompiled);
+		Data->SetNumberField(TEXT("cache_hits"), CacheHits);
+		Data->SetNumberField(TEXT("total_errors"), TotalErrors);
+		Data->SetNumberField(TEXT("total_warnings"), TotalWarnings);
+		Data->SetNumberField(TEXT("blueprints_with_issues"), BlueprintsWithErrors.Num());
+		Data->SetArrayField(TEXT("blueprints"), BlueprintsWithErrors);
+
+		// Also persists partial results of a cancelled run
+		CompileCache->Save();
+		return Data;
+	}
+
+private:
+	void CheckBlueprint(const FAssetData& Asset)
+	{
+		// Unchanged blueprints whose dependencies are unchanged too compile the same way as last time
+		if (bUseCache)
+		{
+			if (const FMCPCompileRecord* Record = CompileCache->Find(Asset.PackageName, CompileCache->ComputeFingerprint(Asset.PackageName)))
 			{
-				WarningCount++;
-				TSharedPtr<FJsonObject> MsgObj = MakeShared<FJsonObject>();
-				MsgObj->SetStringField(TEXT("message"), Message->ToText().ToString());
-				WarningsArray.Add(MakeShared<FJsonValueObject>(MsgObj));
+				CacheHits++;
+				ReportBlueprint(Asset, *Record);
+				return;
 			}
 		}
 
-		// If Blueprint has Error status but CompileLog captured no messages,
-		// add a synthetic error so the BP is still reported
-		if (ErrorCount == 0 && Blueprint->Status == BS_Error)
+		FString BlueprintPath = Asset.GetObjectPathString();
+		UBlueprint* Blueprint = LoadObject<UBlueprint>(nullptr, *BlueprintPath);
+
+		if (!Blueprint)
 		{
-			ErrorCount++;
-			TSharedPtr<FJsonObject> MsgObj = MakeShared<FJsonObject>();
-			MsgObj->SetStringField(TEXT("message"), TEXT("Blueprint has Error status after compilation (errors may have occurred during asset loading/validation)"));
-			ErrorsArray.Add(MakeShared<FJsonValueObject>(MsgObj));
+			return;
 		}
 
-		TotalErrors += ErrorCount;
-		TotalWarnings += WarningCount;
+		TotalCompiled++;
+
+		// Compile the blueprint and count errors and warnings
+		FMCPCompileRecord Record = MoveTemp(FMCPCompileQueue::CompileBlueprint(Blueprint).Messages);
+
+		ReportBlueprint(Asset, Record);
+
+		// Fingerprint taken after compiling, in case compiling itself dirtied the package
+		Record.Fingerprint = CompileCache->ComputeFingerprint(Asset.PackageName);
+		CompileCache->Store(Asset.PackageName, MoveTemp(Record));
+	}
+
+	void ReportBlueprint(const FAssetData& Asset, const FMCPCompileRecord& Record)
+	{
+		TotalChecked++;
+		TotalErrors += Record.ErrorCount;
+		TotalWarnings += Record.WarningCount;
 
 		// Only include blueprints with errors (or warnings if requested)
-		if (ErrorCount > 0 || (bIncludeWarnings && WarningCount > 0))
+		if (Record.ErrorCount > 0 || (bIncludeWarnings && Record.WarningCount > 0))
 		{
+			auto ToMessageArray = [](const TArray<FString>& Messages)
+			{
+				TArray<TSharedPtr<FJsonValue>> MessagesArray;
+				for (const FString& Message : Messages)
+				{
+					TSharedPtr<FJsonObject> MsgObj = MakeShared<FJsonObject>();
+					MsgObj->SetStringField(TEXT("message"), Message);
+					MessagesArray.Add(MakeShared<FJsonValueObject>(MsgObj));
+				}
+				return MessagesArray;
+			};
+
 			TSharedPtr<FJsonObject> BPObj = MakeShared<FJsonObject>();
 			BPObj->SetStringField(TEXT("name"), Asset.AssetName.ToString());
-			BPObj->SetStringField(TEXT("path"), BlueprintPath);
-			BPObj->SetNumberField(TEXT("error_count"), ErrorCount);
-			BPObj->SetNumberField(TEXT("warning_count"), WarningCount);
-			BPObj->SetArrayField(TEXT("errors"), ErrorsArray);
+			BPObj->SetStringField(TEXT("path"), Asset.GetObjectPathString());
+			BPObj->SetNumberField(TEXT("error_count"), Record.ErrorCount);
+			BPObj->SetNumberField(TEXT("warning_count"), Record.WarningCount);
+			BPObj->SetArrayField(TEXT("errors"), ToMessageArray(Record.Errors));
 			if (bIncludeWarnings)
 			{
-				BPObj->SetArrayField(TEXT("warnings"), WarningsArray);
+				BPObj->SetArrayField(TEXT("warnings"), ToMessageArray(Record.Warnings));
 			}
 			BlueprintsWithErrors.Add(MakeShared<FJsonValueObject>(BPObj));
 		}
 	}
 
-	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-	Data->SetNumberField(TEXT("total_checked"), TotalChecked);
-	Data->SetNumberField(TEXT("total_errors"), TotalErrors);
-	Data->SetNumberField(TEXT("total_warnings"), TotalWarnings);
-	Data->SetNumberField(TEXT("blueprints_with_issues"), BlueprintsWithErrors.Num());
-	Data->SetArrayField(TEXT("blueprints"), BlueprintsWithErrors);
+	TArray<FAssetData> Assets;
+	bool bIncludeWarnings = false;
+	TSharedRef<FMCPCompileCache> CompileCache;
+	bool bUseCache = true;
 
-	return MakeResponse(true, Data);
+	TArray<TSharedPtr<FJsonValue>> BlueprintsWithErrors;
+	int32 TotalChecked = 0;
+	int32 TotalCompiled = 0;
+	int32 CacheHits = 0;
+	int32 TotalErrors = 0;
+	int32 TotalWarnings = 0;
+};
+
+FString FMCPServer::HandleCheckAllBlueprints(const TSharedPtr<FJsonObject>& Params)
+{
+	FString PathFilter = TEXT("/Game/");
+	if (Params.IsValid() && Params->HasField(TEXT("path")))
+	{
+		PathFilter = Params->GetStringField(TEXT("path"));
+	}
+
+	bool bIncludeWarnings = false;
+	if (Params.IsValid() && Params->HasField(TEXT("include_warnings")))
+	{
+		bIncludeWarnings = Params->GetBoolField(TEXT("include_warnings"));
+	}
+
+	// Cached results are reused unless asked not to; recompiled results refresh the cache either way
+	bool bUseCache = true;
+	if (Params.IsValid() && Params->HasField(TEXT("use_cache")))
+	{
+		bUseCache = Params->GetBoolField(TEXT("use_cache"));
+	}
+
+	// With "async": true this returns a job id right away and compiles over several frames
+	return RunJob(MakeShared<FCheckAllBlueprintsJob>(PathFilter, bIncludeWarnings, CompileCache.ToSharedRef(), bUseCache), TEXT("check_all_blueprints"), Params);
 }
 
 FString FMCPServer::HandleReadBlueprint(const TSharedPtr<FJsonObject>& Params)
@@ -344,9 +629,22 @@ FString FMCPServer::HandleReadClassDefaults(const TSharedPtr<FJsonObject>& Param
 		return MakeError(TEXT("Failed to get class default object"));
 	}
 
-	TArray<TSharedPtr<FJsonValue>> PropertyArray;
+	FMCPPage Page(TEXT("read_class_defaults"));
+	FString PageError;
+	if (!Page.Init(Params, PageError))
+	{
+		return MakeError(PageError);
+	}
+
+	FMCPFieldSelection Fields;
+	FString FieldsError;
+	if (!Fields.Init(Params, FieldsError))
+	{
+		return MakeError(FieldsError);
+	}
 
-	// Iterate through all properties (including inherited ones)
+	// Iterate through all properties (including inherited ones); only this page's get exported
+	TArray<FProperty*> Properties;
 	for (TFieldIterator<FProperty> PropIt(GeneratedClass); PropIt; ++PropIt)
 	{
 		FProperty* Property = *PropIt;
@@ -357,16 +655,36 @@ FString FMCPServer::HandleReadClassDefaults(const TSharedPtr<FJsonObject>& Param
 			continue;
 		}
 
+		Page.Offer(Property->GetName(), Properties.Add(Property));
+	}
+
+	TArray<TSharedPtr<FJsonValue>> PropertyArray;
+	for (const int32 PropertyIndex : Page.Finish())
+	{
+		FProperty* Property = Properties[PropertyIndex];
+
 		TSharedPtr<FJsonObject> PropObj = MakeShared<FJsonObject>();
-		PropObj->SetStringField(TEXT("name"), Property->GetName());
-		PropObj->SetStringField(TEXT("type"), Property->GetCPPType());
-		PropObj->SetStringField(TEXT("category"), Property->GetMetaData(TEXT("Category")));
+		if (Fields.Has(TEXT("name")))
+		{
+			PropObj->SetStringField(TEXT("name"), Property->GetName());
+		}
+		if (Fields.Has(TEXT("type")))
+		{
+			PropObj->SetStringField(TEXT("type"), Property->GetCPPType());
+		}
+		if (Fields.Has(TEXT("category")))
+		{
+			PropObj->SetStringField(TEXT("category"), Property->GetMetaData(TEXT("Category")));
+		}
 
-		// Get the property value from CDO
+		// Get the property value from CDO; struct and container values count as nested
 		void* PropertyValue = Property->ContainerPtrToValuePtr<void>(CDO);
-		FString ValueString;
-		Property->ExportTextItem_Direct(ValueString, PropertyValue, nullptr, nullptr, PPF_None);
-		PropObj->SetStringField(TEXT("value"), ValueString);
+		if (IsNestedProperty(Property) ? Fields.HasNested(TEXT("value")) : Fields.Has(TEXT("value")))
+		{
+			FString ValueString;
+			Property->ExportTextItem_Direct(ValueString, PropertyValue, nullptr, nullptr, PPF_None);
+			PropObj->SetStringField(TEXT("value"), ValueString);
+		}
 
 		// Check if it's an object property
 		if (FObjectProperty* ObjectProp = CastField<FObjectProperty>(Property))
@@ -374,18 +692,22 @@ FString FMCPServer::HandleReadClassDefaults(const TSharedPtr<FJsonObject>& Param
 			UObject* ObjectValue = ObjectProp->GetObjectPropertyValue(PropertyValue);
 			if (ObjectValue)
 			{
-				PropObj->SetStringField(TEXT("object_value"), ObjectValue->GetPathName());
-				PropObj->SetStringField(TEXT("object_class"), ObjectValue->GetClass()->GetName());
+				if (Fields.Has(TEXT("object_value"))) PropObj->SetStringField(TEXT("object_value"), ObjectValue->GetPathName());
+				if (Fields.Has(TEXT("object_class"))) PropObj->SetStringField(TEXT("object_class"), ObjectValue->GetClass()->GetName());
 			}
 		}
 		// Check if it's an array property
 		else if (FArrayProperty* ArrayProp = CastField<FArrayProperty>(Property))
 		{
 			FScriptArrayHelper ArrayHelper(ArrayProp, PropertyValue);
-			PropObj->SetNumberField(TEXT("array_size"), ArrayHelper.Num());
+			if (Fields.Has(TEXT("array_size")))
+			{
+				PropObj->SetNumberField(TEXT("array_size"), ArrayHelper.Num());
+			}
 
 			// For object arrays, list the objects
-			if (FObjectProperty* InnerObjectProp = CastField<FObjectProperty>(ArrayProp->Inner))
+			FObjectProperty* InnerObjectProp = CastField<FObjectProperty>(ArrayProp->Inner);
+			if (InnerObjectProp && Fields.HasNested(TEXT("array_values")))
 			{
 				TArray<TSharedPtr<FJsonValue>> ObjectArray;
 				for (int32 i = 0; i < ArrayHelper.Num(); ++i)
@@ -411,6 +733,7 @@ FString FMCPServer::HandleReadClassDefaults(const TSharedPtr<FJsonObject>& Param
 	Data->SetNumberField(TEXT("count"), PropertyArray.Num());
 	Data->SetStringField(TEXT("class_name"), GeneratedClass->GetName());
 	Data->SetStringField(TEXT("parent_class"), GeneratedClass->GetSuperClass() ? GeneratedClass->GetSuperClass()->GetName() : TEXT("None"));
+	Page.WriteCursor(Data);
 
 	return MakeResponse(true, Data);
 }
@@ -47,6 +47,8 @@
 #include "EnhancedInputComponent.h"
 #include "Components/ActorComponent.h"
 #include "Kismet2/ComponentEditorUtils.h"
+#include "MCPServerPaging.h"
+#include "MCPServerFields.h"
 
 FString FMCPServer::HandleReadComponents(const TSharedPtr<FJsonObject>& Params)
 {
@@ -63,14 +65,29 @@ FString FMCPServer::HandleReadComponents(const TSharedPtr<FJsonObject>& Params)
 		return MakeError(FString::Printf(TEXT("Blueprint not found: %s"), *Path));
 	}
 
+	FMCPPage Page(TEXT("read_components"));
+	FString PageError;
+	if (!Page.Init(Params, PageError))
+	{
+		return MakeError(PageError);
+	}
+
 	TArray<TSharedPtr<FJsonValue>> CompArray;
 
 	if (Blueprint->SimpleConstructionScript)
 	{
 		const TArray<USCS_Node*>& Nodes = Blueprint->SimpleConstructionScript->GetAllNodes();
-		for (USCS_Node* Node : Nodes)
+		for (int32 NodeIndex = 0; NodeIndex < Nodes.Num(); ++NodeIndex)
 		{
-			if (!Node) continue;
+			if (Nodes[NodeIndex])
+			{
+				Page.Offer(Nodes[NodeIndex]->GetVariableName().ToString(), NodeIndex);
+			}
+		}
+
+		for (const int32 NodeIndex : Page.Finish())
+		{
+			USCS_Node* Node = Nodes[NodeIndex];
 
 			TSharedPtr<FJsonObject> CompObj = MakeShared<FJsonObject>();
 			CompObj->SetStringField(TEXT("name"), Node->GetVariableName().ToString());
@@ -98,6 +115,7 @@ FString FMCPServer::HandleReadComponents(const TSharedPtr<FJsonObject>& Params)
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetArrayField(TEXT("components"), CompArray);
 	Data->SetNumberField(TEXT("count"), CompArray.Num());
+	Page.WriteCursor(Data);
 
 	return MakeResponse(true, Data);
 }
@@ -142,9 +160,22 @@ FString FMCPServer::HandleReadComponentProperties(const TSharedPtr<FJsonObject>&
 	UObject* ComponentTemplate = TargetNode->ComponentTemplate;
 	UClass* ComponentClass = ComponentTemplate->GetClass();
 
-	TArray<TSharedPtr<FJsonValue>> PropsArray;
+	FMCPPage Page(TEXT("read_component_properties"));
+	FString PageError;
+	if (!Page.Init(Params, PageError))
+	{
+		return MakeError(PageError);
+	}
 
-	// Iterate through all properties
+	FMCPFieldSelection Fields;
+	FString FieldsError;
+	if (!Fields.Init(Params, FieldsError))
+	{
+		return MakeError(FieldsError);
+	}
+
+	// Iterate through all properties; only this page's get exported
+	TArray<FProperty*> Properties;
 	for (TFieldIterator<FProperty> PropIt(ComponentClass); PropIt; ++PropIt)
 	{
 		FProperty* Property = *PropIt;
@@ -156,22 +187,39 @@ FString FMCPServer::HandleReadComponentProperties(const TSharedPtr<FJsonObject>&
 			continue;
 		}
 
+		Page.Offer(Property->GetName(), Properties.Add(Property));
+	}
+
+	TArray<TSharedPtr<FJsonValue>> PropsArray;
+	for (const int32 PropertyIndex : Page.Finish())
+	{
+		FProperty* Property = Properties[PropertyIndex];
+
 		TSharedPtr<FJsonObject> PropObj = MakeShared<FJsonObject>();
-		PropObj->SetStringField(TEXT("name"), Property->GetName());
-		PropObj->SetStringField(TEXT("type"), Property->GetClass()->GetName());
+		if (Fields.Has(TEXT("name")))
+		{
+			PropObj->SetStringField(TEXT("name"), Property->GetName());
+		}
+		if (Fields.Has(TEXT("type")))
+		{
+			PropObj->SetStringField(TEXT("type"), Property->GetClass()->GetName());
+		}
 
 		// Get property category
-		FString Category = Property->GetMetaData(TEXT("Category"));
+		FString Category = Fields.Has(TEXT("category")) ? Property->GetMetaData(TEXT("Category")) : FString();
 		if (!Category.IsEmpty())
 		{
 			PropObj->SetStringField(TEXT("category"), Category);
 		}
 
-		// Get property value as string
+		// Get property value as string; struct and container values count as nested
 		void* ValuePtr = Property->ContainerPtrToValuePtr<void>(ComponentTemplate);
-		FString ValueStr;
-		Property->ExportTextItem_Direct(ValueStr, ValuePtr, nullptr, ComponentTemplate, PPF_None);
-		PropObj->SetStringField(TEXT("value"), ValueStr);
+		if (IsNestedProperty(Property) ? Fields.HasNested(TEXT("value")) : Fields.Has(TEXT("value")))
+		{
+			FString ValueStr;
+			Property->ExportTextItem_Direct(ValueStr, ValuePtr, nullptr, ComponentTemplate, PPF_None);
+			PropObj->SetStringField(TEXT("value"), ValueStr);
+		}
 
 		// For object/class properties, also export the object path
 		if (FObjectProperty* ObjProp = CastField<FObjectProperty>(Property))
@@ -179,8 +227,8 @@ FString FMCPServer::HandleReadComponentProperties(const TSharedPtr<FJsonObject>&
 			UObject* ObjValue = ObjProp->GetObjectPropertyValue(ValuePtr);
 			if (ObjValue)
 			{
-				PropObj->SetStringField(TEXT("object_value"), ObjValue->GetPathName());
-				PropObj->SetStringField(TEXT("object_class"), ObjValue->GetClass()->GetName());
+				if (Fields.Has(TEXT("object_value"))) PropObj->SetStringField(TEXT("object_value"), ObjValue->GetPathName());
+				if (Fields.Has(TEXT("object_class"))) PropObj->SetStringField(TEXT("object_class"), ObjValue->GetClass()->GetName());
 			}
 		}
 		else if (FClassProperty* ClassProp = CastField<FClassProperty>(Property))
@@ -188,8 +236,8 @@ FString FMCPServer::HandleReadComponentProperties(const TSharedPtr<FJsonObject>&
 			UClass* ClassValue = Cast<UClass>(ClassProp->GetObjectPropertyValue(ValuePtr));
 			if (ClassValue)
 			{
-				PropObj->SetStringField(TEXT("class_value"), ClassValue->GetPathName());
-				PropObj->SetStringField(TEXT("class_name"), ClassValue->GetName());
+				if (Fields.Has(TEXT("class_value"))) PropObj->SetStringField(TEXT("class_value"), ClassValue->GetPathName());
+				if (Fields.Has(TEXT("class_name"))) PropObj->SetStringField(TEXT("class_name"), ClassValue->GetName());
 			}
 		}
 
@@ -199,6 +247,7 @@ FString FMCPServer::HandleReadComponentProperties(const TSharedPtr<FJsonObject>&
 	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
 	Data->SetArrayField(TEXT("properties"), PropsArray);
 	Data->SetNumberField(TEXT("count"), PropsArray.Num());
+	Page.WriteCursor(Data);
 	Data->SetStringField(TEXT("component_name"), ComponentName);
 	Data->SetStringField(TEXT("component_class"), ComponentClass->GetName());
 
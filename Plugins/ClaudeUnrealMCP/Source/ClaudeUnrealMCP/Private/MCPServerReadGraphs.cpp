@@ -48,265 +48,557 @@
 #include "Components/ActorComponent.h"
 #include "Kismet2/ComponentEditorUtils.h"
 #include "MCPServerHelpers.h"
-
-FString FMCPServer::HandleReadEventGraph(const TSharedPtr<FJsonObject>& Params)
+#include "MCPServerResponseWriter.h"
+#include "MCPServerGraphSnapshots.h"
+#include "MCPServerFields.h"
+#include "MCPServerPaging.h"
+
+// Writes one node object with the selected fields. Function graphs additionally classify
+// entry/result nodes and expose the property path of PropertyAccess nodes.
+static void WriteGraphNode(FMCPResponseWriter& Writer, UEdGraphNode* Node, bool bFunctionGraph, const FMCPFieldSelection& Fields)
 {
-	if (!Params.IsValid() || !Params->HasField(TEXT("path")))
+	Writer.BeginObject();
+	if (Fields.Has(TEXT("id")))
 	{
-		return MakeError(TEXT("Missing 'path' parameter"));
+		Writer.WriteString(TEXT("id"), Node->NodeGuid.ToString());
 	}
-
-	FString Path = Params->GetStringField(TEXT("path"));
-	UBlueprint* Blueprint = LoadBlueprintFromPath(Path);
-
-	if (!Blueprint)
+	if (Fields.Has(TEXT("class")))
 	{
-		return MakeError(FString::Printf(TEXT("Blueprint not found: %s"), *Path));
+		Writer.WriteString(TEXT("class"), Node->GetClass()->GetName());
 	}
-
-	TArray<TSharedPtr<FJsonValue>> GraphsArray;
-
-	for (UEdGraph* Graph : Blueprint->UbergraphPages)
+	// Titles are built from scratch on every call and cost more than the rest of the node
+	if (Fields.Has(TEXT("title")))
 	{
-		if (!Graph) continue;
+		Writer.WriteString(TEXT("title"), Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
+	}
 
-		TSharedPtr<FJsonObject> GraphObj = MakeShared<FJsonObject>();
-		GraphObj->SetStringField(TEXT("name"), Graph->GetName());
+	// Get node-specific info
+	const bool bType = Fields.Has(TEXT("type"));
+	if (UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
+	{
+		if (bType) Writer.WriteString(TEXT("type"), TEXT("Event"));
+		if (Fields.Has(TEXT("event_name"))) Writer.WriteString(TEXT("event_name"), EventNode->GetFunctionName().ToString());
+	}
+	else if (UK2Node_CallFunction* FuncNode = Cast<UK2Node_CallFunction>(Node))
+	{
+		if (bType) Writer.WriteString(TEXT("type"), TEXT("FunctionCall"));
+		if (Fields.Has(TEXT("function_name"))) Writer.WriteString(TEXT("function_name"), FuncNode->GetFunctionName().ToString());
+	}
+	else if (UK2Node_VariableGet* GetNode = Cast<UK2Node_VariableGet>(Node))
+	{
+		if (bType) Writer.WriteString(TEXT("type"), TEXT("VariableGet"));
+		if (Fields.Has(TEXT("variable_name"))) Writer.WriteString(TEXT("variable_name"), GetNode->GetVarName().ToString());
+	}
+	else if (UK2Node_VariableSet* SetNode = Cast<UK2Node_VariableSet>(Node))
+	{
+		if (bType) Writer.WriteString(TEXT("type"), TEXT("VariableSet"));
+		if (Fields.Has(TEXT("variable_name"))) Writer.WriteString(TEXT("variable_name"), SetNode->GetVarName().ToString());
+	}
+	else if (bFunctionGraph && Cast<UK2Node_FunctionEntry>(Node))
+	{
+		if (bType) Writer.WriteString(TEXT("type"), TEXT("FunctionEntry"));
+	}
+	else if (bFunctionGraph && Cast<UK2Node_FunctionResult>(Node))
+	{
+		if (bType) Writer.WriteString(TEXT("type"), TEXT("FunctionResult"));
+	}
+	else
+	{
+		if (bType) Writer.WriteString(TEXT("type"), TEXT("Other"));
+	}
 
-		TArray<TSharedPtr<FJsonValue>> NodesArray;
-		for (UEdGraphNode* Node : Graph->Nodes)
+	// For K2Node_PropertyAccess, extract the property path via reflection
+	if (bFunctionGraph && Node->GetClass()->GetName() == TEXT("K2Node_PropertyAccess"))
+	{
+		// Get TextPath (FText) via reflection - avoids needing private header include
+		FTextProperty* TextPathProp = Fields.Has(TEXT("property_path")) ? CastField<FTextProperty>(Node->GetClass()->FindPropertyByName(TEXT("TextPath"))) : nullptr;
+		if (TextPathProp)
 		{
-			if (!Node) continue;
-
-			TSharedPtr<FJsonObject> NodeObj = MakeShared<FJsonObject>();
-			NodeObj->SetStringField(TEXT("id"), Node->NodeGuid.ToString());
-			NodeObj->SetStringField(TEXT("class"), Node->GetClass()->GetName());
-			NodeObj->SetStringField(TEXT("title"), Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
-
-			// Get node-specific info
-			if (UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
+			const FText& PathText = TextPathProp->GetPropertyValue_InContainer(Node);
+			if (!PathText.IsEmpty())
 			{
-				NodeObj->SetStringField(TEXT("type"), TEXT("Event"));
-				NodeObj->SetStringField(TEXT("event_name"), EventNode->GetFunctionName().ToString());
+				Writer.WriteString(TEXT("property_path"), PathText.ToString());
 			}
-			else if (UK2Node_CallFunction* FuncNode = Cast<UK2Node_CallFunction>(Node))
+		}
+		// Also get the Path array (TArray<FString>) for segment-level detail
+		FArrayProperty* PathArrayProp = Fields.HasNested(TEXT("path_segments")) ? CastField<FArrayProperty>(Node->GetClass()->FindPropertyByName(TEXT("Path"))) : nullptr;
+		FStrProperty* InnerProp = PathArrayProp ? CastField<FStrProperty>(PathArrayProp->Inner) : nullptr;
+		if (InnerProp)
+		{
+			FScriptArrayHelper ArrayHelper(PathArrayProp, PathArrayProp->ContainerPtrToValuePtr<void>(Node));
+			if (ArrayHelper.Num() > 0)
 			{
-				NodeObj->SetStringField(TEXT("type"), TEXT("FunctionCall"));
-				NodeObj->SetStringField(TEXT("function_name"), FuncNode->GetFunctionName().ToString());
+				Writer.BeginArray(TEXT("path_segments"));
+				for (int32 i = 0; i < ArrayHelper.Num(); i++)
+				{
+					Writer.WriteString(InnerProp->GetPropertyValue(ArrayHelper.GetRawPtr(i)));
+				}
+				Writer.EndArray();
 			}
-			else if (UK2Node_VariableGet* GetNode = Cast<UK2Node_VariableGet>(Node))
+		}
+	}
+
+	// Pin defaults (useful for nodes like Delay)
+	if (Fields.HasNested(TEXT("pins")))
+	{
+		const FMCPFieldSelection PinFields = Fields.Nested(TEXT("pins"));
+		const bool bPinType = PinFields.HasNested(TEXT("type"));
+		const bool bDefaultValue = PinFields.Has(TEXT("default_value"));
+		const bool bDefaultText = PinFields.Has(TEXT("default_text"));
+		const bool bDefaultObject = PinFields.Has(TEXT("default_object"));
+
+		Writer.BeginArray(TEXT("pins"));
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (!Pin) continue;
+
+			Writer.BeginObject();
+			if (PinFields.Has(TEXT("name")))
 			{
-				NodeObj->SetStringField(TEXT("type"), TEXT("VariableGet"));
-				NodeObj->SetStringField(TEXT("variable_name"), GetNode->GetVarName().ToString());
+				Writer.WriteString(TEXT("name"), Pin->PinName.ToString());
 			}
-			else if (UK2Node_VariableSet* SetNode = Cast<UK2Node_VariableSet>(Node))
+			if (PinFields.Has(TEXT("direction")))
 			{
-				NodeObj->SetStringField(TEXT("type"), TEXT("VariableSet"));
-				NodeObj->SetStringField(TEXT("variable_name"), SetNode->GetVarName().ToString());
+				Writer.WriteString(TEXT("direction"), Pin->Direction == EGPD_Input ? TEXT("Input") : TEXT("Output"));
 			}
-			else
+
+			if (bPinType)
 			{
-				NodeObj->SetStringField(TEXT("type"), TEXT("Other"));
+				Writer.BeginObject(TEXT("type"));
+				WritePinType(Writer, Pin->PinType);
+				Writer.EndObject();
 			}
 
-			// Pin defaults (useful for nodes like Delay)
-			TArray<TSharedPtr<FJsonValue>> PinsArray;
-			for (UEdGraphPin* Pin : Node->Pins)
+			if (bDefaultValue && !Pin->DefaultValue.IsEmpty())
 			{
-				if (!Pin) continue;
+				Writer.WriteString(TEXT("default_value"), Pin->DefaultValue);
+			}
 
-				TSharedPtr<FJsonObject> PinObj = MakeShared<FJsonObject>();
-				PinObj->SetStringField(TEXT("name"), Pin->PinName.ToString());
-				PinObj->SetStringField(TEXT("direction"), Pin->Direction == EGPD_Input ? TEXT("Input") : TEXT("Output"));
+			if (bDefaultText && !Pin->DefaultTextValue.IsEmpty())
+			{
+				Writer.WriteString(TEXT("default_text"), Pin->DefaultTextValue.ToString());
+			}
 
-				TSharedPtr<FJsonObject> PinTypeObj = MakeShared<FJsonObject>();
-				SerializePinType(Pin->PinType, PinTypeObj);
-				PinObj->SetObjectField(TEXT("type"), PinTypeObj);
+			if (bDefaultObject && Pin->DefaultObject)
+			{
+				Writer.WriteString(TEXT("default_object"), Pin->DefaultObject->GetPathName());
+			}
 
-				if (!Pin->DefaultValue.IsEmpty())
-				{
-					PinObj->SetStringField(TEXT("default_value"), Pin->DefaultValue);
-				}
+			if (PinFields.Has(TEXT("is_linked")))
+			{
+				Writer.WriteBool(TEXT("is_linked"), Pin->LinkedTo.Num() > 0);
+			}
+			Writer.EndObject();
+		}
+		Writer.EndArray();
+	}
 
-				if (!Pin->DefaultTextValue.IsEmpty())
-				{
-					PinObj->SetStringField(TEXT("default_text"), Pin->DefaultTextValue.ToString());
-				}
+	// Get pin connections
+	if (Fields.HasNested(TEXT("connections")))
+	{
+		const FMCPFieldSelection LinkFields = Fields.Nested(TEXT("connections"));
+		const bool bFromPin = LinkFields.Has(TEXT("from_pin"));
+		const bool bToNode = LinkFields.Has(TEXT("to_node"));
+		const bool bToPin = LinkFields.Has(TEXT("to_pin"));
 
-				if (Pin->DefaultObject)
-				{
-					PinObj->SetStringField(TEXT("default_object"), Pin->DefaultObject->GetPathName());
-				}
+		Writer.BeginArray(TEXT("connections"));
+		for (UEdGraphPin* Pin : Node->Pins)
+		{
+			if (!Pin || Pin->Direction != EGPD_Output) continue;
 
-				PinObj->SetBoolField(TEXT("is_linked"), Pin->LinkedTo.Num() > 0);
+			for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
+			{
+				if (!LinkedPin || !LinkedPin->GetOwningNode()) continue;
 
-				PinsArray.Add(MakeShared<FJsonValueObject>(PinObj));
+				Writer.BeginObject();
+				if (bFromPin) Writer.WriteString(TEXT("from_pin"), Pin->PinName.ToString());
+				if (bToNode) Writer.WriteString(TEXT("to_node"), LinkedPin->GetOwningNode()->NodeGuid.ToString());
+				if (bToPin) Writer.WriteString(TEXT("to_pin"), LinkedPin->PinName.ToString());
+				Writer.EndObject();
 			}
-			NodeObj->SetArrayField(TEXT("pins"), PinsArray);
+		}
+		Writer.EndArray();
+	}
 
-			// Get pin connections
-			TArray<TSharedPtr<FJsonValue>> ConnectionsArray;
-			for (UEdGraphPin* Pin : Node->Pins)
-			{
-				if (!Pin || Pin->Direction != EGPD_Output) continue;
+	Writer.EndObject();
+}
 
-				for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
-				{
-					if (!LinkedPin || !LinkedPin->GetOwningNode()) continue;
+static void WriteGraphLinks(FMCPResponseWriter& Writer, FStringView Key, const TArray<FMCPGraphLink>& Links)
+{
+	Writer.BeginArray(Key);
+	for (const FMCPGraphLink& Link : Links)
+	{
+		Writer.BeginObject();
+		Writer.WriteString(TEXT("from_node"), Link.FromNode.ToString());
+		Writer.WriteString(TEXT("from_pin"), Link.FromPin.ToString());
+		Writer.WriteString(TEXT("to_node"), Link.ToNode.ToString());
+		Writer.WriteString(TEXT("to_pin"), Link.ToPin.ToString());
+		Writer.EndObject();
+	}
+	Writer.EndArray();
+}
 
-					TSharedPtr<FJsonObject> ConnObj = MakeShared<FJsonObject>();
-					ConnObj->SetStringField(TEXT("from_pin"), Pin->PinName.ToString());
-					ConnObj->SetStringField(TEXT("to_node"), LinkedPin->GetOwningNode()->NodeGuid.ToString());
-					ConnObj->SetStringField(TEXT("to_pin"), LinkedPin->PinName.ToString());
-					ConnectionsArray.Add(MakeShared<FJsonValueObject>(ConnObj));
-				}
+// What the graph readers return for each graph: the changes since the caller's version when
+// that snapshot is still known, otherwise the nodes of a full read. Held weakly, since a
+// parked response is written over several ticks with other commands running in between.
+struct FGraphReadPlan
+{
+	TWeakObjectPtr<UEdGraph> Graph;
+	FString Name;
+	bool bDelta = false;
+	FMCPGraphDelta Delta;
+	TArray<TWeakObjectPtr<UEdGraphNode>> Nodes;
+};
+
+// Every node of every graph, for the readers without paging or deltas
+static TArray<FGraphReadPlan> PlanFullGraphReads(const TArray<UEdGraph*>& Graphs)
+{
+	TArray<FGraphReadPlan> Plans;
+	for (UEdGraph* Graph : Graphs)
+	{
+		FGraphReadPlan& Plan = Plans.AddDefaulted_GetRef();
+		Plan.Graph = Graph;
+		Plan.Name = Graph->GetName();
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (Node)
+			{
+				Plan.Nodes.Add(Node);
 			}
-			NodeObj->SetArrayField(TEXT("connections"), ConnectionsArray);
-
-			NodesArray.Add(MakeShared<FJsonValueObject>(NodeObj));
 		}
-
-		GraphObj->SetArrayField(TEXT("nodes"), NodesArray);
-		GraphObj->SetNumberField(TEXT("node_count"), NodesArray.Num());
-		GraphsArray.Add(MakeShared<FJsonValueObject>(GraphObj));
 	}
-
-	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-	Data->SetArrayField(TEXT("graphs"), GraphsArray);
-	Data->SetNumberField(TEXT("count"), GraphsArray.Num());
-
-	return MakeResponse(true, Data);
+	return Plans;
 }
 
-FString FMCPServer::HandleReadEventGraphDetailed(const TSharedPtr<FJsonObject>& Params)
+// Fills the plans of the full reads (FullReads indexes Plans) with one page of nodes, keyed
+// "<graph name>/<node guid>". Graphs are taken in the order of their "<name>/" prefixes, which
+// is the order of their keys since names have no '/'; graphs before the cursor's are skipped
+// and the cursor's own graph is entered by a seek in the snapshot cache's node id order. Only
+// the page's nodes (plus one) are offered, however large the graphs.
+static void PageGraphNodes(FMCPGraphSnapshotCache& Snapshots, TArray<FGraphReadPlan>& Plans, TArray<int32>& FullReads, FMCPPage& Page)
 {
-	if (!Params.IsValid() || !Params->HasField(TEXT("path")))
+	auto PrefixOf = [&Plans](int32 PlanIndex) { return Plans[PlanIndex].Name + TEXT('/'); };
+	FullReads.Sort([&PrefixOf](int32 A, int32 B) { return FMCPPage::KeyLess(PrefixOf(A), PrefixOf(B)); });
+
+	FString AfterPrefix;
+	FGuid AfterNode;
+	bool bHasAfterNode = false;
+	const FString* AfterKey = Page.GetAfterKey();
+	if (AfterKey)
 	{
-		return MakeError(TEXT("Missing 'path' parameter"));
+		int32 Slash = INDEX_NONE;
+		AfterKey->FindChar(TEXT('/'), Slash);
+		AfterPrefix = AfterKey->Left(Slash + 1);
+		bHasAfterNode = FGuid::Parse(AfterKey->Mid(Slash + 1), AfterNode);
 	}
 
-	FString Path = Params->GetStringField(TEXT("path"));
-	const int32 MaxNodes = Params->HasField(TEXT("max_nodes")) ? Params->GetIntegerField(TEXT("max_nodes")) : -1;
-	const int32 StartIndex = Params->HasField(TEXT("start_index")) ? Params->GetIntegerField(TEXT("start_index")) : 0;
-	UBlueprint* Blueprint = LoadBlueprintFromPath(Path);
+	// Every node offered to the page, as (plan, node)
+	TArray<TPair<int32, UEdGraphNode*>> Offered;
+	TStringBuilder<256> Key;
 
-	if (!Blueprint)
+	for (const int32 PlanIndex : FullReads)
 	{
-		return MakeError(FString::Printf(TEXT("Blueprint not found: %s"), *Path));
+		const int32 Remaining = Page.GetSeekCount() - Offered.Num();
+		if (Remaining <= 0)
+		{
+			break;
+		}
+
+		const FString Prefix = PrefixOf(PlanIndex);
+		const FGuid* SeekAfter = nullptr;
+		if (AfterKey)
+		{
+			if (FMCPPage::KeyLess(Prefix, AfterPrefix))
+			{
+				continue;
+			}
+			if (bHasAfterNode && Prefix.Equals(AfterPrefix, ESearchCase::CaseSensitive))
+			{
+				SeekAfter = &AfterNode;
+			}
+		}
+
+		for (UEdGraphNode* Node : Snapshots.GetNodesInIdOrder(Plans[PlanIndex].Graph.Get(), SeekAfter, Remaining))
+		{
+			Key.Reset();
+			Key << Prefix << Node->NodeGuid.ToString();
+			Page.Offer(Key.ToView(), Offered.Add({ PlanIndex, Node }));
+		}
 	}
 
-	TArray<TSharedPtr<FJsonValue>> GraphsArray;
+	for (const int32 Index : Page.Finish())
+	{
+		Plans[Offered[Index].Key].Nodes.Add(Offered[Index].Value);
+	}
+}
 
-	for (UEdGraph* Graph : Blueprint->UbergraphPages)
+// Works out what to send for every graph. Full reads are paged together: with page_size or
+// cursor, by keyset over "<graph name>/<node guid>" (PageGraphNodes), so a page picks up after
+// the last node sent even if nodes were added or removed in between; otherwise by the older
+// per-graph start_index and max_nodes, which shift when the graph changes.
+static TArray<FGraphReadPlan> PlanGraphReads(FMCPGraphSnapshotCache& Snapshots, const TArray<UEdGraph*>& Graphs,
+	const int64* SinceVersion, FMCPPage& Page, int32 StartIndex, int32 MaxNodes)
+{
+	TArray<FGraphReadPlan> Plans;
+	Plans.Reserve(Graphs.Num());
+	TArray<int32> FullReads;
+
+	for (UEdGraph* Graph : Graphs)
 	{
-		if (!Graph) continue;
+		FGraphReadPlan& Plan = Plans.AddDefaulted_GetRef();
+		Plan.Graph = Graph;
+		Plan.Name = Graph->GetName();
+		if (SinceVersion && Snapshots.GetDelta(Graph, *SinceVersion, Plan.Delta))
+		{
+			Plan.bDelta = true;
+			Plan.Nodes.Append(Plan.Delta.ChangedNodes);
+			Plan.Delta.ChangedNodes.Reset();
+			continue;
+		}
 
-		TSharedPtr<FJsonObject> GraphObj = MakeShared<FJsonObject>();
-		GraphObj->SetStringField(TEXT("name"), Graph->GetName());
+		if (Page.IsPaged())
+		{
+			FullReads.Add(Plans.Num() - 1);
+			continue;
+		}
 
-		TArray<TSharedPtr<FJsonValue>> NodesArray;
 		int32 NodeIndex = 0;
 		for (UEdGraphNode* Node : Graph->Nodes)
 		{
 			if (!Node) continue;
+
 			if (NodeIndex++ < StartIndex) continue;
-			if (MaxNodes >= 0 && NodesArray.Num() >= MaxNodes) break;
+			if (MaxNodes >= 0 && Plan.Nodes.Num() >= MaxNodes) break;
+			Plan.Nodes.Add(Node);
+		}
+	}
 
-			TSharedPtr<FJsonObject> NodeObj = MakeShared<FJsonObject>();
-			NodeObj->SetStringField(TEXT("id"), Node->NodeGuid.ToString());
-			NodeObj->SetStringField(TEXT("class"), Node->GetClass()->GetName());
-			NodeObj->SetStringField(TEXT("title"), Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
+	if (Page.IsPaged())
+	{
+		PageGraphNodes(Snapshots, Plans, FullReads, Page);
+	}
 
-			if (UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
-			{
-				NodeObj->SetStringField(TEXT("type"), TEXT("Event"));
-				NodeObj->SetStringField(TEXT("event_name"), EventNode->GetFunctionName().ToString());
-			}
-			else if (UK2Node_CallFunction* FuncNode = Cast<UK2Node_CallFunction>(Node))
+	return Plans;
+}
+
+/**
+ * The "graphs" array of the graph readers, a few nodes per step. With snapshots, each graph
+ * also gets its "version" (or its delta), and the response the latest version and cursor.
+ * Nodes removed while the response was parked are left out.
+ */
+class FGraphReadStream : public FMCPResponseStream
+{
+public:
+	FGraphReadStream(TArray<FGraphReadPlan>&& InPlans, const FMCPFieldSelection& InFields, bool bInFunctionGraphs)
+		: Plans(MoveTemp(InPlans))
+		, Fields(InFields)
+		, bFunctionGraphs(bInFunctionGraphs)
+	{
+		Writer.BeginArray(TEXT("graphs"));
+	}
+
+	/** Write versions and deltas from these snapshots; bInSinceVersion adds "delta": false to full reads. */
+	void SetSnapshots(const TSharedPtr<FMCPGraphSnapshotCache>& InSnapshots, bool bInSinceVersion, const FString& InNextCursor)
+	{
+		Snapshots = InSnapshots;
+		bSinceVersion = bInSinceVersion;
+		NextCursor = InNextCursor;
+	}
+
+	virtual bool Step() override
+	{
+		for (int32 Written = 0; GraphIndex < Plans.Num(); )
+		{
+			const FGraphReadPlan& Plan = Plans[GraphIndex];
+			if (NodeIndex == INDEX_NONE)
 			{
-				NodeObj->SetStringField(TEXT("type"), TEXT("FunctionCall"));
-				NodeObj->SetStringField(TEXT("function_name"), FuncNode->GetFunctionName().ToString());
+				BeginGraph(Plan);
+				NodeIndex = 0;
 			}
-			else if (UK2Node_VariableGet* GetNode = Cast<UK2Node_VariableGet>(Node))
+
+			while (NodeIndex < Plan.Nodes.Num())
 			{
-				NodeObj->SetStringField(TEXT("type"), TEXT("VariableGet"));
-				NodeObj->SetStringField(TEXT("variable_name"), GetNode->GetVarName().ToString());
+				if (Written++ == NodesPerStep)
+				{
+					return true;
+				}
+				if (UEdGraphNode* Node = Plan.Nodes[NodeIndex++].Get())
+				{
+					WriteGraphNode(Writer, Node, bFunctionGraphs, Fields);
+					++NodeCount;
+				}
 			}
-			else if (UK2Node_VariableSet* SetNode = Cast<UK2Node_VariableSet>(Node))
+
+			EndGraph(Plan);
+			++GraphIndex;
+			NodeIndex = INDEX_NONE;
+		}
+
+		Writer.EndArray();
+		Writer.WriteInteger(TEXT("count"), Plans.Num());
+		if (Snapshots.IsValid())
+		{
+			// Pass back as since_version to get deltas for every graph above
+			Writer.WriteInteger(TEXT("version"), Snapshots->GetLatestVersion());
+		}
+		if (!NextCursor.IsEmpty())
+		{
+			Writer.WriteString(TEXT("next_cursor"), NextCursor);
+		}
+		return false;
+	}
+
+private:
+	void BeginGraph(const FGraphReadPlan& Plan)
+	{
+		Writer.BeginObject();
+		Writer.WriteString(TEXT("name"), Plan.Name);
+		if (bFunctionGraphs)
+		{
+			Writer.WriteString(TEXT("graph_type"), TEXT("Function"));
+		}
+
+		if (Snapshots.IsValid())
+		{
+			if (Plan.bDelta)
 			{
-				NodeObj->SetStringField(TEXT("type"), TEXT("VariableSet"));
-				NodeObj->SetStringField(TEXT("variable_name"), SetNode->GetVarName().ToString());
+				Writer.WriteInteger(TEXT("version"), Plan.Delta.Version);
+				Writer.WriteBool(TEXT("delta"), true);
 			}
 			else
 			{
-				NodeObj->SetStringField(TEXT("type"), TEXT("Other"));
+				if (UEdGraph* Graph = Plan.Graph.Get())
+				{
+					Writer.WriteInteger(TEXT("version"), Snapshots->GetVersion(Graph));
+				}
+				if (bSinceVersion)
+				{
+					Writer.WriteBool(TEXT("delta"), false);
+				}
 			}
+		}
 
-			TArray<TSharedPtr<FJsonValue>> PinsArray;
-			for (UEdGraphPin* Pin : Node->Pins)
-			{
-				if (!Pin) continue;
+		Writer.BeginArray(TEXT("nodes"));
+		NodeCount = 0;
+	}
 
-				TSharedPtr<FJsonObject> PinObj = MakeShared<FJsonObject>();
-				PinObj->SetStringField(TEXT("name"), Pin->PinName.ToString());
-				PinObj->SetStringField(TEXT("direction"), Pin->Direction == EGPD_Input ? TEXT("Input") : TEXT("Output"));
+	void EndGraph(const FGraphReadPlan& Plan)
+	{
+		Writer.EndArray();
+		Writer.WriteInteger(TEXT("node_count"), NodeCount);
 
-				TSharedPtr<FJsonObject> PinTypeObj = MakeShared<FJsonObject>();
-				SerializePinType(Pin->PinType, PinTypeObj);
-				PinObj->SetObjectField(TEXT("type"), PinTypeObj);
+		if (Plan.bDelta)
+		{
+			Writer.BeginArray(TEXT("removed_nodes"));
+			for (const FGuid& NodeGuid : Plan.Delta.RemovedNodes)
+			{
+				Writer.WriteString(NodeGuid.ToString());
+			}
+			Writer.EndArray();
 
-				if (!Pin->DefaultValue.IsEmpty())
-				{
-					PinObj->SetStringField(TEXT("default_value"), Pin->DefaultValue);
-				}
+			WriteGraphLinks(Writer, TEXT("added_links"), Plan.Delta.AddedLinks);
+			WriteGraphLinks(Writer, TEXT("removed_links"), Plan.Delta.RemovedLinks);
+		}
+		Writer.EndObject();
+	}
 
-				if (!Pin->DefaultTextValue.IsEmpty())
-				{
-					PinObj->SetStringField(TEXT("default_text"), Pin->DefaultTextValue.ToString());
-				}
+	// Enough to fill a chunk or so, so backpressure is looked at between chunks
+	static constexpr int32 NodesPerStep = 32;
 
-				if (Pin->DefaultObject)
-				{
-					PinObj->SetStringField(TEXT("default_object"), Pin->DefaultObject->GetPathName());
-				}
+	TArray<FGraphReadPlan> Plans;
+	FMCPFieldSelection Fields;
+	bool bFunctionGraphs = false;
 
-				PinObj->SetBoolField(TEXT("is_linked"), Pin->LinkedTo.Num() > 0);
+	TSharedPtr<FMCPGraphSnapshotCache> Snapshots;
+	bool bSinceVersion = false;
+	FString NextCursor;
 
-				PinsArray.Add(MakeShared<FJsonValueObject>(PinObj));
-			}
-			NodeObj->SetArrayField(TEXT("pins"), PinsArray);
+	int32 GraphIndex = 0;
+	int32 NodeIndex = INDEX_NONE;
+	int32 NodeCount = 0;
+};
 
-			TArray<TSharedPtr<FJsonValue>> ConnectionsArray;
-			for (UEdGraphPin* Pin : Node->Pins)
-			{
-				if (!Pin || Pin->Direction != EGPD_Output) continue;
+FString FMCPServer::HandleReadEventGraph(const TSharedPtr<FJsonObject>& Params)
+{
+	if (!Params.IsValid() || !Params->HasField(TEXT("path")))
+	{
+		return MakeError(TEXT("Missing 'path' parameter"));
+	}
 
-				for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
-				{
-					if (!LinkedPin || !LinkedPin->GetOwningNode()) continue;
+	FString Path = Params->GetStringField(TEXT("path"));
+	UBlueprint* Blueprint = LoadBlueprintFromPath(Path);
 
-					TSharedPtr<FJsonObject> ConnObj = MakeShared<FJsonObject>();
-					ConnObj->SetStringField(TEXT("from_pin"), Pin->PinName.ToString());
-					ConnObj->SetStringField(TEXT("to_node"), LinkedPin->GetOwningNode()->NodeGuid.ToString());
-					ConnObj->SetStringField(TEXT("to_pin"), LinkedPin->PinName.ToString());
-					ConnectionsArray.Add(MakeShared<FJsonValueObject>(ConnObj));
-				}
-			}
-			NodeObj->SetArrayField(TEXT("connections"), ConnectionsArray);
+	if (!Blueprint)
+	{
+		return MakeError(FString::Printf(TEXT("Blueprint not found: %s"), *Path));
+	}
+
+	FMCPFieldSelection Fields;
+	FString FieldsError;
+	if (!Fields.Init(Params, FieldsError))
+	{
+		return MakeError(FieldsError);
+	}
 
-			NodesArray.Add(MakeShared<FJsonValueObject>(NodeObj));
+	TArray<UEdGraph*> Graphs;
+	for (UEdGraph* Graph : Blueprint->UbergraphPages)
+	{
+		if (Graph)
+		{
+			Graphs.Add(Graph);
 		}
+	}
+
+	// Graph dumps get large; stream them instead of building a JSON tree first
+	return RunResponseStream(MakeShared<FGraphReadStream>(PlanFullGraphReads(Graphs), Fields, false));
+}
+
+FString FMCPServer::HandleReadEventGraphDetailed(const TSharedPtr<FJsonObject>& Params)
+{
+	if (!Params.IsValid() || !Params->HasField(TEXT("path")))
+	{
+		return MakeError(TEXT("Missing 'path' parameter"));
+	}
+
+	FString Path = Params->GetStringField(TEXT("path"));
+	const int32 MaxNodes = Params->HasField(TEXT("max_nodes")) ? Params->GetIntegerField(TEXT("max_nodes")) : -1;
+	const int32 StartIndex = Params->HasField(TEXT("start_index")) ? Params->GetIntegerField(TEXT("start_index")) : 0;
+	int64 SinceVersion = 0;
+	const bool bSinceVersion = Params->TryGetNumberField(TEXT("since_version"), SinceVersion);
+	UBlueprint* Blueprint = LoadBlueprintFromPath(Path);
 
-		GraphObj->SetArrayField(TEXT("nodes"), NodesArray);
-		GraphObj->SetNumberField(TEXT("node_count"), NodesArray.Num());
-		GraphsArray.Add(MakeShared<FJsonValueObject>(GraphObj));
+	if (!Blueprint)
+	{
+		return MakeError(FString::Printf(TEXT("Blueprint not found: %s"), *Path));
 	}
 
-	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-	Data->SetArrayField(TEXT("graphs"), GraphsArray);
-	Data->SetNumberField(TEXT("count"), GraphsArray.Num());
+	FMCPFieldSelection Fields;
+	FString FieldsError;
+	if (!Fields.Init(Params, FieldsError))
+	{
+		return MakeError(FieldsError);
+	}
 
-	return MakeResponse(true, Data);
+	FMCPPage Page(TEXT("read_event_graph_detailed"));
+	FString PageError;
+	if (!Page.Init(Params, PageError))
+	{
+		return MakeError(PageError);
+	}
+
+	TArray<UEdGraph*> Graphs;
+	for (UEdGraph* Graph : Blueprint->UbergraphPages)
+	{
+		if (Graph)
+		{
+			Graphs.Add(Graph);
+		}
+	}
+	TArray<FGraphReadPlan> Plans = PlanGraphReads(*GraphSnapshots, Graphs, bSinceVersion ? &SinceVersion : nullptr, Page, StartIndex, MaxNodes);
+
+	TSharedRef<FGraphReadStream> Stream = MakeShared<FGraphReadStream>(MoveTemp(Plans), Fields, false);
+	Stream->SetSnapshots(GraphSnapshots, bSinceVersion, Page.GetNextCursor());
+	return RunResponseStream(Stream);
 }
 
 FString FMCPServer::HandleReadFunctionGraphs(const TSharedPtr<FJsonObject>& Params)
@@ -320,6 +612,8 @@ FString FMCPServer::HandleReadFunctionGraphs(const TSharedPtr<FJsonObject>& Para
 	const FString FilterName = Params->HasField(TEXT("name")) ? Params->GetStringField(TEXT("name")) : FString();
 	const int32 MaxNodes = Params->HasField(TEXT("max_nodes")) ? Params->GetIntegerField(TEXT("max_nodes")) : -1;
 	const int32 StartIndex = Params->HasField(TEXT("start_index")) ? Params->GetIntegerField(TEXT("start_index")) : 0;
+	int64 SinceVersion = 0;
+	const bool bSinceVersion = Params->TryGetNumberField(TEXT("since_version"), SinceVersion);
 	UBlueprint* Blueprint = LoadBlueprintFromPath(Path);
 
 	if (!Blueprint)
@@ -327,7 +621,19 @@ FString FMCPServer::HandleReadFunctionGraphs(const TSharedPtr<FJsonObject>& Para
 		return MakeError(FString::Printf(TEXT("Blueprint not found: %s"), *Path));
 	}
 
-	TArray<TSharedPtr<FJsonValue>> GraphsArray;
+	FMCPFieldSelection Fields;
+	FString FieldsError;
+	if (!Fields.Init(Params, FieldsError))
+	{
+		return MakeError(FieldsError);
+	}
+
+	FMCPPage Page(TEXT("read_function_graphs"));
+	FString PageError;
+	if (!Page.Init(Params, PageError))
+	{
+		return MakeError(PageError);
+	}
 
 	// Collect all function graphs: regular + interface implementation graphs
 	TArray<UEdGraph*> AllFunctionGraphs;
@@ -337,161 +643,18 @@ FString FMCPServer::HandleReadFunctionGraphs(const TSharedPtr<FJsonObject>& Para
 		AllFunctionGraphs.Append(Interface.Graphs);
 	}
 
+	TArray<UEdGraph*> Graphs;
 	for (UEdGraph* Graph : AllFunctionGraphs)
 	{
 		if (!Graph) continue;
 		if (!FilterName.IsEmpty() && Graph->GetName() != FilterName) continue;
-
-		TSharedPtr<FJsonObject> GraphObj = MakeShared<FJsonObject>();
-		GraphObj->SetStringField(TEXT("name"), Graph->GetName());
-		GraphObj->SetStringField(TEXT("graph_type"), TEXT("Function"));
-
-		TArray<TSharedPtr<FJsonValue>> NodesArray;
-		int32 NodeIndex = 0;
-		for (UEdGraphNode* Node : Graph->Nodes)
-		{
-			if (!Node) continue;
-			if (NodeIndex++ < StartIndex) continue;
-			if (MaxNodes >= 0 && NodesArray.Num() >= MaxNodes) break;
-
-			TSharedPtr<FJsonObject> NodeObj = MakeShared<FJsonObject>();
-			NodeObj->SetStringField(TEXT("id"), Node->NodeGuid.ToString());
-			NodeObj->SetStringField(TEXT("class"), Node->GetClass()->GetName());
-			NodeObj->SetStringField(TEXT("title"), Node->GetNodeTitle(ENodeTitleType::FullTitle).ToString());
-
-			if (UK2Node_Event* EventNode = Cast<UK2Node_Event>(Node))
-			{
-				NodeObj->SetStringField(TEXT("type"), TEXT("Event"));
-				NodeObj->SetStringField(TEXT("event_name"), EventNode->GetFunctionName().ToString());
-			}
-			else if (UK2Node_CallFunction* FuncNode = Cast<UK2Node_CallFunction>(Node))
-			{
-				NodeObj->SetStringField(TEXT("type"), TEXT("FunctionCall"));
-				NodeObj->SetStringField(TEXT("function_name"), FuncNode->GetFunctionName().ToString());
-			}
-			else if (UK2Node_VariableGet* GetNode = Cast<UK2Node_VariableGet>(Node))
-			{
-				NodeObj->SetStringField(TEXT("type"), TEXT("VariableGet"));
-				NodeObj->SetStringField(TEXT("variable_name"), GetNode->GetVarName().ToString());
-			}
-			else if (UK2Node_VariableSet* SetNode = Cast<UK2Node_VariableSet>(Node))
-			{
-				NodeObj->SetStringField(TEXT("type"), TEXT("VariableSet"));
-				NodeObj->SetStringField(TEXT("variable_name"), SetNode->GetVarName().ToString());
-			}
-			else if (Cast<UK2Node_FunctionEntry>(Node))
-			{
-				NodeObj->SetStringField(TEXT("type"), TEXT("FunctionEntry"));
-			}
-			else if (Cast<UK2Node_FunctionResult>(Node))
-			{
-				NodeObj->SetStringField(TEXT("type"), TEXT("FunctionResult"));
-			}
-			else
-			{
-				NodeObj->SetStringField(TEXT("type"), TEXT("Other"));
-			}
-
-			// For K2Node_PropertyAccess, extract the property path via reflection
-			if (Node->GetClass()->GetName() == TEXT("K2Node_PropertyAccess"))
-			{
-				// Get TextPath (FText) via reflection - avoids needing private header include
-				FTextProperty* TextPathProp = CastField<FTextProperty>(Node->GetClass()->FindPropertyByName(TEXT("TextPath")));
-				if (TextPathProp)
-				{
-					const FText& PathText = TextPathProp->GetPropertyValue_InContainer(Node);
-					if (!PathText.IsEmpty())
-					{
-						NodeObj->SetStringField(TEXT("property_path"), PathText.ToString());
-					}
-				}
-				// Also get the Path array (TArray<FString>) for segment-level detail
-				FArrayProperty* PathArrayProp = CastField<FArrayProperty>(Node->GetClass()->FindPropertyByName(TEXT("Path")));
-				if (PathArrayProp)
-				{
-					FScriptArrayHelper ArrayHelper(PathArrayProp, PathArrayProp->ContainerPtrToValuePtr<void>(Node));
-					TArray<TSharedPtr<FJsonValue>> PathSegments;
-					FStrProperty* InnerProp = CastField<FStrProperty>(PathArrayProp->Inner);
-					if (InnerProp)
-					{
-						for (int32 i = 0; i < ArrayHelper.Num(); i++)
-						{
-							FString Segment = InnerProp->GetPropertyValue(ArrayHelper.GetRawPtr(i));
-							PathSegments.Add(MakeShared<FJsonValueString>(Segment));
-						}
-					}
-					if (PathSegments.Num() > 0)
-					{
-						NodeObj->SetArrayField(TEXT("path_segments"), PathSegments);
-					}
-				}
-			}
-
-			TArray<TSharedPtr<FJsonValue>> PinsArray;
-			for (UEdGraphPin* Pin : Node->Pins)
-			{
-				if (!Pin) continue;
-
-				TSharedPtr<FJsonObject> PinObj = MakeShared<FJsonObject>();
-				PinObj->SetStringField(TEXT("name"), Pin->PinName.ToString());
-				PinObj->SetStringField(TEXT("direction"), Pin->Direction == EGPD_Input ? TEXT("Input") : TEXT("Output"));
-
-				TSharedPtr<FJsonObject> PinTypeObj = MakeShared<FJsonObject>();
-				SerializePinType(Pin->PinType, PinTypeObj);
-				PinObj->SetObjectField(TEXT("type"), PinTypeObj);
-
-				if (!Pin->DefaultValue.IsEmpty())
-				{
-					PinObj->SetStringField(TEXT("default_value"), Pin->DefaultValue);
-				}
-
-				if (!Pin->DefaultTextValue.IsEmpty())
-				{
-					PinObj->SetStringField(TEXT("default_text"), Pin->DefaultTextValue.ToString());
-				}
-
-				if (Pin->DefaultObject)
-				{
-					PinObj->SetStringField(TEXT("default_object"), Pin->DefaultObject->GetPathName());
-				}
-
-				PinObj->SetBoolField(TEXT("is_linked"), Pin->LinkedTo.Num() > 0);
-
-				PinsArray.Add(MakeShared<FJsonValueObject>(PinObj));
-			}
-			NodeObj->SetArrayField(TEXT("pins"), PinsArray);
-
-			TArray<TSharedPtr<FJsonValue>> ConnectionsArray;
-			for (UEdGraphPin* Pin : Node->Pins)
-			{
-				if (!Pin || Pin->Direction != EGPD_Output) continue;
-
-				for (UEdGraphPin* LinkedPin : Pin->LinkedTo)
-				{
-					if (!LinkedPin || !LinkedPin->GetOwningNode()) continue;
-
-					TSharedPtr<FJsonObject> ConnObj = MakeShared<FJsonObject>();
-					ConnObj->SetStringField(TEXT("from_pin"), Pin->PinName.ToString());
-					ConnObj->SetStringField(TEXT("to_node"), LinkedPin->GetOwningNode()->NodeGuid.ToString());
-					ConnObj->SetStringField(TEXT("to_pin"), LinkedPin->PinName.ToString());
-					ConnectionsArray.Add(MakeShared<FJsonValueObject>(ConnObj));
-				}
-			}
-			NodeObj->SetArrayField(TEXT("connections"), ConnectionsArray);
-
-			NodesArray.Add(MakeShared<FJsonValueObject>(NodeObj));
-		}
-
-		GraphObj->SetArrayField(TEXT("nodes"), NodesArray);
-		GraphObj->SetNumberField(TEXT("node_count"), NodesArray.Num());
-		GraphsArray.Add(MakeShared<FJsonValueObject>(GraphObj));
+		Graphs.Add(Graph);
 	}
+	TArray<FGraphReadPlan> Plans = PlanGraphReads(*GraphSnapshots, Graphs, bSinceVersion ? &SinceVersion : nullptr, Page, StartIndex, MaxNodes);
 
-	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
-	Data->SetArrayField(TEXT("graphs"), GraphsArray);
-	Data->SetNumberField(TEXT("count"), GraphsArray.Num());
-
-	return MakeResponse(true, Data);
+	TSharedRef<FGraphReadStream> Stream = MakeShared<FGraphReadStream>(MoveTemp(Plans), Fields, true);
+	Stream->SetSnapshots(GraphSnapshots, bSinceVersion, Page.GetNextCursor());
+	return RunResponseStream(Stream);
 }
 
 static TArray<TSharedPtr<FJsonValue>> SerializeRichCurveKeys(const FRichCurve& Curve)
@@ -0,0 +1,200 @@
+#include "MCPServerResolveCache.h"
+#include "MCPServerHelpers.h"
+#include "Engine/Blueprint.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/PackageName.h"
+#include "UObject/PackageReload.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace MCPResolveCache
+{
+	// Object path in an export-text reference (Blueprint'/Game/BP.BP'), else the text trimmed
+	static FString StripReference(const FString& Path)
+	{
+		FString Text = Path.TrimStartAndEnd();
+		Text.TrimQuotesInline();
+		return FPackageName::ExportTextPathToObjectPath(Text);
+	}
+}
+
+FMCPResolveCache::FMCPResolveCache()
+	: Blueprints(MaxEntries)
+	, Classes(MaxEntries)
+{
+}
+
+FMCPResolveCache::~FMCPResolveCache()
+{
+	if (!bBound)
+	{
+		return;
+	}
+
+	if (FAssetRegistryModule* AssetRegistryModule = FModuleManager::GetModulePtr<FAssetRegistryModule>("AssetRegistry"))
+	{
+		IAssetRegistry& AssetRegistry = AssetRegistryModule->Get();
+		AssetRegistry.OnAssetAdded().Remove(AssetAddedHandle);
+		AssetRegistry.OnAssetRemoved().Remove(AssetRemovedHandle);
+		AssetRegistry.OnAssetRenamed().Remove(AssetRenamedHandle);
+		AssetRegistry.OnInMemoryAssetCreated().Remove(InMemoryAssetCreatedHandle);
+		AssetRegistry.OnInMemoryAssetDeleted().Remove(InMemoryAssetDeletedHandle);
+	}
+	FCoreUObjectDelegates::OnPackageReloaded.Remove(PackageReloadedHandle);
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+	FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
+}
+
+UBlueprint* FMCPResolveCache::FindBlueprint(const FString& Path)
+{
+	const FString Key = NormalizeBlueprintPath(Path);
+	return Cast<UBlueprint>(FindOrResolve(Blueprints, Key, [&Key]() -> UObject*
+	{
+		return LoadObject<UBlueprint>(nullptr, *Key);
+	}));
+}
+
+UClass* FMCPResolveCache::FindClass(const FString& ClassPath)
+{
+	const FString Key = MCPResolveCache::StripReference(ClassPath);
+	if (Key.IsEmpty())
+	{
+		return nullptr;
+	}
+	return Cast<UClass>(FindOrResolve(Classes, Key, [&Key]() -> UObject*
+	{
+		return ResolveParentClass(Key);
+	}));
+}
+
+FString FMCPResolveCache::NormalizeBlueprintPath(const FString& Path)
+{
+	FString Normalized = MCPResolveCache::StripReference(Path);
+	Normalized.ReplaceCharInline(TEXT('\\'), TEXT('/'));
+	if (!Normalized.StartsWith(TEXT("/")))
+	{
+		Normalized = TEXT("/Game/") + Normalized;
+	}
+
+	const FString Extension = TEXT(".") + FPackageName::GetAssetPackageExtension();
+	if (Normalized.EndsWith(Extension))
+	{
+		Normalized.LeftChopInline(Extension.Len());
+	}
+
+	// A package path names the asset of the same name inside it
+	int32 LastSlash = INDEX_NONE;
+	Normalized.FindLastChar(TEXT('/'), LastSlash);
+	const FString AssetName = Normalized.RightChop(LastSlash + 1);
+	if (!AssetName.IsEmpty() && !AssetName.Contains(TEXT(".")))
+	{
+		Normalized += TEXT(".") + AssetName;
+	}
+	return Normalized;
+}
+
+UObject* FMCPResolveCache::FindOrResolve(FEntries& Entries, const FString& Key, TFunctionRef<UObject*()> Resolve)
+{
+	BindDelegates();
+
+	if (const FEntry* Entry = Entries.FindAndTouch(Key))
+	{
+		if (Entry->bMiss && Entry->MissGeneration == MissGeneration)
+		{
+			return nullptr;
+		}
+		if (!Entry->bMiss)
+		{
+			if (UObject* Object = Entry->Object.Get())
+			{
+				return Object;
+			}
+		}
+	}
+
+	UObject* Object = Resolve();
+
+	FEntry Entry;
+	Entry.Object = Object;
+	Entry.bMiss = Object == nullptr;
+	Entry.MissGeneration = MissGeneration;
+	Entries.Add(Key, Entry);
+	return Object;
+}
+
+void FMCPResolveCache::BindDelegates()
+{
+	if (bBound)
+	{
+		return;
+	}
+	bBound = true;
+
+	IAssetRegistry& AssetRegistry = FAssetRegistryModule::GetRegistry();
+	AssetAddedHandle = AssetRegistry.OnAssetAdded().AddRaw(this, &FMCPResolveCache::OnAssetAdded);
+	AssetRemovedHandle = AssetRegistry.OnAssetRemoved().AddRaw(this, &FMCPResolveCache::OnAssetRemoved);
+	AssetRenamedHandle = AssetRegistry.OnAssetRenamed().AddRaw(this, &FMCPResolveCache::OnAssetRenamed);
+	InMemoryAssetCreatedHandle = AssetRegistry.OnInMemoryAssetCreated().AddRaw(this, &FMCPResolveCache::OnInMemoryAssetCreated);
+	InMemoryAssetDeletedHandle = AssetRegistry.OnInMemoryAssetDeleted().AddRaw(this, &FMCPResolveCache::OnInMemoryAssetDeleted);
+	PackageReloadedHandle = FCoreUObjectDelegates::OnPackageReloaded.AddRaw(this, &FMCPResolveCache::OnPackageReloaded);
+	// Live coding and hot reload can add classes
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddLambda([this](EReloadCompleteReason)
+	{
+		ForgetMisses();
+	});
+	ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddRaw(this, &FMCPResolveCache::OnModulesChanged);
+}
+
+void FMCPResolveCache::Clear()
+{
+	Blueprints.Empty(MaxEntries);
+	Classes.Empty(MaxEntries);
+}
+
+void FMCPResolveCache::ForgetMisses()
+{
+	// Entries recorded in an older generation no longer count as misses
+	++MissGeneration;
+}
+
+void FMCPResolveCache::OnAssetAdded(const FAssetData& AssetData)
+{
+	ForgetMisses();
+}
+
+void FMCPResolveCache::OnAssetRemoved(const FAssetData& AssetData)
+{
+	Clear();
+}
+
+void FMCPResolveCache::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	// The object keeps its pointer, so a hit for the old path would still find it
+	Clear();
+	ForgetMisses();
+}
+
+void FMCPResolveCache::OnInMemoryAssetCreated(UObject* Object)
+{
+	ForgetMisses();
+}
+
+void FMCPResolveCache::OnInMemoryAssetDeleted(UObject* Object)
+{
+	Clear();
+}
+
+void FMCPResolveCache::OnPackageReloaded(EPackageReloadPhase Phase, FPackageReloadedEvent* Event)
+{
+	// Reloading replaces the package's objects
+	Clear();
+	ForgetMisses();
+}
+
+void FMCPResolveCache::OnModulesChanged(FName ModuleName, EModuleChangeReason Reason)
+{
+	if (Reason == EModuleChangeReason::ModuleLoaded)
+	{
+		ForgetMisses();
+	}
+}
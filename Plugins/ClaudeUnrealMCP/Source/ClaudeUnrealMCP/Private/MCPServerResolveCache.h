@@ -0,0 +1,85 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/LruCache.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/WeakObjectPtr.h"
+
+class UBlueprint;
+struct FAssetData;
+enum class EPackageReloadPhase : uint8;
+class FPackageReloadedEvent;
+
+/**
+ * What LoadBlueprintFromPath and ResolveParentClass resolved recently, so repeated commands
+ * against the same blueprint or class skip the resolver (and the failed loads and warnings of
+ * its fallbacks) entirely.
+ *
+ * Paths are normalized first, so "BP_Foo", "/Game/BP_Foo", "/Game/BP_Foo.BP_Foo" and
+ * "Blueprint'/Game/BP_Foo.BP_Foo'" share one entry. Hits are held weakly and resolved again
+ * once the object is gone. Misses are remembered too, until an asset is added, created or
+ * renamed, a module is loaded, or code is reloaded, since any of those can make the path
+ * resolve. Every entry is dropped when an asset is removed, renamed or its package reloaded.
+ * Each kind of lookup keeps its most recently used entries only.
+ *
+ * Game thread only.
+ */
+class FMCPResolveCache
+{
+public:
+	FMCPResolveCache();
+	~FMCPResolveCache();
+
+	/** The blueprint at an object path; relative paths are under /Game/. */
+	UBlueprint* FindBlueprint(const FString& Path);
+
+	/** The class ResolveParentClass finds for a name or path. */
+	UClass* FindClass(const FString& ClassPath);
+
+	/** "/Game/Dir/BP.BP" for "Dir/BP", "/Game/Dir/BP", "/Game/Dir/BP.uasset" or "Blueprint'/Game/Dir/BP.BP'". */
+	static FString NormalizeBlueprintPath(const FString& Path);
+
+	// Entries kept per kind of lookup
+	static constexpr int32 MaxEntries = 512;
+
+private:
+	struct FEntry
+	{
+		TWeakObjectPtr<UObject> Object;
+		// Set for misses: the miss generation it was recorded in
+		uint32 MissGeneration = 0;
+		bool bMiss = false;
+	};
+
+	using FEntries = TLruCache<FString, FEntry>;
+
+	UObject* FindOrResolve(FEntries& Entries, const FString& Key, TFunctionRef<UObject*()> Resolve);
+	void BindDelegates();
+
+	void Clear();
+	void ForgetMisses();
+
+	void OnAssetAdded(const FAssetData& AssetData);
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+	void OnInMemoryAssetCreated(UObject* Object);
+	void OnInMemoryAssetDeleted(UObject* Object);
+	void OnPackageReloaded(EPackageReloadPhase Phase, FPackageReloadedEvent* Event);
+	void OnModulesChanged(FName ModuleName, EModuleChangeReason Reason);
+
+	FEntries Blueprints;
+	FEntries Classes;
+
+	// Bumped whenever a miss may have become resolvable
+	uint32 MissGeneration = 0;
+
+	bool bBound = false;
+	FDelegateHandle AssetAddedHandle;
+	FDelegateHandle AssetRemovedHandle;
+	FDelegateHandle AssetRenamedHandle;
+	FDelegateHandle InMemoryAssetCreatedHandle;
+	FDelegateHandle InMemoryAssetDeletedHandle;
+	FDelegateHandle PackageReloadedHandle;
+	FDelegateHandle ReloadCompleteHandle;
+	FDelegateHandle ModulesChangedHandle;
+};
@@ -0,0 +1,636 @@
+#include "MCPServerResponseWriter.h"
+#include "MCPServerDispatch.h"
+#include "MCPServerEncoding.h"
+#include "Misc/ScopeLock.h"
+
+namespace MCPResponseWriter
+{
+	// CBOR major types and the simple values used here (RFC 8949)
+	static constexpr uint8 CborUnsigned = 0;
+	static constexpr uint8 CborNegative = 1;
+	static constexpr uint8 CborText = 3;
+	static constexpr uint8 CborIndefiniteArray = 0x9F;
+	static constexpr uint8 CborIndefiniteMap = 0xBF;
+	static constexpr uint8 CborBreak = 0xFF;
+	static constexpr uint8 CborFalse = 0xF4;
+	static constexpr uint8 CborTrue = 0xF5;
+	static constexpr uint8 CborNull = 0xF6;
+	static constexpr uint8 CborDouble = 0xFB;
+
+	// Calls Visit with each code point of Text; unpaired surrogates become U+FFFD
+	template <typename VisitorType>
+	static void ForEachCodePoint(FStringView Text, VisitorType&& Visit)
+	{
+		const int32 Length = Text.Len();
+		for (int32 Index = 0; Index < Length; ++Index)
+		{
+			uint32 CodePoint = static_cast<uint32>(Text[Index]);
+			if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF)
+			{
+				const uint32 Low = Index + 1 < Length ? static_cast<uint32>(Text[Index + 1]) : 0;
+				if (Low >= 0xDC00 && Low <= 0xDFFF)
+				{
+					CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (Low - 0xDC00);
+					++Index;
+				}
+				else
+				{
+					CodePoint = 0xFFFD;
+				}
+			}
+			else if ((CodePoint >= 0xDC00 && CodePoint <= 0xDFFF) || CodePoint > 0x10FFFF)
+			{
+				CodePoint = 0xFFFD;
+			}
+			Visit(CodePoint);
+		}
+	}
+
+	static int32 Utf8Length(uint32 CodePoint)
+	{
+		return CodePoint < 0x80 ? 1 : CodePoint < 0x800 ? 2 : CodePoint < 0x10000 ? 3 : 4;
+	}
+
+	static void AppendCodePoint(TArray<uint8>& Buffer, uint32 CodePoint)
+	{
+		if (CodePoint < 0x80)
+		{
+			Buffer.Add(static_cast<uint8>(CodePoint));
+		}
+		else if (CodePoint < 0x800)
+		{
+			Buffer.Add(static_cast<uint8>(0xC0 | (CodePoint >> 6)));
+			Buffer.Add(static_cast<uint8>(0x80 | (CodePoint & 0x3F)));
+		}
+		else if (CodePoint < 0x10000)
+		{
+			Buffer.Add(static_cast<uint8>(0xE0 | (CodePoint >> 12)));
+			Buffer.Add(static_cast<uint8>(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Buffer.Add(static_cast<uint8>(0x80 | (CodePoint & 0x3F)));
+		}
+		else
+		{
+			Buffer.Add(static_cast<uint8>(0xF0 | (CodePoint >> 18)));
+			Buffer.Add(static_cast<uint8>(0x80 | ((CodePoint >> 12) & 0x3F)));
+			Buffer.Add(static_cast<uint8>(0x80 | ((CodePoint >> 6) & 0x3F)));
+			Buffer.Add(static_cast<uint8>(0x80 | (CodePoint & 0x3F)));
+		}
+	}
+
+	// Doubles that hold whole numbers (counts, indices) are written as integers, as in MCPEncoding
+	static bool IsIntegral(double Value)
+	{
+		return FMath::IsFinite(Value) && Value == FMath::RoundToDouble(Value) && FMath::Abs(Value) < 9.0e15;
+	}
+}
+
+FMCPBufferPool& FMCPBufferPool::Get()
+{
+	static FMCPBufferPool Pool;
+	return Pool;
+}
+
+TArray<uint8> FMCPBufferPool::Acquire()
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (FreeBuffers.Num() > 0)
+		{
+			return FreeBuffers.Pop(EAllowShrinking::No);
+		}
+	}
+
+	TArray<uint8> Buffer;
+	Buffer.Reserve(InitialCapacity);
+	return Buffer;
+}
+
+void FMCPBufferPool::Release(TArray<uint8>&& Buffer)
+{
+	// Small frames are cheap to allocate and huge ones are not worth pinning in memory
+	if (Buffer.Max() < InitialCapacity || Buffer.Max() > MaxRetainedCapacity)
+	{
+		return;
+	}
+
+	Buffer.Reset();
+
+	FScopeLock ScopeLock(&Lock);
+	if (FreeBuffers.Num() < MaxFreeBuffers)
+	{
+		FreeBuffers.Add(MoveTemp(Buffer));
+	}
+}
+
+FMCPResponseWriter::FMCPResponseWriter()
+	: Buffer(FMCPBufferPool::Get().Acquire())
+{
+	FMCPRequestContext* CurrentContext = FMCPRequestContext::Get();
+	if (CurrentContext && CurrentContext->Connection.IsValid() && CurrentContext->SendFrame && CurrentContext->NestingDepth == 0)
+	{
+		Context = CurrentContext;
+		Connection = CurrentContext->Connection;
+		SendFrame = CurrentContext->SendFrame;
+		Encoding = CurrentContext->Encoding;
+		bChunked = Connection->bChunkedResponses;
+	}
+
+	bPrefixed = Encoding != EMCPEncoding::Json || bChunked;
+	if (bPrefixed)
+	{
+		MCPEncoding::BeginPrefixedFrame(Buffer);
+	}
+
+	// Same envelope as MakeResponse, with the request id first as the server adds it
+	BeginObject();
+	if (Context && Context->RequestId.IsValid())
+	{
+		WriteJsonValue(TEXT("id"), Context->RequestId);
+	}
+	WriteBool(TEXT("success"), true);
+	BeginObject(TEXT("data"));
+}
+
+FMCPResponseWriter::~FMCPResponseWriter()
+{
+	if (!bFinished)
+	{
+		FMCPBufferPool::Get().Release(MoveTemp(Buffer));
+	}
+}
+
+void FMCPResponseWriter::BeginObject()
+{
+	BeginElement();
+	BeginContainer(EScope::Object);
+}
+
+void FMCPResponseWriter::BeginObject(FStringView Key)
+{
+	WriteKey(Key);
+	BeginContainer(EScope::Object);
+}
+
+void FMCPResponseWriter::EndObject()
+{
+	EndContainer(EScope::Object);
+}
+
+void FMCPResponseWriter::BeginArray()
+{
+	BeginElement();
+	BeginContainer(EScope::Array);
+}
+
+void FMCPResponseWriter::BeginArray(FStringView Key)
+{
+	WriteKey(Key);
+	BeginContainer(EScope::Array);
+}
+
+void FMCPResponseWriter::EndArray()
+{
+	EndContainer(EScope::Array);
+}
+
+void FMCPResponseWriter::WriteString(FStringView Key, FStringView Value)
+{
+	WriteKey(Key);
+	AppendString(Value);
+}
+
+void FMCPResponseWriter::WriteInteger(FStringView Key, int64 Value)
+{
+	WriteKey(Key);
+	AppendInteger(Value);
+}
+
+void FMCPResponseWriter::WriteNumber(FStringView Key, double Value)
+{
+	WriteKey(Key);
+	AppendNumber(Value);
+}
+
+void FMCPResponseWriter::WriteBool(FStringView Key, bool Value)
+{
+	WriteKey(Key);
+	AppendBool(Value);
+}
+
+void FMCPResponseWriter::WriteNull(FStringView Key)
+{
+	WriteKey(Key);
+	AppendNull();
+}
+
+void FMCPResponseWriter::WriteJsonValue(FStringView Key, const TSharedPtr<FJsonValue>& Value)
+{
+	WriteKey(Key);
+	AppendJsonValue(Value);
+}
+
+void FMCPResponseWriter::WriteString(FStringView Value)
+{
+	BeginElement();
+	AppendString(Value);
+}
+
+void FMCPResponseWriter::WriteInteger(int64 Value)
+{
+	BeginElement();
+	AppendInteger(Value);
+}
+
+void FMCPResponseWriter::WriteJsonValue(const TSharedPtr<FJsonValue>& Value)
+{
+	BeginElement();
+	AppendJsonValue(Value);
+}
+
+FString FMCPResponseWriter::Finish()
+{
+	check(!bFinished);
+	EndObject(); // data
+	EndObject(); // response
+	ensureMsgf(Scopes.Num() == 0, TEXT("ClaudeUnrealMCP: Response finished with %d unclosed containers"), Scopes.Num());
+	bFinished = true;
+
+	if (Connection.IsValid())
+	{
+		if (StreamId != 0)
+		{
+			FlushChunk(true);
+			FMCPBufferPool::Get().Release(MoveTemp(Buffer));
+		}
+		else
+		{
+			// Fits in one frame
+			if (bPrefixed)
+			{
+				MCPEncoding::FinishPrefixedFrame(Buffer, Encoding);
+			}
+			else
+			{
+				AppendByte('\n');
+			}
+			SendFrame(MoveTemp(Buffer));
+		}
+
+		if (!bDeferred)
+		{
+			Context->bResponseSent = true;
+		}
+		return FString();
+	}
+
+	FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Buffer.GetData()), Buffer.Num());
+	FString Result(Converter.Length(), Converter.Get());
+	FMCPBufferPool::Get().Release(MoveTemp(Buffer));
+	return Result;
+}
+
+void FMCPResponseWriter::WriteKey(FStringView Key)
+{
+	checkSlow(Scopes.Num() > 0 && Scopes.Last() == EScope::Object);
+	BeginElement();
+
+	if (Encoding == EMCPEncoding::Json)
+	{
+		AppendJsonString(Key);
+		AppendByte(':');
+	}
+	else
+	{
+		AppendString(Key);
+	}
+}
+
+void FMCPResponseWriter::BeginElement()
+{
+	// Keys and values alternate inside objects; only the key position takes a separator
+	if (Encoding == EMCPEncoding::Json && Scopes.Num() > 0)
+	{
+		if (bHasElement)
+		{
+			AppendByte(',');
+		}
+		bHasElement = true;
+	}
+}
+
+void FMCPResponseWriter::BeginContainer(EScope Scope)
+{
+	if (Encoding == EMCPEncoding::Json)
+	{
+		AppendByte(Scope == EScope::Object ? '{' : '[');
+	}
+	else
+	{
+		// Indefinite lengths, so nothing has to be counted before it is written
+		AppendByte(Scope == EScope::Object ? MCPResponseWriter::CborIndefiniteMap : MCPResponseWriter::CborIndefiniteArray);
+	}
+
+	Scopes.Add(Scope);
+	HasElementStack.Add(bHasElement);
+	bHasElement = false;
+}
+
+void FMCPResponseWriter::EndContainer(EScope Scope)
+{
+	check(Scopes.Num() > 0 && Scopes.Last() == Scope);
+	Scopes.Pop(EAllowShrinking::No);
+	bHasElement = HasElementStack.Pop(EAllowShrinking::No);
+
+	if (Encoding == EMCPEncoding::Json)
+	{
+		AppendByte(Scope == EScope::Object ? '}' : ']');
+	}
+	else
+	{
+		AppendByte(MCPResponseWriter::CborBreak);
+	}
+
+	// Chunks are cut between elements only to keep the check cheap; the split point does not
+	// matter to the client, which joins the payloads back together before decoding
+	if (bChunked && Buffer.Num() >= ChunkBytes && Scopes.Num() > 0)
+	{
+		FlushChunk(false);
+	}
+}
+
+void FMCPResponseWriter::FlushChunk(bool bLast)
+{
+	if (StreamId == 0)
+	{
+		StreamId = static_cast<uint32>(Connection->NextStreamId.Increment());
+	}
+
+	if (Connection->bClosed)
+	{
+		// Nobody is listening any more; keep memory flat until the handler finishes
+		MCPEncoding::BeginPrefixedFrame(Buffer);
+		return;
+	}
+
+	ANSICHAR Tags[48];
+	FCStringAnsi::Snprintf(Tags, UE_ARRAY_COUNT(Tags), bLast ? "chunk=%u:last" : "chunk=%u", StreamId);
+	MCPEncoding::FinishPrefixedFrame(Buffer, Encoding, Tags);
+	SendFrame(MoveTemp(Buffer));
+
+	Buffer = FMCPBufferPool::Get().Acquire();
+	MCPEncoding::BeginPrefixedFrame(Buffer);
+}
+
+bool FMCPResponseWriter::IsBackedUp()
+{
+	if (!IsStreaming() || Connection->bClosed)
+	{
+		return false;
+	}
+
+	const int64 Queued = Connection->QueuedBytes.GetValue();
+	if (Queued <= MaxQueuedBytes)
+	{
+		StallStartTime = 0.0;
+		return false;
+	}
+
+	// Any bytes taken since the last check restart the clock; only a client that has stopped
+	// reading altogether is dropped
+	const double Now = FPlatformTime::Seconds();
+	if (StallStartTime == 0.0 || Queued < StallQueuedBytes)
+	{
+		StallStartTime = Now;
+		StallQueuedBytes = Queued;
+	}
+	else if (Now - StallStartTime > StallTimeoutSeconds)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("ClaudeUnrealMCP: Client on connection %u stopped reading a streamed response; dropping it"),
+			Connection->ConnectionId);
+		Connection->bClosed = true;
+		return false;
+	}
+	return true;
+}
+
+void FMCPResponseWriter::AppendString(FStringView Value)
+{
+	if (Encoding == EMCPEncoding::Json)
+	{
+		AppendJsonString(Value);
+		return;
+	}
+
+	int32 ByteLength = 0;
+	MCPResponseWriter::ForEachCodePoint(Value, [&ByteLength](uint32 CodePoint)
+	{
+		ByteLength += MCPResponseWriter::Utf8Length(CodePoint);
+	});
+
+	AppendCborHeader(MCPResponseWriter::CborText, ByteLength);
+	AppendUtf8(Value);
+}
+
+void FMCPResponseWriter::AppendInteger(int64 Value)
+{
+	if (Encoding == EMCPEncoding::Json)
+	{
+		ANSICHAR Text[32];
+		FCStringAnsi::Snprintf(Text, UE_ARRAY_COUNT(Text), "%lld", static_cast<long long>(Value));
+		AppendAnsi(Text);
+	}
+	else if (Value >= 0)
+	{
+		AppendCborHeader(MCPResponseWriter::CborUnsigned, static_cast<uint64>(Value));
+	}
+	else
+	{
+		AppendCborHeader(MCPResponseWriter::CborNegative, static_cast<uint64>(-1 - Value));
+	}
+}
+
+void FMCPResponseWriter::AppendNumber(double Value)
+{
+	if (MCPResponseWriter::IsIntegral(Value))
+	{
+		AppendInteger(static_cast<int64>(Value));
+		return;
+	}
+
+	if (!FMath::IsFinite(Value))
+	{
+		// JSON has no representation for NaN or infinity
+		AppendNull();
+		return;
+	}
+
+	if (Encoding == EMCPEncoding::Json)
+	{
+		ANSICHAR Text[40];
+		FCStringAnsi::Snprintf(Text, UE_ARRAY_COUNT(Text), "%.17g", Value);
+		AppendAnsi(Text);
+		return;
+	}
+
+	uint64 Bits = 0;
+	FMemory::Memcpy(&Bits, &Value, sizeof(Bits));
+	AppendByte(MCPResponseWriter::CborDouble);
+	for (int32 Shift = 56; Shift >= 0; Shift -= 8)
+	{
+		AppendByte(static_cast<uint8>(Bits >> Shift));
+	}
+}
+
+void FMCPResponseWriter::AppendBool(bool Value)
+{
+	if (Encoding == EMCPEncoding::Json)
+	{
+		AppendAnsi(Value ? "true" : "false");
+	}
+	else
+	{
+		AppendByte(Value ? MCPResponseWriter::CborTrue : MCPResponseWriter::CborFalse);
+	}
+}
+
+void FMCPResponseWriter::AppendNull()
+{
+	if (Encoding == EMCPEncoding::Json)
+	{
+		AppendAnsi("null");
+	}
+	else
+	{
+		AppendByte(MCPResponseWriter::CborNull);
+	}
+}
+
+void FMCPResponseWriter::AppendJsonValue(const TSharedPtr<FJsonValue>& Value)
+{
+	if (!Value.IsValid())
+	{
+		AppendNull();
+		return;
+	}
+
+	switch (Value->Type)
+	{
+	case EJson::String:
+		AppendString(Value->AsString());
+		break;
+
+	case EJson::Number:
+		AppendNumber(Value->AsNumber());
+		break;
+
+	case EJson::Boolean:
+		AppendBool(Value->AsBool());
+		break;
+
+	case EJson::Array:
+		BeginContainer(EScope::Array);
+		for (const TSharedPtr<FJsonValue>& Element : Value->AsArray())
+		{
+			BeginElement();
+			AppendJsonValue(Element);
+		}
+		EndContainer(EScope::Array);
+		break;
+
+	case EJson::Object:
+		BeginContainer(EScope::Object);
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Value->AsObject()->Values)
+		{
+			WriteKey(Field.Key);
+			AppendJsonValue(Field.Value);
+		}
+		EndContainer(EScope::Object);
+		break;
+
+	case EJson::None:
+	case EJson::Null:
+	default:
+		AppendNull();
+		break;
+	}
+}
+
+void FMCPResponseWriter::AppendAnsi(const ANSICHAR* Text)
+{
+	Buffer.Append(reinterpret_cast<const uint8*>(Text), FCStringAnsi::Strlen(Text));
+}
+
+void FMCPResponseWriter::AppendUtf8(FStringView Text)
+{
+	MCPResponseWriter::ForEachCodePoint(Text, [this](uint32 CodePoint)
+	{
+		MCPResponseWriter::AppendCodePoint(Buffer, CodePoint);
+	});
+}
+
+void FMCPResponseWriter::AppendJsonString(FStringView Text)
+{
+	static const ANSICHAR HexDigits[] = "0123456789abcdef";
+
+	AppendByte('"');
+	MCPResponseWriter::ForEachCodePoint(Text, [this](uint32 CodePoint)
+	{
+		switch (CodePoint)
+		{
+		case '"': AppendAnsi("\\\""); return;
+		case '\\': AppendAnsi("\\\\"); return;
+		case '\n': AppendAnsi("\\n"); return;
+		case '\r': AppendAnsi("\\r"); return;
+		case '\t': AppendAnsi("\\t"); return;
+		case '\b': AppendAnsi("\\b"); return;
+		case '\f': AppendAnsi("\\f"); return;
+		default: break;
+		}
+
+		if (CodePoint < 0x20)
+		{
+			// Raw control characters would also break newline framing
+			AppendAnsi("\\u00");
+			AppendByte(HexDigits[CodePoint >> 4]);
+			AppendByte(HexDigits[CodePoint & 0xF]);
+			return;
+		}
+
+		MCPResponseWriter::AppendCodePoint(Buffer, CodePoint);
+	});
+	AppendByte('"');
+}
+
+void FMCPResponseWriter::AppendCborHeader(uint8 MajorType, uint64 Argument)
+{
+	const uint8 Major = static_cast<uint8>(MajorType << 5);
+	if (Argument < 24)
+	{
+		AppendByte(Major | static_cast<uint8>(Argument));
+		return;
+	}
+
+	int32 ByteCount = 8;
+	uint8 Info = 27;
+	if (Argument <= 0xFF)
+	{
+		ByteCount = 1;
+		Info = 24;
+	}
+	else if (Argument <= 0xFFFF)
+	{
+		ByteCount = 2;
+		Info = 25;
+	}
+	else if (Argument <= 0xFFFFFFFF)
+	{
+		ByteCount = 4;
+		Info = 26;
+	}
+
+	AppendByte(Major | Info);
+	for (int32 Shift = (ByteCount - 1) * 8; Shift >= 0; Shift -= 8)
+	{
+		AppendByte(static_cast<uint8>(Argument >> Shift));
+	}
+}
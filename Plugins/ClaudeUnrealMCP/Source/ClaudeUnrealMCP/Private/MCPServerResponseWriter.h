@@ -0,0 +1,186 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "HAL/CriticalSection.h"
+#include "MCPServerConnection.h"
+#include "MCPServerJobs.h"
+
+struct FMCPRequestContext;
+
+/**
+ * Recycles outgoing frame buffers so large responses do not reallocate their way up to
+ * full size on every request. The reactor hands buffers back once they are sent.
+ */
+class FMCPBufferPool
+{
+public:
+	static FMCPBufferPool& Get();
+
+	/** An empty buffer, with capacity left over from earlier use when one is available. */
+	TArray<uint8> Acquire();
+	void Release(TArray<uint8>&& Buffer);
+
+private:
+	// Bounds on what the pool holds on to while idle
+	static constexpr int32 MaxFreeBuffers = 8;
+	static constexpr int32 MaxRetainedCapacity = 8 * 1024 * 1024;
+	static constexpr int32 InitialCapacity = 64 * 1024;
+
+	FCriticalSection Lock;
+	TArray<TArray<uint8>> FreeBuffers;
+};
+
+/**
+ * Streams a successful response straight into its output frame, with no FJsonObject tree
+ * in between. Use it in handlers whose responses can get large (graph dumps):
+ *
+ *     FMCPResponseWriter Writer;           // opens {"success":true,"data":{
+ *     Writer.BeginArray(TEXT("graphs"));
+ *     ...
+ *     Writer.EndArray();
+ *     return Writer.Finish();              // closes the response and hands it to the server
+ *
+ * Output uses the encoding the calling connection negotiated (JSON or CBOR) and carries the
+ * request id. When there is no connection to stream to (e.g. inside batch), Finish returns
+ * the JSON text instead, like MakeResponse. Validate parameters and return MakeError before
+ * creating the writer; once started, the response is a success.
+ *
+ * If the client asked for chunking, output is sent in frames of about ChunkBytes as it is
+ * written, so the server never holds the whole response. The writer itself never waits for
+ * the client; producers that can pause check IsBackedUp between elements, or are written as
+ * an FMCPResponseStream, which the server parks until the connection has drained. A client
+ * that takes nothing for StallTimeoutSeconds while backed up is disconnected.
+ */
+class FMCPResponseWriter
+{
+public:
+	FMCPResponseWriter();
+	~FMCPResponseWriter();
+
+	FMCPResponseWriter(const FMCPResponseWriter&) = delete;
+	FMCPResponseWriter& operator=(const FMCPResponseWriter&) = delete;
+
+	// Containers; the keyed forms add a member to the enclosing object, the others an array element
+	void BeginObject();
+	void BeginObject(FStringView Key);
+	void EndObject();
+	void BeginArray();
+	void BeginArray(FStringView Key);
+	void EndArray();
+
+	// Object members
+	void WriteString(FStringView Key, FStringView Value);
+	void WriteInteger(FStringView Key, int64 Value);
+	void WriteNumber(FStringView Key, double Value);
+	void WriteBool(FStringView Key, bool Value);
+	void WriteNull(FStringView Key);
+	void WriteJsonValue(FStringView Key, const TSharedPtr<FJsonValue>& Value);
+
+	// Array elements
+	void WriteString(FStringView Value);
+	void WriteInteger(int64 Value);
+	void WriteJsonValue(const TSharedPtr<FJsonValue>& Value);
+
+	/** Close the response. Returns what the handler should return. */
+	FString Finish();
+
+	/** True when output goes out in chunks as it is written, straight to the calling connection. */
+	bool IsStreaming() const { return bChunked && Connection.IsValid(); }
+
+	/** True while the client is more than MaxQueuedBytes behind; producers should pause. */
+	bool IsBackedUp();
+
+	/**
+	 * Finish will be called later, outside the handler (FMCPServer::RunResponseStream), so it
+	 * must not touch the request context. Only for streaming writers.
+	 */
+	void Defer() { check(IsStreaming()); bDeferred = true; }
+
+	const FMCPConnectionPtr& GetConnection() const { return Connection; }
+
+	// Size at which a chunked response is cut into a frame
+	static constexpr int32 ChunkBytes = 64 * 1024;
+
+	// Unsent bytes a connection may have queued before producers pause
+	static constexpr int64 MaxQueuedBytes = 4 * 1024 * 1024;
+
+	// How long a backed-up client may go without taking any bytes before it is dropped
+	static constexpr double StallTimeoutSeconds = 30.0;
+
+private:
+	enum class EScope : uint8
+	{
+		Object,
+		Array
+	};
+
+	void WriteKey(FStringView Key);
+	void BeginElement();
+	void BeginContainer(EScope Scope);
+	void EndContainer(EScope Scope);
+
+	/** Send what has been written so far as one chunk of the response stream. */
+	void FlushChunk(bool bLast);
+
+	// Bare values, in the writer's encoding
+	void AppendString(FStringView Value);
+	void AppendInteger(int64 Value);
+	void AppendNumber(double Value);
+	void AppendBool(bool Value);
+	void AppendNull();
+	void AppendJsonValue(const TSharedPtr<FJsonValue>& Value);
+
+	void AppendByte(uint8 Byte) { Buffer.Add(Byte); }
+	void AppendAnsi(const ANSICHAR* Text);
+	void AppendUtf8(FStringView Text);
+	void AppendJsonString(FStringView Text);
+	void AppendCborHeader(uint8 MajorType, uint64 Argument);
+
+	TArray<uint8> Buffer;
+	EMCPEncoding Encoding = EMCPEncoding::Json;
+
+	// Set when the response goes straight to the connection rather than back as a string. The
+	// context is only used while the handler runs; the rest is copied so Finish can come later.
+	FMCPRequestContext* Context = nullptr;
+	FMCPConnectionPtr Connection;
+	TFunction<void(TArray<uint8>&&)> SendFrame;
+	bool bDeferred = false;
+
+	// Backed-up bookkeeping: when the client stopped taking bytes, and how many were queued then
+	double StallStartTime = 0.0;
+	int64 StallQueuedBytes = 0;
+
+	// Length-prefixed framing (always for binary encodings, and for JSON once chunking is on)
+	bool bPrefixed = false;
+	bool bChunked = false;
+	uint32 StreamId = 0;
+	bool bFinished = false;
+
+	// Open containers, and whether the innermost one already has an element (JSON needs commas)
+	TArray<EScope, TInlineAllocator<32>> Scopes;
+	bool bHasElement = false;
+	TArray<bool, TInlineAllocator<32>> HasElementStack;
+};
+
+/**
+ * A streamed response written a piece per Step, for handlers whose output can get large. The
+ * handler validates its parameters, builds the stream (which opens the response) and returns
+ * FMCPServer::RunResponseStream(Stream). The stream runs right away; if its client falls
+ * behind, the rest is parked and stepped from the job ticker once the connection has drained,
+ * so neither the game thread nor the response is held up by a slow reader.
+ *
+ * Everything a stream keeps between steps must survive other commands and garbage collection
+ * running in between: hold UObjects weakly and skip the ones that are gone.
+ */
+class FMCPResponseStream : public FMCPJob
+{
+public:
+	FMCPResponseWriter& GetWriter() { return Writer; }
+
+	virtual bool IsWaiting() override { return Writer.IsBackedUp(); }
+	virtual TSharedPtr<FJsonObject> BuildResult() override { return nullptr; }
+
+protected:
+	FMCPResponseWriter Writer;
+};
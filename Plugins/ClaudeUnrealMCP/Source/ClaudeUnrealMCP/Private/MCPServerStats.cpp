@@ -0,0 +1,228 @@
+#include "MCPServerStats.h"
+#include "MCPServer.h"
+#include "HAL/MemoryBase.h"
+
+UE_TRACE_CHANNEL_DEFINE(MCPServerChannel);
+
+namespace MCPServerStats
+{
+	struct FStatInfo
+	{
+		const TCHAR* Name;
+		// Multiplier from recorded units to reported ones
+		double Scale;
+	};
+
+	static const FStatInfo StatInfos[(int32)EMCPStat::Num] =
+	{
+		{TEXT("queue_wait_ms"), 0.001},
+		{TEXT("execute_ms"), 0.001},
+		{TEXT("serialize_ms"), 0.001},
+		{TEXT("send_ms"), 0.001},
+		{TEXT("response_bytes"), 1.0},
+		{TEXT("allocations"), 1.0}
+	};
+}
+
+FMCPServerStats::FMCPServerStats(const TArray<FString>& CommandNames)
+	: ResetTime(FPlatformTime::Seconds())
+{
+	Records.Reserve(CommandNames.Num());
+	for (const FString& Name : CommandNames)
+	{
+		CommandIndices.Add(Name, Records.Num());
+		TUniquePtr<FCommandRecord>& Record = Records.Add_GetRef(MakeUnique<FCommandRecord>());
+		Record->Name = Name;
+	}
+}
+
+int32 FMCPServerStats::FindCommand(const FString& Command) const
+{
+	const int32* Index = CommandIndices.Find(Command);
+	return Index ? *Index : INDEX_NONE;
+}
+
+const FString& FMCPServerStats::GetCommandName(int32 CommandIndex) const
+{
+	static const FString Unknown(TEXT("unknown command"));
+	return Records.IsValidIndex(CommandIndex) ? Records[CommandIndex]->Name : Unknown;
+}
+
+void FMCPServerStats::Record(int32 CommandIndex, EMCPStat Stat, uint64 Value)
+{
+	if (Records.IsValidIndex(CommandIndex))
+	{
+		Records[CommandIndex]->Stats[(int32)Stat].Add(Value);
+	}
+}
+
+void FMCPServerStats::RecordSeconds(int32 CommandIndex, EMCPStat Stat, double Seconds)
+{
+	Record(CommandIndex, Stat, (uint64)FMath::Max(Seconds * 1000000.0, 0.0));
+}
+
+uint64 FMCPServerStats::GetAllocationCount()
+{
+#if !UE_BUILD_SHIPPING
+	// Maintained by the engine's allocators; zero for allocators that do not count
+	return (uint64)FMalloc::TotalMallocCalls + (uint64)FMalloc::TotalReallocCalls;
+#else
+	return 0;
+#endif
+}
+
+TSharedPtr<FJsonObject> FMCPServerStats::ToJson(const TSet<FString>& Commands, bool bIncludeHistograms) const
+{
+	TArray<const FCommandRecord*> Ran;
+	uint64 TotalRequests = 0;
+	for (const TUniquePtr<FCommandRecord>& Record : Records)
+	{
+		const uint64 Count = Record->Stats[(int32)EMCPStat::Execute].Count.load(std::memory_order_relaxed);
+		TotalRequests += Count;
+		if (Count > 0 && (Commands.IsEmpty() || Commands.Contains(Record->Name)))
+		{
+			Ran.Add(Record.Get());
+		}
+	}
+
+	// Where the server's time goes: the command with the most total execution time first
+	Ran.Sort([](const FCommandRecord& A, const FCommandRecord& B)
+	{
+		return A.Stats[(int32)EMCPStat::Execute].Sum.load(std::memory_order_relaxed) >
+			B.Stats[(int32)EMCPStat::Execute].Sum.load(std::memory_order_relaxed);
+	});
+
+	TArray<TSharedPtr<FJsonValue>> CommandsArray;
+	for (const FCommandRecord* Record : Ran)
+	{
+		TSharedPtr<FJsonObject> CommandObj = MakeShared<FJsonObject>();
+		CommandObj->SetStringField(TEXT("command"), Record->Name);
+		CommandObj->SetNumberField(TEXT("count"), (double)Record->Stats[(int32)EMCPStat::Execute].Count.load(std::memory_order_relaxed));
+		for (int32 Stat = 0; Stat < (int32)EMCPStat::Num; ++Stat)
+		{
+			const MCPServerStats::FStatInfo& Info = MCPServerStats::StatInfos[Stat];
+			CommandObj->SetObjectField(Info.Name, Record->Stats[Stat].ToJson(Info.Scale, bIncludeHistograms));
+		}
+		CommandsArray.Add(MakeShared<FJsonValueObject>(CommandObj));
+	}
+
+	TSharedPtr<FJsonObject> Data = MakeShared<FJsonObject>();
+	Data->SetNumberField(TEXT("seconds"), FPlatformTime::Seconds() - ResetTime.load(std::memory_order_relaxed));
+	Data->SetNumberField(TEXT("total_requests"), (double)TotalRequests);
+	Data->SetBoolField(TEXT("allocations_counted"), GetAllocationCount() > 0);
+	Data->SetArrayField(TEXT("commands"), CommandsArray);
+	return Data;
+}
+
+void FMCPServerStats::Reset()
+{
+	for (const TUniquePtr<FCommandRecord>& Record : Records)
+	{
+		for (FHistogram& Histogram : Record->Stats)
+		{
+			Histogram.Reset();
+		}
+	}
+	ResetTime.store(FPlatformTime::Seconds(), std::memory_order_relaxed);
+}
+
+void FMCPServerStats::FHistogram::Add(uint64 Value)
+{
+	const int32 Bucket = Value == 0 ? 0 : FMath::Min((int32)FMath::FloorLog2_64(Value) + 1, NumBuckets - 1);
+	Buckets[Bucket].fetch_add(1, std::memory_order_relaxed);
+	Count.fetch_add(1, std::memory_order_relaxed);
+	Sum.fetch_add(Value, std::memory_order_relaxed);
+
+	uint64 Previous = Max.load(std::memory_order_relaxed);
+	while (Value > Previous && !Max.compare_exchange_weak(Previous, Value, std::memory_order_relaxed))
+	{
+	}
+}
+
+void FMCPServerStats::FHistogram::Reset()
+{
+	for (std::atomic<uint64>& Bucket : Buckets)
+	{
+		Bucket.store(0, std::memory_order_relaxed);
+	}
+	Count.store(0, std::memory_order_relaxed);
+	Sum.store(0, std::memory_order_relaxed);
+	Max.store(0, std::memory_order_relaxed);
+}
+
+uint64 FMCPServerStats::FHistogram::GetPercentile(double Fraction) const
+{
+	const uint64 Total = Count.load(std::memory_order_relaxed);
+	const uint64 Rank = FMath::Max<uint64>((uint64)FMath::CeilToDouble(Fraction * (double)Total), 1);
+	const uint64 Largest = Max.load(std::memory_order_relaxed);
+
+	uint64 Seen = 0;
+	for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+	{
+		Seen += Buckets[Bucket].load(std::memory_order_relaxed);
+		if (Seen >= Rank)
+		{
+			const uint64 UpperEdge = Bucket == 0 ? 0 : (uint64(1) << Bucket) - 1;
+			return FMath::Min(UpperEdge, Largest);
+		}
+	}
+	return Largest;
+}
+
+TSharedPtr<FJsonObject> FMCPServerStats::FHistogram::ToJson(double Scale, bool bIncludeBuckets) const
+{
+	const uint64 Samples = Count.load(std::memory_order_relaxed);
+	const double Total = (double)Sum.load(std::memory_order_relaxed) * Scale;
+
+	TSharedPtr<FJsonObject> Obj = MakeShared<FJsonObject>();
+	Obj->SetNumberField(TEXT("count"), (double)Samples);
+	Obj->SetNumberField(TEXT("total"), Total);
+	Obj->SetNumberField(TEXT("mean"), Samples > 0 ? Total / (double)Samples : 0.0);
+	Obj->SetNumberField(TEXT("p50"), (double)GetPercentile(0.50) * Scale);
+	Obj->SetNumberField(TEXT("p90"), (double)GetPercentile(0.90) * Scale);
+	Obj->SetNumberField(TEXT("p99"), (double)GetPercentile(0.99) * Scale);
+	Obj->SetNumberField(TEXT("max"), (double)Max.load(std::memory_order_relaxed) * Scale);
+
+	if (bIncludeBuckets)
+	{
+		// Non-empty buckets only, each with the largest value it can hold
+		TArray<TSharedPtr<FJsonValue>> BucketsArray;
+		for (int32 Bucket = 0; Bucket < NumBuckets; ++Bucket)
+		{
+			const uint64 BucketCount = Buckets[Bucket].load(std::memory_order_relaxed);
+			if (BucketCount == 0) continue;
+
+			TSharedPtr<FJsonObject> BucketObj = MakeShared<FJsonObject>();
+			const uint64 UpperEdge = Bucket == 0 ? 0 : (uint64(1) << Bucket) - 1;
+			BucketObj->SetNumberField(TEXT("le"), (double)UpperEdge * Scale);
+			BucketObj->SetNumberField(TEXT("count"), (double)BucketCount);
+			BucketsArray.Add(MakeShared<FJsonValueObject>(BucketObj));
+		}
+		Obj->SetArrayField(TEXT("buckets"), BucketsArray);
+	}
+	return Obj;
+}
+
+FString FMCPServer::HandleGetServerStats(const TSharedPtr<FJsonObject>& Params)
+{
+	TSet<FString> Commands;
+	bool bIncludeHistograms = false;
+	bool bReset = false;
+	if (Params.IsValid())
+	{
+		TArray<FString> CommandNames;
+		if (Params->TryGetStringArrayField(TEXT("commands"), CommandNames))
+		{
+			Commands.Append(CommandNames);
+		}
+		Params->TryGetBoolField(TEXT("histograms"), bIncludeHistograms);
+		Params->TryGetBoolField(TEXT("reset"), bReset);
+	}
+
+	TSharedPtr<FJsonObject> Data = Stats->ToJson(Commands, bIncludeHistograms);
+	if (bReset)
+	{
+		Stats->Reset();
+	}
+	return MakeResponse(true, Data);
+}
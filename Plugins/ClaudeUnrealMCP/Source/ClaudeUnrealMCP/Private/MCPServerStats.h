@@ -0,0 +1,96 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Trace/Trace.h"
+#include <atomic>
+
+/** Channel of the server's CPU trace scopes; record it in Unreal Insights with -trace=cpu,MCPServer. */
+UE_TRACE_CHANNEL_EXTERN(MCPServerChannel);
+
+/** What a sample measures. Times are recorded in microseconds. */
+enum class EMCPStat : uint8
+{
+	// From the request being read off the socket to its handler starting
+	QueueWait,
+
+	// The handler itself, on whichever thread the command runs
+	Execute,
+
+	// Encoding the handler's returned response into a frame; streamed responses encode inside Execute
+	Serialize,
+
+	// From a frame being queued to its last byte being written to the socket. One sample per frame.
+	Send,
+
+	// Bytes of each frame as written to the socket, after compression. One sample per frame.
+	ResponseBytes,
+
+	// Malloc and Realloc calls made by the whole process while the handler ran
+	Allocations,
+
+	Num
+};
+
+/**
+ * Per-command histograms of queue wait, execution, serialization and send time, response size
+ * and allocations, reported by get_server_stats.
+ *
+ * Every command of the command table gets its record when the server is created, so recording a
+ * sample is a few relaxed atomic adds and never locks or allocates. Histograms have log2 buckets;
+ * percentiles are the upper edge of their bucket, capped at the largest sample, so they are
+ * within a factor of two of the true value. Safe to use from any thread.
+ */
+class FMCPServerStats
+{
+public:
+	explicit FMCPServerStats(const TArray<FString>& CommandNames);
+
+	/** Record index of a command, or INDEX_NONE for commands not in the table (which are not recorded). */
+	int32 FindCommand(const FString& Command) const;
+
+	const FString& GetCommandName(int32 CommandIndex) const;
+
+	void Record(int32 CommandIndex, EMCPStat Stat, uint64 Value);
+	void RecordSeconds(int32 CommandIndex, EMCPStat Stat, double Seconds);
+
+	/** Process-wide count of Malloc and Realloc calls so far; 0 where the allocator does not count them. */
+	static uint64 GetAllocationCount();
+
+	/**
+	 * The commands named in Commands (all if empty) that ran at least once, by total execution time,
+	 * longest first. Buckets are only listed when bIncludeHistograms is set.
+	 */
+	TSharedPtr<FJsonObject> ToJson(const TSet<FString>& Commands, bool bIncludeHistograms) const;
+
+	/** Start over from zero. Samples recorded while this runs may land on either side. */
+	void Reset();
+
+private:
+	struct FHistogram
+	{
+		static constexpr int32 NumBuckets = 48;
+
+		// Bucket 0 holds zero, bucket N values in [2^(N-1), 2^N)
+		std::atomic<uint64> Buckets[NumBuckets];
+		std::atomic<uint64> Count;
+		std::atomic<uint64> Sum;
+		std::atomic<uint64> Max;
+
+		FHistogram() { Reset(); }
+		void Add(uint64 Value);
+		void Reset();
+		uint64 GetPercentile(double Fraction) const;
+		TSharedPtr<FJsonObject> ToJson(double Scale, bool bIncludeBuckets) const;
+	};
+
+	struct FCommandRecord
+	{
+		FString Name;
+		FHistogram Stats[(int32)EMCPStat::Num];
+	};
+
+	TArray<TUniquePtr<FCommandRecord>> Records;
+	TMap<FString, int32> CommandIndices;
+	std::atomic<double> ResetTime;
+};
@@ -0,0 +1,328 @@
+#include "MCPServerTypeIndex.h"
+#include "MCPServerMigrationAnalysis.h"
+#include "Engine/Blueprint.h"
+#include "EdGraph/EdGraph.h"
+#include "EdGraph/EdGraphNode.h"
+#include "EdGraph/EdGraphPin.h"
+#include "K2Node_StructOperation.h"
+#include "K2Node_SwitchEnum.h"
+#include "K2Node_CastByteToEnum.h"
+#include "K2Node_DynamicCast.h"
+#include "K2Node_FunctionEntry.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Misc/PackageName.h"
+#include "UObject/Package.h"
+
+namespace MCPTypeIndex
+{
+	static bool FindBlueprintAsset(FName PackageName, FAssetData& OutAsset)
+	{
+		TArray<FAssetData> Assets;
+		FAssetRegistryModule::GetRegistry().GetAssetsByPackageName(PackageName, Assets);
+		for (const FAssetData& Asset : Assets)
+		{
+			if (Asset.IsInstanceOf(UBlueprint::StaticClass()))
+			{
+				OutAsset = Asset;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// References found since ScopeStart are checked for duplicates; a node's pins repeat the same types a lot
+	static void AddType(TArray<FMCPTypeReference>& References, int32 ScopeStart, const UObject* Object,
+		const TCHAR* Kind, FName Graph = NAME_None, const FGuid& NodeGuid = FGuid())
+	{
+		if (!Object || !(Object->IsA<UEnum>() || Object->IsA<UScriptStruct>() || Object->IsA<UClass>()))
+		{
+			return;
+		}
+
+		FMCPTypeReference Reference;
+		Reference.Type = FSoftObjectPath(Object);
+		Reference.Kind = Kind;
+		Reference.Graph = Graph;
+		Reference.NodeGuid = NodeGuid;
+		for (int32 Index = ScopeStart; Index < References.Num(); ++Index)
+		{
+			if (References[Index] == Reference)
+			{
+				++References[Index].Count;
+				return;
+			}
+		}
+		References.Add(MoveTemp(Reference));
+	}
+
+	static void AddPinType(TArray<FMCPTypeReference>& References, int32 ScopeStart, const FEdGraphPinType& PinType,
+		const TCHAR* Kind, FName Graph = NAME_None, const FGuid& NodeGuid = FGuid())
+	{
+		AddType(References, ScopeStart, PinType.PinSubCategoryObject.Get(), Kind, Graph, NodeGuid);
+		// Map values
+		AddType(References, ScopeStart, PinType.PinValueType.TerminalSubCategoryObject.Get(), Kind, Graph, NodeGuid);
+	}
+}
+
+bool FMCPBlueprintTypeReferences::ReferencesType(const UObject* Type, EMCPTypeMatch Match) const
+{
+	return Type && ReferencesType(FSoftObjectPath(Type), Match);
+}
+
+bool FMCPBlueprintTypeReferences::ReferencesType(const FSoftObjectPath& TypePath, EMCPTypeMatch Match) const
+{
+	if (TypePath.IsNull())
+	{
+		return false;
+	}
+
+	return References.ContainsByPredicate([&](const FMCPTypeReference& Reference)
+	{
+		return Reference.Matches(TypePath, Match);
+	});
+}
+
+FMCPTypeReferenceIndex::FMCPTypeReferenceIndex()
+{
+	PackageMarkedDirtyHandle = UPackage::PackageMarkedDirtyEvent.AddRaw(this, &FMCPTypeReferenceIndex::OnPackageMarkedDirty);
+}
+
+FMCPTypeReferenceIndex::~FMCPTypeReferenceIndex()
+{
+	UPackage::PackageMarkedDirtyEvent.Remove(PackageMarkedDirtyHandle);
+}
+
+TArray<FName> FMCPTypeReferenceIndex::GetCandidatePackages(const UObject* Type)
+{
+	return Type ? GetCandidatePackages(FSoftObjectPath(Type)) : TArray<FName>();
+}
+
+TArray<FName> FMCPTypeReferenceIndex::GetCandidatePackages(const FSoftObjectPath& Type)
+{
+	TSet<FName> Candidates;
+	if (Type.IsNull())
+	{
+		return TArray<FName>();
+	}
+
+	// Saved blueprints import the package that defines each type they use
+	const IAssetRegistry& AssetRegistry = FAssetRegistryModule::GetRegistry();
+	TArray<FName> Referencers;
+	AssetRegistry.GetReferencers(Type.GetLongPackageFName(), Referencers,
+		UE::AssetRegistry::EDependencyCategory::Package, UE::AssetRegistry::EDependencyQuery::Hard);
+
+	FAssetData Asset;
+	for (const FName Referencer : Referencers)
+	{
+		if (Entries.Contains(Referencer) || MCPTypeIndex::FindBlueprintAsset(Referencer, Asset))
+		{
+			Candidates.Add(Referencer);
+		}
+	}
+
+	// Already indexed, including name matches that live in other packages than the type's own
+	if (const TSet<FName>* Indexed = PackagesByTypeName.Find(Type.GetAssetFName()))
+	{
+		Candidates.Append(*Indexed);
+	}
+
+	// Edits not saved yet
+	for (const FName PackageName : StalePackages)
+	{
+		if (MCPTypeIndex::FindBlueprintAsset(PackageName, Asset) && Asset.IsAssetLoaded())
+		{
+			Candidates.Add(PackageName);
+		}
+	}
+
+	TArray<FName> Sorted = Candidates.Array();
+	Sorted.Sort(FNameLexicalLess());
+	return Sorted;
+}
+
+const FMCPBlueprintTypeReferences* FMCPTypeReferenceIndex::GetBlueprintReferences(FName PackageName)
+{
+	if (const FMCPBlueprintTypeReferences* Entry = Entries.Find(PackageName))
+	{
+		if (!StalePackages.Contains(PackageName))
+		{
+			return Entry;
+		}
+	}
+
+	StalePackages.Remove(PackageName);
+
+	FAssetData Asset;
+	UBlueprint* Blueprint = MCPTypeIndex::FindBlueprintAsset(PackageName, Asset) ? Cast<UBlueprint>(Asset.GetAsset()) : nullptr;
+	if (!Blueprint)
+	{
+		RemoveEntry(PackageName);
+		return nullptr;
+	}
+
+	ScanBlueprint(PackageName, Blueprint);
+	return Entries.Find(PackageName);
+}
+
+const FMCPBlueprintTypeReferences* FMCPTypeReferenceIndex::FindBlueprintReferences(FName PackageName) const
+{
+	return StalePackages.Contains(PackageName) ? nullptr : Entries.Find(PackageName);
+}
+
+TArray<FSoftObjectPath> FMCPTypeReferenceIndex::FindReferencingBlueprints(const UObject* Type, EMCPTypeMatch Match)
+{
+	TArray<FSoftObjectPath> Blueprints;
+	for (const FName PackageName : GetCandidatePackages(Type))
+	{
+		const FMCPBlueprintTypeReferences* Entry = GetBlueprintReferences(PackageName);
+		if (Entry && Entry->ReferencesType(Type, Match))
+		{
+			Blueprints.Add(Entry->Blueprint);
+		}
+	}
+	return Blueprints;
+}
+
+void FMCPTypeReferenceIndex::OnBlueprintPreCompile(UBlueprint* Blueprint)
+{
+	if (Blueprint)
+	{
+		StalePackages.Add(Blueprint->GetOutermost()->GetFName());
+	}
+}
+
+void FMCPTypeReferenceIndex::OnBlueprintCompiled()
+{
+	for (const FName PackageName : StalePackages.Array())
+	{
+		FAssetData Asset;
+		if (!MCPTypeIndex::FindBlueprintAsset(PackageName, Asset))
+		{
+			// Levels and other assets dirtied along the way
+			StalePackages.Remove(PackageName);
+			RemoveEntry(PackageName);
+		}
+		else if (UBlueprint* Blueprint = Cast<UBlueprint>(Asset.FastGetAsset(false)))
+		{
+			StalePackages.Remove(PackageName);
+			ScanBlueprint(PackageName, Blueprint);
+		}
+	}
+}
+
+void FMCPTypeReferenceIndex::OnAssetRemoved(const FAssetData& AssetData)
+{
+	StalePackages.Remove(AssetData.PackageName);
+	RemoveEntry(AssetData.PackageName);
+}
+
+void FMCPTypeReferenceIndex::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	const FName OldPackageName(*FPackageName::ObjectPathToPackageName(OldObjectPath));
+	StalePackages.Remove(OldPackageName);
+	RemoveEntry(OldPackageName);
+	StalePackages.Add(AssetData.PackageName);
+}
+
+void FMCPTypeReferenceIndex::ScanBlueprint(FName PackageName, UBlueprint* Blueprint)
+{
+	RemoveEntry(PackageName);
+
+	FMCPBlueprintTypeReferences Entry;
+	Entry.Blueprint = FSoftObjectPath(Blueprint);
+	TArray<FMCPTypeReference>& References = Entry.References;
+
+	MCPTypeIndex::AddType(References, 0, Blueprint->ParentClass, TEXT("parent_class"));
+	for (const FBPInterfaceDescription& Interface : Blueprint->ImplementedInterfaces)
+	{
+		MCPTypeIndex::AddType(References, 0, Interface.Interface, TEXT("interface"));
+	}
+	for (const FBPVariableDescription& Var : Blueprint->NewVariables)
+	{
+		MCPTypeIndex::AddPinType(References, 0, Var.VarType, TEXT("variable"));
+	}
+
+	for (UEdGraph* Graph : MCPMigrationAnalysis::GetAllGraphs(Blueprint))
+	{
+		if (!Graph) continue;
+
+		const FName GraphName = Graph->GetFName();
+		for (UEdGraphNode* Node : Graph->Nodes)
+		{
+			if (!Node) continue;
+
+			const int32 ScopeStart = References.Num();
+			const FGuid& NodeGuid = Node->NodeGuid;
+
+			if (const UK2Node_StructOperation* StructNode = Cast<UK2Node_StructOperation>(Node))
+			{
+				MCPTypeIndex::AddType(References, ScopeStart, StructNode->StructType, TEXT("node"), GraphName, NodeGuid);
+			}
+			else if (const UK2Node_SwitchEnum* SwitchNode = Cast<UK2Node_SwitchEnum>(Node))
+			{
+				MCPTypeIndex::AddType(References, ScopeStart, SwitchNode->Enum, TEXT("node"), GraphName, NodeGuid);
+			}
+			else if (const UK2Node_CastByteToEnum* CastEnumNode = Cast<UK2Node_CastByteToEnum>(Node))
+			{
+				MCPTypeIndex::AddType(References, ScopeStart, CastEnumNode->Enum, TEXT("node"), GraphName, NodeGuid);
+			}
+			else if (const UK2Node_DynamicCast* CastNode = Cast<UK2Node_DynamicCast>(Node))
+			{
+				MCPTypeIndex::AddType(References, ScopeStart, CastNode->TargetType, TEXT("node"), GraphName, NodeGuid);
+			}
+			else if (const UK2Node_FunctionEntry* EntryNode = Cast<UK2Node_FunctionEntry>(Node))
+			{
+				for (const FBPVariableDescription& LocalVar : EntryNode->LocalVariables)
+				{
+					MCPTypeIndex::AddPinType(References, ScopeStart, LocalVar.VarType, TEXT("local_variable"), GraphName, NodeGuid);
+				}
+			}
+
+			for (const UEdGraphPin* Pin : Node->Pins)
+			{
+				if (Pin)
+				{
+					MCPTypeIndex::AddPinType(References, ScopeStart, Pin->PinType, TEXT("pin"), GraphName, NodeGuid);
+				}
+			}
+		}
+	}
+
+	for (const FMCPTypeReference& Reference : References)
+	{
+		PackagesByTypeName.FindOrAdd(Reference.Type.GetAssetFName()).Add(PackageName);
+	}
+	Entries.Add(PackageName, MoveTemp(Entry));
+}
+
+void FMCPTypeReferenceIndex::RemoveEntry(FName PackageName)
+{
+	const FMCPBlueprintTypeReferences* Entry = Entries.Find(PackageName);
+	if (!Entry)
+	{
+		return;
+	}
+
+	for (const FMCPTypeReference& Reference : Entry->References)
+	{
+		const FName TypeName = Reference.Type.GetAssetFName();
+		if (TSet<FName>* Packages = PackagesByTypeName.Find(TypeName))
+		{
+			Packages->Remove(PackageName);
+			if (Packages->Num() == 0)
+			{
+				PackagesByTypeName.Remove(TypeName);
+			}
+		}
+	}
+	Entries.Remove(PackageName);
+}
+
+void FMCPTypeReferenceIndex::OnPackageMarkedDirty(UPackage* Package, bool bWasDirty)
+{
+	if (Package)
+	{
+		StalePackages.Add(Package->GetFName());
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/SoftObjectPath.h"
+
+class UBlueprint;
+class UPackage;
+struct FAssetData;
+
+/** How an indexed type is compared with the type being looked up. */
+enum class EMCPTypeMatch : uint8
+{
+	// Same object path
+	Exact,
+	// Same object name; UE can keep several loaded copies of a user-defined struct
+	Name
+};
+
+/** One use of an enum, struct or class inside a blueprint. */
+struct FMCPTypeReference
+{
+	FSoftObjectPath Type;
+
+	// "variable", "local_variable", "pin", "node", "parent_class" or "interface"
+	const TCHAR* Kind = TEXT("");
+
+	// None / invalid for uses outside any graph, such as member variables
+	FName Graph;
+	FGuid NodeGuid;
+
+	// Uses folded into this one: a node with several pins of the type is one pin reference
+	int32 Count = 1;
+
+	bool Matches(const FSoftObjectPath& TypePath, EMCPTypeMatch Match) const
+	{
+		return Match == EMCPTypeMatch::Exact ? Type == TypePath : Type.GetAssetFName() == TypePath.GetAssetFName();
+	}
+
+	// Count is not part of the identity
+	bool operator==(const FMCPTypeReference& Other) const
+	{
+		return Type == Other.Type && FCString::Strcmp(Kind, Other.Kind) == 0 && Graph == Other.Graph && NodeGuid == Other.NodeGuid;
+	}
+};
+
+/** Every type use found in one blueprint. */
+struct FMCPBlueprintTypeReferences
+{
+	FSoftObjectPath Blueprint;
+	TArray<FMCPTypeReference> References;
+
+	bool ReferencesType(const UObject* Type, EMCPTypeMatch Match) const;
+	bool ReferencesType(const FSoftObjectPath& Type, EMCPTypeMatch Match) const;
+};
+
+/**
+ * Reverse index from enums, structs and classes to the blueprints, graphs and nodes that use them.
+ *
+ * Blueprints are indexed lazily. The asset registry's package dependencies tell which blueprints
+ * can reference a type without loading anything; only candidates that have no current entry are
+ * loaded and scanned, so a blueprint is loaded at most once per session for lookups.
+ *
+ * Entries go stale when their package is marked dirty or the blueprint is about to compile.
+ * Stale blueprints that are still loaded are rescanned once compiling finishes, the rest on
+ * their next lookup. Removed and renamed assets drop their entries. The module forwards the
+ * editor's compile and asset registry callbacks.
+ *
+ * Game thread only.
+ */
+class FMCPTypeReferenceIndex
+{
+public:
+	FMCPTypeReferenceIndex();
+	~FMCPTypeReferenceIndex();
+
+	/** Packages of blueprints that may use Type, in name order. Loads nothing. */
+	TArray<FName> GetCandidatePackages(const UObject* Type);
+	TArray<FName> GetCandidatePackages(const FSoftObjectPath& Type);
+
+	/** Type uses of the blueprint in the package if they are indexed and current, else null. Loads nothing. */
+	const FMCPBlueprintTypeReferences* FindBlueprintReferences(FName PackageName) const;
+
+	/** Type uses of the blueprint in the package, scanning it first if needed. Null if the package holds no blueprint. */
+	const FMCPBlueprintTypeReferences* GetBlueprintReferences(FName PackageName);
+
+	/** Blueprints that use Type, in package name order. */
+	TArray<FSoftObjectPath> FindReferencingBlueprints(const UObject* Type, EMCPTypeMatch Match);
+
+	void OnBlueprintPreCompile(UBlueprint* Blueprint);
+	void OnBlueprintCompiled();
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+private:
+	void ScanBlueprint(FName PackageName, UBlueprint* Blueprint);
+	void RemoveEntry(FName PackageName);
+	void OnPackageMarkedDirty(UPackage* Package, bool bWasDirty);
+
+	// Indexed blueprints by package name
+	TMap<FName, FMCPBlueprintTypeReferences> Entries;
+
+	// Type object name -> packages of indexed blueprints that use a type of that name
+	TMap<FName, TSet<FName>> PackagesByTypeName;
+
+	// Packages changed since they were last scanned, indexed or not. Unsaved edits are not in
+	// the asset registry's dependencies, so these are always lookup candidates while loaded.
+	TSet<FName> StalePackages;
+
+	FDelegateHandle PackageMarkedDirtyHandle;
+};
@@ -0,0 +1,275 @@
+#include "MCPServerTypeRegistry.h"
+#include "AssetRegistry/AssetData.h"
+#include "UObject/UObjectIterator.h"
+
+FMCPTypeRegistry& FMCPTypeRegistry::Get()
+{
+	static FMCPTypeRegistry Registry;
+	return Registry;
+}
+
+FMCPTypeRegistry::FMCPTypeRegistry()
+{
+	GUObjectArray.AddUObjectCreateListener(this);
+	GUObjectArray.AddUObjectDeleteListener(this);
+	bListening = true;
+}
+
+FMCPTypeRegistry::~FMCPTypeRegistry()
+{
+	if (bListening)
+	{
+		GUObjectArray.RemoveUObjectCreateListener(this);
+		GUObjectArray.RemoveUObjectDeleteListener(this);
+	}
+}
+
+FString FMCPTypeRegistry::GetScriptTypeName(const FString& PathOrName)
+{
+	FString ModuleName;
+	FString TypeName;
+	if (PathOrName.StartsWith(TEXT("/Script/")) && PathOrName.RightChop(8).Split(TEXT("."), &ModuleName, &TypeName))
+	{
+		return TypeName;
+	}
+	return PathOrName;
+}
+
+TArray<FName> FMCPTypeRegistry::GetAllNames()
+{
+	Update();
+
+	TArray<FName> Names;
+	TypesByName.GetKeys(Names);
+	return Names;
+}
+
+void FMCPTypeRegistry::OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath)
+{
+	if (bDirty)
+	{
+		return;
+	}
+
+	// Only entries still filed under the old name need moving; queued creations are filed
+	// under whatever name the object has when the queue is applied
+	const FName OldName = GetObjectName(OldObjectPath);
+	TArray<TWeakObjectPtr<UField>>* Entries = TypesByName.Find(OldName);
+	if (!Entries)
+	{
+		return;
+	}
+
+	TArray<UField*> Renamed;
+	Entries->RemoveAll([OldName, &Renamed](const TWeakObjectPtr<UField>& Entry)
+	{
+		UField* Type = Entry.Get();
+		if (Type && Type->GetFName() != OldName)
+		{
+			Renamed.Add(Type);
+			return true;
+		}
+		return false;
+	});
+	if (Entries->Num() == 0)
+	{
+		TypesByName.Remove(OldName);
+	}
+
+	for (UField* Type : Renamed)
+	{
+		AddType(Type);
+	}
+}
+
+void FMCPTypeRegistry::NotifyUObjectCreated(const UObjectBase* Object, int32 Index)
+{
+	// Nothing to record while a full scan is due anyway. The object is not constructed yet,
+	// so only its address and name are kept; it is looked at again when the queue is applied.
+	if (!bDirty.load(std::memory_order_relaxed) && IsTypeClass(Object->GetClass()))
+	{
+		FScopeLock ScopeLock(&PendingLock);
+		QueueChange({ Object, Object->GetFName(), true });
+	}
+}
+
+void FMCPTypeRegistry::NotifyUObjectDeleted(const UObjectBase* Object, int32 Index)
+{
+	if (!bDirty.load(std::memory_order_relaxed) && IsTypeClass(Object->GetClass()))
+	{
+		FScopeLock ScopeLock(&PendingLock);
+		QueueChange({ Object, Object->GetFName(), false });
+	}
+}
+
+void FMCPTypeRegistry::QueueChange(const FPendingChange& Change)
+{
+	if (PendingChanges.Num() >= MaxPendingChanges)
+	{
+		PendingChanges.Empty();
+		bHasPendingChanges = false;
+		bDirty = true;
+		return;
+	}
+	PendingChanges.Add(Change);
+	bHasPendingChanges = true;
+}
+
+void FMCPTypeRegistry::OnUObjectArrayShutdown()
+{
+	if (bListening)
+	{
+		GUObjectArray.RemoveUObjectCreateListener(this);
+		GUObjectArray.RemoveUObjectDeleteListener(this);
+		bListening = false;
+	}
+}
+
+TArray<UField*> FMCPTypeRegistry::FindTypes(FName Name)
+{
+	Update();
+
+	TArray<UField*> Types;
+	if (const TArray<TWeakObjectPtr<UField>>* Entries = TypesByName.Find(Name))
+	{
+		for (const TWeakObjectPtr<UField>& Entry : *Entries)
+		{
+			UField* Type = Entry.Get();
+			if (Type && Type->GetFName() == Name)
+			{
+				Types.Add(Type);
+			}
+			else
+			{
+				// Renamed without an asset rename event (OnAssetRenamed); rescan on the next lookup
+				bDirty = true;
+			}
+		}
+	}
+	return Types;
+}
+
+void FMCPTypeRegistry::Update()
+{
+	if (bDirty)
+	{
+		Rebuild();
+	}
+	if (bHasPendingChanges)
+	{
+		ApplyPendingChanges();
+	}
+}
+
+void FMCPTypeRegistry::Rebuild()
+{
+	// Cleared first, so types created while iterating are queued as well; AddType skips the
+	// ones the scan already found
+	bDirty = false;
+	{
+		FScopeLock ScopeLock(&PendingLock);
+		PendingChanges.Reset();
+		bHasPendingChanges = false;
+	}
+	TypesByName.Reset();
+
+	for (TObjectIterator<UEnum> It; It; ++It)
+	{
+		TypesByName.FindOrAdd(It->GetFName()).Add(*It);
+	}
+	for (TObjectIterator<UScriptStruct> It; It; ++It)
+	{
+		TypesByName.FindOrAdd(It->GetFName()).Add(*It);
+	}
+	for (TPair<FName, TArray<TWeakObjectPtr<UField>>>& Pair : TypesByName)
+	{
+		Pair.Value.Sort([](const TWeakObjectPtr<UField>& A, const TWeakObjectPtr<UField>& B)
+		{
+			return GUObjectArray.ObjectToIndex(A.Get()) < GUObjectArray.ObjectToIndex(B.Get());
+		});
+	}
+}
+
+void FMCPTypeRegistry::ApplyPendingChanges()
+{
+	TArray<FPendingChange> Changes;
+	{
+		FScopeLock ScopeLock(&PendingLock);
+		Changes = MoveTemp(PendingChanges);
+		PendingChanges.Reset();
+		bHasPendingChanges = false;
+	}
+
+	// A created object is only safe to look at if it was not destroyed later in the queue
+	// (its memory may even hold a newer object by now, which has an entry of its own)
+	TMap<const UObjectBase*, int32> LastDeleted;
+	for (int32 Index = 0; Index < Changes.Num(); ++Index)
+	{
+		if (!Changes[Index].bCreated)
+		{
+			LastDeleted.Add(Changes[Index].Object, Index);
+		}
+	}
+
+	for (int32 Index = 0; Index < Changes.Num(); ++Index)
+	{
+		const FPendingChange& Change = Changes[Index];
+		if (Change.bCreated)
+		{
+			const int32* DeletedAt = LastDeleted.Find(Change.Object);
+			if (!DeletedAt || *DeletedAt < Index)
+			{
+				AddType(static_cast<UField*>(const_cast<UObjectBase*>(Change.Object)));
+			}
+			continue;
+		}
+
+		if (TArray<TWeakObjectPtr<UField>>* Entries = TypesByName.Find(Change.Name))
+		{
+			Entries->RemoveAll([](const TWeakObjectPtr<UField>& Entry) { return !Entry.IsValid(); });
+			if (Entries->Num() == 0)
+			{
+				TypesByName.Remove(Change.Name);
+			}
+		}
+	}
+}
+
+void FMCPTypeRegistry::AddType(UField* Type)
+{
+	TArray<TWeakObjectPtr<UField>>& Entries = TypesByName.FindOrAdd(Type->GetFName());
+	const TWeakObjectPtr<UField> NewEntry(Type);
+	Entries.RemoveAll([](const TWeakObjectPtr<UField>& Entry) { return !Entry.IsValid(); });
+	if (Entries.Contains(NewEntry))
+	{
+		return;
+	}
+
+	// Keep object index order; a new object may reuse a lower slot
+	const int32 TypeIndex = GUObjectArray.ObjectToIndex(Type);
+	int32 InsertAt = Entries.Num();
+	while (InsertAt > 0 && GUObjectArray.ObjectToIndex(Entries[InsertAt - 1].Get()) > TypeIndex)
+	{
+		--InsertAt;
+	}
+	Entries.Insert(NewEntry, InsertAt);
+}
+
+FName FMCPTypeRegistry::GetObjectName(const FString& Path)
+{
+	int32 Separator = INDEX_NONE;
+	for (int32 Index = Path.Len() - 1; Index >= 0; --Index)
+	{
+		if (Path[Index] == TEXT('.') || Path[Index] == TEXT(':'))
+		{
+			Separator = Index;
+			break;
+		}
+	}
+	return FName(*Path.RightChop(Separator + 1));
+}
+
+bool FMCPTypeRegistry::IsTypeClass(const UClass* Class)
+{
+	return Class && (Class->IsChildOf(UEnum::StaticClass()) || Class->IsChildOf(UScriptStruct::StaticClass()));
+}
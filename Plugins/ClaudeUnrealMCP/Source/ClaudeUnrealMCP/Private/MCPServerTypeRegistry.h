@@ -0,0 +1,123 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UObjectArray.h"
+#include "UObject/WeakObjectPtr.h"
+#include "HAL/CriticalSection.h"
+#include <atomic>
+
+struct FAssetData;
+
+/**
+ * Live enums and structs by short name, for commands that take a bare type name or a path
+ * such as /Script/Module.Type. Classes are left out: blueprint compiles create and destroy
+ * them all the time, and FindFirstObject already finds them by name.
+ *
+ * The map is built with one scan on first use and then kept up to date. Objects are created
+ * and destroyed on any thread, so the UObject array listeners only queue the change under a
+ * lock; the next lookup applies the queue to the map. Renaming keeps the object, so the
+ * module forwards asset renames to move the entry to its new name. Types sharing a name come back in
+ * object index order, the order TObjectIterator yields them, so "first match" picks the same
+ * object a full scan would.
+ *
+ * Lookups are game thread only.
+ */
+class FMCPTypeRegistry : public FUObjectArray::FUObjectCreateListener, public FUObjectArray::FUObjectDeleteListener
+{
+public:
+	static FMCPTypeRegistry& Get();
+
+	virtual ~FMCPTypeRegistry();
+
+	/** Every live T with this short name. */
+	template<typename T>
+	TArray<T*> FindAll(FName Name)
+	{
+		TArray<T*> Found;
+		for (UField* Type : FindTypes(Name))
+		{
+			if (T* Typed = Cast<T>(Type))
+			{
+				Found.Add(Typed);
+			}
+		}
+		return Found;
+	}
+
+	/** First live T with this short name, or null. */
+	template<typename T>
+	T* FindFirst(FName Name)
+	{
+		for (UField* Type : FindTypes(Name))
+		{
+			if (T* Typed = Cast<T>(Type))
+			{
+				return Typed;
+			}
+		}
+		return nullptr;
+	}
+
+	/** The live T whose path name is exactly Path, or null. */
+	template<typename T>
+	T* FindByPath(const FString& Path)
+	{
+		for (UField* Type : FindTypes(GetObjectName(Path)))
+		{
+			T* Typed = Cast<T>(Type);
+			if (Typed && Typed->GetPathName() == Path)
+			{
+				return Typed;
+			}
+		}
+		return nullptr;
+	}
+
+	/** "Type" for "/Script/Module.Type"; anything else is returned as is. */
+	static FString GetScriptTypeName(const FString& PathOrName);
+
+	/** Short names of every live type, in no particular order. */
+	TArray<FName> GetAllNames();
+
+	/** Files a renamed user-defined enum or struct under its new name. Game thread only. */
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
+
+	// FUObjectCreateListener / FUObjectDeleteListener
+	virtual void NotifyUObjectCreated(const UObjectBase* Object, int32 Index) override;
+	virtual void NotifyUObjectDeleted(const UObjectBase* Object, int32 Index) override;
+	virtual void OnUObjectArrayShutdown() override;
+
+private:
+	FMCPTypeRegistry();
+
+	/** A type object that came or went since the map was last brought up to date. */
+	struct FPendingChange
+	{
+		const UObjectBase* Object = nullptr;
+		FName Name;
+		bool bCreated = false;
+	};
+
+	TArray<UField*> FindTypes(FName Name);
+	void Update();
+	void Rebuild();
+	void ApplyPendingChanges();
+
+	/** Called with PendingLock held. */
+	void QueueChange(const FPendingChange& Change);
+	void AddType(UField* Type);
+
+	static FName GetObjectName(const FString& Path);
+	static bool IsTypeClass(const UClass* Class);
+
+	// Past this many queued changes the queue is dropped and the next lookup rescans instead
+	static constexpr int32 MaxPendingChanges = 4096;
+
+	TMap<FName, TArray<TWeakObjectPtr<UField>>> TypesByName;
+	std::atomic<bool> bDirty{ true };
+	bool bListening = false;
+
+	FCriticalSection PendingLock;
+	TArray<FPendingChange> PendingChanges;
+	std::atomic<bool> bHasPendingChanges{ false };
+};
@@ -5,6 +5,8 @@
 #include "Containers/Ticker.h"
 
 class FMCPServer;
+class UBlueprint;
+struct FAssetData;
 
 class FClaudeUnrealMCPModule : public IModuleInterface
 {
@@ -13,9 +15,15 @@ public:
 	virtual void ShutdownModule() override;
 
 private:
+	void OnBlueprintPreCompile(UBlueprint* Blueprint);
 	void OnBlueprintCompiled();
+	void OnAssetRemoved(const FAssetData& AssetData);
+	void OnAssetRenamed(const FAssetData& AssetData, const FString& OldObjectPath);
 
 	FMCPServer* Server = nullptr;
+	FDelegateHandle OnBlueprintPreCompileHandle;
 	FDelegateHandle OnBlueprintCompiledHandle;
+	FDelegateHandle OnAssetRemovedHandle;
+	FDelegateHandle OnAssetRenamedHandle;
 	FTSTicker::FDelegateHandle TickerHandle;
 };
@@ -4,7 +4,26 @@
 #include "Sockets.h"
 #include "SocketSubsystem.h"
 #include "Interfaces/IPv4/IPv4Address.h"
-#include "Common/TcpListener.h"
+#include "Containers/Queue.h"
+#include "Containers/Ticker.h"
+#include "HAL/ThreadSafeCounter.h"
+#include <atomic>
+
+struct FMCPConnection;
+struct FMCPPendingCommand;
+struct FMCPJobEntry;
+class FMCPJob;
+class FMCPResponseStream;
+class FMCPServerReactor;
+class FMCPCompileCache;
+class FMCPCompileQueue;
+class FMCPTypeReferenceIndex;
+class FMCPActorIndex;
+class FMCPGraphSnapshotCache;
+class FMCPResolveCache;
+class FMCPServerStats;
+enum class EMCPCommandThreading : uint8;
+enum class EMCPEncoding : uint8;
 
 class FMCPServer
 {
@@ -14,13 +33,35 @@ public:
 
 	bool Start(int32 Port = 9877);
 	void Stop();
+
+	/** Null while the server is stopped. The module keeps it current from editor callbacks. */
+	FMCPTypeReferenceIndex* GetTypeReferenceIndex() const { return TypeIndex.Get(); }
 private:
-	bool HandleConnection(FSocket* ClientSocket, const FIPv4Endpoint& ClientEndpoint);
-	void HandleClient(FSocket* ClientSocket);
+	using FCommandHandler = FString (FMCPServer::*)(const TSharedPtr<FJsonObject>&);
+	struct FCommandEntry
+	{
+		FCommandHandler Handler;
+		EMCPCommandThreading Threading;
+	};
+	static const TMap<FString, FCommandEntry>& GetCommandTable();
+
+	void DispatchRequest(const TSharedRef<FMCPConnection, ESPMode::ThreadSafe>& Connection, FUtf8StringView Payload);
+	void ExecutePendingCommand(FMCPPendingCommand& Pending);
+	bool TickGameThreadQueue(float DeltaTime);
+	void QueueResponse(FMCPConnection& Connection, EMCPEncoding Encoding, const TSharedPtr<FJsonValue>& RequestId, const FString& Response, int32 StatsCommand = INDEX_NONE);
+	void QueueMessage(FMCPConnection& Connection, EMCPEncoding Encoding, const TSharedPtr<FJsonValue>& RequestId, const TSharedRef<FJsonObject>& Message, int32 StatsCommand = INDEX_NONE);
+	void RecordFrameSent(int32 StatsCommand, double Seconds, int32 Bytes);
 	FString ProcessCommand(const TSharedPtr<FJsonObject>& JsonCommand);
 
+	// Server commands
+	FString HandlePing(const TSharedPtr<FJsonObject>& Params);
+	FString HandleHello(const TSharedPtr<FJsonObject>& Params);
+	FString HandleGetServerStats(const TSharedPtr<FJsonObject>& Params);
+	FString HandleListStructs(const TSharedPtr<FJsonObject>& Params);
+
 	// Blueprint reading commands
 	FString HandleListBlueprints(const TSharedPtr<FJsonObject>& Params);
+	FString HandleQueryAssets(const TSharedPtr<FJsonObject>& Params);
 	FString HandleCheckAllBlueprints(const TSharedPtr<FJsonObject>& Params);
 	FString HandleReadBlueprint(const TSharedPtr<FJsonObject>& Params);
 	FString HandleReadVariables(const TSharedPtr<FJsonObject>& Params);
@@ -40,6 +81,7 @@ private:
 	FString HandleFindActorsByName(const TSharedPtr<FJsonObject>& Params);
 	FString HandleGetActorMaterialInfo(const TSharedPtr<FJsonObject>& Params);
 	FString HandleGetSceneSummary(const TSharedPtr<FJsonObject>& Params);
+	FString HandleQueryActors(const TSharedPtr<FJsonObject>& Params);
 
 	// Blueprint writing commands
 	FString HandleAddComponent(const TSharedPtr<FJsonObject>& Params);
@@ -50,6 +92,7 @@ private:
 	FString HandleAddInputMapping(const TSharedPtr<FJsonObject>& Params);
 	FString HandleReparentBlueprint(const TSharedPtr<FJsonObject>& Params);
 	FString HandleCompileBlueprint(const TSharedPtr<FJsonObject>& Params);
+	FString HandleFlush(const TSharedPtr<FJsonObject>& Params);
 	FString HandleSaveAsset(const TSharedPtr<FJsonObject>& Params);
 	FString HandleSaveAll(const TSharedPtr<FJsonObject>& Params);
 	FString HandleDeleteInterfaceFunction(const TSharedPtr<FJsonObject>& Params);
@@ -102,6 +145,7 @@ private:
 	// Struct migration (Sprint 7)
 	FString HandleMigrateStructReferences(const TSharedPtr<FJsonObject>& Params);
 	FString HandleMigrateEnumReferences(const TSharedPtr<FJsonObject>& Params);
+	FString HandlePlanMigration(const TSharedPtr<FJsonObject>& Params);
 	FString HandleFixPropertyAccessPaths(const TSharedPtr<FJsonObject>& Params);
 	FString HandleCleanPropertyAccessPaths(const TSharedPtr<FJsonObject>& Params);
 	FString HandleFixStructSubPins(const TSharedPtr<FJsonObject>& Params);
@@ -120,13 +164,71 @@ private:
 	// Chooser Table migration (Sprint 9)
 	FString HandleMigrateChooserTable(const TSharedPtr<FJsonObject>& Params);
 
+	// Runs several commands in one game-thread slice
+	FString HandleBatch(const TSharedPtr<FJsonObject>& Params);
+
+	// Long-running jobs
+	FString HandleGetJobStatus(const TSharedPtr<FJsonObject>& Params);
+	FString HandleCancelJob(const TSharedPtr<FJsonObject>& Params);
+	FString RunJob(const TSharedRef<FMCPJob>& Job, const FString& Command, const TSharedPtr<FJsonObject>& Params);
+	bool TickJobs(float DeltaTime);
+
+	// Streamed responses: run until done or the client falls behind, then parked and stepped by TickJobs
+	FString RunResponseStream(const TSharedRef<FMCPResponseStream>& Stream);
+	void FinishResponseStream(FMCPResponseStream& Stream);
+	void FinishJob(FMCPJobEntry& Entry, bool bCancelled);
+	void SendJobEvent(const FMCPJobEntry& Entry, const TCHAR* EventName, const TSharedPtr<FJsonObject>& Payload);
+	TSharedPtr<FJsonObject> DescribeJob(const FMCPJobEntry& Entry, bool bIncludeResult) const;
+
 	// Helpers
 	FString MakeResponse(bool bSuccess, const TSharedPtr<FJsonObject>& Data, const FString& Error = TEXT(""));
 	FString MakeError(const FString& Error);
 	class UBlueprint* LoadBlueprintFromPath(const FString& Path);
 
-	FTcpListener* Listener = nullptr;
-	bool bRunning = false;
-	TArray<FSocket*> ClientSockets;
-	FCriticalSection ClientSocketsLock;
+	// Deferred compiles: handlers queue the blueprints they edit; the queue is flushed at the end
+	// of a batch, by flush or compile_blueprint, before saving, and once the server has been idle
+	void QueueCompile(class UBlueprint* Blueprint);
+	TSharedPtr<FJsonObject> FlushCompileQueue(TArray<FString>& OutFailed);
+
+	TUniquePtr<FMCPServerReactor> Reactor;
+
+	// Cleared first in Stop; read by the I/O thread and worker commands
+	std::atomic<bool> bRunning{false};
+
+	// Game-thread commands in arrival order, drained by TickGameThreadQueue once per frame
+	TQueue<TSharedPtr<FMCPPendingCommand, ESPMode::ThreadSafe>, EQueueMode::Mpsc> GameThreadQueue;
+	FTSTicker::FDelegateHandle GameThreadQueueTicker;
+
+	// Asset-registry-only commands currently running on worker threads
+	FThreadSafeCounter ActiveWorkerCommands;
+
+	// Per-command timings for get_server_stats. Created with the server rather than in Start, so
+	// the I/O thread and worker commands can always record into it. Safe to use from any thread.
+	TUniquePtr<FMCPServerStats> Stats;
+
+	// Async jobs, running and recently finished, in start order. Game thread only.
+	TArray<TSharedPtr<FMCPJobEntry>> Jobs;
+	uint32 NextJobId = 1;
+	FTSTicker::FDelegateHandle JobTicker;
+
+	// Streamed responses waiting for their clients to catch up. Game thread only.
+	TArray<TSharedPtr<FMCPResponseStream>> ResponseStreams;
+
+	// Blueprint compile results reused by check_all_blueprints. Game thread only.
+	TSharedPtr<FMCPCompileCache> CompileCache;
+
+	// Blueprints edited since their last full compile. Game thread only.
+	TSharedPtr<FMCPCompileQueue> CompileQueue;
+
+	// Which blueprints use which enums, structs and classes, for the migration commands. Game thread only.
+	TSharedPtr<FMCPTypeReferenceIndex> TypeIndex;
+
+	// Editor world actors by name, label, class and location. Game thread only.
+	TSharedPtr<FMCPActorIndex> ActorIndex;
+
+	// Versions of the graphs the graph readers returned, for since_version deltas. Game thread only.
+	TSharedPtr<FMCPGraphSnapshotCache> GraphSnapshots;
+
+	// Blueprints and classes by the paths commands named them with. Game thread only.
+	TSharedPtr<FMCPResolveCache> ResolveCache;
 };